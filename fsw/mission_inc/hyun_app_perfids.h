@@ -29,6 +29,15 @@
 #ifndef HYUN_APP_PERFIDS_H
 #define HYUN_APP_PERFIDS_H
 
-#define HYUN_APP_PERF_ID 81
+#define HYUN_APP_PERF_ID        81
+#define HYUN_APP_SENSOR_PERF_ID 82 /* HYUN_PIPE_1 drain + batch processing */
+#define HYUN_APP_KF_PERF_ID     83 /* Kalman step on one aligned frame */
+#define HYUN_APP_FILTER_PERF_ID 84 /* Sensor filters over one batch */
+#define HYUN_APP_NMEA_PERF_ID   85 /* NMEA parsing of one raw GPS packet */
+#define HYUN_APP_ALIGN_PERF_ID  86 /* Resampling onto the common tick */
+#define HYUN_APP_UPLINK_PERF_ID 87 /* Text uplink command parsing */
+#define HYUN_APP_UDPTLM_PERF_ID 88 /* UDP telemetry batch, pipe drain to sendmmsg */
+#define HYUN_APP_UDPCMD_PERF_ID 89 /* UDP command batch, recvmmsg to SB */
+#define HYUN_APP_DATA_PERF_ID   90 /* Data task cycle, requests to downlink service */
 
 #endif /* HYUN_APP_PERFIDS_H */
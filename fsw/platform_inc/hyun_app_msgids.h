@@ -38,5 +38,35 @@
 /* V1 Telemetry Message IDs must be 0x08xx */
 #define HYUN_APP_MID_HOUSEKEEPING_RES 0x0815
 #define HYUN_APP_MID_SENDTORCVTEST_RES	0x0816
+#define HYUN_APP_MID_ESTIMATE_TLM	0x0818
+#define HYUN_APP_MID_ALIGNED_TLM	0x0819
+#define HYUN_APP_MID_COMPRESSED_TLM	0x081A
+#define HYUN_APP_MID_TTAG_LIST_TLM	0x081B
+#define HYUN_APP_MID_FILE_DATA_TLM	0x081C
+
+/*
+** Sensor telemetry published by the spacey sensor apps.
+** HYUN_APP only subscribes to these on HYUN_PIPE_1. The values below are
+** placeholders: libs/spacey.h, the only sensor interface in this build,
+** defines no sensor MIDs. The mission build sets the real ones through
+** the CMake variables of the same name (e.g. in targets.cmake or with
+** -DHYUN_APP_MID_SENSOR_IMU=0x08nn), which CMakeLists.txt turns into
+** compile definitions for the app and its tables.
+*/
+#ifndef HYUN_APP_MID_SENSOR_BARO
+#define HYUN_APP_MID_SENSOR_BARO    0x0820 /* Placeholder */
+#endif
+#ifndef HYUN_APP_MID_SENSOR_GPS
+#define HYUN_APP_MID_SENSOR_GPS     0x0821 /* Placeholder */
+#endif
+#ifndef HYUN_APP_MID_SENSOR_IMU
+#define HYUN_APP_MID_SENSOR_IMU     0x0822 /* Placeholder */
+#endif
+#ifndef HYUN_APP_MID_SENSOR_VOLTAGE
+#define HYUN_APP_MID_SENSOR_VOLTAGE 0x0823 /* Placeholder */
+#endif
+#ifndef HYUN_APP_MID_SENSOR_GPS_RAW
+#define HYUN_APP_MID_SENSOR_GPS_RAW 0x0824 /* Placeholder, raw NMEA byte stream from the GPS UART */
+#endif
 
 #endif /* HYUN_APP_MSGIDS_H */
\ No newline at end of file
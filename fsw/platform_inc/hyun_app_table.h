@@ -29,6 +29,53 @@
 #ifndef HYUN_APP_TABLE_H
 #define HYUN_APP_TABLE_H
 
+#define HYUN_APP_DOWNLINK_MAX_STREAMS 4 /* MIDs that can be given a downlink codec */
+
+#define HYUN_APP_UDPTLM_HOST_LEN 16 /* IPv4 dotted quad and terminator */
+#define HYUN_APP_UDPTLM_MAX_MIDS 8
+
+#define HYUN_APP_XBEE_DEVICE_LEN 32
+
+/*
+** Software Bus pipes whose depth and subscriptions come from the table
+*/
+#define HYUN_APP_SUB_PIPE_CMD    0 /* HYUN_APP_CMD_PIPE, HK requests and ground commands */
+#define HYUN_APP_SUB_PIPE_SENSOR 1 /* HYUN_PIPE_1, sensor samples */
+#define HYUN_APP_SUB_PIPES       2
+
+#define HYUN_APP_SUB_MAX_MIDS 8 /* Subscriptions per pipe */
+
+/*
+** Downlink codec selection for one telemetry MID (HYUN_APP_CODEC_xxx).
+** Unused entries have MsgId 0; MIDs not listed are sent unchanged.
+*/
+typedef struct
+{
+    uint16 MsgId;
+    uint8  Codec;
+    uint8  spare;
+} HYUN_APP_DownlinkCodec_t;
+
+/*
+** One MID subscribed on a pipe. Unused entries have MsgId 0.
+*/
+typedef struct
+{
+    uint16 MsgId;
+    uint16 MsgLimit; /* Messages of this MID queued on the pipe at once */
+} HYUN_APP_SubEntry_t;
+
+/*
+** A pipe and its subscriptions. Changing Depth recreates the pipe, which
+** discards whatever is queued on it.
+*/
+typedef struct
+{
+    uint16              Depth;
+    uint16              spare;
+    HYUN_APP_SubEntry_t Entry[HYUN_APP_SUB_MAX_MIDS];
+} HYUN_APP_SubPipe_t;
+
 /*
 ** Table structure
 */
@@ -37,6 +84,58 @@ typedef struct
     uint16 Int1;
     uint16 Int2;
 
+    /*
+    ** Flight state machine thresholds. Altitudes are above the ground
+    ** reference latched on the pad, velocities are up positive.
+    */
+    float  LaunchAltitude;  /* [m]   LAUNCH_WAIT -> ASCENT when above ... */
+    float  LaunchVelocity;  /* [m/s] ... and climbing faster than this */
+    float  ApogeeVelocity;  /* [m/s] ASCENT -> APOGEE when below */
+    float  DescentVelocity; /* [m/s] APOGEE -> DESCENT when sinking faster than this */
+    float  ReleaseAltitude; /* [m]   DESCENT -> PAYLOAD_RELEASE when below */
+    float  LandedAltitude;  /* [m]   PAYLOAD_RELEASE -> LANDED when below ... */
+    float  LandedVelocity;  /* [m/s] ... and |v| below this */
+    uint16 HysteresisCount; /* Consecutive estimator steps (aligned frames) a condition must hold */
+
+    uint16 FilterWindow; /* Baro median / min-max window [samples], 1..HYUN_APP_FILTER_MAX_WINDOW */
+
+    /*
+    ** Common tick the sensor streams are resampled onto
+    */
+    uint16 AlignPeriodMs;     /* Tick period [ms] */
+    uint16 AlignMaxLatencyMs; /* Max wait for a late fast stream before it is held [ms] */
+
+    HYUN_APP_DownlinkCodec_t DownlinkCodec[HYUN_APP_DOWNLINK_MAX_STREAMS];
+
+    /*
+    ** Downlink scheduler token bucket
+    */
+    uint32 LinkBytesPerSec; /* Radio link budget [bytes/s], 0 = unpaced */
+    uint16 LinkBurstBytes;  /* Bucket depth [bytes], must hold the largest packet */
+
+    uint16 TeamId; /* Expected <TEAM_ID> of CANSAT text commands */
+
+    /*
+    ** Local UDP telemetry output for ground testing
+    */
+    char   UdpTlmHost[HYUN_APP_UDPTLM_HOST_LEN];  /* Destination IPv4 address */
+    uint16 UdpTlmPort;                            /* Destination port, 0 = disabled */
+    uint16 UdpTlmMsgId[HYUN_APP_UDPTLM_MAX_MIDS]; /* MIDs forwarded, 0 = unused */
+    uint16 UdpCmdPort;                            /* Loopback command ingest port, 0 = disabled */
+
+    /*
+    ** XBee radio in API mode 2 on a serial port
+    */
+    char   XbeeDevice[HYUN_APP_XBEE_DEVICE_LEN]; /* Serial device, "" = downlink on SB only */
+    uint32 XbeeBaud;                             /* 9600 .. 115200, must match ATBD */
+    uint32 XbeeDestHigh;                         /* 64-bit destination address, upper half */
+    uint32 XbeeDestLow;                          /* 0x0000FFFF broadcasts */
+
+    /*
+    ** Pipe depths and per-MID message limits, HYUN_APP_SUB_PIPE_xxx
+    */
+    HYUN_APP_SubPipe_t SubPipe[HYUN_APP_SUB_PIPES];
+
 } HYUN_APP_Table_t;
 
 #endif /* HYUN_APP_TABLE_H */
@@ -102,8 +102,14 @@ void HYUN_APP_Main(void)
         */
         CFE_ES_PerfLogExit(HYUN_APP_PERF_ID);
 
-        /* Pend on receipt of command packet */
-        status = CFE_SB_ReceiveBuffer(&SBBufPtr, HYUN_APP_Data.CommandPipe, CFE_SB_PEND_FOREVER);
+        /*
+        ** Pend on receipt of command packet. Sensor data is handled by the
+        ** data task, so this task only wakes for commands, for the next
+        ** time-tagged command and to keep the deferred table load and
+        ** subscription changes moving.
+        */
+        status = CFE_SB_ReceiveBuffer(&SBBufPtr, HYUN_APP_Data.CommandPipe,
+                                      HYUN_APP_TtagTimeout(HYUN_APP_CYCLE_TIMEOUT_MS));
 
         /*
         ** Performance Log Entry Stamp
@@ -115,13 +121,31 @@ void HYUN_APP_Main(void)
             HYUN_APP_ProcessCommandPacket(SBBufPtr);
             //printf("Hyun app ES RUNLOOP\n");
         }
-        else
+        else if (status != CFE_SB_TIME_OUT && status != CFE_SB_NO_MESSAGE)
         {
             CFE_EVS_SendEvent(HYUN_APP_PIPE_ERR_EID, CFE_EVS_EventType_ERROR,
                               "HYUN_APP: SB Pipe Read Error, App Will Exit");
 
             HYUN_APP_Data.RunStatus = CFE_ES_RunStatus_APP_ERROR;
         }
+
+        /*
+        ** Time-tagged commands that came due
+        */
+        HYUN_APP_TtagService();
+
+        /*
+        ** Deferred table load, once the app already answers commands
+        */
+        if (HYUN_APP_Data.TblLoadPending)
+        {
+            HYUN_APP_TblLoad();
+        }
+
+        /*
+        ** Command pipe changes of a new table, between two receives
+        */
+        HYUN_APP_SubApply(HYUN_APP_SUB_PIPE_CMD);
     }
 
     /*
@@ -283,7 +307,7 @@ int32 HYUN_APP_TEST_SB_INIT(void)
 {
     int32 Status = 0; 
 
-    //status = CFE_SB_CreatePipe(&HYUN_APP_Data.CommandPipe, HYUN_APP_Data.PipeDepth, HYUN_APP_Data.PipeName);
+    //status = CFE_SB_CreatePipe(&HYUN_APP_Data.CommandPipe, HYUN_APP_Data.Cold.PipeDepth, HYUN_APP_Data.Cold.PipeName);
 
     //Status = CFE_SB_CreatePipe(&HYUN_APP_Data.HYUN_PIPE_1, HYUN_PIPE_1_DEPTH, HYUN_PIPE_1_NAME);
     if (Status == CFE_SUCCESS){
@@ -312,33 +336,29 @@ int32 HYUN_APP_TEST_SB_SEND(void)
     return CFE_SUCCESS;
 }
 
-int32 HYUN_APP_TEST_SB_RCV(void)
+int32 HYUN_APP_SEND_CHAR20_TO_RCVTEST(void)
 {
-    int32 Status;
-    CFE_SB_Buffer_t *SBBufPtr; //메세지를 받을 포인터 선언
-    printf("buffer made\n");
-    Status = CFE_SB_ReceiveBuffer(&SBBufPtr, HYUN_APP_Data.HYUN_PIPE_1, CFE_SB_PEND_FOREVER);
-    
-    if (Status == CFE_SUCCESS)
+    uint32                   CmdCounter;
+    uint32                   ErrCounter;
+    SPACEY_LIB_MSG_CHAR20_t *Char20msgPacket;
+
+    // 풀에서 미리 초기화된 버퍼를 받아서 쓰고, 보낸 뒤 돌려준다
+    Char20msgPacket = (SPACEY_LIB_MSG_CHAR20_t *)HYUN_APP_PoolTake(&HYUN_APP_Data.Pool[HYUN_APP_POOL_CHAR20]);
+    if (Char20msgPacket == NULL)
     {
-        HYUN_APP_ProcessCommandPacket(SBBufPtr);
-        printf("TUTORIAL MSG RCV\n");
+        return CFE_SB_BUF_ALOC_ERR;
     }
-    printf("test msg rcv\n");
-    return CFE_SUCCESS;
-}
 
-int32 HYUN_APP_SEND_CHAR20_TO_RCVTEST(void)
-{
-    strncpy(HYUN_APP_Data.Char20msgPacket.Payload.TextData, "Hello World!\n", sizeof(HYUN_APP_Data.Char20msgPacket.Payload.TextData));
+    strncpy(Char20msgPacket->Payload.TextData, "Hello World!\n", sizeof(Char20msgPacket->Payload.TextData));
     // 보낼 메세지의 CmdCounter, Error Counter 설정
     
-    CFE_SB_TimeStampMsg(&HYUN_APP_Data.Char20msgPacket.TlmHeader.Msg); // Message에 현재 시간 넣기
-    HYUN_APP_Data.Char20msgPacket.Payload.CommandErrorCounter = HYUN_APP_Data.ErrCounter;
-    HYUN_APP_Data.Char20msgPacket.Payload.CommandCounter      = HYUN_APP_Data.CmdCounter;
+    CFE_SB_TimeStampMsg(&Char20msgPacket->TlmHeader.Msg); // Message에 현재 시간 넣기
+    HYUN_APP_CountersSum(&HYUN_APP_Data.Counters, &CmdCounter, &ErrCounter);
+    Char20msgPacket->Payload.CommandErrorCounter = (uint8)ErrCounter;
+    Char20msgPacket->Payload.CommandCounter      = (uint8)CmdCounter;
 
-    CFE_SB_TransmitMsg(&HYUN_APP_Data.Char20msgPacket.TlmHeader.Msg, true);
-    return CFE_SUCCESS;
+    // 다운링크는 데이터 태스크가 맡는다, 버퍼도 거기서 풀에 돌려준다
+    return HYUN_APP_DataPostTlm(&HYUN_APP_Data.Pool[HYUN_APP_POOL_CHAR20], &Char20msgPacket->TlmHeader.Msg);
 }
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  */
 /*                                                                            */
@@ -348,51 +368,68 @@ int32 HYUN_APP_SEND_CHAR20_TO_RCVTEST(void)
 int32 HYUN_APP_Init(void)
 {
 
-    int32 status;
+    int32  status;
+    uint64 StartUs;
+    uint64 MarkUs;
+
+    StartUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+    MarkUs  = StartUs;
 
     HYUN_APP_Data.RunStatus = CFE_ES_RunStatus_APP_RUN;
 
     /*
     ** Initialize app command execution counters
     */
-    HYUN_APP_Data.CmdCounter = 0;
-    HYUN_APP_Data.ErrCounter = 0;
+    HYUN_APP_CountersInit(&HYUN_APP_Data.Counters);
+
+    /*
+    ** Telemetry flows until the ground sends CX OFF
+    */
+    HYUN_APP_Data.TelemetryEnabled   = true;
+    HYUN_APP_Data.SimMode            = HYUN_APP_SIM_DISABLED;
+    HYUN_APP_Data.MissionTimeFromGps = false;
+    HYUN_APP_Data.MissionTimeOffset  = 0;
+    memset(&HYUN_APP_Data.Replay, 0, sizeof(HYUN_APP_Data.Replay));
+    HYUN_APP_TtagInit();
+    memset(&HYUN_APP_Data.Seq, 0, sizeof(HYUN_APP_Data.Seq));
+    HYUN_APP_FileInit();
 
     /*
     ** Initialize app configuration data
     */
-    HYUN_APP_Data.PipeDepth = HYUN_APP_PIPE_DEPTH;
+    memset(&HYUN_APP_Data.Sub, 0, sizeof(HYUN_APP_Data.Sub));
 
-    strncpy(HYUN_APP_Data.PipeName, "HYUN_APP_CMD_PIPE", sizeof(HYUN_APP_Data.PipeName));
-    HYUN_APP_Data.PipeName[sizeof(HYUN_APP_Data.PipeName) - 1] = 0;
+    strncpy(HYUN_APP_Data.Cold.PipeName, "HYUN_APP_CMD_PIPE", sizeof(HYUN_APP_Data.Cold.PipeName));
+    HYUN_APP_Data.Cold.PipeName[sizeof(HYUN_APP_Data.Cold.PipeName) - 1] = 0;
 
     /*
     ** Initialize event filter table...
     */
-    HYUN_APP_Data.EventFilters[0].EventID = HYUN_APP_STARTUP_INF_EID;
-    HYUN_APP_Data.EventFilters[0].Mask    = 0x0000;
-    HYUN_APP_Data.EventFilters[1].EventID = HYUN_APP_COMMAND_ERR_EID;
-    HYUN_APP_Data.EventFilters[1].Mask    = 0x0000;
-    HYUN_APP_Data.EventFilters[2].EventID = HYUN_APP_COMMANDNOP_INF_EID;
-    HYUN_APP_Data.EventFilters[2].Mask    = 0x0000;
-    HYUN_APP_Data.EventFilters[3].EventID = HYUN_APP_COMMANDRST_INF_EID;
-    HYUN_APP_Data.EventFilters[3].Mask    = 0x0000;
-    HYUN_APP_Data.EventFilters[4].EventID = HYUN_APP_INVALID_MSGID_ERR_EID;
-    HYUN_APP_Data.EventFilters[4].Mask    = 0x0000;
-    HYUN_APP_Data.EventFilters[5].EventID = HYUN_APP_LEN_ERR_EID;
-    HYUN_APP_Data.EventFilters[5].Mask    = 0x0000;
-    HYUN_APP_Data.EventFilters[6].EventID = HYUN_APP_PIPE_ERR_EID;
-    HYUN_APP_Data.EventFilters[6].Mask    = 0x0000;
+    HYUN_APP_Data.Cold.EventFilters[0].EventID = HYUN_APP_STARTUP_INF_EID;
+    HYUN_APP_Data.Cold.EventFilters[0].Mask    = 0x0000;
+    HYUN_APP_Data.Cold.EventFilters[1].EventID = HYUN_APP_COMMAND_ERR_EID;
+    HYUN_APP_Data.Cold.EventFilters[1].Mask    = 0x0000;
+    HYUN_APP_Data.Cold.EventFilters[2].EventID = HYUN_APP_COMMANDNOP_INF_EID;
+    HYUN_APP_Data.Cold.EventFilters[2].Mask    = 0x0000;
+    HYUN_APP_Data.Cold.EventFilters[3].EventID = HYUN_APP_COMMANDRST_INF_EID;
+    HYUN_APP_Data.Cold.EventFilters[3].Mask    = 0x0000;
+    HYUN_APP_Data.Cold.EventFilters[4].EventID = HYUN_APP_INVALID_MSGID_ERR_EID;
+    HYUN_APP_Data.Cold.EventFilters[4].Mask    = 0x0000;
+    HYUN_APP_Data.Cold.EventFilters[5].EventID = HYUN_APP_LEN_ERR_EID;
+    HYUN_APP_Data.Cold.EventFilters[5].Mask    = 0x0000;
+    HYUN_APP_Data.Cold.EventFilters[6].EventID = HYUN_APP_PIPE_ERR_EID;
+    HYUN_APP_Data.Cold.EventFilters[6].Mask    = 0x0000;
 
     /*
     ** Register the events
     */
-    status = CFE_EVS_Register(HYUN_APP_Data.EventFilters, HYUN_APP_EVENT_COUNTS, CFE_EVS_EventFilter_BINARY);
+    status = CFE_EVS_Register(HYUN_APP_Data.Cold.EventFilters, HYUN_APP_EVENT_COUNTS, CFE_EVS_EventFilter_BINARY);
     if (status != CFE_SUCCESS)
     {
         CFE_ES_WriteToSysLog("Hyun_app: Error Registering Events, RC = 0x%08lX\n", (unsigned long)status);
         return (status);
     }
+    MarkUs = HYUN_APP_InitPhaseDone(HYUN_APP_INIT_EVS, MarkUs);
 
     /*
     ** Initialize Packets
@@ -410,46 +447,69 @@ int32 HYUN_APP_Init(void)
     
 
     /*
-    ** Initialize housekeeping packet (clear user data area).
+    ** Initialize the housekeeping, rcvtest and time-tag list packet
+    ** pools, every buffer gets its header here once
     */
-    CFE_MSG_Init(&HYUN_APP_Data.HkTlm.TlmHeader.Msg, HYUN_APP_MID_HOUSEKEEPING_RES, sizeof(HYUN_APP_Data.HkTlm));
+    status = HYUN_APP_PoolInit(&HYUN_APP_Data.Pool[HYUN_APP_POOL_HK], HYUN_APP_MID_HOUSEKEEPING_RES,
+                               sizeof(HYUN_APP_HkTlm_t));
+    if (status == CFE_SUCCESS)
+    {
+        status = HYUN_APP_PoolInit(&HYUN_APP_Data.Pool[HYUN_APP_POOL_CHAR20], HYUN_APP_MID_SENDTORCVTEST_RES,
+                                   sizeof(SPACEY_LIB_MSG_CHAR20_t));
+    }
+    if (status == CFE_SUCCESS)
+    {
+        status = HYUN_APP_PoolInit(&HYUN_APP_Data.Pool[HYUN_APP_POOL_TTAG], HYUN_APP_MID_TTAG_LIST_TLM,
+                                   sizeof(HYUN_APP_TtagListTlm_t));
+    }
+    if (status != CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("Hyun_app: Error Initializing Message Pool, RC = 0x%08lX\n", (unsigned long)status);
+        return (status);
+    }
 
     /*
-    ** Initialize " Char20msgPacket " 
+    ** Initialize estimate packet and the estimator itself
     */
-    CFE_MSG_Init(&HYUN_APP_Data.Char20msgPacket.TlmHeader.Msg, HYUN_APP_MID_SENDTORCVTEST_RES, sizeof(HYUN_APP_Data.Char20msgPacket));
+    CFE_MSG_Init(&HYUN_APP_Data.EstimateTlm.TlmHeader.Msg, HYUN_APP_MID_ESTIMATE_TLM, sizeof(HYUN_APP_Data.EstimateTlm));
+    HYUN_APP_KF_Init(&HYUN_APP_Data.Kf, HYUN_APP_KF_DEFAULT_STATES);
+    HYUN_APP_FlightInit(&HYUN_APP_Data.Flight);
+
+    CFE_MSG_Init(&HYUN_APP_Data.AlignedTlm.TlmHeader.Msg, HYUN_APP_MID_ALIGNED_TLM, sizeof(HYUN_APP_Data.AlignedTlm));
+    HYUN_APP_AlignInit(&HYUN_APP_Data.Align);
+    HYUN_APP_DownlinkInit();
 
+    MarkUs = HYUN_APP_InitPhaseDone(HYUN_APP_INIT_MSG, MarkUs);
 
     /*
-    ** Create Software Bus message pipe.
+    ** Create Software Bus message pipe and subscribe to Housekeeping
+    ** requests and ground commands, default depth and limits until the
+    ** table is loaded
     */
-    status = CFE_SB_CreatePipe(&HYUN_APP_Data.CommandPipe, HYUN_APP_Data.PipeDepth, HYUN_APP_Data.PipeName);
+    status = HYUN_APP_SubInit(HYUN_APP_SUB_PIPE_CMD);
     if (status != CFE_SUCCESS)
     {
-        CFE_ES_WriteToSysLog("Hyun_app: Error creating pipe, RC = 0x%08lX\n", (unsigned long)status);
         return (status);
     }
+    MarkUs = HYUN_APP_InitPhaseDone(HYUN_APP_INIT_SB, MarkUs);
 
     /*
-    ** Subscribe to Housekeeping request commands
+    ** Create the sensor pipe (HYUN_PIPE_1) and subscribe to sensor data
     */
-    status = CFE_SB_Subscribe(HYUN_APP_MID_HOUSEKEEPING_REQ, HYUN_APP_Data.CommandPipe);
+    status = HYUN_APP_SensorInit();
     if (status != CFE_SUCCESS)
     {
-        CFE_ES_WriteToSysLog("Hyun_app: Error Subscribing to HK request, RC = 0x%08lX\n", (unsigned long)status);
         return (status);
     }
+    MarkUs = HYUN_APP_InitPhaseDone(HYUN_APP_INIT_SENSOR, MarkUs);
 
     /*
-    ** Subscribe to ground command packets
+    ** Recover counters, modes and flight state after a restart. Runs
+    ** after every module whose state it restores has been initialized,
+    ** the sensor init clears the sensor message counter.
     */
-    status = CFE_SB_Subscribe(HYUN_APP_MID_GROUNDCMD_REQ, HYUN_APP_Data.CommandPipe);
-    if (status != CFE_SUCCESS)
-    {
-        CFE_ES_WriteToSysLog("Hyun_app: Error Subscribing to Command, RC = 0x%08lX\n", (unsigned long)status);
-
-        return (status);
-    }
+    HYUN_APP_CdsInit();
+    MarkUs = HYUN_APP_InitPhaseDone(HYUN_APP_INIT_CDS, MarkUs);
 
     /*
     ** Register Table(s)
@@ -462,19 +522,130 @@ int32 HYUN_APP_Init(void)
 
         return (status);
     }
-    else
+
+    status = CFE_TBL_Register(&HYUN_APP_Data.TblHandles[HYUN_APP_SEQ_TBL_INDEX], "HyunAppSeqTable",
+                              sizeof(HYUN_APP_SeqTable_t), CFE_TBL_OPT_DEFAULT, HYUN_APP_SeqTblValidationFunc);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("Hyun_app: Error Registering Sequence Table, RC = 0x%08lX\n", (unsigned long)status);
+
+        return (status);
+    }
+    MarkUs = HYUN_APP_InitPhaseDone(HYUN_APP_INIT_TBL, MarkUs);
+
+    /*
+    ** Start the UDP telemetry and command tasks, idle until the table
+    ** names a port
+    */
+    status = HYUN_APP_UdpTlmInit();
+    if (status != CFE_SUCCESS)
     {
-        status = CFE_TBL_Load(HYUN_APP_Data.TblHandles[0], CFE_TBL_SRC_FILE, HYUN_APP_TABLE_FILE);
+        return (status);
     }
 
+    status = HYUN_APP_UdpCmdInit();
+    if (status != CFE_SUCCESS)
+    {
+        return (status);
+    }
 
-    CFE_EVS_SendEvent(HYUN_APP_STARTUP_INF_EID, CFE_EVS_EventType_INFORMATION, "Hyun_app Initialized.%s",
-                      HYUN_APP_VERSION_STRING);
+    /*
+    ** Start the data task, which takes over HYUN_PIPE_1 from here on
+    */
+    status = HYUN_APP_DataTaskInit();
+    if (status != CFE_SUCCESS)
+    {
+        return (status);
+    }
+    MarkUs = HYUN_APP_InitPhaseDone(HYUN_APP_INIT_TASK, MarkUs);
+
+    HYUN_APP_Data.Cold.InitDoneUs = MarkUs;
+    HYUN_APP_Data.TblLoadPending  = true;
+#if !HYUN_APP_TBL_LOAD_DEFERRED
+    HYUN_APP_TblLoad();
+    MarkUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+#endif
+
+    HYUN_APP_Data.Cold.InitUs = (uint32)(MarkUs - StartUs);
+
+    CFE_EVS_SendEvent(HYUN_APP_STARTUP_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "Hyun_app Initialized.%s in %lu us: evs %lu msg %lu sb %lu sensor %lu cds %lu tbl %lu task %lu",
+                      HYUN_APP_VERSION_STRING, (unsigned long)HYUN_APP_Data.Cold.InitUs,
+                      (unsigned long)HYUN_APP_Data.Cold.InitPhaseUs[HYUN_APP_INIT_EVS],
+                      (unsigned long)HYUN_APP_Data.Cold.InitPhaseUs[HYUN_APP_INIT_MSG],
+                      (unsigned long)HYUN_APP_Data.Cold.InitPhaseUs[HYUN_APP_INIT_SB],
+                      (unsigned long)HYUN_APP_Data.Cold.InitPhaseUs[HYUN_APP_INIT_SENSOR],
+                      (unsigned long)HYUN_APP_Data.Cold.InitPhaseUs[HYUN_APP_INIT_CDS],
+                      (unsigned long)HYUN_APP_Data.Cold.InitPhaseUs[HYUN_APP_INIT_TBL],
+                      (unsigned long)HYUN_APP_Data.Cold.InitPhaseUs[HYUN_APP_INIT_TASK]);
 
     return (CFE_SUCCESS);
 
 } /* End of HYUN_APP_Init() */
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_InitPhaseDone -- Record the duration of an init phase  */
+/* and return the start of the next one                            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint64 HYUN_APP_InitPhaseDone(uint32 Phase, uint64 StartUs)
+{
+    uint64 NowUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+
+    HYUN_APP_Data.Cold.InitPhaseUs[Phase] = (uint32)(NowUs - StartUs);
+
+    return NowUs;
+
+} /* End of HYUN_APP_InitPhaseDone() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_TblLoad                                                   */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Load the table file. Runs from the main loop when deferred; a      */
+/*         failed load is reported and leaves the built-in defaults active    */
+/*         until the ground loads a table through TBL services.               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HYUN_APP_TblLoad(void)
+{
+    int32  status;
+    int32  SeqStatus;
+    uint64 StartUs;
+
+    HYUN_APP_Data.TblLoadPending = false;
+
+    StartUs   = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+    status    = CFE_TBL_Load(HYUN_APP_Data.TblHandles[0], CFE_TBL_SRC_FILE, HYUN_APP_TABLE_FILE);
+    SeqStatus = CFE_TBL_Load(HYUN_APP_Data.TblHandles[HYUN_APP_SEQ_TBL_INDEX], CFE_TBL_SRC_FILE,
+                             HYUN_APP_SEQ_TABLE_FILE);
+    HYUN_APP_InitPhaseDone(HYUN_APP_INIT_LOAD, StartUs);
+
+    /*
+    ** Without sequences SEQ_START is refused, everything else runs as usual
+    */
+    if (SeqStatus != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(HYUN_APP_TBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "Hyun_app: Error Loading %s, RC = 0x%08lX", HYUN_APP_SEQ_TABLE_FILE,
+                          (unsigned long)SeqStatus);
+    }
+
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(HYUN_APP_TBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "Hyun_app: Error Loading %s, RC = 0x%08lX", HYUN_APP_TABLE_FILE, (unsigned long)status);
+        return;
+    }
+
+    CFE_EVS_SendEvent(HYUN_APP_STARTUP_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "Table loaded in %lu us, %lu us after init",
+                      (unsigned long)HYUN_APP_Data.Cold.InitPhaseUs[HYUN_APP_INIT_LOAD],
+                      (unsigned long)(StartUs - HYUN_APP_Data.Cold.InitDoneUs));
+
+} /* End of HYUN_APP_TblLoad() */
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*  Name:  HYUN_APP_ProcessCommandPacket                                    */
 /*                                                                            */
@@ -510,53 +681,60 @@ void HYUN_APP_ProcessCommandPacket(CFE_SB_Buffer_t *SBBufPtr)
 
 } /* End HYUN_APP_ProcessCommandPacket */
 
+/*
+** Expected length of each ground command, indexed by CC
+*/
+#define HYUN_APP_CMD_LENGTH(Name, CC, Type, Handler) [CC] = sizeof(Type),
+
+const size_t HYUN_APP_CmdLength[HYUN_APP_CMD_COUNT] = {HYUN_APP_CMD_DEFS(HYUN_APP_CMD_LENGTH)};
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*                                                                            */
 /* HYUN_APP_ProcessGroundCommand() -- SAMPLE ground commands                */
 /*                                                                            */
+/* Returns the status of the command handler, for command sequences           */
+/*                                                                            */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
-void HYUN_APP_ProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr)
+int32 HYUN_APP_ProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr)
 {
     //printf("hyun app process ground command\n");
     CFE_MSG_FcnCode_t CommandCode = 0;
+    int32             status      = CFE_STATUS_BAD_COMMAND_CODE;
 
     CFE_MSG_GetFcnCode(&SBBufPtr->Msg, &CommandCode);
 
+    if (CommandCode >= HYUN_APP_CMD_COUNT)
+    {
+        CFE_EVS_SendEvent(HYUN_APP_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "Invalid ground command code: CC = %d", CommandCode);
+        return status;
+    }
+
+    if (!HYUN_APP_VerifyCmdLength(&SBBufPtr->Msg, HYUN_APP_CmdLength[CommandCode]))
+    {
+        return CFE_STATUS_WRONG_MSG_LENGTH;
+    }
+
     /*
     ** Process "known" Hyun_app ground commands
     */
     switch (CommandCode)
     {
-        case HYUN_APP_NOOP_CC:
-            if (HYUN_APP_VerifyCmdLength(&SBBufPtr->Msg, sizeof(HYUN_APP_NoopCmd_t)))
-            {
-                HYUN_APP_Noop((HYUN_APP_NoopCmd_t *)SBBufPtr);
-            }
+#define HYUN_APP_CMD_DISPATCH(Name, CC, Type, Handler) \
+    case HYUN_APP_##Name##_CC:                         \
+        status = Handler((Type *)SBBufPtr);            \
+        break;
 
-            break;
+        HYUN_APP_CMD_DEFS(HYUN_APP_CMD_DISPATCH)
 
-        case HYUN_APP_RESET_COUNTERS_CC:
-            if (HYUN_APP_VerifyCmdLength(&SBBufPtr->Msg, sizeof(HYUN_APP_ResetCountersCmd_t)))
-            {
-                HYUN_APP_ResetCounters((HYUN_APP_ResetCountersCmd_t *)SBBufPtr);
-            }
-            break;
+#undef HYUN_APP_CMD_DISPATCH
 
-        case HYUN_APP_PROCESS_CC:
-            if (HYUN_APP_VerifyCmdLength(&SBBufPtr->Msg, sizeof(HYUN_APP_ProcessCmd_t)))
-            {
-                HYUN_APP_Process((HYUN_APP_ProcessCmd_t *)SBBufPtr);
-            }
-            break;
-
-        /* default case already found during FC vs length test */
+        /* Every code below HYUN_APP_CMD_COUNT has a case above */
         default:
-            CFE_EVS_SendEvent(HYUN_APP_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
-                              "Invalid ground command code: CC = %d", CommandCode);
             break;
     }
 
-    return;
+    return status;
 
 } /* End of HYUN_APP_ProcessGroundCommand() */
 
@@ -572,19 +750,24 @@ void HYUN_APP_ProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr)
 int32 HYUN_APP_ReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg)
 {
     //printf("hyun app report housekeeping\n");
-    int i;
+    int               i;
+    HYUN_APP_HkTlm_t *HkTlm;
+    HYUN_APP_Table_t *TblPtr;
 
     /*
-    ** Get command execution counters...
+    ** Build and send housekeeping telemetry in a pool buffer, skipped
+    ** (and counted by the pool) while every buffer is still in use...
+    ** The data task owns the downlink, so the buffer is handed over
+    ** rather than sent from here, and the data task releases it.
     */
-    HYUN_APP_Data.HkTlm.Payload.CommandErrorCounter = HYUN_APP_Data.ErrCounter;
-    HYUN_APP_Data.HkTlm.Payload.CommandCounter      = HYUN_APP_Data.CmdCounter;
+    HkTlm = (HYUN_APP_HkTlm_t *)HYUN_APP_PoolTake(&HYUN_APP_Data.Pool[HYUN_APP_POOL_HK]);
+    if (HkTlm != NULL)
+    {
+        HYUN_APP_BuildHousekeeping(HkTlm);
 
-    /*
-    ** Send housekeeping telemetry packet...
-    */
-    CFE_SB_TimeStampMsg(&HYUN_APP_Data.HkTlm.TlmHeader.Msg);
-    CFE_SB_TransmitMsg(&HYUN_APP_Data.HkTlm.TlmHeader.Msg, true);
+        CFE_SB_TimeStampMsg(&HkTlm->TlmHeader.Msg);
+        HYUN_APP_DataPostTlm(&HYUN_APP_Data.Pool[HYUN_APP_POOL_HK], &HkTlm->TlmHeader.Msg);
+    }
 
     /*
     ** Manage any pending table loads, validations, etc.
@@ -594,6 +777,18 @@ int32 HYUN_APP_ReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg)
         CFE_TBL_Manage(HYUN_APP_Data.TblHandles[i]);
     }
 
+    /*
+    ** Follow the UDP telemetry and command settings and the subscriptions
+    ** of the active table
+    */
+    if (CFE_TBL_GetAddress((void *)&TblPtr, HYUN_APP_Data.TblHandles[0]) >= CFE_SUCCESS)
+    {
+        HYUN_APP_UdpTlmConfig(TblPtr);
+        HYUN_APP_UdpCmdConfig(TblPtr);
+        HYUN_APP_SubConfig(TblPtr);
+        CFE_TBL_ReleaseAddress(HYUN_APP_Data.TblHandles[0]);
+    }
+
 
 
     /*
@@ -601,12 +796,112 @@ int32 HYUN_APP_ReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg)
     */
     HYUN_APP_SEND_CHAR20_TO_RCVTEST();
 
-    //HYUN_APP_TEST_SB_RCV();
-
     return CFE_SUCCESS;
 
 } /* End of HYUN_APP_ReportHousekeeping() */
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_BuildHousekeeping -- Fill the HK payload               */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_BuildHousekeeping(HYUN_APP_HkTlm_t *HkTlm)
+{
+    uint32                       i;
+    uint32                       CmdCounter;
+    uint32                       ErrCounter;
+    HYUN_APP_DataStatus_t        Status;
+    const HYUN_APP_DataStatus_t *Data = &HYUN_APP_Data.DataTask.StatusCopy;
+
+    /*
+    ** Get command execution counters, summed over the task shards...
+    */
+    HYUN_APP_CountersSum(&HYUN_APP_Data.Counters, &CmdCounter, &ErrCounter);
+
+    /*
+    ** ...and the data task's own state from its snapshot. While the data
+    ** task is rewriting it, the previous copy is reported again.
+    */
+    if (HYUN_APP_DataStatusGet(&Status))
+    {
+        HYUN_APP_Data.DataTask.StatusCopy = Status;
+    }
+
+    HkTlm->Payload.CommandErrorCounter   = (uint8)ErrCounter;
+    HkTlm->Payload.CommandCounter        = (uint8)CmdCounter;
+    HkTlm->Payload.TelemetryEnabled      = HYUN_APP_Data.TelemetryEnabled;
+    HkTlm->Payload.SimMode               = HYUN_APP_Data.SimMode;
+    HkTlm->Payload.SensorMsgCounter      = Data->SensorMsgCounter;
+    HkTlm->Payload.SensorDropCounter     = Data->SensorDropCounter;
+    HkTlm->Payload.SensorErrCounter      = Data->SensorErrCounter;
+    HkTlm->Payload.SensorLastBatch       = Data->SensorLastBatch;
+    HkTlm->Payload.GpsSentenceCounter    = Data->GpsSentenceCounter;
+    HkTlm->Payload.GpsChecksumErrCounter = Data->GpsChecksumErrCounter;
+    HkTlm->Payload.GpsFormatErrCounter   = Data->GpsFormatErrCounter;
+    HkTlm->Payload.BaroSpread            = Data->BaroSpread;
+    HkTlm->Payload.Voltage               = Data->Voltage;
+    HkTlm->Payload.DownlinkInBytes       = Data->DownlinkInBytes;
+    HkTlm->Payload.DownlinkOutBytes      = Data->DownlinkOutBytes;
+    HkTlm->Payload.ReplaySampleCounter   = Data->ReplaySampleCounter;
+    HkTlm->Payload.DownlinkSentBytes     = Data->DownlinkSentBytes;
+    HkTlm->Payload.CdsCommitCounter      = Data->CdsCommitCounter;
+    HkTlm->Payload.CdsRestoreUs          = HYUN_APP_Data.Cds.RestoreUs;
+    HkTlm->Payload.InitUs                = HYUN_APP_Data.Cold.InitUs;
+    HkTlm->Payload.TblLoadUs             = HYUN_APP_Data.Cold.InitPhaseUs[HYUN_APP_INIT_LOAD];
+    HkTlm->Payload.UdpTlmDatagramCounter = HYUN_APP_Data.UdpTlm.DatagramCounter;
+    HkTlm->Payload.UdpTlmDropCounter     = HYUN_APP_Data.UdpTlm.DropCounter;
+    HkTlm->Payload.UdpTlmDatagramsPerSec = HYUN_APP_Data.UdpTlm.DatagramsPerSec;
+    HkTlm->Payload.UdpTlmBytesPerSec     = HYUN_APP_Data.UdpTlm.BytesPerSec;
+    HkTlm->Payload.UdpCmdPacketCounter   = HYUN_APP_Data.UdpCmd.PacketCounter;
+    HkTlm->Payload.UdpCmdRejectCounter   = HYUN_APP_Data.UdpCmd.RejectCounter;
+    HkTlm->Payload.UdpCmdDropCounter     = HYUN_APP_Data.UdpCmd.DropCounter;
+    HkTlm->Payload.UdpCmdPacketsPerSec   = HYUN_APP_Data.UdpCmd.PacketsPerSec;
+    HkTlm->Payload.XbeeFrameCounter      = Data->XbeeFrameCounter;
+    HkTlm->Payload.XbeeDropCounter       = Data->XbeeDropCounter;
+    HkTlm->Payload.XbeeFramesPerSec      = Data->XbeeFramesPerSec;
+    HkTlm->Payload.XbeeBytesPerSec       = Data->XbeeBytesPerSec;
+    HkTlm->Payload.XbeeBudgetBytesPerSec = Data->XbeeBudgetBytesPerSec;
+    HkTlm->Payload.XbeeOverBudgetCounter = Data->XbeeOverBudgetCounter;
+    HkTlm->Payload.SubChangeCounter      = 0;
+    HkTlm->Payload.SubErrCounter         = 0;
+    HkTlm->Payload.HandoffDropCounter =
+        HYUN_APP_Data.DataTask.Request.DropCounter + HYUN_APP_Data.DataTask.Tlm.DropCounter;
+    HkTlm->Payload.TtagPending        = (uint16)HYUN_APP_Data.Ttag.Count;
+    HkTlm->Payload.TtagExecCounter    = HYUN_APP_Data.Ttag.ExecCounter;
+    HkTlm->Payload.TtagLastJitterUs   = HYUN_APP_Data.Ttag.LastJitterUs;
+    HkTlm->Payload.TtagMaxJitterUs    = HYUN_APP_Data.Ttag.MaxJitterUs;
+    HkTlm->Payload.SeqRunCounter      = HYUN_APP_Data.Seq.RunCounter;
+    HkTlm->Payload.SeqAbortCounter    = HYUN_APP_Data.Seq.AbortCounter;
+    HkTlm->Payload.SeqLastRunUs       = HYUN_APP_Data.Seq.LastRunUs;
+    HkTlm->Payload.RecordCounter      = Data->RecordCounter;
+    HkTlm->Payload.RecordDropCounter  = Data->RecordDropCounter;
+    HkTlm->Payload.RecordBytes        = Data->RecordBytes;
+    HkTlm->Payload.FileTransferId     = Data->FileTransferId;
+    HkTlm->Payload.FileAckedBytes     = Data->FileAckedBytes;
+    HkTlm->Payload.FileResendCounter  = Data->FileResendCounter;
+    HkTlm->Payload.FileTimeoutCounter = Data->FileTimeoutCounter;
+
+    for (i = 0; i < HYUN_APP_DOWNLINK_CLASSES; i++)
+    {
+        HkTlm->Payload.DownlinkQueueDepth[i]     = Data->DownlinkQueueDepth[i];
+        HkTlm->Payload.DownlinkQueueHighWater[i] = Data->DownlinkQueueHighWater[i];
+        HkTlm->Payload.DownlinkDropCounter[i]    = Data->DownlinkDropCounter[i];
+    }
+
+    for (i = 0; i < HYUN_APP_SUB_PIPES; i++)
+    {
+        HkTlm->Payload.SubChangeCounter += HYUN_APP_Data.Sub.ChangeCounter[i];
+        HkTlm->Payload.SubErrCounter += HYUN_APP_Data.Sub.ErrCounter[i];
+    }
+
+    for (i = 0; i < HYUN_APP_POOLS; i++)
+    {
+        HkTlm->Payload.PoolHighWater[i]        = (uint16)HYUN_APP_Data.Pool[i].HighWater;
+        HkTlm->Payload.PoolExhaustedCounter[i] = (uint16)HYUN_APP_Data.Pool[i].ExhaustedCounter;
+    }
+
+} /* End of HYUN_APP_BuildHousekeeping() */
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*                                                                            */
 /* HYUN_APP_Noop -- SAMPLE NOOP commands                                        */
@@ -615,7 +910,7 @@ int32 HYUN_APP_ReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg)
 int32 HYUN_APP_Noop(const HYUN_APP_NoopCmd_t *Msg)
 {
     //printf("hyun app noop\n");
-    HYUN_APP_Data.CmdCounter++;
+    HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].CmdCounter++;
 
     //CFE_EVS_SendEvent(HYUN_APP_COMMANDNOP_INF_EID, CFE_EVS_EventType_INFORMATION, "SAMPLE: NOOP command %s",HYUN_APP_VERSION);
 
@@ -634,8 +929,7 @@ int32 HYUN_APP_Noop(const HYUN_APP_NoopCmd_t *Msg)
 int32 HYUN_APP_ResetCounters(const HYUN_APP_ResetCountersCmd_t *Msg)
 {
 
-    HYUN_APP_Data.CmdCounter = 0;
-    HYUN_APP_Data.ErrCounter = 0;
+    HYUN_APP_CountersReset(&HYUN_APP_Data.Counters);
 
     CFE_EVS_SendEvent(HYUN_APP_COMMANDRST_INF_EID, CFE_EVS_EventType_INFORMATION, "SAMPLE: RESET command");
 
@@ -684,6 +978,198 @@ int32 HYUN_APP_Process(const HYUN_APP_ProcessCmd_t *Msg)
 
 } /* End of HYUN_APP_ProcessCC */
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_TextCommand                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Parse and execute one CANSAT text command. Accepted and rejected   */
+/*         commands count in CmdCounter / ErrCounter like the binary ones.    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 HYUN_APP_TextCommand(const HYUN_APP_TextCmd_t *Msg)
+{
+    HYUN_APP_UplinkCmd_t  Cmd;
+    HYUN_APP_DataReq_t    Req;
+    HYUN_APP_DataStatus_t Status;
+    HYUN_APP_Table_t     *TblPtr = NULL;
+    const char           *Reject = NULL;
+    int32                 status;
+
+    memset(&Req, 0, sizeof(Req));
+
+    CFE_ES_PerfLogEntry(HYUN_APP_UPLINK_PERF_ID);
+    status = HYUN_APP_UplinkParse(Msg->Payload.Text, sizeof(Msg->Payload.Text), &Cmd);
+    CFE_ES_PerfLogExit(HYUN_APP_UPLINK_PERF_ID);
+
+    /*
+    ** Commands for another team are rejected once the table is loaded
+    */
+    if (status == HYUN_APP_UPLINK_SUCCESS &&
+        CFE_TBL_GetAddress((void *)&TblPtr, HYUN_APP_Data.TblHandles[0]) >= CFE_SUCCESS)
+    {
+        if (Cmd.TeamId != TblPtr->TeamId)
+        {
+            status = HYUN_APP_UPLINK_ERR_TEAM;
+        }
+        CFE_TBL_ReleaseAddress(HYUN_APP_Data.TblHandles[0]);
+    }
+
+    if (status != HYUN_APP_UPLINK_SUCCESS)
+    {
+        HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter++;
+        CFE_EVS_SendEvent(HYUN_APP_UPLINK_ERR_EID, CFE_EVS_EventType_ERROR, "Uplink: %s error in '%.*s'",
+                          HYUN_APP_UplinkErrorName(status), (int)sizeof(Msg->Payload.Text), Msg->Payload.Text);
+        return status;
+    }
+
+    switch (Cmd.Mnemonic)
+    {
+        case HYUN_APP_UPLINK_KW_CX:
+            HYUN_APP_Data.TelemetryEnabled = (Cmd.Arg == HYUN_APP_UPLINK_KW_ON);
+            break;
+
+        case HYUN_APP_UPLINK_KW_ST:
+            HYUN_APP_Data.MissionTimeFromGps = (Cmd.Arg == HYUN_APP_UPLINK_KW_GPS);
+            if (!HYUN_APP_Data.MissionTimeFromGps)
+            {
+                HYUN_APP_Data.MissionTimeOffset = (int32)Cmd.Value - (int32)(CFE_TIME_GetUTC().Seconds % 86400);
+            }
+            break;
+
+        case HYUN_APP_UPLINK_KW_SIM:
+            if (Cmd.Arg == HYUN_APP_UPLINK_KW_ENABLE)
+            {
+                if (HYUN_APP_Data.SimMode == HYUN_APP_SIM_DISABLED)
+                {
+                    HYUN_APP_Data.SimMode = HYUN_APP_SIM_ENABLED;
+                }
+            }
+            else if (Cmd.Arg == HYUN_APP_UPLINK_KW_ACTIVATE)
+            {
+                if (HYUN_APP_Data.SimMode == HYUN_APP_SIM_DISABLED)
+                {
+                    Reject = "SIM ACTIVATE before SIM ENABLE";
+                }
+                else
+                {
+                    HYUN_APP_Data.SimMode = HYUN_APP_SIM_ACTIVE;
+                }
+            }
+            else
+            {
+                HYUN_APP_Data.SimMode = HYUN_APP_SIM_DISABLED;
+            }
+            break;
+
+        case HYUN_APP_UPLINK_KW_SIMP:
+            if (HYUN_APP_Data.SimMode != HYUN_APP_SIM_ACTIVE)
+            {
+                Reject = "SIMP outside simulation mode";
+            }
+            else
+            {
+                Req.Code     = HYUN_APP_DATA_REQ_SIMP;
+                Req.Pressure = (float)Cmd.Value;
+                Req.TimeUs   = HYUN_APP_SysTimeToUsec(CFE_TIME_GetTime());
+            }
+            break;
+
+        case HYUN_APP_UPLINK_KW_CAL:
+            /* Early reject from the data task snapshot; the data task checks again */
+            if (HYUN_APP_DataStatusGet(&Status) && Status.FlightState != HYUN_APP_FLIGHT_LAUNCH_WAIT)
+            {
+                Reject = "CAL after launch";
+            }
+            else
+            {
+                Req.Code = HYUN_APP_DATA_REQ_CAL;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    /*
+    ** SIMP and CAL change data task state, so the data task runs them
+    */
+    if (Reject == NULL && Req.Code != 0 && !HYUN_APP_DataRequest(&Req))
+    {
+        Reject = "data task busy";
+    }
+
+    if (Reject != NULL)
+    {
+        HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter++;
+        CFE_EVS_SendEvent(HYUN_APP_UPLINK_ERR_EID, CFE_EVS_EventType_ERROR, "Uplink: %s", Reject);
+        return HYUN_APP_UPLINK_ERR_ARG;
+    }
+
+    /* Requests count where they run */
+    if (Req.Code == 0)
+    {
+        HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].CmdCounter++;
+    }
+    CFE_EVS_SendEvent(HYUN_APP_UPLINK_INF_EID, CFE_EVS_EventType_INFORMATION, "Uplink: '%.*s' accepted",
+                      (int)sizeof(Msg->Payload.Text), Msg->Payload.Text);
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_TextCommand() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_ReplayStartCmd                                            */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Start replaying a pressure profile (SIM mode must be active). The  */
+/*         data task opens the file and counts the outcome.                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 HYUN_APP_ReplayStartCmd(const HYUN_APP_ReplayStartCmd_t *Msg)
+{
+    HYUN_APP_DataReq_t Req;
+
+    memset(&Req, 0, sizeof(Req));
+    Req.Code     = HYUN_APP_DATA_REQ_REPLAY_START;
+    Req.Speed    = Msg->Payload.Speed;
+    Req.PeriodMs = Msg->Payload.PeriodMs;
+    strncpy(Req.Filename, Msg->Payload.Filename, sizeof(Req.Filename));
+    Req.Filename[sizeof(Req.Filename) - 1] = '\0';
+
+    if (!HYUN_APP_DataRequest(&Req))
+    {
+        HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter++;
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_ReplayStartCmd() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_ReplayStopCmd -- Abort a running replay                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 HYUN_APP_ReplayStopCmd(const HYUN_APP_ReplayStopCmd_t *Msg)
+{
+    HYUN_APP_DataReq_t Req;
+
+    (void)Msg;
+
+    memset(&Req, 0, sizeof(Req));
+    Req.Code = HYUN_APP_DATA_REQ_REPLAY_STOP;
+
+    if (!HYUN_APP_DataRequest(&Req))
+    {
+        HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter++;
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_ReplayStopCmd() */
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*                                                                            */
 /* HYUN_APP_VerifyCmdLength() -- Verify command packet length                   */
@@ -713,7 +1199,7 @@ bool HYUN_APP_VerifyCmdLength(CFE_MSG_Message_t *MsgPtr, size_t ExpectedLength)
 
         result = false;
 
-        HYUN_APP_Data.ErrCounter++;
+        HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter++;
     }
 
     return (result);
@@ -730,6 +1216,7 @@ int32 HYUN_APP_TblValidationFunc(void *TblData)
 {
     int32               ReturnCode = CFE_SUCCESS;
     HYUN_APP_Table_t *TblDataPtr = (HYUN_APP_Table_t *)TblData;
+    uint32              i;
 
     /*
     ** Sample Table Validation
@@ -740,6 +1227,65 @@ int32 HYUN_APP_TblValidationFunc(void *TblData)
         ReturnCode = HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
     }
 
+    /*
+    ** Flight thresholds must describe a descent that can actually complete
+    */
+    if (TblDataPtr->HysteresisCount == 0 || TblDataPtr->HysteresisCount > HYUN_APP_TBL_HYSTERESIS_MAX ||
+        TblDataPtr->DescentVelocity < 0.0f || TblDataPtr->LandedVelocity <= 0.0f ||
+        TblDataPtr->LandedAltitude >= TblDataPtr->ReleaseAltitude ||
+        TblDataPtr->ApogeeVelocity >= TblDataPtr->LaunchVelocity)
+    {
+        ReturnCode = HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+    }
+
+    if (TblDataPtr->FilterWindow == 0 || TblDataPtr->FilterWindow > HYUN_APP_FILTER_MAX_WINDOW)
+    {
+        ReturnCode = HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+    }
+
+    if (TblDataPtr->TeamId > HYUN_APP_TBL_TEAM_ID_MAX)
+    {
+        ReturnCode = HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+    }
+
+    if (TblDataPtr->AlignPeriodMs < HYUN_APP_ALIGN_MIN_PERIOD_MS || TblDataPtr->AlignPeriodMs > HYUN_APP_ALIGN_MAX_PERIOD_MS ||
+        TblDataPtr->AlignMaxLatencyMs > HYUN_APP_ALIGN_MAX_LATENCY_LIMIT_MS)
+    {
+        ReturnCode = HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+    }
+
+    for (i = 0; i < HYUN_APP_DOWNLINK_MAX_STREAMS; i++)
+    {
+        if (TblDataPtr->DownlinkCodec[i].Codec > HYUN_APP_CODEC_LZ)
+        {
+            ReturnCode = HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+        }
+    }
+
+    /*
+    ** A paced link must be able to pass the largest queued packet
+    */
+    if (TblDataPtr->LinkBytesPerSec != 0 && TblDataPtr->LinkBurstBytes < HYUN_APP_DOWNLINK_SLOT_SIZE)
+    {
+        ReturnCode = HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+    }
+
+    if (TblDataPtr->UdpTlmPort != 0 && !HYUN_APP_UdpTlmValidHost(TblDataPtr->UdpTlmHost))
+    {
+        ReturnCode = HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+    }
+
+    if (memchr(TblDataPtr->XbeeDevice, '\0', sizeof(TblDataPtr->XbeeDevice)) == NULL ||
+        (TblDataPtr->XbeeDevice[0] != 0 && !HYUN_APP_XbeeValidBaud(TblDataPtr->XbeeBaud)))
+    {
+        ReturnCode = HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+    }
+
+    if (!HYUN_APP_SubValid(TblDataPtr->SubPipe))
+    {
+        ReturnCode = HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+    }
+
     return ReturnCode;
 
 } /* End of HYUN_APP_TBLValidationFunc() */
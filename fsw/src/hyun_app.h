@@ -41,19 +41,77 @@
 #include "hyun_app_perfids.h"
 #include "hyun_app_msgids.h"
 #include "hyun_app_msg.h"
+#include "hyun_app_sensor.h"
+#include "hyun_app_kf.h"
+#include "hyun_app_flight.h"
+#include "hyun_app_align.h"
+#include "hyun_app_replay.h"
+#include "hyun_app_downlink.h"
+#include "hyun_app_cds.h"
+#include "hyun_app_counters.h"
+#include "hyun_app_pool.h"
+#include "hyun_app_udptlm.h"
+#include "hyun_app_udpcmd.h"
+#include "hyun_app_sub.h"
+#include "hyun_app_datatask.h"
+#include "hyun_app_ttag.h"
+#include "hyun_app_seq.h"
+#include "hyun_app_record.h"
+#include "hyun_app_file.h"
 #include "libs/spacey.h"
 
 /***********************************************************************/
+/*
+** Command pipe defaults, used until the table sets SubPipe[HYUN_APP_SUB_PIPE_CMD]
+*/
 #define HYUN_APP_PIPE_DEPTH 32 /* Depth of the Command Pipe for Application */
 
-#define HYUN_APP_NUMBER_OF_TABLES 1 /* Number of Table(s) */
+#define HYUN_APP_HK_REQ_MSG_LIMIT    4  /* SB default limit */
+#define HYUN_APP_GROUNDCMD_MSG_LIMIT 16 /* Ground commands queued at once, room for UDP command bursts */
+
+#define HYUN_APP_CYCLE_TIMEOUT_MS 50 /* Main task pipe wait, data task cycle period */
+
+#define HYUN_APP_NUMBER_OF_TABLES 2 /* Number of Table(s) */
+#define HYUN_APP_SEQ_TBL_INDEX    1 /* TblHandles[] entry of the command sequence table */
 
 /* Define filenames of default data images for tables */
-#define HYUN_APP_TABLE_FILE "/cf/hyun_app_tbl.tbl"
+#define HYUN_APP_TABLE_FILE     "/cf/hyun_app_tbl.tbl"
+#define HYUN_APP_SEQ_TABLE_FILE "/cf/hyun_app_seq.tbl"
+
+/*
+** Load HYUN_APP_TABLE_FILE from the first main loop cycle instead of
+** HYUN_APP_Init, so commands and HK are served before the file is read.
+** Until then the modules run on their built-in defaults.
+*/
+#define HYUN_APP_TBL_LOAD_DEFERRED 1
+
+/*
+** Init phases timed for the startup event
+*/
+#define HYUN_APP_INIT_EVS    0 /* Event registration */
+#define HYUN_APP_INIT_MSG    1 /* Packet and module state */
+#define HYUN_APP_INIT_CDS    2 /* Critical Data Store restore */
+#define HYUN_APP_INIT_SB     3 /* Command pipe and subscriptions */
+#define HYUN_APP_INIT_SENSOR 4 /* Sensor pipe and subscriptions */
+#define HYUN_APP_INIT_TBL    5 /* Table registration */
+#define HYUN_APP_INIT_TASK   6 /* Child tasks */
+#define HYUN_APP_INIT_LOAD   7 /* Table file load, deferred or not */
+#define HYUN_APP_INIT_PHASES 8
 
 #define HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE -1
+#define HYUN_APP_SENSOR_INVALID_ERR_CODE     -2
 
 #define HYUN_APP_TBL_ELEMENT_1_MAX 10
+
+#define HYUN_APP_TBL_HYSTERESIS_MAX 50
+#define HYUN_APP_TBL_TEAM_ID_MAX    9999
+
+/*
+** Simulation mode, driven by the SIM text command
+*/
+#define HYUN_APP_SIM_DISABLED 0
+#define HYUN_APP_SIM_ENABLED  1 /* Armed, waiting for SIM ACTIVATE */
+#define HYUN_APP_SIM_ACTIVE   2 /* Baro sensor ignored, pressure comes from SIMP */
 /************************************************************************
 ** Type Definitions
 *************************************************************************/
@@ -70,18 +128,89 @@
 SB 설명을 위한 패킷. 실제 Mission에서 쓰이지 않음.
 */
 
+/*
+** Written at init only. Kept on its own cache lines behind the hot state
+** so init-time data never shares a line with per-message counters.
+*/
 typedef struct
 {
+    char PipeName[CFE_MISSION_MAX_API_LEN];
+
+    CFE_EVS_BinFilter_t EventFilters[HYUN_APP_EVENT_COUNTS];
+
+    /*
+    ** Startup timing
+    */
+    uint32 InitPhaseUs[HYUN_APP_INIT_PHASES];
+    uint32 InitUs;     /* Entry of HYUN_APP_Init to ready for commands */
+    uint64 InitDoneUs; /* MET when HYUN_APP_Init returned */
+} HYUN_APP_CACHE_ALIGNED HYUN_APP_ColdData_t;
+
+typedef struct
+{
+    /*
+    ** Command interface counters, one cache line per task...
+    */
+    HYUN_APP_Counters_t Counters;
+
+    /*
+    ** Run Status variable used in the main processing loop
+    */
+    uint32 RunStatus;
+
+    /*
+    ** Pipes and tables, read on every cycle
+    */
+    CFE_SB_PipeId_t CommandPipe;
+    /*
+    Software Bus Pipe를 정의한다.
+    */
+    CFE_SB_PipeId_t  HYUN_PIPE_1; /* Variable to hold Pipe ID (i.e.- Handle) */
+    CFE_TBL_Handle_t TblHandles[HYUN_APP_NUMBER_OF_TABLES];
+    bool             TblLoadPending;
+
+    /*
+    ** Modes set by the CANSAT text uplink... Written by the main task
+    ** only; the data task reads each as a single word.
+    */
+    bool  TelemetryEnabled;
+    uint8 SimMode;
+    bool  MissionTimeFromGps;
+    int32 MissionTimeOffset; /* Mission time - UTC [s], from ST */
+
     /*
-    ** Command interface counters...
+    ** Housekeeping, rcvtest and time-tag list packet buffers,
+    ** HYUN_APP_POOL_xxx...
     */
-    uint8 CmdCounter;
-    uint8 ErrCounter;
+    HYUN_APP_MsgPool_t Pool[HYUN_APP_POOLS];
 
     /*
-    ** Housekeeping telemetry packet...
+    ** Altitude / velocity estimate, published every cycle...
     */
-    HYUN_APP_HkTlm_t HkTlm;
+    HYUN_APP_EstimateTlm_t EstimateTlm;
+
+    /*
+    ** Sensor frame resampled onto the common tick...
+    */
+    HYUN_APP_AlignedTlm_t AlignedTlm;
+
+    /*
+    ** Compressed downlink wrapper and per-MID codec state...
+    */
+    HYUN_APP_CompressedTlm_t CompressedTlm;
+    HYUN_APP_DownlinkData_t  Downlink;
+
+    HYUN_APP_Replay_t Replay;
+
+    /*
+    ** Packet archive, data task only
+    */
+    HYUN_APP_Record_t Record;
+
+    /*
+    ** Chunked file downlink, data task only
+    */
+    HYUN_APP_File_t File;
 
     /*
     SB Tutorial에 사용되는 telemetry packet...
@@ -89,36 +218,58 @@ typedef struct
     HYUN_APP_TUTORIAL_t TutorialPacket;
 
     /*
-    rcvtest 앱에 String을 보내기 위해 정의한 Packet.
+    ** Sensor ingest state fed from HYUN_PIPE_1, data task only
     */
-    SPACEY_LIB_MSG_CHAR20_t Char20msgPacket;
+    HYUN_APP_SensorData_t Sensor;
+    HYUN_APP_KF_t         Kf;
+    HYUN_APP_FlightData_t Flight;
+    HYUN_APP_Align_t      Align;
+
     /*
-    Software Bus Pipe를 정의한다.
+    ** Warm restart state kept in the Critical Data Store
     */
-    CFE_SB_PipeId_t HYUN_PIPE_1; /* Variable to hold Pipe ID (i.e.- Handle) */
+    HYUN_APP_Cds_t Cds;
 
+    /*
+    ** Local UDP telemetry and command child tasks
+    */
+    HYUN_APP_UdpTlm_t UdpTlm;
+    HYUN_APP_UdpCmd_t UdpCmd;
 
     /*
-    ** Run Status variable used in the main processing loop
+    ** Pipe depths and subscriptions following the table
     */
-    uint32 RunStatus;
+    HYUN_APP_Sub_t Sub;
 
     /*
-    ** Operational data (not reported in housekeeping)...
+    ** Sensor data task and its handoff queues from the main task
     */
-    CFE_SB_PipeId_t CommandPipe;
+    HYUN_APP_DataTask_t DataTask;
 
     /*
-    ** Initialization data (not reported in housekeeping)...
+    ** Ground commands waiting for their execution time, main task only
     */
-    char   PipeName[CFE_MISSION_MAX_API_LEN];
-    uint16 PipeDepth;
+    HYUN_APP_Ttag_t Ttag;
 
-    CFE_EVS_BinFilter_t EventFilters[HYUN_APP_EVENT_COUNTS];
-    CFE_TBL_Handle_t    TblHandles[HYUN_APP_NUMBER_OF_TABLES];
+    /*
+    ** Command sequence run state, main task only
+    */
+    HYUN_APP_Seq_t Seq;
+
+    /*
+    ** Initialization data (not reported in housekeeping)...
+    */
+    HYUN_APP_ColdData_t Cold;
 
 } HYUN_APP_Data_t;
 
+extern HYUN_APP_Data_t HYUN_APP_Data;
+
+/*
+** Full packet length of every ground command, indexed by CC
+*/
+extern const size_t HYUN_APP_CmdLength[HYUN_APP_CMD_COUNT];
+
 /****************************************************************************/
 /*
 ** Local function prototypes.
@@ -132,6 +283,8 @@ typedef struct
 
 void  HYUN_APP_Main(void);
 int32 HYUN_APP_Init(void);
+uint64 HYUN_APP_InitPhaseDone(uint32 Phase, uint64 StartUs);
+void  HYUN_APP_TblLoad(void);
 
 //Software Bus 설명용 함수
 int32 HYUN_APP_SB_TUTORIAL(void);
@@ -140,23 +293,26 @@ App이 Initalization 될 때, app은 cFE에 자신이 쓸 pipe들을 알려줘
 먼저 헤더 파일 (hyun_app.h)에 관련 변수들을 정의하자.
 */
 
-#define HYUN_PIPE_1_DEPTH  (10) //Pipe Depth는 한 Pipe에 얼마나 많은 message가 들어갈 수 있는지 정의한다
+#define HYUN_PIPE_1_DEPTH  (64) //Pipe Depth는 한 Pipe에 얼마나 많은 message가 들어갈 수 있는지 정의한다. 200 Hz IMU + 20 Hz baro 기준으로 잡음
 #define HYUN_APP_TUTORIAL_LIMIT (10) //message limit은 특정 message ID를 가진 message가 한 pipe에 얼마나 들어갈 수 있는지를 정의한다.
 
 
 void  HYUN_APP_ProcessCommandPacket(CFE_SB_Buffer_t *SBBufPtr);
-void  HYUN_APP_ProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr);
+int32 HYUN_APP_ProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr);
 int32 HYUN_APP_ReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg);
+void  HYUN_APP_BuildHousekeeping(HYUN_APP_HkTlm_t *HkTlm);
 int32 HYUN_APP_ResetCounters(const HYUN_APP_ResetCountersCmd_t *Msg);
 int32 HYUN_APP_Process(const HYUN_APP_ProcessCmd_t *Msg);
 int32 HYUN_APP_Noop(const HYUN_APP_NoopCmd_t *Msg);
+int32 HYUN_APP_TextCommand(const HYUN_APP_TextCmd_t *Msg);
+int32 HYUN_APP_ReplayStartCmd(const HYUN_APP_ReplayStartCmd_t *Msg);
+int32 HYUN_APP_ReplayStopCmd(const HYUN_APP_ReplayStopCmd_t *Msg);
 void  HYUN_APP_GetCrc(const char *TableName);
 
 int32 HYUN_APP_TblValidationFunc(void *TblData);
 
 bool HYUN_APP_VerifyCmdLength(CFE_MSG_Message_t *MsgPtr, size_t ExpectedLength);
 
-int32 HYUN_APP_TEST_SB_RCV(void);
 int32 HYUN_APP_TEST_SB_SEND(void);
 int32 HYUN_APP_TEST_SB_INIT(void);
 
@@ -0,0 +1,412 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_align.c
+**
+** Purpose:
+**   Resample the sensor rings onto a common tick with linear
+**   interpolation and a bounded wait for late streams.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "hyun_app_events.h"
+#include "hyun_app.h"
+#include "hyun_app_align.h"
+
+/*
+** Result of a ring lookup around one tick
+*/
+#define HYUN_APP_ALIGN_NONE   0 /* Ring is empty */
+#define HYUN_APP_ALIGN_HOLD   1 /* Only samples older than the tick */
+#define HYUN_APP_ALIGN_INTERP 2 /* Tick is bracketed (or precedes all samples) */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_AlignInit -- Wait for the first fast sample            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_AlignInit(HYUN_APP_Align_t *Align)
+{
+    memset(Align, 0, sizeof(*Align));
+
+    Align->PeriodUs     = HYUN_APP_ALIGN_DEFAULT_PERIOD_MS * 1000u;
+    Align->MaxLatencyUs = HYUN_APP_ALIGN_DEFAULT_MAX_LATENCY_MS * 1000u;
+
+} /* End of HYUN_APP_AlignInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_AlignFind                                                 */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Locate the samples bracketing TickUs in one ring. The search runs  */
+/*         backwards from the newest sample; ticks trail the newest data by   */
+/*         at most the latency bound, so only a few slots are visited.        */
+/*         Lo / Hi are ring indexes, Frac the weight of Hi.                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+static uint8 HYUN_APP_AlignFind(const uint64 *TimeUs, uint32 Head, uint32 Size, uint64 TickUs, uint32 *Lo,
+                                uint32 *Hi, float *Frac)
+{
+    uint32 Avail = (Head < Size) ? Head : Size;
+    uint32 Newer;
+    uint32 Older;
+    uint32 n;
+
+    *Frac = 0.0f;
+
+    if (Avail == 0)
+    {
+        return HYUN_APP_ALIGN_NONE;
+    }
+
+    Newer = HYUN_APP_RING_INDEX(Head - 1, Size);
+    if (TimeUs[Newer] < TickUs)
+    {
+        *Lo = Newer;
+        *Hi = Newer;
+        return HYUN_APP_ALIGN_HOLD;
+    }
+
+    for (n = 2; n <= Avail; n++)
+    {
+        Older = HYUN_APP_RING_INDEX(Head - n, Size);
+        if (TimeUs[Older] <= TickUs)
+        {
+            *Lo = Older;
+            *Hi = Newer;
+            if (TimeUs[Newer] > TimeUs[Older])
+            {
+                *Frac = (float)(TickUs - TimeUs[Older]) / (float)(TimeUs[Newer] - TimeUs[Older]);
+            }
+            return HYUN_APP_ALIGN_INTERP;
+        }
+        Newer = Older;
+    }
+
+    /*
+    ** Tick precedes everything still in the ring, use the oldest sample
+    */
+    *Lo = Newer;
+    *Hi = Newer;
+    return HYUN_APP_ALIGN_INTERP;
+
+} /* End of HYUN_APP_AlignFind() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_AlignLerp -- Linear interpolation                      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static inline float HYUN_APP_AlignLerp(float A, float B, float Frac)
+{
+    return A + (B - A) * Frac;
+
+} /* End of HYUN_APP_AlignLerp() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_AlignSample                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Fill one aligned frame for TickUs from the sensor rings. Returns   */
+/*         the mask of streams that had no sample at or after the tick and    */
+/*         were held at their last value.                                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+uint8 HYUN_APP_AlignSample(const HYUN_APP_SensorData_t *Sensor, uint64 TickUs, HYUN_APP_AlignedTlm_Payload_t *Out)
+{
+    uint32 Lo   = 0;
+    uint32 Hi   = 0;
+    float  Frac = 0.0f;
+    uint8  Found;
+
+    Out->ValidMask = 0;
+    Out->HoldMask  = 0;
+
+    Found = HYUN_APP_AlignFind(Sensor->Baro.TimeUs, Sensor->Baro.Head, HYUN_APP_BARO_RING_SIZE, TickUs, &Lo, &Hi,
+                               &Frac);
+    if (Found != HYUN_APP_ALIGN_NONE)
+    {
+        Out->Pressure    = HYUN_APP_AlignLerp(Sensor->Baro.Pressure[Lo], Sensor->Baro.Pressure[Hi], Frac);
+        Out->Altitude    = HYUN_APP_AlignLerp(Sensor->Baro.AltitudeFilt[Lo], Sensor->Baro.AltitudeFilt[Hi], Frac);
+        Out->Temperature = HYUN_APP_AlignLerp(Sensor->Baro.Temperature[Lo], Sensor->Baro.Temperature[Hi], Frac);
+        Out->ValidMask |= HYUN_APP_ALIGN_BARO;
+        if (Found == HYUN_APP_ALIGN_HOLD)
+        {
+            Out->HoldMask |= HYUN_APP_ALIGN_BARO;
+        }
+    }
+
+    Found =
+        HYUN_APP_AlignFind(Sensor->Imu.TimeUs, Sensor->Imu.Head, HYUN_APP_IMU_RING_SIZE, TickUs, &Lo, &Hi, &Frac);
+    if (Found != HYUN_APP_ALIGN_NONE)
+    {
+        Out->Accel[0] = HYUN_APP_AlignLerp(Sensor->Imu.AccelX[Lo], Sensor->Imu.AccelX[Hi], Frac);
+        Out->Accel[1] = HYUN_APP_AlignLerp(Sensor->Imu.AccelY[Lo], Sensor->Imu.AccelY[Hi], Frac);
+        Out->Accel[2] = HYUN_APP_AlignLerp(Sensor->Imu.AccelZ[Lo], Sensor->Imu.AccelZ[Hi], Frac);
+        Out->Gyro[0]  = HYUN_APP_AlignLerp(Sensor->Imu.GyroX[Lo], Sensor->Imu.GyroX[Hi], Frac);
+        Out->Gyro[1]  = HYUN_APP_AlignLerp(Sensor->Imu.GyroY[Lo], Sensor->Imu.GyroY[Hi], Frac);
+        Out->Gyro[2]  = HYUN_APP_AlignLerp(Sensor->Imu.GyroZ[Lo], Sensor->Imu.GyroZ[Hi], Frac);
+        Out->ValidMask |= HYUN_APP_ALIGN_IMU;
+        if (Found == HYUN_APP_ALIGN_HOLD)
+        {
+            Out->HoldMask |= HYUN_APP_ALIGN_IMU;
+        }
+    }
+
+    /*
+    ** Coordinates are only interpolated between two valid fixes, otherwise
+    ** the newest fix at or before the tick is held.
+    */
+    Found = HYUN_APP_AlignFind(Sensor->Gps.TimeUs, Sensor->Gps.Head, HYUN_APP_GPS_RING_SIZE, TickUs, &Lo, &Hi, &Frac);
+    if (Found != HYUN_APP_ALIGN_NONE)
+    {
+        if (!Sensor->Gps.FixValid[Lo] || !Sensor->Gps.FixValid[Hi])
+        {
+            Frac = 0.0f;
+        }
+        Out->LatitudeE7 = Sensor->Gps.LatitudeE7[Lo] +
+                          (int32)((double)((int64)Sensor->Gps.LatitudeE7[Hi] - Sensor->Gps.LatitudeE7[Lo]) * Frac);
+        Out->LongitudeE7 = Sensor->Gps.LongitudeE7[Lo] +
+                           (int32)((double)((int64)Sensor->Gps.LongitudeE7[Hi] - Sensor->Gps.LongitudeE7[Lo]) * Frac);
+        Out->GpsAltitude   = HYUN_APP_AlignLerp(Sensor->Gps.Altitude[Lo], Sensor->Gps.Altitude[Hi], Frac);
+        Out->GpsSatellites = Sensor->Gps.Satellites[Lo];
+        Out->ValidMask |= HYUN_APP_ALIGN_GPS;
+        if (Found == HYUN_APP_ALIGN_HOLD)
+        {
+            Out->HoldMask |= HYUN_APP_ALIGN_GPS;
+        }
+    }
+
+    Found = HYUN_APP_AlignFind(Sensor->Voltage.TimeUs, Sensor->Voltage.Head, HYUN_APP_VOLTAGE_RING_SIZE, TickUs, &Lo,
+                               &Hi, &Frac);
+    if (Found != HYUN_APP_ALIGN_NONE)
+    {
+        Out->Voltage = HYUN_APP_AlignLerp(Sensor->Voltage.Voltage[Lo], Sensor->Voltage.Voltage[Hi], Frac);
+        Out->ValidMask |= HYUN_APP_ALIGN_VOLTAGE;
+        if (Found == HYUN_APP_ALIGN_HOLD)
+        {
+            Out->HoldMask |= HYUN_APP_ALIGN_VOLTAGE;
+        }
+    }
+
+    return Out->HoldMask;
+
+} /* End of HYUN_APP_AlignSample() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_AlignEstimate                                             */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Step the estimator up to one aligned tick. Every IMU sample since  */
+/*         the previous step is applied at its own time, so the whole 200 Hz  */
+/*         stream is integrated instead of one value per tick. The aligned    */
+/*         baro is then fused at the tick, unless it was held at its last     */
+/*         value and so carries no new information. Returns the arrival time  */
+/*         of the newest sample the step used, 0 if none.                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+uint64 HYUN_APP_AlignEstimate(HYUN_APP_KF_t *Kf, const HYUN_APP_SensorData_t *Sensor, uint64 TickUs,
+                              const HYUN_APP_AlignedTlm_Payload_t *Frame)
+{
+    const HYUN_APP_ImuRing_t  *Imu       = &Sensor->Imu;
+    const HYUN_APP_BaroRing_t *Baro      = &Sensor->Baro;
+    uint32                     Avail     = (Imu->Head < HYUN_APP_IMU_RING_SIZE) ? Imu->Head : HYUN_APP_IMU_RING_SIZE;
+    uint32                     Seq       = Imu->Head;
+    uint32                     Idx;
+    uint64                     ArrivalUs = 0;
+    uint8                      Mask      = 0;
+
+    CFE_ES_PerfLogEntry(HYUN_APP_KF_PERF_ID);
+
+    /*
+    ** Walk back to the first sample not yet applied. Samples that arrived
+    ** after the estimator already passed their time are dropped.
+    */
+    while (Seq != Imu->Head - Avail &&
+           Imu->TimeUs[HYUN_APP_RING_INDEX(Seq - 1, HYUN_APP_IMU_RING_SIZE)] > Kf->LastTimeUs)
+    {
+        Seq--;
+    }
+
+    for (; Seq != Imu->Head; Seq++)
+    {
+        Idx = HYUN_APP_RING_INDEX(Seq, HYUN_APP_IMU_RING_SIZE);
+        if (Imu->TimeUs[Idx] > TickUs)
+        {
+            break;
+        }
+        HYUN_APP_KF_Step(Kf, Imu->TimeUs[Idx], HYUN_APP_KF_MEAS_ACCEL, 0.0f, Imu->AccelZ[Idx] - HYUN_APP_KF_GRAVITY);
+        ArrivalUs = Imu->ArrivalUs[Idx];
+    }
+
+    if (Frame->ValidMask & (uint8)~Frame->HoldMask & HYUN_APP_ALIGN_BARO)
+    {
+        Mask |= HYUN_APP_KF_MEAS_BARO;
+
+        /*
+        ** The baro sample closing the tick is the oldest one at or after it.
+        ** A fresh baro guarantees the newest sample is past the tick.
+        */
+        Avail = (Baro->Head < HYUN_APP_BARO_RING_SIZE) ? Baro->Head : HYUN_APP_BARO_RING_SIZE;
+        Seq   = Baro->Head - 1;
+        while (Seq != Baro->Head - Avail &&
+               Baro->TimeUs[HYUN_APP_RING_INDEX(Seq - 1, HYUN_APP_BARO_RING_SIZE)] >= TickUs)
+        {
+            Seq--;
+        }
+        Idx = HYUN_APP_RING_INDEX(Seq, HYUN_APP_BARO_RING_SIZE);
+        if (Baro->ArrivalUs[Idx] > ArrivalUs)
+        {
+            ArrivalUs = Baro->ArrivalUs[Idx];
+        }
+    }
+    HYUN_APP_KF_Step(Kf, TickUs, Mask, Frame->Altitude, 0.0f);
+
+    CFE_ES_PerfLogExit(HYUN_APP_KF_PERF_ID);
+
+    return ArrivalUs;
+
+} /* End of HYUN_APP_AlignEstimate() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_AlignNewestUs -- Time of the newest sample, 0 if none  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static inline uint64 HYUN_APP_AlignNewestUs(const uint64 *TimeUs, uint32 Head, uint32 Size)
+{
+    return (Head == 0) ? 0 : TimeUs[HYUN_APP_RING_INDEX(Head - 1, Size)];
+
+} /* End of HYUN_APP_AlignNewestUs() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_AlignProcess                                              */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Emit every tick that is complete, or whose wait for a late fast    */
+/*         stream has reached the latency bound. The period and bound follow  */
+/*         the table once it is loaded. Every frame steps the estimator and   */
+/*         then the flight state machine once, and publishes the estimate.    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 HYUN_APP_AlignProcess(const HYUN_APP_Table_t *TblPtr)
+{
+    HYUN_APP_Align_t            *Align  = &HYUN_APP_Data.Align;
+    const HYUN_APP_SensorData_t *Sensor = &HYUN_APP_Data.Sensor;
+    HYUN_APP_AlignedTlm_t       *Tlm    = &HYUN_APP_Data.AlignedTlm;
+    CFE_TIME_SysTime_t           TickTime;
+    uint64                       BaroUs;
+    uint64                       ImuUs;
+    uint64                       NowUs;
+    uint64                       Skipped;
+    uint64                       ArrivalUs;
+    uint32                       Frames;
+    uint8                        HoldMask;
+
+    if (TblPtr != NULL)
+    {
+        Align->PeriodUs     = TblPtr->AlignPeriodMs * 1000u;
+        Align->MaxLatencyUs = TblPtr->AlignMaxLatencyMs * 1000u;
+    }
+
+    BaroUs = HYUN_APP_AlignNewestUs(Sensor->Baro.TimeUs, Sensor->Baro.Head, HYUN_APP_BARO_RING_SIZE);
+    ImuUs  = HYUN_APP_AlignNewestUs(Sensor->Imu.TimeUs, Sensor->Imu.Head, HYUN_APP_IMU_RING_SIZE);
+
+    if (!Align->Started)
+    {
+        if (Sensor->Baro.Head == 0 && Sensor->Imu.Head == 0)
+        {
+            return CFE_SUCCESS;
+        }
+
+        /*
+        ** First tick on the period grid after the first fast sample
+        */
+        Align->NextTickUs = (BaroUs > ImuUs) ? BaroUs : ImuUs;
+        Align->NextTickUs = ((Align->NextTickUs + Align->PeriodUs - 1) / Align->PeriodUs) * Align->PeriodUs;
+        Align->Started    = true;
+    }
+
+    NowUs = HYUN_APP_ReplayNowUs(HYUN_APP_SysTimeToUsec(CFE_TIME_GetTime()));
+
+    /*
+    ** After a stall, skip the ticks that could only be emitted beyond the
+    ** latency bound anyway instead of bursting them all out
+    */
+    if (NowUs > Align->NextTickUs + Align->MaxLatencyUs + (uint64)Align->PeriodUs * HYUN_APP_ALIGN_MAX_FRAMES)
+    {
+        Skipped = (NowUs - Align->MaxLatencyUs - Align->NextTickUs) / Align->PeriodUs;
+        Align->NextTickUs += Skipped * Align->PeriodUs;
+        Align->SkipCounter += (uint32)Skipped;
+    }
+
+    for (Frames = 0; Frames < HYUN_APP_ALIGN_MAX_FRAMES && Align->NextTickUs <= NowUs; Frames++)
+    {
+        if ((BaroUs < Align->NextTickUs || ImuUs < Align->NextTickUs) &&
+            NowUs < Align->NextTickUs + Align->MaxLatencyUs)
+        {
+            break;
+        }
+
+        HoldMask = HYUN_APP_AlignSample(Sensor, Align->NextTickUs, &Tlm->Payload);
+        if (HoldMask & HYUN_APP_ALIGN_FAST_STREAMS)
+        {
+            Align->HoldCounter++;
+        }
+
+        ArrivalUs = HYUN_APP_AlignEstimate(&HYUN_APP_Data.Kf, Sensor, Align->NextTickUs, &Tlm->Payload);
+        if (TblPtr != NULL)
+        {
+            HYUN_APP_FlightProcess(TblPtr, ArrivalUs);
+        }
+        HYUN_APP_SendEstimate();
+
+        Align->FrameCounter++;
+        Align->LastLatencyUs = (uint32)(NowUs - Align->NextTickUs);
+        if (Align->LastLatencyUs > Align->MaxAddedLatencyUs)
+        {
+            Align->MaxAddedLatencyUs = Align->LastLatencyUs;
+        }
+
+        Tlm->Payload.FrameCounter   = Align->FrameCounter;
+        Tlm->Payload.AddedLatencyUs = Align->LastLatencyUs;
+        Tlm->Payload.FlightState    = HYUN_APP_Data.Flight.State;
+
+        TickTime.Seconds    = (uint32)(Align->NextTickUs / 1000000u);
+        TickTime.Subseconds = CFE_TIME_Micro2SubSecs((uint32)(Align->NextTickUs % 1000000u));
+        CFE_MSG_SetMsgTime(&Tlm->TlmHeader.Msg, TickTime);
+
+        /* CX OFF stops the frames, not the alignment */
+        if (HYUN_APP_Data.TelemetryEnabled)
+        {
+            HYUN_APP_DownlinkSend(&Tlm->TlmHeader.Msg);
+        }
+
+        Align->NextTickUs += Align->PeriodUs;
+    }
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_AlignProcess() */
@@ -0,0 +1,101 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Multi-sensor time alignment
+ *
+ * The sensors sample on unrelated clocks (IMU 200 Hz, baro 20 Hz, GPS
+ * 1 Hz). This stage resamples every stream onto one common tick so that
+ * derived telemetry always combines values taken at the same instant.
+ *
+ * A tick T is emitted once the fast streams (baro, IMU) have a sample at
+ * or after T, each value being linearly interpolated between the samples
+ * bracketing T. If a fast stream has not reached T within the maximum
+ * latency, the tick is emitted anyway with that stream held at its last
+ * value, so the added latency is bounded. Slow streams (GPS, voltage)
+ * never hold a tick back.
+ *
+ * Every emitted frame also steps the altitude estimator up to its tick:
+ * the raw IMU samples since the previous tick are applied one by one and
+ * the aligned baro altitude is fused at the tick itself. The flight state
+ * machine then runs once on the new estimate.
+ */
+
+#ifndef HYUN_APP_ALIGN_H
+#define HYUN_APP_ALIGN_H
+
+#include "cfe.h"
+#include "hyun_app_msg.h"
+#include "hyun_app_table.h"
+#include "hyun_app_sensor.h"
+#include "hyun_app_kf.h"
+
+/***********************************************************************/
+#define HYUN_APP_ALIGN_DEFAULT_PERIOD_MS      100 /* Used until the table is loaded */
+#define HYUN_APP_ALIGN_DEFAULT_MAX_LATENCY_MS 100
+#define HYUN_APP_ALIGN_MIN_PERIOD_MS          10
+#define HYUN_APP_ALIGN_MAX_PERIOD_MS          1000
+#define HYUN_APP_ALIGN_MAX_LATENCY_LIMIT_MS   1000
+
+#define HYUN_APP_ALIGN_MAX_FRAMES 8 /* Ticks emitted per cycle, older ticks are skipped */
+
+/*
+** Stream bits used in the ValidMask / HoldMask telemetry fields
+*/
+#define HYUN_APP_ALIGN_BARO    0x01
+#define HYUN_APP_ALIGN_IMU     0x02
+#define HYUN_APP_ALIGN_GPS     0x04
+#define HYUN_APP_ALIGN_VOLTAGE 0x08
+
+#define HYUN_APP_ALIGN_FAST_STREAMS (HYUN_APP_ALIGN_BARO | HYUN_APP_ALIGN_IMU)
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    bool   Started;
+    uint64 NextTickUs;
+    uint32 PeriodUs;
+    uint32 MaxLatencyUs;
+
+    uint32 FrameCounter;
+    uint32 HoldCounter; /* Frames emitted with at least one fast stream held */
+    uint32 SkipCounter; /* Ticks dropped to catch up after a stall */
+    uint32 LastLatencyUs;
+    uint32 MaxAddedLatencyUs;
+} HYUN_APP_Align_t;
+
+/****************************************************************************/
+/*
+** Alignment prototypes
+*/
+void   HYUN_APP_AlignInit(HYUN_APP_Align_t *Align);
+uint8  HYUN_APP_AlignSample(const HYUN_APP_SensorData_t *Sensor, uint64 TickUs, HYUN_APP_AlignedTlm_Payload_t *Out);
+uint64 HYUN_APP_AlignEstimate(HYUN_APP_KF_t *Kf, const HYUN_APP_SensorData_t *Sensor, uint64 TickUs,
+                              const HYUN_APP_AlignedTlm_Payload_t *Frame);
+int32  HYUN_APP_AlignProcess(const HYUN_APP_Table_t *TblPtr);
+
+#endif /* HYUN_APP_ALIGN_H */
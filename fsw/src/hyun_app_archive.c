@@ -0,0 +1,167 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+** File: hyun_app_archive.c
+**
+** Purpose:
+**   Record blocks and index entries of the packet archive. Shared between
+**   the flight recorder and the host reader.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "hyun_app_archive.h"
+
+CompileTimeAssert(sizeof(HYUN_APP_ArchiveHdr_t) == 16, HYUN_APP_ArchiveHdrPadded);
+CompileTimeAssert(sizeof(HYUN_APP_ArchiveRec_t) == 16, HYUN_APP_ArchiveRecPadded);
+CompileTimeAssert(sizeof(HYUN_APP_ArchiveIndex_t) == 48, HYUN_APP_ArchiveIndexPadded);
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_ArchiveHdrInit -- File header of a new data or index   */
+/* file                                                            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_ArchiveHdrInit(HYUN_APP_ArchiveHdr_t *Hdr, uint32 Magic)
+{
+    memset(Hdr, 0, sizeof(*Hdr));
+    Hdr->Magic      = Magic;
+    Hdr->Version    = HYUN_APP_ARCHIVE_VERSION;
+    Hdr->HeaderSize = sizeof(*Hdr);
+    Hdr->EntrySize  = (Magic == HYUN_APP_ARCHIVE_INDEX_MAGIC) ? sizeof(HYUN_APP_ArchiveIndex_t) : 0;
+
+} /* End of HYUN_APP_ArchiveHdrInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_ArchiveHdrValid -- Header written by this version, in  */
+/* this byte order                                                 */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool HYUN_APP_ArchiveHdrValid(const HYUN_APP_ArchiveHdr_t *Hdr, uint32 Magic)
+{
+    HYUN_APP_ArchiveHdr_t Expected;
+
+    HYUN_APP_ArchiveHdrInit(&Expected, Magic);
+
+    return Hdr->Magic == Expected.Magic && Hdr->Version == Expected.Version &&
+           Hdr->HeaderSize == Expected.HeaderSize && Hdr->EntrySize == Expected.EntrySize;
+
+} /* End of HYUN_APP_ArchiveHdrValid() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_ArchiveBlockInit                                          */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Start an empty block at data file Offset. Last is the final        */
+/*         index entry when appending to an existing archive, so the          */
+/*         running time bounds carry on; NULL for a new archive.              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HYUN_APP_ArchiveBlockInit(HYUN_APP_ArchiveBlock_t *Block, uint64 Offset, const HYUN_APP_ArchiveIndex_t *Last)
+{
+    memset(&Block->Entry, 0, sizeof(Block->Entry));
+
+    if (Last != NULL)
+    {
+        Block->Entry.MaxTimeUs = Last->MaxTimeUs;
+        Block->Entry.LateUs    = Last->LateUs;
+    }
+
+    Block->Entry.Offset = Offset;
+
+} /* End of HYUN_APP_ArchiveBlockInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_ArchiveAppend                                             */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Add a record to the block and fold it into the block's index       */
+/*         entry. False if the block has no room left; the caller then        */
+/*         writes the block out, calls HYUN_APP_ArchiveBlockNext and tries    */
+/*         again. Packets over HYUN_APP_ARCHIVE_MAX_PACKET never fit.         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+bool HYUN_APP_ArchiveAppend(HYUN_APP_ArchiveBlock_t *Block, uint64 TimeUs, uint16 MsgId, const void *Packet,
+                            uint16 Length)
+{
+    HYUN_APP_ArchiveIndex_t *Entry = &Block->Entry;
+    HYUN_APP_ArchiveRec_t    Rec;
+    uint64                   Late;
+
+    if (sizeof(Rec) + Length > HYUN_APP_ARCHIVE_BLOCK_SIZE - Entry->Length)
+    {
+        return false;
+    }
+
+    Rec.TimeUs = TimeUs;
+    Rec.MsgId  = MsgId;
+    Rec.Length = Length;
+    Rec.Sync   = HYUN_APP_ARCHIVE_SYNC;
+
+    memcpy(&Block->Data[Entry->Length], &Rec, sizeof(Rec));
+    memcpy(&Block->Data[Entry->Length + sizeof(Rec)], Packet, Length);
+
+    if (Entry->Count == 0 || TimeUs < Entry->MinTimeUs)
+    {
+        Entry->MinTimeUs = TimeUs;
+    }
+
+    if (TimeUs > Entry->MaxTimeUs)
+    {
+        Entry->MaxTimeUs = TimeUs;
+    }
+    else
+    {
+        Late = Entry->MaxTimeUs - TimeUs;
+        if (Late > Entry->LateUs)
+        {
+            Entry->LateUs = (Late >= HYUN_APP_ARCHIVE_LATE_UNBOUNDED) ? HYUN_APP_ARCHIVE_LATE_UNBOUNDED : (uint32)Late;
+        }
+    }
+
+    Entry->MidMask |= HYUN_APP_ARCHIVE_MID_BIT(MsgId);
+    Entry->Length += sizeof(Rec) + Length;
+    Entry->Count++;
+
+    return true;
+
+} /* End of HYUN_APP_ArchiveAppend() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_ArchiveBlockNext -- Empty the block once it and its    */
+/* index entry are written, the next one follows it in the file    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_ArchiveBlockNext(HYUN_APP_ArchiveBlock_t *Block)
+{
+    HYUN_APP_ArchiveIndex_t *Entry = &Block->Entry;
+
+    Entry->Offset += Entry->Length;
+    Entry->Length    = 0;
+    Entry->Count     = 0;
+    Entry->MinTimeUs = 0;
+    Entry->MidMask   = 0;
+
+} /* End of HYUN_APP_ArchiveBlockNext() */
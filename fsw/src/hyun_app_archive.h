@@ -0,0 +1,139 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Time-indexed packet archive
+ *
+ * Recorded packets go into an append-only data file as records, each a
+ * small header (time stamp, MID, length) followed by the packet as it
+ * was on the bus. Records are collected into blocks of up to
+ * HYUN_APP_ARCHIVE_BLOCK_SIZE bytes. Every block written to the data
+ * file gets one fixed-size entry in a companion index file, holding the
+ * block's offset and length, its earliest time stamp, the running
+ * maximum time stamp of the archive so far and a 64-bit mask of the
+ * MIDs it contains (bit MsgId % 64).
+ *
+ * Packets are recorded in arrival order. A writer that stamps them with
+ * their own time sees streams step back a little; the flight recorder
+ * stamps the MET of recording, which only steps back when MET restarts
+ * after a power-on reset. The index keeps the largest such step seen so
+ * far (LateUs), which lets a reader bound a range query on both ends:
+ * blocks before the first entry whose running maximum reaches the start
+ * time hold nothing newer, and no block after an entry whose running
+ * maximum exceeds the end time by more than LateUs holds anything older. A LateUs of HYUN_APP_ARCHIVE_LATE_UNBOUNDED (e.g. the
+ * time base restarted) makes the reader scan to the end.
+ *
+ * The data block is always written before its index entry, so after a
+ * crash the index can only lag the data; readers scan the unindexed
+ * tail record by record.
+ *
+ * Both files are in the byte order of the recording computer. Only
+ * depends on the OSAL base types so the same source builds into the host
+ * reader under tools/.
+ */
+
+#ifndef HYUN_APP_ARCHIVE_H
+#define HYUN_APP_ARCHIVE_H
+
+#include "common_types.h"
+
+/***********************************************************************/
+#define HYUN_APP_ARCHIVE_DATA_MAGIC  0x48594144 /* "HYAD" */
+#define HYUN_APP_ARCHIVE_INDEX_MAGIC 0x48594149 /* "HYAI" */
+#define HYUN_APP_ARCHIVE_VERSION     1
+
+#define HYUN_APP_ARCHIVE_SYNC       0x5AA5C33C /* Marks every record header */
+#define HYUN_APP_ARCHIVE_BLOCK_SIZE 4096       /* Max data bytes per index entry */
+
+#define HYUN_APP_ARCHIVE_LATE_UNBOUNDED 0xFFFFFFFFu
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+/*
+** First bytes of both files
+*/
+typedef struct
+{
+    uint32 Magic;      /* HYUN_APP_ARCHIVE_DATA_MAGIC / _INDEX_MAGIC */
+    uint16 Version;
+    uint16 HeaderSize; /* Records / entries start here */
+    uint32 EntrySize;  /* Index entry size, 0 in the data file */
+    uint32 spare;
+} HYUN_APP_ArchiveHdr_t;
+
+/*
+** Data file record, followed by Length packet bytes. Records are packed,
+** so readers must not assume any alignment.
+*/
+typedef struct
+{
+    uint64 TimeUs; /* Time stamp, MET when written by the flight recorder */
+    uint16 MsgId;
+    uint16 Length;
+    uint32 Sync; /* HYUN_APP_ARCHIVE_SYNC */
+} HYUN_APP_ArchiveRec_t;
+
+/*
+** Index file entry, one per data block
+*/
+typedef struct
+{
+    uint64 Offset;    /* Data file offset of the block's first record */
+    uint64 MinTimeUs; /* Earliest time stamp in the block */
+    uint64 MaxTimeUs; /* Latest time stamp in the archive up to the end of the block */
+    uint64 MidMask;   /* Bit MsgId % 64 set for every MID in the block */
+    uint32 Length;    /* Block bytes */
+    uint32 Count;     /* Records in the block */
+    uint32 LateUs;    /* Largest step back in time so far, MaxTimeUs - TimeUs */
+    uint32 spare;
+} HYUN_APP_ArchiveIndex_t;
+
+/*
+** Block being filled. Entry describes Data and carries the running
+** MaxTimeUs / LateUs from one block to the next.
+*/
+typedef struct
+{
+    HYUN_APP_ArchiveIndex_t Entry;
+    uint8                   Data[HYUN_APP_ARCHIVE_BLOCK_SIZE];
+} HYUN_APP_ArchiveBlock_t;
+
+#define HYUN_APP_ARCHIVE_MAX_PACKET (HYUN_APP_ARCHIVE_BLOCK_SIZE - sizeof(HYUN_APP_ArchiveRec_t))
+
+#define HYUN_APP_ARCHIVE_MID_BIT(MsgId) ((uint64)1 << ((MsgId)&63))
+
+/****************************************************************************/
+/*
+** Archive prototypes
+*/
+void HYUN_APP_ArchiveHdrInit(HYUN_APP_ArchiveHdr_t *Hdr, uint32 Magic);
+bool HYUN_APP_ArchiveHdrValid(const HYUN_APP_ArchiveHdr_t *Hdr, uint32 Magic);
+void HYUN_APP_ArchiveBlockInit(HYUN_APP_ArchiveBlock_t *Block, uint64 Offset, const HYUN_APP_ArchiveIndex_t *Last);
+bool HYUN_APP_ArchiveAppend(HYUN_APP_ArchiveBlock_t *Block, uint64 TimeUs, uint16 MsgId, const void *Packet,
+                            uint16 Length);
+void HYUN_APP_ArchiveBlockNext(HYUN_APP_ArchiveBlock_t *Block);
+
+#endif /* HYUN_APP_ARCHIVE_H */
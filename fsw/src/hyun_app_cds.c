@@ -0,0 +1,219 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_cds.c
+**
+** Purpose:
+**   Persistence of key runtime state in the cFE Critical Data Store.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <stddef.h>
+#include <string.h>
+
+#include "hyun_app_events.h"
+#include "hyun_app.h"
+#include "hyun_app_cds.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_CdsCapture -- Snapshot the persisted state             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void HYUN_APP_CdsCapture(HYUN_APP_CdsImage_t *Image)
+{
+    uint32 CmdCounter;
+    uint32 ErrCounter;
+
+    HYUN_APP_CountersSum(&HYUN_APP_Data.Counters, &CmdCounter, &ErrCounter);
+
+    memset(Image, 0, sizeof(*Image));
+
+    Image->Version            = HYUN_APP_CDS_VERSION;
+    Image->CmdCounter         = (uint8)CmdCounter;
+    Image->ErrCounter         = (uint8)ErrCounter;
+    Image->TelemetryEnabled   = HYUN_APP_Data.TelemetryEnabled;
+    Image->SimMode            = HYUN_APP_Data.SimMode;
+    Image->MissionTimeFromGps = HYUN_APP_Data.MissionTimeFromGps;
+    Image->FlightState        = HYUN_APP_Data.Flight.State;
+    Image->GroundValid        = HYUN_APP_Data.Flight.GroundValid;
+    Image->MissionTimeOffset  = HYUN_APP_Data.MissionTimeOffset;
+    Image->GroundAltitude     = HYUN_APP_Data.Flight.GroundAltitude;
+    Image->TransitionCounter  = HYUN_APP_Data.Flight.TransitionCounter;
+    Image->MaxAltitude        = HYUN_APP_Data.Flight.MaxAltitude;
+    Image->PacketCounter      = HYUN_APP_Data.Align.FrameCounter;
+    Image->SensorMsgCounter   = HYUN_APP_Data.Sensor.MsgCounter;
+
+} /* End of HYUN_APP_CdsCapture() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_CdsApply -- Put a restored snapshot back in place      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void HYUN_APP_CdsApply(const HYUN_APP_CdsImage_t *Image)
+{
+    HYUN_APP_CountersInit(&HYUN_APP_Data.Counters);
+    HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].CmdCounter = Image->CmdCounter;
+    HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter = Image->ErrCounter;
+
+    HYUN_APP_Data.TelemetryEnabled   = (Image->TelemetryEnabled != 0);
+    HYUN_APP_Data.SimMode            = Image->SimMode;
+    HYUN_APP_Data.MissionTimeFromGps = (Image->MissionTimeFromGps != 0);
+    HYUN_APP_Data.MissionTimeOffset  = Image->MissionTimeOffset;
+
+    HYUN_APP_Data.Flight.State             = Image->FlightState;
+    HYUN_APP_Data.Flight.PendingState      = Image->FlightState;
+    HYUN_APP_Data.Flight.PendingCounter    = 0;
+    HYUN_APP_Data.Flight.GroundValid       = (Image->GroundValid != 0);
+    HYUN_APP_Data.Flight.GroundAltitude    = Image->GroundAltitude;
+    HYUN_APP_Data.Flight.MaxAltitude       = Image->MaxAltitude;
+    HYUN_APP_Data.Flight.TransitionCounter = Image->TransitionCounter;
+
+    HYUN_APP_Data.Align.FrameCounter = Image->PacketCounter + HYUN_APP_CDS_PACKET_MARGIN;
+    HYUN_APP_Data.Sensor.MsgCounter  = Image->SensorMsgCounter;
+
+} /* End of HYUN_APP_CdsApply() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_CdsCommit -- Write a snapshot to the CDS               */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void HYUN_APP_CdsCommit(const HYUN_APP_CdsImage_t *Image, uint64 NowUs)
+{
+    HYUN_APP_Cds_t *Cds = &HYUN_APP_Data.Cds;
+
+    if (CFE_ES_CopyToCDS(Cds->Handle, Image) != CFE_SUCCESS)
+    {
+        /* Retried on the next cycle, the image still differs */
+        Cds->ErrCounter++;
+        return;
+    }
+
+    Cds->Image        = *Image;
+    Cds->LastCommitUs = NowUs;
+    Cds->CommitCounter++;
+
+} /* End of HYUN_APP_CdsCommit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_CdsInit                                                   */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Register the CDS block and, if it survived a restart, restore the  */
+/*         state from it. Must run after the modules it restores have been    */
+/*         initialized. Without a CDS the app runs on, only unprotected.      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HYUN_APP_CdsInit(void)
+{
+    HYUN_APP_Cds_t     *Cds = &HYUN_APP_Data.Cds;
+    HYUN_APP_CdsImage_t Image;
+    uint64              StartUs;
+    uint64              NowUs;
+    int32               Status;
+
+    memset(Cds, 0, sizeof(*Cds));
+    StartUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+
+    Status = CFE_ES_RegisterCDS(&Cds->Handle, sizeof(HYUN_APP_CdsImage_t), HYUN_APP_CDS_NAME);
+    if (Status == CFE_ES_CDS_ALREADY_EXISTS)
+    {
+        Cds->Registered = true;
+
+        /* cFE checks the block CRC, the version catches a changed layout */
+        Status = CFE_ES_RestoreFromCDS(&Image, Cds->Handle);
+        if (Status == CFE_SUCCESS && Image.Version == HYUN_APP_CDS_VERSION)
+        {
+            HYUN_APP_CdsApply(&Image);
+            Cds->Restored = true;
+        }
+        else
+        {
+            CFE_EVS_SendEvent(HYUN_APP_CDS_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CDS contents invalid, RC = 0x%08lX, starting fresh", (unsigned long)Status);
+        }
+    }
+    else if (Status == CFE_SUCCESS)
+    {
+        Cds->Registered = true;
+    }
+    else
+    {
+        CFE_ES_WriteToSysLog("Hyun_app: Error Registering CDS, RC = 0x%08lX\n", (unsigned long)Status);
+        return;
+    }
+
+    NowUs          = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+    Cds->RestoreUs = (uint32)(NowUs - StartUs);
+
+    HYUN_APP_CdsCapture(&Image);
+    HYUN_APP_CdsCommit(&Image, NowUs);
+
+    if (Cds->Restored)
+    {
+        CFE_EVS_SendEvent(HYUN_APP_CDS_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "CDS restored in %lu us: state %s, packet %lu, cmd %u/%u",
+                          (unsigned long)Cds->RestoreUs, HYUN_APP_FlightStateName(HYUN_APP_Data.Flight.State),
+                          (unsigned long)HYUN_APP_Data.Align.FrameCounter, (unsigned int)Image.CmdCounter,
+                          (unsigned int)Image.ErrCounter);
+    }
+
+} /* End of HYUN_APP_CdsInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_CdsUpdate                                                 */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Called once per cycle. Commits right away when a mode, counter of  */
+/*         commands or the flight state changed, otherwise only once per      */
+/*         counter period while the running counters move.                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HYUN_APP_CdsUpdate(void)
+{
+    HYUN_APP_Cds_t     *Cds = &HYUN_APP_Data.Cds;
+    HYUN_APP_CdsImage_t Image;
+    uint64              NowUs;
+
+    if (!Cds->Registered)
+    {
+        return;
+    }
+
+    HYUN_APP_CdsCapture(&Image);
+    NowUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+
+    if (memcmp(&Image, &Cds->Image, offsetof(HYUN_APP_CdsImage_t, MaxAltitude)) == 0)
+    {
+        if (NowUs - Cds->LastCommitUs < (uint64)HYUN_APP_CDS_COUNTER_PERIOD_MS * 1000u ||
+            memcmp(&Image, &Cds->Image, sizeof(Image)) == 0)
+        {
+            return;
+        }
+    }
+
+    HYUN_APP_CdsCommit(&Image, NowUs);
+
+} /* End of HYUN_APP_CdsUpdate() */
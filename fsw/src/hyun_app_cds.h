@@ -0,0 +1,102 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Critical Data Store persistence
+ *
+ * The state that must survive an app restart or reload mid-flight (command
+ * counters, modes, flight state, packet count) is mirrored into a small
+ * CDS block. cFE only copies whole blocks, so the block is kept to a few
+ * dozen bytes and written only when it changed: at once for modes and
+ * flight state, and at most every HYUN_APP_CDS_COUNTER_PERIOD_MS when only
+ * the fast running counters moved.
+ */
+
+#ifndef HYUN_APP_CDS_H
+#define HYUN_APP_CDS_H
+
+#include "cfe.h"
+
+/***********************************************************************/
+#define HYUN_APP_CDS_NAME    "HyunAppCds"
+#define HYUN_APP_CDS_VERSION 1 /* Bump when HYUN_APP_CdsImage_t changes */
+
+#define HYUN_APP_CDS_COUNTER_PERIOD_MS 1000
+
+/*
+** Packet counter advance on restore, the most aligned frames one counter
+** period can hold, so the ground never sees a packet count repeat
+*/
+#define HYUN_APP_CDS_PACKET_MARGIN (HYUN_APP_CDS_COUNTER_PERIOD_MS / HYUN_APP_ALIGN_MIN_PERIOD_MS)
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+/*
+** Everything up to MaxAltitude is committed on change, the counters
+** after it only with the counter period
+*/
+typedef struct
+{
+    uint16 Version;
+    uint8  CmdCounter;
+    uint8  ErrCounter;
+    uint8  TelemetryEnabled;
+    uint8  SimMode;
+    uint8  MissionTimeFromGps;
+    uint8  FlightState;
+    uint8  GroundValid;
+    uint8  spare[3];
+    int32  MissionTimeOffset;
+    float  GroundAltitude;
+    uint32 TransitionCounter;
+
+    float  MaxAltitude;
+    uint32 PacketCounter;
+    uint32 SensorMsgCounter;
+} HYUN_APP_CdsImage_t;
+
+typedef struct
+{
+    bool               Registered;
+    bool               Restored;
+    CFE_ES_CDSHandle_t Handle;
+
+    HYUN_APP_CdsImage_t Image; /* Last committed contents */
+    uint64              LastCommitUs;
+
+    uint32 CommitCounter;
+    uint32 ErrCounter;
+    uint32 RestoreUs; /* Register + restore + apply at startup */
+} HYUN_APP_Cds_t;
+
+/****************************************************************************/
+/*
+** CDS prototypes
+*/
+void  HYUN_APP_CdsInit(void);
+void  HYUN_APP_CdsUpdate(void);
+
+#endif /* HYUN_APP_CDS_H */
@@ -0,0 +1,551 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_codec.c
+**
+** Purpose:
+**   Delta / zigzag varint and LZ codecs for radio-limited downlink.
+**   Shared between the flight software and the host decoder.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "hyun_app_codec.h"
+
+static const uint8 HYUN_APP_CodecZeros[HYUN_APP_CODEC_MAX_PAYLOAD];
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_CodecLoadWord -- Little-endian word, zero padded       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static inline uint32 HYUN_APP_CodecLoadWord(const uint8 *Ptr, size_t Avail)
+{
+    uint32 Word = 0;
+
+    switch (Avail)
+    {
+        default:
+            Word |= (uint32)Ptr[3] << 24;
+            /* fall through */
+        case 3:
+            Word |= (uint32)Ptr[2] << 16;
+            /* fall through */
+        case 2:
+            Word |= (uint32)Ptr[1] << 8;
+            /* fall through */
+        case 1:
+            Word |= (uint32)Ptr[0];
+            break;
+    }
+
+    return Word;
+
+} /* End of HYUN_APP_CodecLoadWord() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_CodecStoreWord -- Little-endian store, truncated       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static inline void HYUN_APP_CodecStoreWord(uint8 *Ptr, size_t Avail, uint32 Word)
+{
+    switch (Avail)
+    {
+        default:
+            Ptr[3] = (uint8)(Word >> 24);
+            /* fall through */
+        case 3:
+            Ptr[2] = (uint8)(Word >> 16);
+            /* fall through */
+        case 2:
+            Ptr[1] = (uint8)(Word >> 8);
+            /* fall through */
+        case 1:
+            Ptr[0] = (uint8)Word;
+            break;
+    }
+
+} /* End of HYUN_APP_CodecStoreWord() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_DeltaEncode                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Word-wise delta against Ref, zigzag, LEB128 varint. Returns the    */
+/*         encoded size, or 0 if it does not fit in OutSize.                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+size_t HYUN_APP_DeltaEncode(const uint8 *Ref, const uint8 *In, size_t Len, uint8 *Out, size_t OutSize)
+{
+    size_t Pos = 0;
+    size_t Off;
+    uint32 Delta;
+    uint32 Zz;
+
+    for (Off = 0; Off < Len; Off += 4)
+    {
+        Delta = HYUN_APP_CodecLoadWord(&In[Off], Len - Off) - HYUN_APP_CodecLoadWord(&Ref[Off], Len - Off);
+        Zz    = (Delta << 1) ^ (uint32)((int32)Delta >> 31);
+
+        do
+        {
+            if (Pos >= OutSize)
+            {
+                return 0;
+            }
+            Out[Pos++] = (uint8)((Zz & 0x7F) | ((Zz > 0x7F) ? 0x80 : 0));
+            Zz >>= 7;
+        } while (Zz != 0);
+    }
+
+    return Pos;
+
+} /* End of HYUN_APP_DeltaEncode() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_DeltaDecode                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Rebuild OutLen bytes from Ref and the varint stream. Returns the   */
+/*         number of input bytes consumed, or 0 on malformed input.           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+size_t HYUN_APP_DeltaDecode(const uint8 *Ref, const uint8 *In, size_t InLen, uint8 *Out, size_t OutLen)
+{
+    size_t Pos = 0;
+    size_t Off;
+    uint32 Zz;
+    uint32 Shift;
+    uint8  Byte;
+
+    for (Off = 0; Off < OutLen; Off += 4)
+    {
+        Zz    = 0;
+        Shift = 0;
+        do
+        {
+            if (Pos >= InLen || Shift > 28)
+            {
+                return 0;
+            }
+            Byte = In[Pos++];
+            Zz |= (uint32)(Byte & 0x7F) << Shift;
+            Shift += 7;
+        } while (Byte & 0x80);
+
+        HYUN_APP_CodecStoreWord(&Out[Off], OutLen - Off,
+                                HYUN_APP_CodecLoadWord(&Ref[Off], OutLen - Off) + ((Zz >> 1) ^ (0u - (Zz & 1))));
+    }
+
+    return Pos;
+
+} /* End of HYUN_APP_DeltaDecode() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_LzPutLength -- 255-run length extension                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static bool HYUN_APP_LzPutLength(size_t Length, uint8 *Out, size_t *Pos, size_t OutSize)
+{
+    for (; Length >= 255; Length -= 255)
+    {
+        if (*Pos >= OutSize)
+        {
+            return false;
+        }
+        Out[(*Pos)++] = 255;
+    }
+
+    if (*Pos >= OutSize)
+    {
+        return false;
+    }
+    Out[(*Pos)++] = (uint8)Length;
+
+    return true;
+
+} /* End of HYUN_APP_LzPutLength() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_LzEmit -- Write one literal run plus optional match    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static bool HYUN_APP_LzEmit(const uint8 *Lit, size_t LitLen, size_t Offset, size_t MatchLen, uint8 *Out,
+                            size_t *Pos, size_t OutSize)
+{
+    size_t TokenPos = *Pos;
+    size_t MatchCode;
+
+    if (*Pos >= OutSize)
+    {
+        return false;
+    }
+    Out[(*Pos)++] = 0;
+
+    Out[TokenPos] = (uint8)(((LitLen < 15) ? LitLen : 15) << 4);
+    if (LitLen >= 15 && !HYUN_APP_LzPutLength(LitLen - 15, Out, Pos, OutSize))
+    {
+        return false;
+    }
+
+    if (*Pos + LitLen > OutSize)
+    {
+        return false;
+    }
+    memcpy(&Out[*Pos], Lit, LitLen);
+    *Pos += LitLen;
+
+    if (MatchLen == 0)
+    {
+        return true;
+    }
+
+    if (*Pos + 2 > OutSize)
+    {
+        return false;
+    }
+    Out[(*Pos)++] = (uint8)Offset;
+    Out[(*Pos)++] = (uint8)(Offset >> 8);
+
+    MatchCode = MatchLen - HYUN_APP_LZ_MIN_MATCH;
+    Out[TokenPos] |= (uint8)((MatchCode < 15) ? MatchCode : 15);
+    if (MatchCode >= 15 && !HYUN_APP_LzPutLength(MatchCode - 15, Out, Pos, OutSize))
+    {
+        return false;
+    }
+
+    return true;
+
+} /* End of HYUN_APP_LzEmit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_LzEncode                                                  */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Greedy LZ77 with a single-entry hash of the next 4 bytes. Each     */
+/*         sequence is a token (literal length << 4 | match length - 4),      */
+/*         the literals, then a 16-bit little-endian offset. The last         */
+/*         sequence has literals only. Returns 0 if OutSize is too small.     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+size_t HYUN_APP_LzEncode(const uint8 *In, size_t Len, uint8 *Out, size_t OutSize)
+{
+    uint16 Table[1 << HYUN_APP_LZ_HASH_BITS]; /* Position + 1, 0 = empty */
+    size_t Pos    = 0;
+    size_t Anchor = 0;
+    size_t Ip     = 0;
+    size_t Ref;
+    size_t MatchLen;
+    uint32 Seq;
+    uint32 Hash;
+
+    if (Len > 0xFFFF)
+    {
+        return 0;
+    }
+
+    memset(Table, 0, sizeof(Table));
+
+    while (Ip + HYUN_APP_LZ_MIN_MATCH <= Len)
+    {
+        Seq  = HYUN_APP_CodecLoadWord(&In[Ip], 4);
+        Hash = (Seq * 2654435761u) >> (32 - HYUN_APP_LZ_HASH_BITS);
+        Ref  = Table[Hash];
+
+        Table[Hash] = (uint16)(Ip + 1);
+
+        if (Ref == 0 || HYUN_APP_CodecLoadWord(&In[Ref - 1], 4) != Seq)
+        {
+            Ip++;
+            continue;
+        }
+        Ref--;
+
+        MatchLen = HYUN_APP_LZ_MIN_MATCH;
+        while (Ip + MatchLen < Len && In[Ref + MatchLen] == In[Ip + MatchLen])
+        {
+            MatchLen++;
+        }
+
+        if (!HYUN_APP_LzEmit(&In[Anchor], Ip - Anchor, Ip - Ref, MatchLen, Out, &Pos, OutSize))
+        {
+            return 0;
+        }
+
+        Ip += MatchLen;
+        Anchor = Ip;
+    }
+
+    if (!HYUN_APP_LzEmit(&In[Anchor], Len - Anchor, 0, 0, Out, &Pos, OutSize))
+    {
+        return 0;
+    }
+
+    return Pos;
+
+} /* End of HYUN_APP_LzEncode() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_LzGetLength -- Read a 255-run length extension         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static bool HYUN_APP_LzGetLength(const uint8 *In, size_t InLen, size_t *Pos, size_t *Length)
+{
+    uint8 Byte;
+
+    do
+    {
+        if (*Pos >= InLen)
+        {
+            return false;
+        }
+        Byte = In[(*Pos)++];
+        *Length += Byte;
+    } while (Byte == 255);
+
+    return true;
+
+} /* End of HYUN_APP_LzGetLength() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_LzDecode                                                  */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Expand an HYUN_APP_LzEncode block. Every length and offset is      */
+/*         checked against both buffers, so corrupt input fails cleanly.      */
+/*         Returns the decoded size, or 0 on error.                           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+size_t HYUN_APP_LzDecode(const uint8 *In, size_t InLen, uint8 *Out, size_t OutSize)
+{
+    size_t Pos = 0;
+    size_t Op  = 0;
+    size_t LitLen;
+    size_t MatchLen;
+    size_t Offset;
+    uint8  Token;
+
+    while (Pos < InLen)
+    {
+        Token  = In[Pos++];
+        LitLen = Token >> 4;
+        if (LitLen == 15 && !HYUN_APP_LzGetLength(In, InLen, &Pos, &LitLen))
+        {
+            return 0;
+        }
+
+        if (LitLen > InLen - Pos || LitLen > OutSize - Op)
+        {
+            return 0;
+        }
+        memcpy(&Out[Op], &In[Pos], LitLen);
+        Pos += LitLen;
+        Op += LitLen;
+
+        if (Pos == InLen)
+        {
+            break;
+        }
+
+        if (InLen - Pos < 2)
+        {
+            return 0;
+        }
+        Offset = (size_t)In[Pos] | ((size_t)In[Pos + 1] << 8);
+        Pos += 2;
+
+        MatchLen = Token & 0x0F;
+        if (MatchLen == 15 && !HYUN_APP_LzGetLength(In, InLen, &Pos, &MatchLen))
+        {
+            return 0;
+        }
+        MatchLen += HYUN_APP_LZ_MIN_MATCH;
+
+        if (Offset == 0 || Offset > Op || MatchLen > OutSize - Op)
+        {
+            return 0;
+        }
+
+        /* Byte copy, matches may overlap their own output */
+        for (; MatchLen > 0; MatchLen--, Op++)
+        {
+            Out[Op] = Out[Op - Offset];
+        }
+    }
+
+    return Op;
+
+} /* End of HYUN_APP_LzDecode() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_CodecStreamInit -- Reset one MID stream                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_CodecStreamInit(HYUN_APP_CodecStream_t *Stream, uint16 MsgId, uint8 Codec)
+{
+    memset(Stream, 0, sizeof(*Stream));
+
+    Stream->MsgId = MsgId;
+    Stream->Codec = Codec;
+
+} /* End of HYUN_APP_CodecStreamInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_CodecEncodeFrame                                          */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Compress one payload with the stream codec. Frames that would not  */
+/*         shrink are sent raw (HYUN_APP_CODEC_NONE); the DELTA reference is  */
+/*         advanced either way so both ends stay in step.                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 HYUN_APP_CodecEncodeFrame(HYUN_APP_CodecStream_t *Stream, const uint8 *Payload, size_t Len,
+                                HYUN_APP_CodecFrame_t *Frame)
+{
+    const uint8 *Ref;
+    size_t       Size = 0;
+
+    if (Len > HYUN_APP_CODEC_MAX_PAYLOAD)
+    {
+        return HYUN_APP_CODEC_ERR_LENGTH;
+    }
+
+    Frame->MsgId     = Stream->MsgId;
+    Frame->Codec     = Stream->Codec;
+    Frame->Flags     = 0;
+    Frame->RawLength = (uint16)Len;
+    Frame->Seq       = Stream->Seq++;
+
+    switch (Stream->Codec)
+    {
+        case HYUN_APP_CODEC_DELTA:
+            Ref = Stream->Ref;
+            if ((Frame->Seq % HYUN_APP_CODEC_KEYFRAME_INTERVAL) == 0 || Stream->RefLength != Len)
+            {
+                Ref = HYUN_APP_CodecZeros;
+                Frame->Flags |= HYUN_APP_CODEC_FLAG_KEY;
+            }
+            Size = HYUN_APP_DeltaEncode(Ref, Payload, Len, Frame->Data, sizeof(Frame->Data));
+            break;
+
+        case HYUN_APP_CODEC_LZ:
+            Size = HYUN_APP_LzEncode(Payload, Len, Frame->Data, sizeof(Frame->Data));
+            break;
+
+        default:
+            break;
+    }
+
+    if (Size == 0 || Size >= Len)
+    {
+        Frame->Codec = HYUN_APP_CODEC_NONE;
+        Frame->Flags = 0;
+        memcpy(Frame->Data, Payload, Len);
+        Size = Len;
+    }
+
+    Frame->Length = (uint16)Size;
+
+    memcpy(Stream->Ref, Payload, Len);
+    Stream->RefLength = (uint16)Len;
+
+    return HYUN_APP_CODEC_SUCCESS;
+
+} /* End of HYUN_APP_CodecEncodeFrame() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_CodecDecodeFrame                                          */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Expand one frame into Payload. A sequence gap invalidates the      */
+/*         DELTA reference until the next key or raw frame.                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 HYUN_APP_CodecDecodeFrame(HYUN_APP_CodecStream_t *Stream, const HYUN_APP_CodecFrame_t *Frame, uint8 *Payload,
+                                size_t PayloadSize)
+{
+    const uint8 *Ref;
+    size_t       Len = Frame->RawLength;
+
+    if (Len > PayloadSize || Len > HYUN_APP_CODEC_MAX_PAYLOAD || Frame->Length > sizeof(Frame->Data))
+    {
+        return HYUN_APP_CODEC_ERR_LENGTH;
+    }
+
+    if (Frame->Seq != Stream->Seq)
+    {
+        Stream->RefValid = false;
+    }
+    Stream->Seq = Frame->Seq + 1;
+
+    switch (Frame->Codec)
+    {
+        case HYUN_APP_CODEC_NONE:
+            if (Frame->Length != Len)
+            {
+                return HYUN_APP_CODEC_ERR_DATA;
+            }
+            memcpy(Payload, Frame->Data, Len);
+            break;
+
+        case HYUN_APP_CODEC_DELTA:
+            Ref = HYUN_APP_CodecZeros;
+            if ((Frame->Flags & HYUN_APP_CODEC_FLAG_KEY) == 0)
+            {
+                if (!Stream->RefValid || Stream->RefLength != Len)
+                {
+                    return HYUN_APP_CODEC_ERR_SYNC;
+                }
+                Ref = Stream->Ref;
+            }
+            if (HYUN_APP_DeltaDecode(Ref, Frame->Data, Frame->Length, Payload, Len) != Frame->Length)
+            {
+                Stream->RefValid = false;
+                return HYUN_APP_CODEC_ERR_DATA;
+            }
+            break;
+
+        case HYUN_APP_CODEC_LZ:
+            if (HYUN_APP_LzDecode(Frame->Data, Frame->Length, Payload, Len) != Len)
+            {
+                return HYUN_APP_CODEC_ERR_DATA;
+            }
+            break;
+
+        default:
+            return HYUN_APP_CODEC_ERR_DATA;
+    }
+
+    memcpy(Stream->Ref, Payload, Len);
+    Stream->RefLength = (uint16)Len;
+    Stream->RefValid  = true;
+
+    return HYUN_APP_CODEC_SUCCESS;
+
+} /* End of HYUN_APP_CodecDecodeFrame() */
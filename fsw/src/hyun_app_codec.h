@@ -0,0 +1,113 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Downlink payload codecs
+ *
+ *   - DELTA : the payload is split into little-endian 32-bit words, each
+ *             word is differenced against the same word of the previous
+ *             frame of that MID, zigzag mapped and written as a varint.
+ *             Unchanged words cost one byte. Lossless for any layout,
+ *             floats included. Every HYUN_APP_CODEC_KEYFRAME_INTERVAL
+ *             frames the reference is all zeros so a receiver that lost
+ *             frames can resynchronise.
+ *   - LZ    : byte oriented LZ77 (LZ4 block style tokens) for text frames.
+ *
+ * Only depends on the OSAL base types so the same source builds into the
+ * host decoder under tools/.
+ */
+
+#ifndef HYUN_APP_CODEC_H
+#define HYUN_APP_CODEC_H
+
+#include "common_types.h"
+
+/***********************************************************************/
+#define HYUN_APP_CODEC_NONE  0
+#define HYUN_APP_CODEC_DELTA 1
+#define HYUN_APP_CODEC_LZ    2
+
+#define HYUN_APP_CODEC_FLAG_KEY 0x01 /* DELTA frame coded against zeros */
+
+#define HYUN_APP_CODEC_SUCCESS    0
+#define HYUN_APP_CODEC_ERR_LENGTH -1 /* Payload does not fit the frame or caller buffer */
+#define HYUN_APP_CODEC_ERR_DATA   -2 /* Corrupt or truncated compressed data */
+#define HYUN_APP_CODEC_ERR_SYNC   -3 /* DELTA frame without a reference, wait for a key frame */
+
+#define HYUN_APP_CODEC_MAX_PAYLOAD        128 /* Largest payload a stream accepts */
+#define HYUN_APP_CODEC_MAX_DATA           160 /* Worst case DELTA is 5 bytes per 4 */
+#define HYUN_APP_CODEC_KEYFRAME_INTERVAL  16
+
+#define HYUN_APP_LZ_MIN_MATCH  4
+#define HYUN_APP_LZ_HASH_BITS  10
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+/*
+** Compressed frame as carried in the downlink packet. RawLength is the
+** payload size of the original packet, Length the bytes used in Data.
+*/
+typedef struct
+{
+    uint16 MsgId;
+    uint8  Codec;
+    uint8  Flags;
+    uint16 RawLength;
+    uint16 Length;
+    uint16 Seq;
+    uint8  spare[2];
+    uint8  Data[HYUN_APP_CODEC_MAX_DATA];
+} HYUN_APP_CodecFrame_t;
+
+/*
+** Per-MID coder state, used the same way on both ends of the link
+*/
+typedef struct
+{
+    uint16 MsgId;
+    uint8  Codec;
+    bool   RefValid; /* Decoder only: false until a key frame arrives */
+    uint16 Seq;
+    uint16 RefLength;
+    uint8  Ref[HYUN_APP_CODEC_MAX_PAYLOAD];
+} HYUN_APP_CodecStream_t;
+
+/****************************************************************************/
+/*
+** Codec prototypes
+*/
+size_t HYUN_APP_DeltaEncode(const uint8 *Ref, const uint8 *In, size_t Len, uint8 *Out, size_t OutSize);
+size_t HYUN_APP_DeltaDecode(const uint8 *Ref, const uint8 *In, size_t InLen, uint8 *Out, size_t OutLen);
+size_t HYUN_APP_LzEncode(const uint8 *In, size_t Len, uint8 *Out, size_t OutSize);
+size_t HYUN_APP_LzDecode(const uint8 *In, size_t InLen, uint8 *Out, size_t OutSize);
+
+void  HYUN_APP_CodecStreamInit(HYUN_APP_CodecStream_t *Stream, uint16 MsgId, uint8 Codec);
+int32 HYUN_APP_CodecEncodeFrame(HYUN_APP_CodecStream_t *Stream, const uint8 *Payload, size_t Len,
+                                HYUN_APP_CodecFrame_t *Frame);
+int32 HYUN_APP_CodecDecodeFrame(HYUN_APP_CodecStream_t *Stream, const HYUN_APP_CodecFrame_t *Frame, uint8 *Payload,
+                                size_t PayloadSize);
+
+#endif /* HYUN_APP_CODEC_H */
@@ -0,0 +1,88 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_counters.c
+**
+** Purpose:
+**   Aggregation and reset of the per-task command counter shards.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "hyun_app_counters.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_CountersInit -- Clear all shards and the baseline      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_CountersInit(HYUN_APP_Counters_t *Counters)
+{
+    memset(Counters, 0, sizeof(*Counters));
+
+} /* End of HYUN_APP_CountersInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_CountersSum                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Counts since the last reset, summed over all shards. Shards are    */
+/*         read without locking; each is a naturally aligned 32-bit word      */
+/*         with a single writer, so a read sees either the old or new value.  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HYUN_APP_CountersSum(const HYUN_APP_Counters_t *Counters, uint32 *CmdCounter, uint32 *ErrCounter)
+{
+    uint32 Cmd = 0;
+    uint32 Err = 0;
+    uint32 i;
+
+    for (i = 0; i < HYUN_APP_MAX_TASKS; i++)
+    {
+        Cmd += Counters->Shard[i].CmdCounter;
+        Err += Counters->Shard[i].ErrCounter;
+    }
+
+    /* Unsigned wrap keeps the difference right across overflow */
+    *CmdCounter = Cmd - Counters->CmdBase;
+    *ErrCounter = Err - Counters->ErrBase;
+
+} /* End of HYUN_APP_CountersSum() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_CountersReset -- Restart the reported counts at zero   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_CountersReset(HYUN_APP_Counters_t *Counters)
+{
+    uint32 Cmd;
+    uint32 Err;
+
+    HYUN_APP_CountersSum(Counters, &Cmd, &Err);
+
+    Counters->CmdBase += Cmd;
+    Counters->ErrBase += Err;
+
+} /* End of HYUN_APP_CountersReset() */
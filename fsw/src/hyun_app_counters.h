@@ -0,0 +1,87 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Per-task command counter shards
+ *
+ * Every task that handles commands counts into its own shard, and each
+ * shard fills a whole cache line, so tasks on different cores never
+ * write to a shared line. HK reports the sum over all shards. A counter
+ * reset only moves a baseline, which keeps every shard single-writer.
+ *
+ * Only depends on the OSAL base types so the same source builds into the
+ * host benchmark under tools/.
+ */
+
+#ifndef HYUN_APP_COUNTERS_H
+#define HYUN_APP_COUNTERS_H
+
+#include "common_types.h"
+
+/***********************************************************************/
+#define HYUN_APP_CACHE_LINE 64
+
+#if defined(__GNUC__)
+#define HYUN_APP_CACHE_ALIGNED __attribute__((aligned(HYUN_APP_CACHE_LINE)))
+#else
+#define HYUN_APP_CACHE_ALIGNED
+#endif
+
+/*
+** Tasks owning a counter shard
+*/
+#define HYUN_APP_TASK_MAIN 0 /* Command / HK task */
+#define HYUN_APP_TASK_DATA 1 /* Sensor data task, requests it executes */
+#define HYUN_APP_MAX_TASKS 4
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    uint32 CmdCounter;
+    uint32 ErrCounter;
+} HYUN_APP_CACHE_ALIGNED HYUN_APP_CounterShard_t;
+
+typedef struct
+{
+    HYUN_APP_CounterShard_t Shard[HYUN_APP_MAX_TASKS];
+
+    /*
+    ** Sums at the last reset, only written by the main task
+    */
+    uint32 CmdBase;
+    uint32 ErrBase;
+} HYUN_APP_Counters_t;
+
+/****************************************************************************/
+/*
+** Counter prototypes
+*/
+void HYUN_APP_CountersInit(HYUN_APP_Counters_t *Counters);
+void HYUN_APP_CountersSum(const HYUN_APP_Counters_t *Counters, uint32 *CmdCounter, uint32 *ErrCounter);
+void HYUN_APP_CountersReset(HYUN_APP_Counters_t *Counters);
+
+#endif /* HYUN_APP_COUNTERS_H */
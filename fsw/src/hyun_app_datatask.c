@@ -0,0 +1,406 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_datatask.c
+**
+** Purpose:
+**   Child task owning HYUN_PIPE_1 and all state fed from it, decoupled
+**   from the command task by two lock-free handoff queues and an HK
+**   snapshot.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "hyun_app_events.h"
+#include "hyun_app.h"
+#include "hyun_app_datatask.h"
+
+/*
+** Both record types have to fit a handoff slot
+*/
+CompileTimeAssert(sizeof(HYUN_APP_DataReq_t) <= HYUN_APP_HANDOFF_SLOT_SIZE, HYUN_APP_DataReqTooLarge);
+CompileTimeAssert(sizeof(HYUN_APP_DataTlm_t) <= HYUN_APP_HANDOFF_SLOT_SIZE, HYUN_APP_DataTlmTooLarge);
+
+/*
+** The housekeeping packet has to fit a pool buffer
+*/
+CompileTimeAssert(sizeof(HYUN_APP_HkTlm_t) <= HYUN_APP_POOL_SLOT_SIZE, HYUN_APP_HkTlmTooLarge);
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_DataTaskInit                                              */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Empty both handoff queues and start the task. HYUN_PIPE_1 must     */
+/*         already exist.                                                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_DataTaskInit(void)
+{
+    HYUN_APP_DataTask_t *Data = &HYUN_APP_Data.DataTask;
+    int32                status;
+
+    memset(Data, 0, sizeof(*Data));
+    HYUN_APP_HandoffInit(&Data->Request);
+    HYUN_APP_HandoffInit(&Data->Tlm);
+
+    status = CFE_ES_CreateChildTask(&Data->TaskId, HYUN_APP_DATA_TASK_NAME, HYUN_APP_DataTask,
+                                    CFE_ES_TASK_STACK_ALLOCATE, HYUN_APP_DATA_STACK_SIZE, HYUN_APP_DATA_PRIORITY,
+                                    0);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("Hyun_app: Error creating data task, RC = 0x%08lX\n", (unsigned long)status);
+    }
+
+    return (status);
+
+} /* End of HYUN_APP_DataTaskInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_DataRequest -- Queue a request, main task. Never       */
+/* waits; false when the data task is DEPTH requests behind.       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool HYUN_APP_DataRequest(const HYUN_APP_DataReq_t *Req)
+{
+    if (!HYUN_APP_HandoffPut(&HYUN_APP_Data.DataTask.Request, Req, sizeof(*Req)))
+    {
+        CFE_EVS_SendEvent(HYUN_APP_DATA_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "Data task request %u refused, %u still queued", (unsigned int)Req->Code,
+                          (unsigned int)HYUN_APP_HANDOFF_DEPTH);
+        return false;
+    }
+
+    return true;
+
+} /* End of HYUN_APP_DataRequest() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_DataPostTlm -- Hand a pool buffer to the downlink,     */
+/* main task. The buffer is the data task's until it is released;  */
+/* a refused one goes straight back and counts in the DropCounter. */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 HYUN_APP_DataPostTlm(HYUN_APP_MsgPool_t *Pool, CFE_MSG_Message_t *MsgPtr)
+{
+    HYUN_APP_DataTlm_t Ref;
+
+    Ref.Pool   = Pool;
+    Ref.MsgPtr = MsgPtr;
+
+    if (!HYUN_APP_HandoffPut(&HYUN_APP_Data.DataTask.Tlm, &Ref, sizeof(Ref)))
+    {
+        HYUN_APP_PoolRelease(Pool, MsgPtr);
+        return CFE_SB_BUF_ALOC_ERR;
+    }
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_DataPostTlm() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_DataExecute                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Run one request against data task state. Requests count in the     */
+/*         data task's shard, where their outcome is known.                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+static void HYUN_APP_DataExecute(const HYUN_APP_DataReq_t *Req)
+{
+    HYUN_APP_CounterShard_t *Shard = &HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_DATA];
+    char                     Filename[HYUN_APP_REPLAY_PATH_LEN];
+
+    switch (Req->Code)
+    {
+        case HYUN_APP_DATA_REQ_SIMP:
+            HYUN_APP_SensorPushBaro(Req->TimeUs, Req->Pressure);
+            Shard->CmdCounter++;
+            break;
+
+        case HYUN_APP_DATA_REQ_CAL:
+            /* The main task checked its snapshot, but the flight may have moved on since */
+            if (HYUN_APP_Data.Flight.State != HYUN_APP_FLIGHT_LAUNCH_WAIT)
+            {
+                Shard->ErrCounter++;
+                CFE_EVS_SendEvent(HYUN_APP_UPLINK_ERR_EID, CFE_EVS_EventType_ERROR, "Uplink: CAL after launch");
+                break;
+            }
+
+            /* Ground reference is latched again from the next estimate */
+            HYUN_APP_Data.Flight.GroundValid = false;
+            HYUN_APP_Data.Flight.MaxAltitude = 0.0f;
+            Shard->CmdCounter++;
+            break;
+
+        case HYUN_APP_DATA_REQ_REPLAY_START:
+            strncpy(Filename, Req->Filename, sizeof(Filename) - 1);
+            Filename[sizeof(Filename) - 1] = '\0';
+
+            if (HYUN_APP_ReplayStart(Filename, Req->Speed, Req->PeriodMs) != CFE_SUCCESS)
+            {
+                Shard->ErrCounter++;
+                break;
+            }
+            Shard->CmdCounter++;
+            break;
+
+        case HYUN_APP_DATA_REQ_REPLAY_STOP:
+            HYUN_APP_ReplayStop("stopped by command");
+            Shard->CmdCounter++;
+            break;
+
+        case HYUN_APP_DATA_REQ_FILE_START:
+            strncpy(Filename, Req->Filename, sizeof(Filename) - 1);
+            Filename[sizeof(Filename) - 1] = '\0';
+
+            if (HYUN_APP_FileStart(Req->TransferId, Filename, Req->Offset) != CFE_SUCCESS)
+            {
+                Shard->ErrCounter++;
+                break;
+            }
+            Shard->CmdCounter++;
+            break;
+
+        case HYUN_APP_DATA_REQ_FILE_ACK:
+            if (HYUN_APP_FileAck(Req->TransferId, Req->AckSeq, Req->SackMask) != CFE_SUCCESS)
+            {
+                Shard->ErrCounter++;
+                break;
+            }
+            Shard->CmdCounter++;
+            break;
+
+        case HYUN_APP_DATA_REQ_FILE_CANCEL:
+            if (HYUN_APP_FileCancel(Req->TransferId) != CFE_SUCCESS)
+            {
+                Shard->ErrCounter++;
+                break;
+            }
+            Shard->CmdCounter++;
+            break;
+
+        default:
+            Shard->ErrCounter++;
+            break;
+    }
+
+} /* End of HYUN_APP_DataExecute() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_DataStatusPublish                                         */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Refresh the HK snapshot from data task state. StatusSeq goes odd   */
+/*         before the first field is written and even again after the last,   */
+/*         so a reader can tell a copy that overlapped the update.            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+static void HYUN_APP_DataStatusPublish(void)
+{
+    HYUN_APP_DataTask_t   *Data   = &HYUN_APP_Data.DataTask;
+    HYUN_APP_DataStatus_t *Status = &Data->Status;
+    uint32                 Seq    = Data->StatusSeq;
+    uint32                 i;
+
+    __atomic_store_n(&Data->StatusSeq, Seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    Status->SensorMsgCounter      = HYUN_APP_Data.Sensor.MsgCounter;
+    Status->SensorDropCounter     = HYUN_APP_Data.Sensor.DropCounter;
+    Status->SensorErrCounter      = HYUN_APP_Data.Sensor.ErrCounter;
+    Status->SensorLastBatch       = HYUN_APP_Data.Sensor.LastBatch;
+    Status->GpsSentenceCounter    = HYUN_APP_Data.Sensor.Nmea.SentenceCounter;
+    Status->GpsChecksumErrCounter = (uint16)HYUN_APP_Data.Sensor.Nmea.ChecksumErrCounter;
+    Status->GpsFormatErrCounter   = (uint16)HYUN_APP_Data.Sensor.Nmea.FormatErrCounter;
+    Status->BaroSpread            = HYUN_APP_Data.Sensor.BaroSpread;
+    Status->Voltage               = HYUN_APP_Data.Sensor.VoltageEma.Value;
+
+    Status->DownlinkInBytes   = HYUN_APP_Data.Downlink.InBytes;
+    Status->DownlinkOutBytes  = HYUN_APP_Data.Downlink.OutBytes;
+    Status->DownlinkSentBytes = HYUN_APP_Data.Downlink.SentBytes;
+    for (i = 0; i < HYUN_APP_DOWNLINK_CLASSES; i++)
+    {
+        Status->DownlinkQueueDepth[i] =
+            (uint16)(HYUN_APP_Data.Downlink.Queue[i].Head - HYUN_APP_Data.Downlink.Queue[i].Tail);
+        Status->DownlinkQueueHighWater[i] = HYUN_APP_Data.Downlink.Queue[i].HighWater;
+        Status->DownlinkDropCounter[i]    = HYUN_APP_Data.Downlink.Queue[i].DropCounter;
+    }
+
+    Status->XbeeFrameCounter      = HYUN_APP_Data.Downlink.Xbee.FrameCounter;
+    Status->XbeeDropCounter       = HYUN_APP_Data.Downlink.Xbee.DropCounter;
+    Status->XbeeFramesPerSec      = (uint16)HYUN_APP_Data.Downlink.Xbee.FramesPerSec;
+    Status->XbeeBytesPerSec       = (uint16)HYUN_APP_Data.Downlink.Xbee.BytesPerSec;
+    Status->XbeeBudgetBytesPerSec = (uint16)HYUN_APP_XbeeBudget(&HYUN_APP_Data.Downlink.Xbee);
+    Status->XbeeOverBudgetCounter = (uint16)HYUN_APP_Data.Downlink.Xbee.OverBudgetCounter;
+
+    Status->ReplaySampleCounter = HYUN_APP_Data.Replay.SampleCounter;
+    Status->CdsCommitCounter    = HYUN_APP_Data.Cds.CommitCounter;
+    Status->RecordCounter       = HYUN_APP_Data.Record.RecordCounter;
+    Status->RecordDropCounter   = HYUN_APP_Data.Record.DropCounter;
+    Status->RecordBytes = (uint32)(HYUN_APP_Data.Record.Block.Entry.Offset - HYUN_APP_Data.Record.StartOffset);
+
+    Status->FileTransferId     = HYUN_APP_Data.File.Active ? HYUN_APP_Data.File.TransferId : 0;
+    Status->FileAckedBytes     = HYUN_APP_Data.File.Win.AckSeq * HYUN_APP_FILE_CHUNK_SIZE;
+    Status->FileResendCounter  = (uint16)HYUN_APP_Data.File.ResendCounter;
+    Status->FileTimeoutCounter = (uint16)HYUN_APP_Data.File.TimeoutCounter;
+
+    /* The last chunk is short */
+    if (Status->FileAckedBytes > HYUN_APP_Data.File.FileSize)
+    {
+        Status->FileAckedBytes = HYUN_APP_Data.File.FileSize;
+    }
+
+    Status->FlightState = HYUN_APP_Data.Flight.State;
+
+    __atomic_store_n(&Data->StatusSeq, Seq + 2, __ATOMIC_RELEASE);
+
+} /* End of HYUN_APP_DataStatusPublish() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_DataStatusGet                                             */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Copy the HK snapshot, any task but the data task. The data task    */
+/*         runs at a lower priority and may be preempted mid-update, so the   */
+/*         read is retried a few times only; false leaves *Status undefined  */
+/*         and the caller keeps the copy it had.                              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+bool HYUN_APP_DataStatusGet(HYUN_APP_DataStatus_t *Status)
+{
+    HYUN_APP_DataTask_t *Data = &HYUN_APP_Data.DataTask;
+    uint32               Begin;
+    uint32               End;
+    uint32               Try;
+
+    for (Try = 0; Try < HYUN_APP_DATA_STATUS_TRIES; Try++)
+    {
+        Begin = __atomic_load_n(&Data->StatusSeq, __ATOMIC_ACQUIRE);
+        if (Begin & 1u)
+        {
+            continue;
+        }
+
+        memcpy(Status, &Data->Status, sizeof(*Status));
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        End = __atomic_load_n(&Data->StatusSeq, __ATOMIC_RELAXED);
+        if (End == Begin)
+        {
+            return true;
+        }
+    }
+
+    return false;
+
+} /* End of HYUN_APP_DataStatusGet() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_DataTask                                                  */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Task entry. Each cycle runs the queued requests, waits on          */
+/*         HYUN_PIPE_1 and processes the batch, forwards the main task's      */
+/*         packets to the downlink and services it, then commits the CDS,     */
+/*         applies sensor subscription changes and publishes the HK snapshot. */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HYUN_APP_DataTask(void)
+{
+    HYUN_APP_DataTask_t      *Data = &HYUN_APP_Data.DataTask;
+    const HYUN_APP_DataTlm_t *Tlm;
+    const void               *Record;
+    size_t                    Size;
+    int32                     status;
+
+    /*
+    ** Recording is optional, the task runs without it
+    */
+    HYUN_APP_RecordOpen();
+
+    while (HYUN_APP_Data.RunStatus == CFE_ES_RunStatus_APP_RUN)
+    {
+        CFE_ES_PerfLogEntry(HYUN_APP_DATA_PERF_ID);
+
+        while ((Record = HYUN_APP_HandoffPeek(&Data->Request, &Size)) != NULL)
+        {
+            HYUN_APP_DataExecute((const HYUN_APP_DataReq_t *)Record);
+            HYUN_APP_HandoffRelease(&Data->Request);
+            Data->RequestCounter++;
+        }
+
+        CFE_ES_PerfLogExit(HYUN_APP_DATA_PERF_ID);
+
+        /*
+        ** The sensor cycle runs on a fixed period, shortened while a fast
+        ** SIM replay runs
+        */
+        status = HYUN_APP_SensorCycle(HYUN_APP_ReplayCycleTimeout());
+        if (status != CFE_SUCCESS)
+        {
+            Data->ErrCounter++;
+            CFE_EVS_SendEvent(HYUN_APP_DATA_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "Sensor pipe read error, RC = 0x%08lX", (unsigned long)status);
+
+            /* Do not spin on a pipe that fails at once */
+            OS_TaskDelay(HYUN_APP_CYCLE_TIMEOUT_MS);
+        }
+
+        CFE_ES_PerfLogEntry(HYUN_APP_DATA_PERF_ID);
+
+        while ((Record = HYUN_APP_HandoffPeek(&Data->Tlm, &Size)) != NULL)
+        {
+            /* Queued by copy, so the buffer can go back to its pool */
+            Tlm = (const HYUN_APP_DataTlm_t *)Record;
+            HYUN_APP_DownlinkSend(Tlm->MsgPtr);
+            HYUN_APP_PoolRelease(Tlm->Pool, Tlm->MsgPtr);
+            HYUN_APP_HandoffRelease(&Data->Tlm);
+        }
+
+        /*
+        ** File chunks fill in behind the telemetry, then everything
+        ** queued goes out as far as the link budget allows
+        */
+        HYUN_APP_FileService();
+
+        HYUN_APP_DownlinkService();
+
+        HYUN_APP_RecordService();
+
+        HYUN_APP_CdsUpdate();
+
+        HYUN_APP_SubApply(HYUN_APP_SUB_PIPE_SENSOR);
+
+        HYUN_APP_DataStatusPublish();
+
+        Data->CycleCounter++;
+
+        CFE_ES_PerfLogExit(HYUN_APP_DATA_PERF_ID);
+    }
+
+    CFE_ES_ExitChildTask();
+
+} /* End of HYUN_APP_DataTask() */
@@ -0,0 +1,190 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Sensor data task
+ *
+ * The app runs as two tasks. The main task owns the command pipe: it
+ * serves ground commands, HK requests and table management, and never
+ * waits on anything but that pipe. This child task owns HYUN_PIPE_1 and
+ * everything fed from it: the sensor batch, estimator, flight state,
+ * alignment, replay, the downlink queues and the CDS.
+ *
+ * The two tasks only meet at two handoff queues, both filled by the main
+ * task and drained by this one at the top of each cycle:
+ *
+ *  - Request: commands that act on data task state (SIMP, CAL, replay
+ *    and file downlink). They are executed here, in order.
+ *  - Tlm: packets built by the main task (HK, rcvtest) for the downlink,
+ *    which only this task touches. The record is a reference to a message
+ *    pool buffer; this task puts the buffer back once the packet is queued.
+ *
+ * A full queue refuses the request at once, so however saturated the
+ * sensor pipe is, a command never waits for the data task. Mode words
+ * (CX, SIM, ST) stay plain single-word stores by the main task.
+ *
+ * In the other direction, the data task publishes its counters and
+ * state for HK as one snapshot at the end of every cycle, guarded by a
+ * sequence count. The main task copies the snapshot out and never reads
+ * data task state directly, so it cannot see a torn 64-bit value or a
+ * half-updated queue.
+ */
+
+#ifndef HYUN_APP_DATATASK_H
+#define HYUN_APP_DATATASK_H
+
+#include "cfe.h"
+#include "hyun_app_msg.h"
+#include "hyun_app_handoff.h"
+#include "hyun_app_pool.h"
+#include "hyun_app_replay.h"
+
+/***********************************************************************/
+#define HYUN_APP_DATA_TASK_NAME  "HYUN_DATA"
+#define HYUN_APP_DATA_STACK_SIZE 32768 /* Estimator, alignment and codecs run here */
+#define HYUN_APP_DATA_PRIORITY   110   /* Below the main task and the UDP tasks */
+
+#define HYUN_APP_DATA_STATUS_TRIES 3 /* Snapshot reads before the main task keeps its last copy */
+
+/*
+** Requests, HYUN_APP_DataReq_t.Code
+*/
+#define HYUN_APP_DATA_REQ_SIMP         1 /* Push Pressure as a simulated baro sample */
+#define HYUN_APP_DATA_REQ_CAL          2 /* Latch the ground reference again */
+#define HYUN_APP_DATA_REQ_REPLAY_START 3
+#define HYUN_APP_DATA_REQ_REPLAY_STOP  4
+#define HYUN_APP_DATA_REQ_FILE_START   5
+#define HYUN_APP_DATA_REQ_FILE_ACK     6
+#define HYUN_APP_DATA_REQ_FILE_CANCEL  7
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    uint16 Code; /* HYUN_APP_DATA_REQ_xxx */
+    uint16 Speed;
+    uint16 PeriodMs;
+    uint16 spare;
+    float  Pressure; /* [Pa] */
+    uint64 TimeUs;   /* When the main task accepted the command */
+    uint32 TransferId;
+    uint32 Offset;
+    uint32 AckSeq;
+    uint32 SackMask;
+    char   Filename[HYUN_APP_REPLAY_PATH_LEN];
+} HYUN_APP_DataReq_t;
+
+/*
+** Tlm record: a pool buffer holding a packet, and the pool it goes back to
+*/
+typedef struct
+{
+    HYUN_APP_MsgPool_t *Pool;
+    CFE_MSG_Message_t  *MsgPtr;
+} HYUN_APP_DataTlm_t;
+
+/*
+** Data task counters and state reported in HK
+*/
+typedef struct
+{
+    uint32 SensorMsgCounter;
+    uint32 SensorDropCounter;
+    uint16 SensorErrCounter;
+    uint16 SensorLastBatch;
+    uint32 GpsSentenceCounter;
+    uint16 GpsChecksumErrCounter;
+    uint16 GpsFormatErrCounter;
+    float  BaroSpread;
+    float  Voltage;
+
+    uint32 DownlinkInBytes;
+    uint32 DownlinkOutBytes;
+    uint32 DownlinkSentBytes;
+    uint16 DownlinkQueueDepth[HYUN_APP_DOWNLINK_CLASSES];
+    uint16 DownlinkQueueHighWater[HYUN_APP_DOWNLINK_CLASSES];
+    uint32 DownlinkDropCounter[HYUN_APP_DOWNLINK_CLASSES];
+
+    uint32 XbeeFrameCounter;
+    uint32 XbeeDropCounter;
+    uint16 XbeeFramesPerSec;
+    uint16 XbeeBytesPerSec;
+    uint16 XbeeBudgetBytesPerSec;
+    uint16 XbeeOverBudgetCounter;
+
+    uint32 ReplaySampleCounter;
+    uint32 CdsCommitCounter;
+    uint32 RecordCounter;
+    uint32 RecordDropCounter;
+    uint32 RecordBytes; /* Archive data written this run */
+
+    uint32 FileTransferId; /* 0 = none */
+    uint32 FileAckedBytes;
+    uint16 FileResendCounter;
+    uint16 FileTimeoutCounter;
+
+    uint8 FlightState;
+    uint8 spare[3];
+} HYUN_APP_DataStatus_t;
+
+typedef struct
+{
+    CFE_ES_TaskId_t TaskId;
+
+    HYUN_APP_Handoff_t Request; /* Main task to data task, HYUN_APP_DataReq_t */
+    HYUN_APP_Handoff_t Tlm;     /* Main task to data task, HYUN_APP_DataTlm_t */
+
+    /*
+    ** Written by the data task only
+    */
+    uint32 RequestCounter;
+    uint32 CycleCounter;
+    uint32 ErrCounter; /* Sensor pipe errors */
+
+    /*
+    ** HK snapshot, written by the data task only. StatusSeq is odd while
+    ** Status is being rewritten.
+    */
+    uint32                StatusSeq HYUN_APP_CACHE_ALIGNED;
+    HYUN_APP_DataStatus_t Status;
+
+    /*
+    ** Last consistent copy, main task only
+    */
+    HYUN_APP_DataStatus_t StatusCopy HYUN_APP_CACHE_ALIGNED;
+} HYUN_APP_DataTask_t;
+
+/****************************************************************************/
+/*
+** Data task prototypes
+*/
+int32 HYUN_APP_DataTaskInit(void);
+bool  HYUN_APP_DataRequest(const HYUN_APP_DataReq_t *Req);
+int32 HYUN_APP_DataPostTlm(HYUN_APP_MsgPool_t *Pool, CFE_MSG_Message_t *MsgPtr);
+bool  HYUN_APP_DataStatusGet(HYUN_APP_DataStatus_t *Status);
+void  HYUN_APP_DataTask(void);
+
+#endif /* HYUN_APP_DATATASK_H */
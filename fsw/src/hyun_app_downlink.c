@@ -0,0 +1,370 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_downlink.c
+**
+** Purpose:
+**   Per-MID compression and bandwidth-budgeted scheduling of downlink
+**   telemetry.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <stddef.h>
+#include <string.h>
+
+#include "hyun_app_events.h"
+#include "hyun_app.h"
+#include "hyun_app_downlink.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_DownlinkInit -- No codecs and no pacing until the     */
+/* table is loaded                                                 */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_DownlinkInit(void)
+{
+    memset(&HYUN_APP_Data.Downlink, 0, sizeof(HYUN_APP_Data.Downlink));
+
+    HYUN_APP_Data.Downlink.LastRefillUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+
+    HYUN_APP_XbeeInit(&HYUN_APP_Data.Downlink.Xbee);
+    HYUN_APP_Data.Downlink.Xbee.WindowStartUs = HYUN_APP_Data.Downlink.LastRefillUs;
+
+    CFE_MSG_Init(&HYUN_APP_Data.CompressedTlm.TlmHeader.Msg, HYUN_APP_MID_COMPRESSED_TLM,
+                 sizeof(HYUN_APP_Data.CompressedTlm));
+
+} /* End of HYUN_APP_DownlinkInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_DownlinkConfig                                            */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Follow the table codec selection and link budget. Only streams     */
+/*         whose entry changed are reset, which also restarts them with a     */
+/*         key frame.                                                         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+void HYUN_APP_DownlinkConfig(const HYUN_APP_Table_t *TblPtr)
+{
+    HYUN_APP_DownlinkData_t *Downlink = &HYUN_APP_Data.Downlink;
+    HYUN_APP_CodecStream_t  *Stream;
+    uint32                   i;
+
+    Downlink->BytesPerSec = TblPtr->LinkBytesPerSec;
+    Downlink->BurstBytes  = TblPtr->LinkBurstBytes;
+
+    if (Downlink->Credit > (uint64)Downlink->BurstBytes * 1000000u)
+    {
+        Downlink->Credit = (uint64)Downlink->BurstBytes * 1000000u;
+    }
+
+    for (i = 0; i < HYUN_APP_DOWNLINK_MAX_STREAMS; i++)
+    {
+        Stream = &Downlink->Stream[i];
+
+        if (Stream->MsgId != TblPtr->DownlinkCodec[i].MsgId || Stream->Codec != TblPtr->DownlinkCodec[i].Codec)
+        {
+            HYUN_APP_CodecStreamInit(Stream, TblPtr->DownlinkCodec[i].MsgId, TblPtr->DownlinkCodec[i].Codec);
+        }
+    }
+
+    HYUN_APP_DownlinkXbeeConfig(TblPtr);
+
+} /* End of HYUN_APP_DownlinkConfig() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_DownlinkXbeeConfig -- Reopen the radio port when its   */
+/* table settings change. A failed open is not retried until the   */
+/* next change.                                                    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_DownlinkXbeeConfig(const HYUN_APP_Table_t *TblPtr)
+{
+    HYUN_APP_DownlinkData_t *Downlink = &HYUN_APP_Data.Downlink;
+    uint64                   Dest64   = ((uint64)TblPtr->XbeeDestHigh << 32) | TblPtr->XbeeDestLow;
+    int32                    status;
+
+    if (strncmp(Downlink->XbeeDevice, TblPtr->XbeeDevice, sizeof(Downlink->XbeeDevice)) == 0 &&
+        Downlink->XbeeBaud == TblPtr->XbeeBaud && Downlink->XbeeDest64 == Dest64)
+    {
+        return;
+    }
+
+    strncpy(Downlink->XbeeDevice, TblPtr->XbeeDevice, sizeof(Downlink->XbeeDevice) - 1);
+    Downlink->XbeeDevice[sizeof(Downlink->XbeeDevice) - 1] = 0;
+    Downlink->XbeeBaud                                     = TblPtr->XbeeBaud;
+    Downlink->XbeeDest64                                   = Dest64;
+
+    if (Downlink->XbeeDevice[0] == 0)
+    {
+        HYUN_APP_XbeeClose(&Downlink->Xbee);
+        return;
+    }
+
+    status = HYUN_APP_XbeeOpen(&Downlink->Xbee, Downlink->XbeeDevice, Downlink->XbeeBaud, Dest64);
+    if (status != HYUN_APP_XBEE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(HYUN_APP_XBEE_ERR_EID, CFE_EVS_EventType_ERROR, "XBee: cannot open %s at %lu baud, RC = %ld",
+                          Downlink->XbeeDevice, (unsigned long)Downlink->XbeeBaud, (long)status);
+        return;
+    }
+
+    CFE_EVS_SendEvent(HYUN_APP_XBEE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "XBee: %s at %lu baud, %lu B/s budget, dest 0x%08lX%08lX", Downlink->XbeeDevice,
+                      (unsigned long)Downlink->XbeeBaud, (unsigned long)HYUN_APP_XbeeBudget(&Downlink->Xbee),
+                      (unsigned long)TblPtr->XbeeDestHigh, (unsigned long)TblPtr->XbeeDestLow);
+
+} /* End of HYUN_APP_DownlinkXbeeConfig() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_DownlinkSend                                              */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Queue a telemetry packet for the radio, compressed if its MID has  */
+/*         a codec, and release whatever the link budget allows. The wrapper  */
+/*         keeps the time stamp and priority class of the original packet.   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 HYUN_APP_DownlinkSend(CFE_MSG_Message_t *MsgPtr)
+{
+    HYUN_APP_DownlinkData_t *Downlink = &HYUN_APP_Data.Downlink;
+    HYUN_APP_CompressedTlm_t *Tlm     = &HYUN_APP_Data.CompressedTlm;
+    HYUN_APP_CodecStream_t   *Stream  = NULL;
+    CFE_SB_MsgId_t            MsgId   = CFE_SB_INVALID_MSG_ID;
+    CFE_TIME_SysTime_t        Time    = {0, 0};
+    size_t                    Size    = 0;
+    uint8                     Class;
+    int32                     Status;
+    uint32                    i;
+
+    /* Archived as generated, ahead of compression and link pacing */
+    HYUN_APP_RecordPacket(MsgPtr);
+
+    CFE_MSG_GetMsgId(MsgPtr, &MsgId);
+    Class = HYUN_APP_DownlinkClass(MsgId);
+
+    for (i = 0; i < HYUN_APP_DOWNLINK_MAX_STREAMS; i++)
+    {
+        if (Downlink->Stream[i].Codec != HYUN_APP_CODEC_NONE &&
+            Downlink->Stream[i].MsgId == CFE_SB_MsgIdToValue(MsgId))
+        {
+            Stream = &Downlink->Stream[i];
+            break;
+        }
+    }
+
+    CFE_MSG_GetSize(MsgPtr, &Size);
+    if (Stream != NULL && Size >= sizeof(CFE_MSG_TelemetryHeader_t) &&
+        HYUN_APP_CodecEncodeFrame(Stream, (const uint8 *)MsgPtr + sizeof(CFE_MSG_TelemetryHeader_t),
+                                  Size - sizeof(CFE_MSG_TelemetryHeader_t), &Tlm->Payload) == HYUN_APP_CODEC_SUCCESS)
+    {
+        Downlink->InBytes += Tlm->Payload.RawLength;
+        Downlink->OutBytes += Tlm->Payload.Length;
+
+        CFE_MSG_GetMsgTime(MsgPtr, &Time);
+        CFE_MSG_SetMsgTime(&Tlm->TlmHeader.Msg, Time);
+        CFE_MSG_SetSize(&Tlm->TlmHeader.Msg, offsetof(HYUN_APP_CompressedTlm_t, Payload.Data) + Tlm->Payload.Length);
+
+        MsgPtr = &Tlm->TlmHeader.Msg;
+    }
+    else if (Stream != NULL)
+    {
+        /* Too large for a codec frame, send it as it is */
+        Downlink->ErrCounter++;
+    }
+
+    Status = HYUN_APP_DownlinkEnqueue(MsgPtr, Class);
+
+    HYUN_APP_DownlinkService();
+
+    return Status;
+
+} /* End of HYUN_APP_DownlinkSend() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_DownlinkClass -- Priority class of a telemetry MID     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint8 HYUN_APP_DownlinkClass(CFE_SB_MsgId_t MsgId)
+{
+    switch (CFE_SB_MsgIdToValue(MsgId))
+    {
+        case HYUN_APP_MID_ESTIMATE_TLM:
+        case HYUN_APP_MID_ALIGNED_TLM:
+            return HYUN_APP_DOWNLINK_CRITICAL;
+
+        case HYUN_APP_MID_HOUSEKEEPING_RES:
+        case HYUN_APP_MID_TTAG_LIST_TLM:
+            return HYUN_APP_DOWNLINK_HK;
+
+        case HYUN_APP_MID_FILE_DATA_TLM:
+            return HYUN_APP_DOWNLINK_FILE;
+
+        default:
+            return HYUN_APP_DOWNLINK_DEBUG;
+    }
+
+} /* End of HYUN_APP_DownlinkClass() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_DownlinkEnqueue                                           */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Copy a packet into its class queue. A full queue gives up its      */
+/*         oldest packet; for a compressed stream the ground decoder then     */
+/*         resynchronizes at the next key frame.                              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 HYUN_APP_DownlinkEnqueue(const CFE_MSG_Message_t *MsgPtr, uint8 Class)
+{
+    HYUN_APP_DownlinkData_t  *Downlink = &HYUN_APP_Data.Downlink;
+    HYUN_APP_DownlinkQueue_t *Queue;
+    size_t                    Size = 0;
+    uint32                    Index;
+
+    CFE_MSG_GetSize(MsgPtr, &Size);
+    if (Size > HYUN_APP_DOWNLINK_SLOT_SIZE || Class >= HYUN_APP_DOWNLINK_CLASSES)
+    {
+        Downlink->ErrCounter++;
+        return CFE_SB_MSG_TOO_BIG;
+    }
+
+    Queue = &Downlink->Queue[Class];
+
+    if (Queue->Head - Queue->Tail == HYUN_APP_DOWNLINK_QUEUE_DEPTH)
+    {
+        Queue->Tail++;
+        Queue->DropCounter++;
+    }
+
+    Index = HYUN_APP_RING_INDEX(Queue->Head, HYUN_APP_DOWNLINK_QUEUE_DEPTH);
+    memcpy(Queue->Slot[Index].Bytes, MsgPtr, Size);
+    Queue->Size[Index] = (uint16)Size;
+    Queue->Head++;
+
+    if (Queue->Head - Queue->Tail > Queue->HighWater)
+    {
+        Queue->HighWater = (uint16)(Queue->Head - Queue->Tail);
+    }
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_DownlinkEnqueue() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_DownlinkPending -- Packets waiting in a class queue    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32 HYUN_APP_DownlinkPending(uint8 Class)
+{
+    if (Class >= HYUN_APP_DOWNLINK_CLASSES)
+    {
+        return 0;
+    }
+
+    return HYUN_APP_Data.Downlink.Queue[Class].Head - HYUN_APP_Data.Downlink.Queue[Class].Tail;
+
+} /* End of HYUN_APP_DownlinkPending() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_DownlinkService                                           */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Refill the token bucket and transmit queued packets in strict      */
+/*         priority order while the credit lasts. A packet that does not fit  */
+/*         also holds back every lower class, so a stream of small HK or      */
+/*         debug packets can never starve critical telemetry. Called from     */
+/*         every send and once per data task cycle.                           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+void HYUN_APP_DownlinkService(void)
+{
+    HYUN_APP_DownlinkData_t  *Downlink = &HYUN_APP_Data.Downlink;
+    HYUN_APP_DownlinkQueue_t *Queue;
+    uint64                    NowUs;
+    uint64                    ElapsedUs = 0;
+    uint64                    Cost;
+    uint32                    Class = 0;
+    uint32                    Index;
+
+    NowUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+    if (NowUs > Downlink->LastRefillUs)
+    {
+        ElapsedUs = NowUs - Downlink->LastRefillUs;
+    }
+    Downlink->LastRefillUs = NowUs;
+
+    if (ElapsedUs > HYUN_APP_DOWNLINK_MAX_REFILL_US)
+    {
+        ElapsedUs = HYUN_APP_DOWNLINK_MAX_REFILL_US;
+    }
+
+    Downlink->Credit += ElapsedUs * Downlink->BytesPerSec;
+    if (Downlink->Credit > (uint64)Downlink->BurstBytes * 1000000u)
+    {
+        Downlink->Credit = (uint64)Downlink->BurstBytes * 1000000u;
+    }
+
+    while (Class < HYUN_APP_DOWNLINK_CLASSES)
+    {
+        Queue = &Downlink->Queue[Class];
+        if (Queue->Head == Queue->Tail)
+        {
+            Class++;
+            continue;
+        }
+
+        Index = HYUN_APP_RING_INDEX(Queue->Tail, HYUN_APP_DOWNLINK_QUEUE_DEPTH);
+
+        if (Downlink->BytesPerSec != 0)
+        {
+            Cost = (uint64)Queue->Size[Index] * 1000000u;
+            if (Downlink->Credit < Cost)
+            {
+                break;
+            }
+            Downlink->Credit -= Cost;
+        }
+
+        CFE_SB_TransmitMsg(&Queue->Slot[Index].Buf.Msg, true);
+
+        if (Downlink->Xbee.Fd >= 0)
+        {
+            HYUN_APP_XbeeQueue(&Downlink->Xbee, Queue->Slot[Index].Bytes, Queue->Size[Index]);
+        }
+
+        Downlink->SentBytes += Queue->Size[Index];
+        Queue->Tail++;
+    }
+
+    /*
+    ** Everything released in this call goes to the radio in one writev
+    */
+    HYUN_APP_XbeeFlush(&Downlink->Xbee);
+    HYUN_APP_XbeeRate(&Downlink->Xbee, NowUs);
+
+} /* End of HYUN_APP_DownlinkService() */
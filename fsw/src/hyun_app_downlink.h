@@ -0,0 +1,125 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Downlink telemetry path
+ *
+ * Telemetry bound for the radio goes through HYUN_APP_DownlinkSend. MIDs
+ * given a codec in the table are wrapped into HYUN_APP_MID_COMPRESSED_TLM,
+ * everything else is transmitted unchanged.
+ *
+ * Packets are copied into one queue per priority class and released to
+ * CFE_SB_TransmitMsg against a token bucket filled at the table link
+ * budget. The highest non-empty class always goes first, so HK and debug
+ * traffic only use what critical telemetry leaves. A full queue drops its
+ * oldest packet, keeping the freshest data for when the link frees up.
+ * File chunks (hyun_app_file.h) are queued directly in the lowest class,
+ * a few at a time, so they never reach a full queue.
+ *
+ * With a serial device in the table, released packets are also framed
+ * for the XBee radio and written once per service call.
+ */
+
+#ifndef HYUN_APP_DOWNLINK_H
+#define HYUN_APP_DOWNLINK_H
+
+#include "cfe.h"
+#include "hyun_app_msg.h"
+#include "hyun_app_table.h"
+#include "hyun_app_codec.h"
+#include "hyun_app_xbee.h"
+
+/***********************************************************************/
+#define HYUN_APP_DOWNLINK_QUEUE_DEPTH 16  /* Packets per class, power of two */
+#define HYUN_APP_DOWNLINK_SLOT_SIZE   256 /* Largest packet that can be queued [bytes] */
+
+#define HYUN_APP_DOWNLINK_MAX_REFILL_US 1000000 /* Idle time credited at most, bounds the burst */
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef union
+{
+    CFE_SB_Buffer_t Buf;
+    uint8           Bytes[HYUN_APP_DOWNLINK_SLOT_SIZE];
+} HYUN_APP_DownlinkSlot_t;
+
+/*
+** Head and Tail run freely like the sensor rings
+*/
+typedef struct
+{
+    uint32 Head;
+    uint32 Tail;
+    uint16 HighWater;
+    uint16 Size[HYUN_APP_DOWNLINK_QUEUE_DEPTH];
+    uint32 DropCounter;
+
+    HYUN_APP_DownlinkSlot_t Slot[HYUN_APP_DOWNLINK_QUEUE_DEPTH];
+} HYUN_APP_DownlinkQueue_t;
+
+typedef struct
+{
+    HYUN_APP_CodecStream_t Stream[HYUN_APP_DOWNLINK_MAX_STREAMS];
+
+    uint32 InBytes;  /* Payload bytes handed to a codec */
+    uint32 OutBytes; /* Payload bytes actually sent for them */
+    uint32 ErrCounter;
+
+    /*
+    ** Token bucket, credit is kept in byte-microseconds so that any
+    ** budget refills exactly without a remainder
+    */
+    uint32 BytesPerSec;
+    uint16 BurstBytes;
+    uint64 Credit;
+    uint64 LastRefillUs;
+    uint32 SentBytes;
+
+    /*
+    ** XBee output and the table settings it was opened with
+    */
+    HYUN_APP_Xbee_t Xbee;
+    char            XbeeDevice[HYUN_APP_XBEE_DEVICE_LEN];
+    uint32          XbeeBaud;
+    uint64          XbeeDest64;
+
+    HYUN_APP_DownlinkQueue_t Queue[HYUN_APP_DOWNLINK_CLASSES];
+} HYUN_APP_DownlinkData_t;
+
+/****************************************************************************/
+/*
+** Downlink prototypes
+*/
+void   HYUN_APP_DownlinkInit(void);
+void   HYUN_APP_DownlinkConfig(const HYUN_APP_Table_t *TblPtr);
+void   HYUN_APP_DownlinkXbeeConfig(const HYUN_APP_Table_t *TblPtr);
+int32  HYUN_APP_DownlinkSend(CFE_MSG_Message_t *MsgPtr);
+uint8  HYUN_APP_DownlinkClass(CFE_SB_MsgId_t MsgId);
+int32  HYUN_APP_DownlinkEnqueue(const CFE_MSG_Message_t *MsgPtr, uint8 Class);
+uint32 HYUN_APP_DownlinkPending(uint8 Class);
+void   HYUN_APP_DownlinkService(void);
+
+#endif /* HYUN_APP_DOWNLINK_H */
@@ -37,6 +37,29 @@
 #define HYUN_APP_INVALID_MSGID_ERR_EID 5
 #define HYUN_APP_LEN_ERR_EID           6
 #define HYUN_APP_PIPE_ERR_EID          7
+#define HYUN_APP_FLIGHT_STATE_INF_EID  8
+#define HYUN_APP_UPLINK_INF_EID        9
+#define HYUN_APP_UPLINK_ERR_EID        10
+#define HYUN_APP_REPLAY_INF_EID        11
+#define HYUN_APP_REPLAY_ERR_EID        12
+#define HYUN_APP_CDS_INF_EID           13
+#define HYUN_APP_CDS_ERR_EID           14
+#define HYUN_APP_TBL_LOAD_ERR_EID      15
+#define HYUN_APP_UDP_INF_EID           16
+#define HYUN_APP_UDP_ERR_EID           17
+#define HYUN_APP_XBEE_INF_EID          18
+#define HYUN_APP_XBEE_ERR_EID          19
+#define HYUN_APP_SUB_INF_EID           20
+#define HYUN_APP_SUB_ERR_EID           21
+#define HYUN_APP_DATA_ERR_EID          22
+#define HYUN_APP_TTAG_INF_EID          23
+#define HYUN_APP_TTAG_ERR_EID          24
+#define HYUN_APP_SEQ_INF_EID           25
+#define HYUN_APP_SEQ_ERR_EID           26
+#define HYUN_APP_RECORD_INF_EID        27
+#define HYUN_APP_RECORD_ERR_EID        28
+#define HYUN_APP_FILE_INF_EID          29
+#define HYUN_APP_FILE_ERR_EID          30
 
 #define HYUN_APP_EVENT_COUNTS 7
 
@@ -0,0 +1,386 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_file.c
+**
+** Purpose:
+**   Chunked file downlink. The FILE_xxx command handlers run in the main
+**   task and pass the command on to the data task, which owns the file
+**   and the downlink queues. Chunks are read with pread so a resend of
+**   any chunk costs one call; the flight computer runs Linux.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "hyun_app_events.h"
+#include "hyun_app.h"
+#include "hyun_app_file.h"
+
+CompileTimeAssert(sizeof(HYUN_APP_FileDataTlm_t) <= HYUN_APP_DOWNLINK_SLOT_SIZE, HYUN_APP_FileDataTlmTooLarge);
+CompileTimeAssert(HYUN_APP_FILE_PATH_LEN <= HYUN_APP_REPLAY_PATH_LEN, HYUN_APP_FilePathTooLong);
+CompileTimeAssert(HYUN_APP_FILE_WINDOW <= HYUN_APP_FILEWIN_MAX, HYUN_APP_FileWindowTooLarge);
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_FileInit -- No transfer and the chunk packet header    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_FileInit(void)
+{
+    HYUN_APP_File_t *File = &HYUN_APP_Data.File;
+
+    memset(File, 0, sizeof(*File));
+    File->Fd = -1;
+    CFE_MSG_Init(&File->DataTlm.TlmHeader.Msg, HYUN_APP_MID_FILE_DATA_TLM, sizeof(File->DataTlm));
+
+} /* End of HYUN_APP_FileInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_FileStart                                                 */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Open the file and start sending at Offset, data task. A transfer   */
+/*         already running is replaced. The acknowledgement timeout covers    */
+/*         a full window at the current link budget.                          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_FileStart(uint32 TransferId, const char *Path, uint32 Offset)
+{
+    HYUN_APP_File_t *File = &HYUN_APP_Data.File;
+    struct stat      Stat;
+    uint32           Chunks;
+    uint32           TimeoutUs;
+    int              Fd;
+
+    if (TransferId == 0 || Offset % HYUN_APP_FILE_CHUNK_SIZE != 0)
+    {
+        CFE_EVS_SendEvent(HYUN_APP_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "File %lu: rejected, offset %lu is not on a chunk", (unsigned long)TransferId,
+                          (unsigned long)Offset);
+        return HYUN_APP_SENSOR_INVALID_ERR_CODE;
+    }
+
+    Fd = open(Path, O_RDONLY);
+    if (Fd < 0 || fstat(Fd, &Stat) != 0 || !S_ISREG(Stat.st_mode) || Stat.st_size > (off_t)0xFFFFFFFFu ||
+        Offset > (uint32)Stat.st_size)
+    {
+        CFE_EVS_SendEvent(HYUN_APP_FILE_ERR_EID, CFE_EVS_EventType_ERROR, "File %lu: can not send %s from %lu",
+                          (unsigned long)TransferId, Path, (unsigned long)Offset);
+        if (Fd >= 0)
+        {
+            close(Fd);
+        }
+        return HYUN_APP_SENSOR_INVALID_ERR_CODE;
+    }
+
+    if (File->Active)
+    {
+        HYUN_APP_FileStop("replaced");
+    }
+
+    /* An empty file still goes out as one empty last chunk */
+    Chunks = ((uint32)Stat.st_size + HYUN_APP_FILE_CHUNK_SIZE - 1) / HYUN_APP_FILE_CHUNK_SIZE;
+    if (Chunks == 0)
+    {
+        Chunks = 1;
+    }
+
+    TimeoutUs =
+        HYUN_APP_FileWinTimeout(HYUN_APP_FILE_WINDOW, sizeof(File->DataTlm), HYUN_APP_Data.Downlink.BytesPerSec);
+
+    File->Active     = true;
+    File->Fd         = Fd;
+    File->TransferId = TransferId;
+    File->FileSize   = (uint32)Stat.st_size;
+    File->StartSeq   = Offset / HYUN_APP_FILE_CHUNK_SIZE;
+    File->StartUs    = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+
+    HYUN_APP_FileWinInit(&File->Win, Chunks, File->StartSeq, HYUN_APP_FILE_WINDOW, TimeoutUs);
+
+    CFE_EVS_SendEvent(HYUN_APP_FILE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "File %lu: %s, %lu bytes from %lu, %lu chunks, ack timeout %lu ms", (unsigned long)TransferId,
+                      Path, (unsigned long)File->FileSize, (unsigned long)Offset,
+                      (unsigned long)(Chunks - File->StartSeq), (unsigned long)(TimeoutUs / 1000u));
+
+    /*
+    ** A resume from the end of the file finds every chunk held already,
+    ** no acknowledgement would ever come to end it
+    */
+    if (HYUN_APP_FileWinDone(&File->Win))
+    {
+        HYUN_APP_FileStop("delivered");
+    }
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_FileStart() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_FileAck                                                   */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Apply a receiver report, data task. The transfer ends once every   */
+/*         chunk is acknowledged.                                             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_FileAck(uint32 TransferId, uint32 AckSeq, uint32 SackMask)
+{
+    HYUN_APP_File_t *File = &HYUN_APP_Data.File;
+
+    /*
+    ** Late reports for a finished transfer are expected, so they are
+    ** only counted
+    */
+    if (!File->Active || TransferId != File->TransferId)
+    {
+        File->StaleCounter++;
+        return CFE_SUCCESS;
+    }
+
+    if (!HYUN_APP_FileWinAck(&File->Win, AckSeq, SackMask, HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET())))
+    {
+        CFE_EVS_SendEvent(HYUN_APP_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "File %lu: ack of chunk %lu, only %lu sent", (unsigned long)TransferId,
+                          (unsigned long)AckSeq, (unsigned long)File->Win.NextSeq);
+        return HYUN_APP_SENSOR_INVALID_ERR_CODE;
+    }
+
+    if (HYUN_APP_FileWinDone(&File->Win))
+    {
+        HYUN_APP_FileStop("delivered");
+    }
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_FileAck() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_FileCancel -- Stop the transfer, data task             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 HYUN_APP_FileCancel(uint32 TransferId)
+{
+    if (!HYUN_APP_Data.File.Active || TransferId != HYUN_APP_Data.File.TransferId)
+    {
+        CFE_EVS_SendEvent(HYUN_APP_FILE_ERR_EID, CFE_EVS_EventType_ERROR, "File %lu: not being sent",
+                          (unsigned long)TransferId);
+        return HYUN_APP_SENSOR_INVALID_ERR_CODE;
+    }
+
+    HYUN_APP_FileStop("cancelled");
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_FileCancel() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_FileStop -- Close the file and report the transfer     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_FileStop(const char *Reason)
+{
+    HYUN_APP_File_t *File = &HYUN_APP_Data.File;
+    uint64           WallUs;
+
+    if (!File->Active)
+    {
+        return;
+    }
+
+    WallUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET()) - File->StartUs;
+
+    close(File->Fd);
+    File->Fd     = -1;
+    File->Active = false;
+
+    CFE_EVS_SendEvent(HYUN_APP_FILE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "File %lu: %s, chunks %lu..%lu acknowledged in %lu ms, %lu sent again, %lu timeouts",
+                      (unsigned long)File->TransferId, Reason, (unsigned long)File->StartSeq,
+                      (unsigned long)File->Win.AckSeq, (unsigned long)(WallUs / 1000u),
+                      (unsigned long)File->Win.ResendCounter, (unsigned long)File->Win.TimeoutCounter);
+
+} /* End of HYUN_APP_FileStop() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_FileService                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Top up the file class queue to HYUN_APP_FILE_MAX_QUEUED chunks,    */
+/*         once per data task cycle ahead of the downlink service. Chunks go  */
+/*         straight to their queue, not through HYUN_APP_DownlinkSend: the   */
+/*         file is on board already, so they are not recorded.                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HYUN_APP_FileService(void)
+{
+    HYUN_APP_File_t                *File    = &HYUN_APP_Data.File;
+    HYUN_APP_FileDataTlm_Payload_t *Payload = &File->DataTlm.Payload;
+    uint64                          NowUs;
+    uint32                          Queued;
+    uint32                          Sent;
+    uint32                          Timeouts;
+    uint32                          Offset;
+    int32                           Seq;
+
+    if (!File->Active)
+    {
+        return;
+    }
+
+    NowUs  = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+    Queued = HYUN_APP_DownlinkPending(HYUN_APP_DOWNLINK_FILE);
+
+    while (Queued < HYUN_APP_FILE_MAX_QUEUED)
+    {
+        Sent     = File->Win.SentCounter;
+        Timeouts = File->Win.TimeoutCounter;
+
+        Seq = HYUN_APP_FileWinNext(&File->Win, NowUs);
+
+        File->TimeoutCounter += File->Win.TimeoutCounter - Timeouts;
+        if (Seq == HYUN_APP_FILEWIN_NONE)
+        {
+            break;
+        }
+
+        Offset = (uint32)Seq * HYUN_APP_FILE_CHUNK_SIZE;
+
+        Payload->TransferId = File->TransferId;
+        Payload->Seq        = (uint32)Seq;
+        Payload->FileSize   = File->FileSize;
+        Payload->Length     = HYUN_APP_FILE_CHUNK_SIZE;
+        Payload->Flags      = 0;
+
+        if (File->FileSize - Offset < HYUN_APP_FILE_CHUNK_SIZE)
+        {
+            Payload->Length = (uint16)(File->FileSize - Offset);
+        }
+
+        if ((uint32)Seq + 1 == File->Win.Chunks)
+        {
+            Payload->Flags |= HYUN_APP_FILE_FLAG_LAST;
+        }
+        if (File->Win.SentCounter == Sent)
+        {
+            Payload->Flags |= HYUN_APP_FILE_FLAG_RESENT;
+            File->ResendCounter++;
+        }
+
+        if (pread(File->Fd, Payload->Data, Payload->Length, (off_t)Offset) != (ssize_t)Payload->Length)
+        {
+            CFE_EVS_SendEvent(HYUN_APP_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "File %lu: read error at %lu", (unsigned long)File->TransferId, (unsigned long)Offset);
+            HYUN_APP_FileStop("aborted");
+            return;
+        }
+        memset(&Payload->Data[Payload->Length], 0, sizeof(Payload->Data) - Payload->Length);
+
+        CFE_SB_TimeStampMsg(&File->DataTlm.TlmHeader.Msg);
+        HYUN_APP_DownlinkEnqueue(&File->DataTlm.TlmHeader.Msg, HYUN_APP_DOWNLINK_FILE);
+        Queued++;
+    }
+
+} /* End of HYUN_APP_FileService() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_FileStartCmd                                              */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Start or resume sending a file. The data task opens it and counts  */
+/*         the outcome.                                                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_FileStartCmd(const HYUN_APP_FileStartCmd_t *Msg)
+{
+    HYUN_APP_DataReq_t Req;
+
+    memset(&Req, 0, sizeof(Req));
+    Req.Code       = HYUN_APP_DATA_REQ_FILE_START;
+    Req.TransferId = Msg->Payload.TransferId;
+    Req.Offset     = Msg->Payload.Offset;
+    strncpy(Req.Filename, Msg->Payload.Path, HYUN_APP_FILE_PATH_LEN);
+    Req.Filename[sizeof(Req.Filename) - 1] = '\0';
+
+    if (!HYUN_APP_DataRequest(&Req))
+    {
+        HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter++;
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_FileStartCmd() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_FileAckCmd -- Pass a receiver report to the data task  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 HYUN_APP_FileAckCmd(const HYUN_APP_FileAckCmd_t *Msg)
+{
+    HYUN_APP_DataReq_t Req;
+
+    memset(&Req, 0, sizeof(Req));
+    Req.Code       = HYUN_APP_DATA_REQ_FILE_ACK;
+    Req.TransferId = Msg->Payload.TransferId;
+    Req.AckSeq     = Msg->Payload.AckSeq;
+    Req.SackMask   = Msg->Payload.SackMask;
+
+    if (!HYUN_APP_DataRequest(&Req))
+    {
+        HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter++;
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_FileAckCmd() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_FileCancelCmd -- Stop a transfer                       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 HYUN_APP_FileCancelCmd(const HYUN_APP_FileCancelCmd_t *Msg)
+{
+    HYUN_APP_DataReq_t Req;
+
+    memset(&Req, 0, sizeof(Req));
+    Req.Code       = HYUN_APP_DATA_REQ_FILE_CANCEL;
+    Req.TransferId = Msg->Payload.TransferId;
+
+    if (!HYUN_APP_DataRequest(&Req))
+    {
+        HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter++;
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_FileCancelCmd() */
@@ -0,0 +1,91 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Chunked file downlink, run by the data task
+ *
+ * FILE_START sends a file from the flight file system as numbered
+ * HYUN_APP_MID_FILE_DATA_TLM chunks of HYUN_APP_FILE_CHUNK_SIZE bytes.
+ * The ground answers with FILE_ACK reports, and the sliding window in
+ * hyun_app_filewin.h chooses what to send next and what to send again.
+ *
+ * Chunks use the lowest downlink class and only a few wait in its queue
+ * at once, so they are paced by the link budget, never dropped from a
+ * full queue, and a retransmission decision is never far behind the
+ * latest report.
+ *
+ * One transfer runs at a time. Nothing of it survives a reset: the
+ * ground restarts it with the offset it holds contiguously, and only the
+ * rest of the file is sent.
+ */
+
+#ifndef HYUN_APP_FILE_H
+#define HYUN_APP_FILE_H
+
+#include "cfe.h"
+#include "hyun_app_msg.h"
+#include "hyun_app_filewin.h"
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    bool   Active;
+    int    Fd;
+    uint32 TransferId;
+    uint32 FileSize;
+    uint32 StartSeq; /* Chunk the transfer started or resumed at */
+    uint64 StartUs;
+
+    HYUN_APP_FileWin_t Win;
+
+    /*
+    ** Reported in housekeeping, summed over transfers
+    */
+    uint32 ResendCounter;
+    uint32 TimeoutCounter;
+
+    uint32 StaleCounter; /* Reports for a transfer no longer running */
+
+    HYUN_APP_FileDataTlm_t DataTlm;
+} HYUN_APP_File_t;
+
+/****************************************************************************/
+/*
+** File downlink prototypes
+*/
+void  HYUN_APP_FileInit(void);
+int32 HYUN_APP_FileStart(uint32 TransferId, const char *Path, uint32 Offset);
+int32 HYUN_APP_FileAck(uint32 TransferId, uint32 AckSeq, uint32 SackMask);
+int32 HYUN_APP_FileCancel(uint32 TransferId);
+void  HYUN_APP_FileStop(const char *Reason);
+void  HYUN_APP_FileService(void);
+
+int32 HYUN_APP_FileStartCmd(const HYUN_APP_FileStartCmd_t *Msg);
+int32 HYUN_APP_FileAckCmd(const HYUN_APP_FileAckCmd_t *Msg);
+int32 HYUN_APP_FileCancelCmd(const HYUN_APP_FileCancelCmd_t *Msg);
+
+#endif /* HYUN_APP_FILE_H */
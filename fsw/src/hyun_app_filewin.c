@@ -0,0 +1,282 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_filewin.c
+**
+** Purpose:
+**   Selective repeat window of the file downlink. Shared between the
+**   flight file sender and the host lossy link test.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "hyun_app_filewin.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_FileWinMask -- Bits 0 .. Count - 1                     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static inline uint32 HYUN_APP_FileWinMask(uint32 Count)
+{
+    return (Count >= 32) ? 0xFFFFFFFFu : ((1u << Count) - 1u);
+
+} /* End of HYUN_APP_FileWinMask() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_FileWinInit                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Start a transfer of Chunks chunks at StartSeq, everything below    */
+/*         being already held by the receiver. TimeoutUs must cover the       */
+/*         round trip of a full window at the link budget.                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HYUN_APP_FileWinInit(HYUN_APP_FileWin_t *Win, uint32 Chunks, uint32 StartSeq, uint32 Window, uint32 TimeoutUs)
+{
+    memset(Win, 0, sizeof(*Win));
+
+    if (Window == 0)
+    {
+        Window = 1;
+    }
+    if (Window > HYUN_APP_FILEWIN_MAX)
+    {
+        Window = HYUN_APP_FILEWIN_MAX;
+    }
+    if (StartSeq > Chunks)
+    {
+        StartSeq = Chunks;
+    }
+
+    Win->Chunks    = Chunks;
+    Win->Window    = Window;
+    Win->AckSeq    = StartSeq;
+    Win->NextSeq   = StartSeq;
+    Win->TimeoutUs = TimeoutUs;
+
+} /* End of HYUN_APP_FileWinInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_FileWinNext                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Chunk to send now, or HYUN_APP_FILEWIN_NONE. Chunks known to be    */
+/*         missing go before new ones. Called again for each free slot on     */
+/*         the link; it also runs the acknowledgement timeout.                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_FileWinNext(HYUN_APP_FileWin_t *Win, uint64 NowUs)
+{
+    uint32 InFlight = Win->NextSeq - Win->AckSeq;
+    uint32 Bit      = 0;
+
+    if (InFlight != 0 && Win->AckDueUs != 0 && NowUs >= Win->AckDueUs)
+    {
+        Win->TimeoutCounter++;
+        Win->AckDueUs = 0;
+        if (Win->Backoff < HYUN_APP_FILEWIN_MAX_BACKOFF)
+        {
+            Win->Backoff++;
+        }
+
+        if (Win->Backoff == 1)
+        {
+            /* Most likely the tail of the window or a resend was lost: go back to AckSeq */
+            Win->Resend = HYUN_APP_FileWinMask(InFlight) & ~Win->Sack;
+        }
+        else
+        {
+            /*
+            ** Taken as link loss: probe the oldest chunk only, backing
+            ** off, until an acknowledgement comes back
+            */
+            Win->Stalled = true;
+            Win->Resend  = 1u;
+        }
+    }
+
+    if (Win->Resend != 0)
+    {
+        while ((Win->Resend & (1u << Bit)) == 0)
+        {
+            Bit++;
+        }
+        Win->Resend &= ~(1u << Bit);
+        Win->ResendCounter++;
+    }
+    else if (!Win->Stalled && Win->NextSeq < Win->Chunks && InFlight < Win->Window)
+    {
+        Bit = InFlight;
+        Win->NextSeq++;
+        Win->SentCounter++;
+    }
+    else
+    {
+        return HYUN_APP_FILEWIN_NONE;
+    }
+
+    Win->Stamp[Bit] = Win->SentCounter + Win->ResendCounter;
+
+    if (Win->AckDueUs == 0)
+    {
+        Win->AckDueUs = NowUs + ((uint64)Win->TimeoutUs << Win->Backoff);
+    }
+
+    return (int32)(Win->AckSeq + Bit);
+
+} /* End of HYUN_APP_FileWinNext() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_FileWinAck                                                */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Apply a receiver report: chunks below AckSeq held, bit i of        */
+/*         SackMask for chunk AckSeq + 1 + i. Chunks first reported here      */
+/*         move Delivered on, and every chunk still missing that was last     */
+/*         sent HYUN_APP_FILEWIN_REORDER transmissions before it is sent      */
+/*         again. Reports overtaken by a newer one are ignored. False if the  */
+/*         report covers chunks never sent.                                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+bool HYUN_APP_FileWinAck(HYUN_APP_FileWin_t *Win, uint32 AckSeq, uint32 SackMask, uint64 NowUs)
+{
+    uint32 Shift;
+    uint32 InFlight;
+    uint32 Reported;
+    uint32 i;
+
+    if (AckSeq > Win->NextSeq)
+    {
+        return false;
+    }
+    if (AckSeq < Win->AckSeq)
+    {
+        return true;
+    }
+
+    /*
+    ** Chunks acknowledged now that were not already reported held
+    */
+    Shift = AckSeq - Win->AckSeq;
+    for (i = 0; i < Shift; i++)
+    {
+        if ((Win->Sack & (1u << i)) == 0 && Win->Stamp[i] > Win->Delivered)
+        {
+            Win->Delivered = Win->Stamp[i];
+        }
+    }
+
+    if (Shift >= HYUN_APP_FILEWIN_MAX)
+    {
+        Win->Sack   = 0;
+        Win->Resend = 0;
+    }
+    else if (Shift != 0)
+    {
+        Win->Sack >>= Shift;
+        Win->Resend >>= Shift;
+        memmove(&Win->Stamp[0], &Win->Stamp[Shift], (HYUN_APP_FILEWIN_MAX - Shift) * sizeof(Win->Stamp[0]));
+    }
+
+    Win->AckSeq = AckSeq;
+    InFlight    = Win->NextSeq - Win->AckSeq;
+
+    /*
+    ** The receiver never gives data back, so reports only add to Sack
+    */
+    Reported = (SackMask << 1) & HYUN_APP_FileWinMask(InFlight) & ~Win->Sack;
+    for (i = 0; i < InFlight; i++)
+    {
+        if ((Reported & (1u << i)) != 0 && Win->Stamp[i] > Win->Delivered)
+        {
+            Win->Delivered = Win->Stamp[i];
+        }
+    }
+    Win->Sack |= Reported;
+    Win->Resend &= ~Win->Sack;
+
+    if (Win->Stalled)
+    {
+        /*
+        ** Link back: resume from the last acknowledged chunk, with
+        ** everything the receiver did not report sent again
+        */
+        Win->Stalled  = false;
+        Win->Backoff  = 0;
+        Win->Resend   = HYUN_APP_FileWinMask(InFlight) & ~Win->Sack;
+        Win->AckDueUs = 0;
+        return true;
+    }
+
+    for (i = 0; i < InFlight; i++)
+    {
+        if ((Win->Sack & (1u << i)) == 0 && Win->Stamp[i] + HYUN_APP_FILEWIN_REORDER <= Win->Delivered)
+        {
+            Win->Resend |= 1u << i;
+        }
+    }
+
+    if (Shift != 0)
+    {
+        Win->Backoff  = 0;
+        Win->AckDueUs = (InFlight != 0) ? NowUs + Win->TimeoutUs : 0;
+    }
+
+    return true;
+
+} /* End of HYUN_APP_FileWinAck() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_FileWinDone -- Every chunk acknowledged                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool HYUN_APP_FileWinDone(const HYUN_APP_FileWin_t *Win)
+{
+    return Win->AckSeq == Win->Chunks;
+
+} /* End of HYUN_APP_FileWinDone() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_FileWinTimeout                                            */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Acknowledgement timeout for a window of PacketBytes packets: the   */
+/*         ground turnaround plus the time the link budget takes to carry     */
+/*         the window. BytesPerSec 0 is an unpaced link.                      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+uint32 HYUN_APP_FileWinTimeout(uint32 Window, uint32 PacketBytes, uint32 BytesPerSec)
+{
+    uint32 TimeoutUs = HYUN_APP_FILE_ACK_TIMEOUT_MS * 1000u;
+
+    if (BytesPerSec != 0)
+    {
+        TimeoutUs += (uint32)((uint64)Window * PacketBytes * 1000000u / BytesPerSec);
+    }
+
+    return TimeoutUs;
+
+} /* End of HYUN_APP_FileWinTimeout() */
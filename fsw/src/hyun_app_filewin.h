@@ -0,0 +1,112 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Sliding window of a chunked file downlink
+ *
+ * Decides which chunk goes out next; reading the file and sending are
+ * left to the caller. At most Window chunks past the last acknowledged
+ * one (AckSeq) are in flight. Acknowledgements are cumulative with a
+ * selective mask above AckSeq. Every transmission is stamped in send
+ * order, and a chunk is sent again alone as soon as transmissions made
+ * HYUN_APP_FILEWIN_REORDER or more after its own are reported, without
+ * waiting for a timeout. This also recovers a lost retransmission.
+ *
+ * When no acknowledgement arrives within the timeout, everything in the
+ * window the receiver has not reported is sent again from AckSeq. If the
+ * next timeout follows, the link is taken as lost: new chunks stop and
+ * only chunk AckSeq is probed, with the timeout doubling each time. The
+ * first acknowledgement after that resumes from the last acknowledged
+ * offset in the same way.
+ *
+ * Only depends on the OSAL base types so the window also builds on the
+ * host under tools/.
+ */
+
+#ifndef HYUN_APP_FILEWIN_H
+#define HYUN_APP_FILEWIN_H
+
+#include "common_types.h"
+
+/***********************************************************************/
+#define HYUN_APP_FILEWIN_MAX         32 /* Chunks in flight, one bit each in the masks */
+#define HYUN_APP_FILEWIN_MAX_BACKOFF 4  /* Probe interval stops doubling at 16 x the timeout */
+#define HYUN_APP_FILEWIN_REORDER     3  /* Later transmissions reported before a chunk counts as lost */
+
+#define HYUN_APP_FILEWIN_NONE (-1) /* HYUN_APP_FileWinNext: nothing to send now */
+
+/*
+** Flight sender settings, here so the host link test runs the same ones
+*/
+#define HYUN_APP_FILE_WINDOW         16   /* Chunks in flight */
+#define HYUN_APP_FILE_MAX_QUEUED     4    /* Chunks waiting in the downlink queue at once */
+#define HYUN_APP_FILE_ACK_TIMEOUT_MS 2000 /* Ground turnaround, on top of a window at the link budget */
+
+/*
+** HYUN_APP_FileDataTlm_Payload_t.Flags
+*/
+#define HYUN_APP_FILE_FLAG_LAST   0x0001 /* Last chunk of the file */
+#define HYUN_APP_FILE_FLAG_RESENT 0x0002 /* Sent before */
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+/*
+** Bit i of the masks and Stamp[i] are chunk AckSeq + i
+*/
+typedef struct
+{
+    uint32 Chunks;  /* In the file */
+    uint32 Window;  /* Chunks in flight at most, 1..HYUN_APP_FILEWIN_MAX */
+    uint32 AckSeq;  /* Every chunk below is acknowledged */
+    uint32 NextSeq; /* First chunk never sent */
+
+    uint32 Sack;   /* Held by the receiver out of order */
+    uint32 Resend; /* To be sent again */
+
+    uint32 Stamp[HYUN_APP_FILEWIN_MAX]; /* Transmission number of each chunk's last send */
+    uint32 Delivered;                   /* Latest transmission known to have arrived */
+
+    bool   Stalled; /* Link taken as lost, only chunk AckSeq is probed */
+    uint8  Backoff; /* Timeouts in a row */
+    uint32 TimeoutUs;
+    uint64 AckDueUs; /* 0 = nothing in flight */
+
+    uint32 SentCounter;   /* Chunks sent for the first time */
+    uint32 ResendCounter; /* Chunks sent again */
+    uint32 TimeoutCounter;
+} HYUN_APP_FileWin_t;
+
+/****************************************************************************/
+/*
+** Window prototypes
+*/
+void   HYUN_APP_FileWinInit(HYUN_APP_FileWin_t *Win, uint32 Chunks, uint32 StartSeq, uint32 Window, uint32 TimeoutUs);
+int32  HYUN_APP_FileWinNext(HYUN_APP_FileWin_t *Win, uint64 NowUs);
+bool   HYUN_APP_FileWinAck(HYUN_APP_FileWin_t *Win, uint32 AckSeq, uint32 SackMask, uint64 NowUs);
+bool   HYUN_APP_FileWinDone(const HYUN_APP_FileWin_t *Win);
+uint32 HYUN_APP_FileWinTimeout(uint32 Window, uint32 PacketBytes, uint32 BytesPerSec);
+
+#endif /* HYUN_APP_FILEWIN_H */
@@ -0,0 +1,391 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_filter.c
+**
+** Purpose:
+**   Constant / logarithmic time sliding window filters.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "hyun_app_filter.h"
+
+#define HYUN_APP_DEQUE_MASK (HYUN_APP_FILTER_MAX_WINDOW - 1)
+
+/*
+** Heap helpers for the median filter. I is an offset from Center.
+*/
+#define HYUN_APP_HEAP(F, I)   ((F)->Heap[(F)->Center + (I)])
+#define HYUN_APP_MIN_CT(F)    (((int16)(F)->Count - 1) / 2)
+#define HYUN_APP_MAX_CT(F)    ((int16)(F)->Count / 2)
+
+static uint16 HYUN_APP_FilterClampSize(uint16 Size);
+static bool   HYUN_APP_MedianLess(const HYUN_APP_Median_t *Filt, int16 i, int16 j);
+static bool   HYUN_APP_MedianCmpExch(HYUN_APP_Median_t *Filt, int16 i, int16 j);
+static void   HYUN_APP_MedianMinSortDown(HYUN_APP_Median_t *Filt, int16 i);
+static void   HYUN_APP_MedianMaxSortDown(HYUN_APP_Median_t *Filt, int16 i);
+static bool   HYUN_APP_MedianMinSortUp(HYUN_APP_Median_t *Filt, int16 i);
+static bool   HYUN_APP_MedianMaxSortUp(HYUN_APP_Median_t *Filt, int16 i);
+
+static uint16 HYUN_APP_FilterClampSize(uint16 Size)
+{
+    if (Size == 0)
+    {
+        return 1;
+    }
+    if (Size > HYUN_APP_FILTER_MAX_WINDOW)
+    {
+        return HYUN_APP_FILTER_MAX_WINDOW;
+    }
+    return Size;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_MovAvgInit -- Moving average over Size samples         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_MovAvgInit(HYUN_APP_MovAvg_t *Filt, uint16 Size)
+{
+    memset(Filt, 0, sizeof(*Filt));
+    Filt->Size = HYUN_APP_FilterClampSize(Size);
+
+} /* End of HYUN_APP_MovAvgInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_MovAvgUpdate -- Add a sample, return the mean          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+float HYUN_APP_MovAvgUpdate(HYUN_APP_MovAvg_t *Filt, float X)
+{
+    uint16 i;
+
+    if (Filt->Count < Filt->Size)
+    {
+        Filt->Count++;
+    }
+    else
+    {
+        Filt->Sum -= Filt->Window[Filt->Idx];
+    }
+
+    Filt->Window[Filt->Idx] = X;
+    Filt->Sum += X;
+
+    Filt->Idx++;
+    if (Filt->Idx == Filt->Size)
+    {
+        /*
+        ** Re-sum once per window to stop float round-off from
+        ** accumulating; still O(1) per sample on average.
+        */
+        Filt->Idx = 0;
+        Filt->Sum = 0.0f;
+        for (i = 0; i < Filt->Count; i++)
+        {
+            Filt->Sum += Filt->Window[i];
+        }
+    }
+
+    return Filt->Sum / (float)Filt->Count;
+
+} /* End of HYUN_APP_MovAvgUpdate() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_EmaInit -- Exponential moving average                  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_EmaInit(HYUN_APP_Ema_t *Filt, float Alpha)
+{
+    if (Alpha <= 0.0f || Alpha > 1.0f)
+    {
+        Alpha = 1.0f;
+    }
+
+    Filt->Alpha  = Alpha;
+    Filt->Value  = 0.0f;
+    Filt->Primed = false;
+
+} /* End of HYUN_APP_EmaInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_EmaUpdate -- Add a sample, return the average          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+float HYUN_APP_EmaUpdate(HYUN_APP_Ema_t *Filt, float X)
+{
+    if (!Filt->Primed)
+    {
+        Filt->Value  = X;
+        Filt->Primed = true;
+    }
+    else
+    {
+        Filt->Value += Filt->Alpha * (X - Filt->Value);
+    }
+
+    return Filt->Value;
+
+} /* End of HYUN_APP_EmaUpdate() */
+
+/*
+** Median filter heap maintenance. The layout follows the classic
+** "mediator" structure: swapping two heap slots also fixes up Pos.
+*/
+static bool HYUN_APP_MedianLess(const HYUN_APP_Median_t *Filt, int16 i, int16 j)
+{
+    return Filt->Data[HYUN_APP_HEAP(Filt, i)] < Filt->Data[HYUN_APP_HEAP(Filt, j)];
+}
+
+static bool HYUN_APP_MedianCmpExch(HYUN_APP_Median_t *Filt, int16 i, int16 j)
+{
+    int16 Tmp;
+
+    if (!HYUN_APP_MedianLess(Filt, i, j))
+    {
+        return false;
+    }
+
+    Tmp                                    = HYUN_APP_HEAP(Filt, i);
+    HYUN_APP_HEAP(Filt, i)                 = HYUN_APP_HEAP(Filt, j);
+    HYUN_APP_HEAP(Filt, j)                 = Tmp;
+    Filt->Pos[HYUN_APP_HEAP(Filt, i)] = i;
+    Filt->Pos[HYUN_APP_HEAP(Filt, j)] = j;
+
+    return true;
+}
+
+/*
+** SortDown takes the index of the first child to compare against its
+** parent, so SortDown(1) / SortDown(-1) also checks the median slot.
+*/
+static void HYUN_APP_MedianMinSortDown(HYUN_APP_Median_t *Filt, int16 i)
+{
+    for (; i <= HYUN_APP_MIN_CT(Filt); i *= 2)
+    {
+        if (i > 1 && i < HYUN_APP_MIN_CT(Filt) && HYUN_APP_MedianLess(Filt, i + 1, i))
+        {
+            ++i;
+        }
+        if (!HYUN_APP_MedianCmpExch(Filt, i, i / 2))
+        {
+            break;
+        }
+    }
+}
+
+static void HYUN_APP_MedianMaxSortDown(HYUN_APP_Median_t *Filt, int16 i)
+{
+    for (; i >= -HYUN_APP_MAX_CT(Filt); i *= 2)
+    {
+        if (i < -1 && i > -HYUN_APP_MAX_CT(Filt) && HYUN_APP_MedianLess(Filt, i, i - 1))
+        {
+            --i;
+        }
+        if (!HYUN_APP_MedianCmpExch(Filt, i / 2, i))
+        {
+            break;
+        }
+    }
+}
+
+/* Returns true when the item bubbled all the way up to the median */
+static bool HYUN_APP_MedianMinSortUp(HYUN_APP_Median_t *Filt, int16 i)
+{
+    while (i > 0 && HYUN_APP_MedianCmpExch(Filt, i, i / 2))
+    {
+        i /= 2;
+    }
+    return (i == 0);
+}
+
+static bool HYUN_APP_MedianMaxSortUp(HYUN_APP_Median_t *Filt, int16 i)
+{
+    while (i < 0 && HYUN_APP_MedianCmpExch(Filt, i / 2, i))
+    {
+        i /= 2;
+    }
+    return (i == 0);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_MedianInit -- Sliding median over Size samples         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_MedianInit(HYUN_APP_Median_t *Filt, uint16 Size)
+{
+    int16 n;
+
+    memset(Filt, 0, sizeof(*Filt));
+    Filt->Size   = HYUN_APP_FilterClampSize(Size);
+    Filt->Center = (int16)(Filt->Size / 2);
+
+    /* Seed slots alternately above and below the median: 0, -1, 1, -2, 2 ... */
+    for (n = (int16)Filt->Size - 1; n >= 0; n--)
+    {
+        Filt->Pos[n]                       = (int16)(((n + 1) / 2) * ((n & 1) ? -1 : 1));
+        HYUN_APP_HEAP(Filt, Filt->Pos[n]) = n;
+    }
+
+} /* End of HYUN_APP_MedianInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_MedianUpdate -- Replace the oldest sample, O(log n)    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+float HYUN_APP_MedianUpdate(HYUN_APP_Median_t *Filt, float X)
+{
+    bool  IsNew = (Filt->Count < Filt->Size);
+    int16 p     = Filt->Pos[Filt->Idx];
+    float Old   = Filt->Data[Filt->Idx];
+    float Median;
+
+    Filt->Data[Filt->Idx] = X;
+    Filt->Idx             = (uint16)((Filt->Idx + 1) % Filt->Size);
+    if (IsNew)
+    {
+        Filt->Count++;
+    }
+
+    if (p > 0)
+    {
+        /* Slot is in the upper (min) heap */
+        if (!IsNew && Old < X)
+        {
+            HYUN_APP_MedianMinSortDown(Filt, (int16)(p * 2));
+        }
+        else if (HYUN_APP_MedianMinSortUp(Filt, p))
+        {
+            HYUN_APP_MedianMaxSortDown(Filt, -1);
+        }
+    }
+    else if (p < 0)
+    {
+        /* Slot is in the lower (max) heap */
+        if (!IsNew && X < Old)
+        {
+            HYUN_APP_MedianMaxSortDown(Filt, (int16)(p * 2));
+        }
+        else if (HYUN_APP_MedianMaxSortUp(Filt, p))
+        {
+            HYUN_APP_MedianMinSortDown(Filt, 1);
+        }
+    }
+    else
+    {
+        /* Slot is the median itself */
+        if (HYUN_APP_MAX_CT(Filt) > 0)
+        {
+            HYUN_APP_MedianMaxSortDown(Filt, -1);
+        }
+        if (HYUN_APP_MIN_CT(Filt) > 0)
+        {
+            HYUN_APP_MedianMinSortDown(Filt, 1);
+        }
+    }
+
+    Median = Filt->Data[HYUN_APP_HEAP(Filt, 0)];
+    if ((Filt->Count & 1) == 0)
+    {
+        Median = 0.5f * (Median + Filt->Data[HYUN_APP_HEAP(Filt, -1)]);
+    }
+
+    return Median;
+
+} /* End of HYUN_APP_MedianUpdate() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_MinMaxInit -- Sliding min / max over Size samples      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_MinMaxInit(HYUN_APP_MinMax_t *Filt, uint16 Size)
+{
+    memset(Filt, 0, sizeof(*Filt));
+    Filt->Size = HYUN_APP_FilterClampSize(Size);
+
+} /* End of HYUN_APP_MinMaxInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_MinMaxUpdate -- Add a sample to both deques            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_MinMaxUpdate(HYUN_APP_MinMax_t *Filt, float X)
+{
+    HYUN_APP_Deque_t *Min = &Filt->Min;
+    HYUN_APP_Deque_t *Max = &Filt->Max;
+    uint32            Seq = Filt->Seq++;
+
+    /*
+    ** Expire the front once it falls out of the window, then drop
+    ** entries from the back that can never be the extreme again. Doing
+    ** the expiry first keeps the deque within Size entries.
+    */
+    if (Min->Head != Min->Tail && Seq - Min->Seq[Min->Tail & HYUN_APP_DEQUE_MASK] >= Filt->Size)
+    {
+        Min->Tail++;
+    }
+    while (Min->Head != Min->Tail && Min->Value[(uint16)(Min->Head - 1) & HYUN_APP_DEQUE_MASK] >= X)
+    {
+        Min->Head--;
+    }
+    Min->Value[Min->Head & HYUN_APP_DEQUE_MASK] = X;
+    Min->Seq[Min->Head & HYUN_APP_DEQUE_MASK]   = Seq;
+    Min->Head++;
+
+    if (Max->Head != Max->Tail && Seq - Max->Seq[Max->Tail & HYUN_APP_DEQUE_MASK] >= Filt->Size)
+    {
+        Max->Tail++;
+    }
+    while (Max->Head != Max->Tail && Max->Value[(uint16)(Max->Head - 1) & HYUN_APP_DEQUE_MASK] <= X)
+    {
+        Max->Head--;
+    }
+    Max->Value[Max->Head & HYUN_APP_DEQUE_MASK] = X;
+    Max->Seq[Max->Head & HYUN_APP_DEQUE_MASK]   = Seq;
+    Max->Head++;
+
+} /* End of HYUN_APP_MinMaxUpdate() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_MinMaxGetMin / GetMax -- Current window extremes       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+float HYUN_APP_MinMaxGetMin(const HYUN_APP_MinMax_t *Filt)
+{
+    return Filt->Min.Value[Filt->Min.Tail & HYUN_APP_DEQUE_MASK];
+}
+
+float HYUN_APP_MinMaxGetMax(const HYUN_APP_MinMax_t *Filt)
+{
+    return Filt->Max.Value[Filt->Max.Tail & HYUN_APP_DEQUE_MASK];
+}
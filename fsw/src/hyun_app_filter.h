@@ -0,0 +1,117 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Streaming filters for sensor samples
+ *
+ * Every filter owns a window of HYUN_APP_FILTER_MAX_WINDOW samples and
+ * uses the first Size of them, so the window can be resized from the
+ * table without allocating. Cost per sample:
+ *   - moving average : O(1)
+ *   - EMA            : O(1)
+ *   - median         : O(log n), two heaps around the median
+ *   - min / max      : O(1) amortized, monotonic deques
+ */
+
+#ifndef HYUN_APP_FILTER_H
+#define HYUN_APP_FILTER_H
+
+#include "common_types.h"
+
+/***********************************************************************/
+#define HYUN_APP_FILTER_MAX_WINDOW 64
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    uint16 Size;
+    uint16 Count;
+    uint16 Idx;
+    float  Sum;
+    float  Window[HYUN_APP_FILTER_MAX_WINDOW];
+} HYUN_APP_MovAvg_t;
+
+typedef struct
+{
+    float Alpha;
+    float Value;
+    bool  Primed;
+} HYUN_APP_Ema_t;
+
+/*
+** Data is the circular window. Heap holds indexes into Data and is
+** addressed relative to Center: Heap[Center] is the median,
+** Heap[Center-1 .. Center-MaxCt] is a max-heap of the lower half and
+** Heap[Center+1 .. Center+MinCt] a min-heap of the upper half.
+** Pos maps a Data index back to its heap offset.
+*/
+typedef struct
+{
+    uint16 Size;
+    uint16 Count;
+    uint16 Idx;
+    int16  Center;
+    float  Data[HYUN_APP_FILTER_MAX_WINDOW];
+    int16  Pos[HYUN_APP_FILTER_MAX_WINDOW];
+    int16  Heap[HYUN_APP_FILTER_MAX_WINDOW];
+} HYUN_APP_Median_t;
+
+typedef struct
+{
+    uint16 Head;
+    uint16 Tail;
+    float  Value[HYUN_APP_FILTER_MAX_WINDOW];
+    uint32 Seq[HYUN_APP_FILTER_MAX_WINDOW];
+} HYUN_APP_Deque_t;
+
+typedef struct
+{
+    uint16           Size;
+    uint32           Seq;
+    HYUN_APP_Deque_t Min;
+    HYUN_APP_Deque_t Max;
+} HYUN_APP_MinMax_t;
+
+/****************************************************************************/
+/*
+** Filter prototypes
+*/
+void  HYUN_APP_MovAvgInit(HYUN_APP_MovAvg_t *Filt, uint16 Size);
+float HYUN_APP_MovAvgUpdate(HYUN_APP_MovAvg_t *Filt, float X);
+
+void  HYUN_APP_EmaInit(HYUN_APP_Ema_t *Filt, float Alpha);
+float HYUN_APP_EmaUpdate(HYUN_APP_Ema_t *Filt, float X);
+
+void  HYUN_APP_MedianInit(HYUN_APP_Median_t *Filt, uint16 Size);
+float HYUN_APP_MedianUpdate(HYUN_APP_Median_t *Filt, float X);
+
+void  HYUN_APP_MinMaxInit(HYUN_APP_MinMax_t *Filt, uint16 Size);
+void  HYUN_APP_MinMaxUpdate(HYUN_APP_MinMax_t *Filt, float X);
+float HYUN_APP_MinMaxGetMin(const HYUN_APP_MinMax_t *Filt);
+float HYUN_APP_MinMaxGetMax(const HYUN_APP_MinMax_t *Filt);
+
+#endif /* HYUN_APP_FILTER_H */
@@ -0,0 +1,227 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_flight.c
+**
+** Purpose:
+**   CANSAT flight phase detection (launch, apogee, descent, payload
+**   release, landing).
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "hyun_app_events.h"
+#include "hyun_app.h"
+#include "hyun_app_flight.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_FlightInit -- Start on the pad                         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_FlightInit(HYUN_APP_FlightData_t *Flight)
+{
+    memset(Flight, 0, sizeof(*Flight));
+
+    Flight->State        = HYUN_APP_FLIGHT_LAUNCH_WAIT;
+    Flight->PendingState = HYUN_APP_FLIGHT_LAUNCH_WAIT;
+
+} /* End of HYUN_APP_FlightInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_FlightStep                                                */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Evaluate the transition condition of the current state on a new    */
+/*         estimate. A new state is only entered after its condition held     */
+/*         for Tbl->HysteresisCount consecutive estimator steps; an estimate  */
+/*         that was already evaluated is not counted again.                   */
+/*         Returns true when the state changed.                               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+bool HYUN_APP_FlightStep(HYUN_APP_FlightData_t *Flight, const HYUN_APP_Table_t *Tbl, const HYUN_APP_KF_t *Kf)
+{
+    float Agl;
+    float Vel;
+    float Dt;
+    uint8 Next;
+
+    if (!Kf->Initialized || (Flight->GroundValid && Kf->LastTimeUs == Flight->LastStepUs))
+    {
+        return false;
+    }
+
+    Vel = Kf->X[HYUN_APP_KF_STATE_VEL];
+
+    if (!Flight->GroundValid)
+    {
+        Flight->GroundAltitude = Kf->X[HYUN_APP_KF_STATE_ALT];
+        Flight->GroundValid    = true;
+    }
+    else if (Flight->State == HYUN_APP_FLIGHT_LAUNCH_WAIT && Kf->LastTimeUs > Flight->LastStepUs)
+    {
+        /*
+        ** Follow slow baro drift on the pad. The gain comes from the time
+        ** between estimates, so tracking does not depend on the step rate.
+        */
+        Dt = (float)(Kf->LastTimeUs - Flight->LastStepUs) * 1.0e-6f;
+        Flight->GroundAltitude += (Dt / (HYUN_APP_FLIGHT_GROUND_TAU_S + Dt)) *
+                                  (Kf->X[HYUN_APP_KF_STATE_ALT] - Flight->GroundAltitude);
+    }
+
+    Flight->LastStepUs = Kf->LastTimeUs;
+
+    Agl = Kf->X[HYUN_APP_KF_STATE_ALT] - Flight->GroundAltitude;
+    if (Agl > Flight->MaxAltitude)
+    {
+        Flight->MaxAltitude = Agl;
+    }
+
+    Next = Flight->State;
+
+    switch (Flight->State)
+    {
+        case HYUN_APP_FLIGHT_LAUNCH_WAIT:
+            if (Agl > Tbl->LaunchAltitude && Vel > Tbl->LaunchVelocity)
+            {
+                Next = HYUN_APP_FLIGHT_ASCENT;
+            }
+            break;
+
+        case HYUN_APP_FLIGHT_ASCENT:
+            if (Vel < Tbl->ApogeeVelocity)
+            {
+                Next = HYUN_APP_FLIGHT_APOGEE;
+            }
+            break;
+
+        case HYUN_APP_FLIGHT_APOGEE:
+            if (Vel < -Tbl->DescentVelocity)
+            {
+                Next = HYUN_APP_FLIGHT_DESCENT;
+            }
+            break;
+
+        case HYUN_APP_FLIGHT_DESCENT:
+            if (Agl < Tbl->ReleaseAltitude)
+            {
+                Next = HYUN_APP_FLIGHT_PAYLOAD_RELEASE;
+            }
+            break;
+
+        case HYUN_APP_FLIGHT_PAYLOAD_RELEASE:
+            if (Agl < Tbl->LandedAltitude && Vel < Tbl->LandedVelocity && Vel > -Tbl->LandedVelocity)
+            {
+                Next = HYUN_APP_FLIGHT_LANDED;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    if (Next == Flight->State)
+    {
+        Flight->PendingCounter = 0;
+        return false;
+    }
+
+    if (Next != Flight->PendingState)
+    {
+        Flight->PendingState   = Next;
+        Flight->PendingCounter = 0;
+    }
+
+    Flight->PendingCounter++;
+    if (Flight->PendingCounter < Tbl->HysteresisCount)
+    {
+        return false;
+    }
+
+    Flight->State          = Next;
+    Flight->PendingCounter = 0;
+    Flight->TransitionCounter++;
+
+    return true;
+
+} /* End of HYUN_APP_FlightStep() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_FlightProcess                                             */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Run one state machine step on the estimate just stepped. On a      */
+/*         state change, measure the latency from ArrivalUs, the MET at which */
+/*         the newest sample of that step reached the data task, and          */
+/*         report it in one event. Sample time stamps are not used, they may  */
+/*         be on the replay clock.                                            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 HYUN_APP_FlightProcess(const HYUN_APP_Table_t *TblPtr, uint64 ArrivalUs)
+{
+    uint64                 NowUs;
+    uint32                 LatencyUs = 0;
+    HYUN_APP_FlightData_t *Flight    = &HYUN_APP_Data.Flight;
+
+    if (HYUN_APP_FlightStep(Flight, TblPtr, &HYUN_APP_Data.Kf))
+    {
+        NowUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+        if (ArrivalUs != 0 && NowUs > ArrivalUs)
+        {
+            LatencyUs = (uint32)(NowUs - ArrivalUs);
+        }
+
+        Flight->LastLatencyUs = LatencyUs;
+        if (LatencyUs > Flight->MaxLatencyUs)
+        {
+            Flight->MaxLatencyUs = LatencyUs;
+        }
+
+        CFE_EVS_SendEvent(HYUN_APP_FLIGHT_STATE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "Flight state %s, alt %d m, latency %lu us", HYUN_APP_FlightStateName(Flight->State),
+                          (int)(HYUN_APP_Data.Kf.X[HYUN_APP_KF_STATE_ALT] - Flight->GroundAltitude),
+                          (unsigned long)LatencyUs);
+    }
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_FlightProcess() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_FlightStateName -- Text for events                     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+const char *HYUN_APP_FlightStateName(uint8 State)
+{
+    static const char *const Names[] = {"LAUNCH_WAIT", "ASCENT", "APOGEE", "DESCENT", "PAYLOAD_RELEASE", "LANDED"};
+
+    if (State >= sizeof(Names) / sizeof(Names[0]))
+    {
+        return "UNKNOWN";
+    }
+
+    return Names[State];
+
+} /* End of HYUN_APP_FlightStateName() */
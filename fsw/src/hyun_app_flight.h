@@ -0,0 +1,83 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * CANSAT flight phase state machine
+ *
+ * Driven by the altitude / velocity estimate once per estimator step,
+ * i.e. once per aligned frame. Thresholds and hysteresis come from
+ * HYUN_APP_Table_t.
+ */
+
+#ifndef HYUN_APP_FLIGHT_H
+#define HYUN_APP_FLIGHT_H
+
+#include "cfe.h"
+#include "hyun_app_table.h"
+#include "hyun_app_kf.h"
+
+/***********************************************************************/
+/*
+** Flight states, reported as-is in telemetry
+*/
+#define HYUN_APP_FLIGHT_LAUNCH_WAIT     0
+#define HYUN_APP_FLIGHT_ASCENT          1
+#define HYUN_APP_FLIGHT_APOGEE          2
+#define HYUN_APP_FLIGHT_DESCENT         3
+#define HYUN_APP_FLIGHT_PAYLOAD_RELEASE 4
+#define HYUN_APP_FLIGHT_LANDED          5
+
+#define HYUN_APP_FLIGHT_GROUND_TAU_S 5.0f /* [s] Ground reference tracking time constant on the pad */
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    uint8  State;
+    uint8  PendingState;   /* Candidate state the hysteresis counter applies to */
+    uint16 PendingCounter; /* Consecutive steps the candidate held */
+    uint64 LastStepUs;     /* Estimate time of the last step */
+
+    bool  GroundValid;
+    float GroundAltitude;
+    float MaxAltitude; /* AGL */
+
+    uint32 TransitionCounter;
+    uint32 LastLatencyUs; /* Arrival of the newest sample in the step -> state change */
+    uint32 MaxLatencyUs;
+} HYUN_APP_FlightData_t;
+
+/****************************************************************************/
+/*
+** Flight state machine prototypes
+*/
+void        HYUN_APP_FlightInit(HYUN_APP_FlightData_t *Flight);
+bool        HYUN_APP_FlightStep(HYUN_APP_FlightData_t *Flight, const HYUN_APP_Table_t *Tbl,
+                                const HYUN_APP_KF_t *Kf);
+int32       HYUN_APP_FlightProcess(const HYUN_APP_Table_t *TblPtr, uint64 ArrivalUs);
+const char *HYUN_APP_FlightStateName(uint8 State);
+
+#endif /* HYUN_APP_FLIGHT_H */
@@ -0,0 +1,115 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_handoff.c
+**
+** Purpose:
+**   Lock-free single-producer single-consumer record queue between two
+**   tasks. Uses the GCC __atomic builtins, as C99 has no atomics.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "hyun_app_handoff.h"
+
+#define HYUN_APP_HANDOFF_INDEX(Seq) ((Seq) & (HYUN_APP_HANDOFF_DEPTH - 1))
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_HandoffInit -- Empty queue, before either task runs    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_HandoffInit(HYUN_APP_Handoff_t *Handoff)
+{
+    memset(Handoff, 0, sizeof(*Handoff));
+
+} /* End of HYUN_APP_HandoffInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_HandoffPut -- Producer: copy a record in and publish   */
+/* it. Returns false, and counts a drop, if it cannot be queued.   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool HYUN_APP_HandoffPut(HYUN_APP_Handoff_t *Handoff, const void *Data, size_t Size)
+{
+    uint32 Head = Handoff->Head;
+    uint32 Tail = __atomic_load_n(&Handoff->Tail, __ATOMIC_ACQUIRE);
+    uint32 Index;
+
+    if (Size > HYUN_APP_HANDOFF_SLOT_SIZE || Head - Tail >= HYUN_APP_HANDOFF_DEPTH)
+    {
+        __atomic_store_n(&Handoff->DropCounter, Handoff->DropCounter + 1, __ATOMIC_RELAXED);
+        return false;
+    }
+
+    Index = HYUN_APP_HANDOFF_INDEX(Head);
+    memcpy(Handoff->Slot[Index].Bytes, Data, Size);
+    Handoff->Size[Index] = (uint16)Size;
+
+    __atomic_store_n(&Handoff->Head, Head + 1, __ATOMIC_RELEASE);
+
+    return true;
+
+} /* End of HYUN_APP_HandoffPut() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_HandoffPeek -- Consumer: oldest record, NULL if none.  */
+/* It stays valid until HYUN_APP_HandoffRelease.                   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+const void *HYUN_APP_HandoffPeek(HYUN_APP_Handoff_t *Handoff, size_t *Size)
+{
+    uint32 Tail = Handoff->Tail;
+    uint32 Head = __atomic_load_n(&Handoff->Head, __ATOMIC_ACQUIRE);
+    uint32 Index;
+
+    if (Head == Tail)
+    {
+        return NULL;
+    }
+
+    if (Head - Tail > Handoff->HighWater)
+    {
+        Handoff->HighWater = Head - Tail;
+    }
+
+    Index = HYUN_APP_HANDOFF_INDEX(Tail);
+    *Size = Handoff->Size[Index];
+
+    return Handoff->Slot[Index].Bytes;
+
+} /* End of HYUN_APP_HandoffPeek() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_HandoffRelease -- Consumer: give the oldest slot back  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_HandoffRelease(HYUN_APP_Handoff_t *Handoff)
+{
+    __atomic_store_n(&Handoff->Tail, Handoff->Tail + 1, __ATOMIC_RELEASE);
+
+} /* End of HYUN_APP_HandoffRelease() */
@@ -0,0 +1,90 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Single-producer single-consumer handoff queue
+ *
+ * The fixed point where one task passes data to another without a lock.
+ * The producer copies a record into the slot at Head and then publishes
+ * Head with release order; the consumer reads Head with acquire order,
+ * uses the slot in place and frees it by publishing Tail. Each index has
+ * exactly one writer and they sit on separate cache lines.
+ *
+ * A full queue refuses the new record rather than blocking, so the
+ * producer's latency never depends on how busy the consumer is.
+ *
+ * Only depends on the OSAL base types so the same source builds into the
+ * host latency test under tools/.
+ */
+
+#ifndef HYUN_APP_HANDOFF_H
+#define HYUN_APP_HANDOFF_H
+
+#include "common_types.h"
+#include "hyun_app_counters.h"
+
+/***********************************************************************/
+#define HYUN_APP_HANDOFF_DEPTH     8   /* Records in flight, power of two */
+#define HYUN_APP_HANDOFF_SLOT_SIZE 256 /* Largest record [bytes] */
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+/*
+** Cache line aligned, so a slot can hold an SB message in place
+*/
+typedef struct
+{
+    uint8 Bytes[HYUN_APP_HANDOFF_SLOT_SIZE];
+} HYUN_APP_CACHE_ALIGNED HYUN_APP_HandoffSlot_t;
+
+typedef struct
+{
+    /*
+    ** Written by the producer only
+    */
+    uint32 Head HYUN_APP_CACHE_ALIGNED;
+    uint32 DropCounter; /* Records refused, queue full or too large */
+    uint16 Size[HYUN_APP_HANDOFF_DEPTH];
+
+    /*
+    ** Written by the consumer only
+    */
+    uint32 Tail HYUN_APP_CACHE_ALIGNED;
+    uint32 HighWater; /* Most records seen waiting at once */
+
+    HYUN_APP_HandoffSlot_t Slot[HYUN_APP_HANDOFF_DEPTH];
+} HYUN_APP_Handoff_t;
+
+/****************************************************************************/
+/*
+** Handoff prototypes
+*/
+void        HYUN_APP_HandoffInit(HYUN_APP_Handoff_t *Handoff);
+bool        HYUN_APP_HandoffPut(HYUN_APP_Handoff_t *Handoff, const void *Data, size_t Size);
+const void *HYUN_APP_HandoffPeek(HYUN_APP_Handoff_t *Handoff, size_t *Size);
+void        HYUN_APP_HandoffRelease(HYUN_APP_Handoff_t *Handoff);
+
+#endif /* HYUN_APP_HANDOFF_H */
@@ -0,0 +1,269 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_kf.c
+**
+** Purpose:
+**   Altitude / vertical velocity Kalman estimator. Shared between the
+**   flight sensor pipeline and the host replay benchmark.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "hyun_app_kf.h"
+
+/*
+** Local function prototypes
+*/
+static void HYUN_APP_KF_Predict2(HYUN_APP_KF_t *Kf, float Dt);
+static void HYUN_APP_KF_Predict3(HYUN_APP_KF_t *Kf, float Dt);
+static void HYUN_APP_KF_ScalarUpdate(HYUN_APP_KF_t *Kf, uint8 State, float Z, float R);
+static void HYUN_APP_KF_Advance(HYUN_APP_KF_t *Kf, uint64 TimeUs);
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_KF_Init -- Reset the estimator                         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_KF_Init(HYUN_APP_KF_t *Kf, uint8 NumStates)
+{
+    uint8 i;
+
+    memset(Kf, 0, sizeof(*Kf));
+
+    if (NumStates != 2 && NumStates != 3)
+    {
+        NumStates = HYUN_APP_KF_DEFAULT_STATES;
+    }
+
+    Kf->NumStates  = NumStates;
+    Kf->ProcessVar = HYUN_APP_KF_PROC_VAR;
+    Kf->BaroVar    = HYUN_APP_KF_BARO_VAR;
+    Kf->AccelVar   = HYUN_APP_KF_ACCEL_VAR;
+
+    for (i = 0; i < NumStates; i++)
+    {
+        Kf->P[i][i] = HYUN_APP_KF_INIT_VAR;
+    }
+
+} /* End of HYUN_APP_KF_Init() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_KF_Predict -- Propagate state and covariance by Dt     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_KF_Predict(HYUN_APP_KF_t *Kf, float Dt)
+{
+    if (Dt <= 0.0f)
+    {
+        return;
+    }
+    if (Dt > HYUN_APP_KF_MAX_DT)
+    {
+        Dt = HYUN_APP_KF_MAX_DT;
+    }
+
+    if (Kf->NumStates == 2)
+    {
+        HYUN_APP_KF_Predict2(Kf, Dt);
+    }
+    else
+    {
+        HYUN_APP_KF_Predict3(Kf, Dt);
+    }
+
+    Kf->PredictCounter++;
+
+} /* End of HYUN_APP_KF_Predict() */
+
+/*
+** 2-state fast path. F = [1 dt; 0 1], the acceleration enters through
+** G = [dt^2/2; dt] and Q = G*G'*q. F*P*F' is expanded by hand.
+*/
+static void HYUN_APP_KF_Predict2(HYUN_APP_KF_t *Kf, float Dt)
+{
+    float Dt2 = Dt * Dt;
+    float q   = Kf->ProcessVar;
+    float P00 = Kf->P[0][0];
+    float P01 = Kf->P[0][1];
+    float P11 = Kf->P[1][1];
+
+    Kf->X[0] += Kf->X[1] * Dt + 0.5f * Kf->Accel * Dt2;
+    Kf->X[1] += Kf->Accel * Dt;
+
+    Kf->P[0][0] = P00 + 2.0f * Dt * P01 + Dt2 * P11 + 0.25f * q * Dt2 * Dt2;
+    Kf->P[0][1] = P01 + Dt * P11 + 0.5f * q * Dt2 * Dt;
+    Kf->P[1][0] = Kf->P[0][1];
+    Kf->P[1][1] = P11 + q * Dt2;
+}
+
+/*
+** 3-state fast path. F = [1 dt dt^2/2; 0 1 dt; 0 0 1] with a random
+** walk on acceleration (Q = diag(0, 0, q*dt)). A = F*P is formed row by
+** row, then A*F' only for the upper triangle.
+*/
+static void HYUN_APP_KF_Predict3(HYUN_APP_KF_t *Kf, float Dt)
+{
+    float h = Dt;
+    float k = 0.5f * Dt * Dt;
+    float A[3][3];
+    uint8 j;
+
+    Kf->X[0] += Kf->X[1] * h + Kf->X[2] * k;
+    Kf->X[1] += Kf->X[2] * h;
+
+    for (j = 0; j < 3; j++)
+    {
+        A[0][j] = Kf->P[0][j] + h * Kf->P[1][j] + k * Kf->P[2][j];
+        A[1][j] = Kf->P[1][j] + h * Kf->P[2][j];
+        A[2][j] = Kf->P[2][j];
+    }
+
+    Kf->P[0][0] = A[0][0] + h * A[0][1] + k * A[0][2];
+    Kf->P[0][1] = A[0][1] + h * A[0][2];
+    Kf->P[0][2] = A[0][2];
+    Kf->P[1][1] = A[1][1] + h * A[1][2];
+    Kf->P[1][2] = A[1][2];
+    Kf->P[2][2] = A[2][2] + Kf->ProcessVar * Dt;
+
+    Kf->P[1][0] = Kf->P[0][1];
+    Kf->P[2][0] = Kf->P[0][2];
+    Kf->P[2][1] = Kf->P[1][2];
+}
+
+/*
+** Update with a direct measurement of one state (H is a unit row), so
+** S is a scalar and K is column 'State' of P divided by S.
+*/
+static void HYUN_APP_KF_ScalarUpdate(HYUN_APP_KF_t *Kf, uint8 State, float Z, float R)
+{
+    float S;
+    float Y;
+    float K[HYUN_APP_KF_MAX_STATES];
+    float Row[HYUN_APP_KF_MAX_STATES];
+    uint8 i;
+    uint8 j;
+    uint8 n = Kf->NumStates;
+
+    S = Kf->P[State][State] + R;
+    Y = Z - Kf->X[State];
+
+    for (i = 0; i < n; i++)
+    {
+        K[i]   = Kf->P[i][State] / S;
+        Row[i] = Kf->P[State][i];
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        Kf->X[i] += K[i] * Y;
+        for (j = i; j < n; j++)
+        {
+            Kf->P[i][j] -= K[i] * Row[j];
+            Kf->P[j][i] = Kf->P[i][j];
+        }
+    }
+
+    Kf->UpdateCounter++;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_KF_UpdateBaro -- Fuse one barometric altitude          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_KF_UpdateBaro(HYUN_APP_KF_t *Kf, float Altitude)
+{
+    if (!Kf->Initialized)
+    {
+        /* First fix seeds altitude, velocity starts at rest */
+        Kf->X[HYUN_APP_KF_STATE_ALT] = Altitude;
+        Kf->P[0][0]                  = Kf->BaroVar;
+        Kf->Initialized              = true;
+        return;
+    }
+
+    HYUN_APP_KF_ScalarUpdate(Kf, HYUN_APP_KF_STATE_ALT, Altitude, Kf->BaroVar);
+
+} /* End of HYUN_APP_KF_UpdateBaro() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_KF_UpdateAccel -- Fuse one vertical acceleration       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_KF_UpdateAccel(HYUN_APP_KF_t *Kf, float VertAccel)
+{
+    if (Kf->NumStates == 2)
+    {
+        /* Control input: held until the next IMU sample */
+        Kf->Accel = VertAccel;
+    }
+    else if (Kf->Initialized)
+    {
+        HYUN_APP_KF_ScalarUpdate(Kf, HYUN_APP_KF_STATE_ACCEL, VertAccel, Kf->AccelVar);
+    }
+
+} /* End of HYUN_APP_KF_UpdateAccel() */
+
+/*
+** Predict up to TimeUs. Samples older than the last one seen are
+** applied without prediction.
+*/
+static void HYUN_APP_KF_Advance(HYUN_APP_KF_t *Kf, uint64 TimeUs)
+{
+    if (Kf->LastTimeUs != 0 && TimeUs > Kf->LastTimeUs)
+    {
+        HYUN_APP_KF_Predict(Kf, (float)(TimeUs - Kf->LastTimeUs) * 1.0e-6f);
+    }
+    if (TimeUs > Kf->LastTimeUs)
+    {
+        Kf->LastTimeUs = TimeUs;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_KF_Step                                                   */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Predict up to TimeUs, then fuse the measurements taken at that     */
+/*         instant that are set in Mask (HYUN_APP_KF_MEAS_*). VertAccel has   */
+/*         gravity removed already. Steps are expected in time order.         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+void HYUN_APP_KF_Step(HYUN_APP_KF_t *Kf, uint64 TimeUs, uint8 Mask, float Altitude, float VertAccel)
+{
+    HYUN_APP_KF_Advance(Kf, TimeUs);
+
+    if (Mask & HYUN_APP_KF_MEAS_ACCEL)
+    {
+        HYUN_APP_KF_UpdateAccel(Kf, VertAccel);
+    }
+    if (Mask & HYUN_APP_KF_MEAS_BARO)
+    {
+        HYUN_APP_KF_UpdateBaro(Kf, Altitude);
+    }
+
+} /* End of HYUN_APP_KF_Step() */
@@ -0,0 +1,101 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Altitude / vertical velocity Kalman estimator
+ *
+ * Two models are supported:
+ *   - 2 states [h, v]    : vertical acceleration is a control input,
+ *                          barometric altitude is the measurement.
+ *   - 3 states [h, v, a] : acceleration is a state, both barometric
+ *                          altitude and accelerometer are measurements.
+ *
+ * All storage is fixed size. Measurements are applied as sequential
+ * scalar updates, so no matrix inversion is ever needed.
+ *
+ * Only depends on the OSAL base types so the estimator also builds on
+ * the host under tools/. Feeding it from the sensor rings and publishing
+ * the estimate are done by the sensor pipeline.
+ */
+
+#ifndef HYUN_APP_KF_H
+#define HYUN_APP_KF_H
+
+#include "common_types.h"
+
+/***********************************************************************/
+#define HYUN_APP_KF_MAX_STATES     3
+#define HYUN_APP_KF_DEFAULT_STATES 3
+
+#define HYUN_APP_KF_GRAVITY   9.80665f /* [m/s^2] subtracted from the IMU Z axis */
+#define HYUN_APP_KF_MAX_DT    1.5f     /* [s] longer gaps are clamped, above the 1 Hz SIMP period */
+#define HYUN_APP_KF_INIT_VAR  100.0f   /* Initial variance of every state */
+#define HYUN_APP_KF_BARO_VAR  0.25f    /* Baro altitude noise [m^2] */
+#define HYUN_APP_KF_ACCEL_VAR 0.5f     /* Accelerometer noise [(m/s^2)^2] */
+#define HYUN_APP_KF_PROC_VAR  1.0f     /* Process noise (accel for 2-state, jerk for 3-state) */
+
+#define HYUN_APP_KF_STATE_ALT   0
+#define HYUN_APP_KF_STATE_VEL   1
+#define HYUN_APP_KF_STATE_ACCEL 2
+
+/*
+** HYUN_APP_KF_Step measurement mask
+*/
+#define HYUN_APP_KF_MEAS_BARO  0x01
+#define HYUN_APP_KF_MEAS_ACCEL 0x02
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    uint8 NumStates;
+    bool  Initialized;
+
+    float X[HYUN_APP_KF_MAX_STATES];
+    float P[HYUN_APP_KF_MAX_STATES][HYUN_APP_KF_MAX_STATES];
+
+    float Accel; /* Last vertical acceleration, control input of the 2-state model */
+
+    float ProcessVar;
+    float BaroVar;
+    float AccelVar;
+
+    uint64 LastTimeUs;
+    uint32 PredictCounter;
+    uint32 UpdateCounter;
+} HYUN_APP_KF_t;
+
+/****************************************************************************/
+/*
+** Estimator prototypes
+*/
+void HYUN_APP_KF_Init(HYUN_APP_KF_t *Kf, uint8 NumStates);
+void HYUN_APP_KF_Predict(HYUN_APP_KF_t *Kf, float Dt);
+void HYUN_APP_KF_UpdateBaro(HYUN_APP_KF_t *Kf, float Altitude);
+void HYUN_APP_KF_UpdateAccel(HYUN_APP_KF_t *Kf, float VertAccel);
+void HYUN_APP_KF_Step(HYUN_APP_KF_t *Kf, uint64 TimeUs, uint8 Mask, float Altitude, float VertAccel);
+
+#endif /* HYUN_APP_KF_H */
@@ -29,12 +29,20 @@
 #ifndef HYUN_APP_MSG_H
 #define HYUN_APP_MSG_H
 
+#include "hyun_app_codec.h"
+#include "hyun_app_msgdefs.h"
+
 /*
-** SAMPLE App command codes
+** SAMPLE App command codes, HYUN_APP_<Name>_CC (see hyun_app_msgdefs.h)
 */
-#define HYUN_APP_NOOP_CC           0
-#define HYUN_APP_RESET_COUNTERS_CC 1
-#define HYUN_APP_PROCESS_CC        2
+#define HYUN_APP_MSG_CC(Name, CC, Type, Handler) HYUN_APP_##Name##_CC = (CC),
+
+enum
+{
+    HYUN_APP_CMD_DEFS(HYUN_APP_MSG_CC)
+};
+
+CompileTimeAssert(HYUN_APP_CMD_CODE_SET == (1u << HYUN_APP_CMD_COUNT) - 1, HYUN_APP_CmdCodesNotDense);
 
 /*************************************************************************/
 
@@ -56,24 +64,121 @@ typedef struct
 typedef HYUN_APP_NoArgsCmd_t HYUN_APP_NoopCmd_t;
 typedef HYUN_APP_NoArgsCmd_t HYUN_APP_ResetCountersCmd_t;
 typedef HYUN_APP_NoArgsCmd_t HYUN_APP_ProcessCmd_t;
+typedef HYUN_APP_NoArgsCmd_t HYUN_APP_ReplayStopCmd_t;
+typedef HYUN_APP_NoArgsCmd_t HYUN_APP_TtagListCmd_t;
+
+/*
+** Messages with a payload, the payload structs come from the schema.
+** A padded payload would make the struct and wire layouts differ.
+*/
+#define HYUN_APP_MSG_HEADER_Cmd CFE_MSG_CommandHeader_t CmdHeader;
+#define HYUN_APP_MSG_HEADER_Tlm CFE_MSG_TelemetryHeader_t TlmHeader;
+
+#define HYUN_APP_MSG_TYPE(Name, Kind, Fields)                                                \
+    typedef struct                                                                           \
+    {                                                                                        \
+        HYUN_APP_MSG_HEADER_##Kind                                                           \
+        HYUN_APP_##Name##_Payload_t Payload;                                                 \
+    } HYUN_APP_##Name##_t;                                                                   \
+    CompileTimeAssert(sizeof(HYUN_APP_##Name##_Payload_t) == HYUN_APP_MSG_WIRE_SIZE(Fields), \
+                      HYUN_APP_##Name##_Padded);
+
+HYUN_APP_PAYLOAD_DEFS(HYUN_APP_MSG_TYPE)
 
 /*************************************************************************/
 /*
-** Type definition (SAMPLE App housekeeping)
+** Type definition (compressed downlink wrapper, see hyun_app_codec.h)
+**
+** Sent with only the used part of Payload.Data.
 */
 
 typedef struct
 {
-    uint8 CommandErrorCounter;
-    uint8 CommandCounter;
-    uint8 spare[2];
-} HYUN_APP_HkTlm_Payload_t;
+    CFE_MSG_TelemetryHeader_t TlmHeader; /**< \brief Telemetry header */
+    HYUN_APP_CodecFrame_t     Payload;   /**< \brief Codec frame */
+} HYUN_APP_CompressedTlm_t;
+
+/*************************************************************************/
+/*
+** Sensor telemetry received on HYUN_PIPE_1
+**
+** These are published by the spacey sensor apps, HYUN_APP only reads them.
+** libs/spacey.h does not define these packets, so the layouts below are
+** this app's assumption (little-endian floats, no padding) and must be
+** checked against the sensor apps. Ingest rejects any packet whose length
+** does not match, counted in SensorErrCounter, so a mismatch shows up in
+** HK rather than as bad samples.
+*/
+
+typedef struct
+{
+    float Pressure;    /**< \brief Static pressure [Pa] */
+    float Altitude;    /**< \brief Barometric altitude [m] */
+    float Temperature; /**< \brief Sensor temperature [degC] */
+} HYUN_APP_BaroTlm_Payload_t;
 
 typedef struct
 {
     CFE_MSG_TelemetryHeader_t  TlmHeader; /**< \brief Telemetry header */
-    HYUN_APP_HkTlm_Payload_t Payload;   /**< \brief Telemetry payload */
-} HYUN_APP_HkTlm_t;
+    HYUN_APP_BaroTlm_Payload_t Payload;   /**< \brief Telemetry payload */
+} HYUN_APP_BaroTlm_t;
+
+typedef struct
+{
+    int32 LatitudeE7;  /**< \brief Latitude [deg * 1e7] */
+    int32 LongitudeE7; /**< \brief Longitude [deg * 1e7] */
+    float Altitude;    /**< \brief Altitude above MSL [m] */
+    uint8 Satellites;  /**< \brief Satellites in use */
+    uint8 FixValid;    /**< \brief Non-zero when the fix is valid */
+    uint8 spare[2];
+} HYUN_APP_GpsTlm_Payload_t;
 
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t TlmHeader; /**< \brief Telemetry header */
+    HYUN_APP_GpsTlm_Payload_t Payload;   /**< \brief Telemetry payload */
+} HYUN_APP_GpsTlm_t;
+
+/*
+** Raw GPS UART bytes. Length is the number of valid bytes in Data;
+** NMEA sentences may be split across consecutive packets.
+*/
+#define HYUN_APP_GPS_RAW_DATA_SIZE 128
+
+typedef struct
+{
+    uint16 Length;
+    uint8  spare[2];
+    uint8  Data[HYUN_APP_GPS_RAW_DATA_SIZE];
+} HYUN_APP_GpsRawTlm_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t    TlmHeader; /**< \brief Telemetry header */
+    HYUN_APP_GpsRawTlm_Payload_t Payload;   /**< \brief Telemetry payload */
+} HYUN_APP_GpsRawTlm_t;
+
+typedef struct
+{
+    float Accel[3]; /**< \brief Body acceleration X/Y/Z [m/s^2] */
+    float Gyro[3];  /**< \brief Body rate X/Y/Z [deg/s] */
+} HYUN_APP_ImuTlm_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t TlmHeader; /**< \brief Telemetry header */
+    HYUN_APP_ImuTlm_Payload_t Payload;   /**< \brief Telemetry payload */
+} HYUN_APP_ImuTlm_t;
+
+typedef struct
+{
+    float Voltage; /**< \brief Battery voltage [V] */
+} HYUN_APP_VoltageTlm_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t     TlmHeader; /**< \brief Telemetry header */
+    HYUN_APP_VoltageTlm_Payload_t Payload;   /**< \brief Telemetry payload */
+} HYUN_APP_VoltageTlm_t;
 
 #endif /* HYUN_APP_MSG_H */
@@ -0,0 +1,353 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * HYUN_APP message schema
+ *
+ * Every command code and every payload the app owns is listed here once,
+ * as X-macro tables. hyun_app_msg.h expands them into the CC constants,
+ * payload structs and message types, hyun_app.c into the command length
+ * table and dispatcher, and hyun_app_wire.c into the big-endian encode
+ * and decode routines of the host tools. Adding a field or a command is
+ * a change to this file only.
+ *
+ * Payload fields are listed in wire order as F(Type, Name) for scalars
+ * and A(Type, Name, Count) for arrays. Each payload must be free of
+ * padding, which hyun_app_msg.h checks at compile time, so the struct
+ * layout and the wire layout can not drift apart.
+ *
+ * MIDs stay in the platform hyun_app_msgids.h so a mission can remap
+ * them without touching the schema.
+ *
+ * Only depends on the OSAL base types so the generated payloads and wire
+ * routines also build on the host under tools/.
+ */
+
+#ifndef HYUN_APP_MSGDEFS_H
+#define HYUN_APP_MSGDEFS_H
+
+#include "common_types.h"
+#include "hyun_app_uplink.h"
+
+/***********************************************************************/
+#define HYUN_APP_REPLAY_PATH_LEN 64
+
+/*
+** Time-tagged commands (see hyun_app_ttag.h)
+*/
+#define HYUN_APP_TTAG_CAPACITY 16 /* Commands queued at once */
+#define HYUN_APP_TTAG_MAX_CMD  96 /* Largest embedded command packet, header included [bytes] */
+
+/*
+** Command sequences (see hyun_app_seq.h)
+*/
+#define HYUN_APP_SEQ_NAME_LEN 16
+
+/*
+** Chunked file downlink (see hyun_app_file.h)
+*/
+#define HYUN_APP_FILE_PATH_LEN   64
+#define HYUN_APP_FILE_CHUNK_SIZE 192 /* File bytes per chunk, the packet fits one downlink slot */
+
+/*
+** Downlink priority classes, highest first (see hyun_app_downlink.h)
+*/
+#define HYUN_APP_DOWNLINK_CRITICAL 0 /* Flight estimate and aligned sensor frames */
+#define HYUN_APP_DOWNLINK_HK       1
+#define HYUN_APP_DOWNLINK_DEBUG    2 /* Everything else */
+#define HYUN_APP_DOWNLINK_FILE     3 /* File chunks, only what all other traffic leaves */
+#define HYUN_APP_DOWNLINK_CLASSES  4
+
+/*
+** Message buffer pools (see hyun_app_pool.h)
+*/
+#define HYUN_APP_POOL_HK     0
+#define HYUN_APP_POOL_CHAR20 1 /* rcvtest string packet */
+#define HYUN_APP_POOL_TTAG   2 /* Time-tag queue listing */
+#define HYUN_APP_POOLS       3
+
+/************************************************************************
+** Ground commands on HYUN_APP_MID_GROUNDCMD_REQ
+**
+**   X(Name, CC, Message type, Handler)
+**
+** Codes must run from 0 without gaps; the dispatcher indexes its length
+** table with the CC.
+*************************************************************************/
+#define HYUN_APP_CMD_DEFS(X)                                                            \
+    X(NOOP, 0, HYUN_APP_NoopCmd_t, HYUN_APP_Noop)                                       \
+    X(RESET_COUNTERS, 1, HYUN_APP_ResetCountersCmd_t, HYUN_APP_ResetCounters)           \
+    X(PROCESS, 2, HYUN_APP_ProcessCmd_t, HYUN_APP_Process)                              \
+    X(TEXT_CMD, 3, HYUN_APP_TextCmd_t, HYUN_APP_TextCommand)                            \
+    X(REPLAY_START, 4, HYUN_APP_ReplayStartCmd_t, HYUN_APP_ReplayStartCmd)              \
+    X(REPLAY_STOP, 5, HYUN_APP_ReplayStopCmd_t, HYUN_APP_ReplayStopCmd)                 \
+    X(TTAG_INSERT, 6, HYUN_APP_TtagInsertCmd_t, HYUN_APP_TtagInsertCmd)                 \
+    X(TTAG_CANCEL, 7, HYUN_APP_TtagCancelCmd_t, HYUN_APP_TtagCancelCmd)                 \
+    X(TTAG_LIST, 8, HYUN_APP_TtagListCmd_t, HYUN_APP_TtagListCmd)                       \
+    X(SEQ_START, 9, HYUN_APP_SeqStartCmd_t, HYUN_APP_SeqStartCmd)                       \
+    X(FILE_START, 10, HYUN_APP_FileStartCmd_t, HYUN_APP_FileStartCmd)                   \
+    X(FILE_ACK, 11, HYUN_APP_FileAckCmd_t, HYUN_APP_FileAckCmd)                         \
+    X(FILE_CANCEL, 12, HYUN_APP_FileCancelCmd_t, HYUN_APP_FileCancelCmd)
+
+/************************************************************************
+** Payloads
+**
+**   P(Name, Cmd | Tlm, Fields) gives HYUN_APP_<Name>_Payload_t and the
+**   message type HYUN_APP_<Name>_t with a command or telemetry header.
+*************************************************************************/
+#define HYUN_APP_PAYLOAD_DEFS(P)                           \
+    P(TextCmd, Cmd, HYUN_APP_TEXT_CMD_FIELDS)              \
+    P(ReplayStartCmd, Cmd, HYUN_APP_REPLAY_START_FIELDS)   \
+    P(TtagInsertCmd, Cmd, HYUN_APP_TTAG_INSERT_FIELDS)     \
+    P(TtagCancelCmd, Cmd, HYUN_APP_TTAG_CANCEL_FIELDS)     \
+    P(TtagListTlm, Tlm, HYUN_APP_TTAG_LIST_TLM_FIELDS)     \
+    P(SeqStartCmd, Cmd, HYUN_APP_SEQ_START_FIELDS)         \
+    P(FileStartCmd, Cmd, HYUN_APP_FILE_START_FIELDS)       \
+    P(FileAckCmd, Cmd, HYUN_APP_FILE_ACK_FIELDS)           \
+    P(FileCancelCmd, Cmd, HYUN_APP_FILE_CANCEL_FIELDS)     \
+    P(FileDataTlm, Tlm, HYUN_APP_FILE_DATA_TLM_FIELDS)     \
+    P(HkTlm, Tlm, HYUN_APP_HK_TLM_FIELDS)                  \
+    P(EstimateTlm, Tlm, HYUN_APP_ESTIMATE_TLM_FIELDS)      \
+    P(AlignedTlm, Tlm, HYUN_APP_ALIGNED_TLM_FIELDS)
+
+/*
+** CANSAT text command as relayed from the ground station radio,
+** e.g. "CMD,1000,CX,ON". Terminated by NUL, CR or LF, or by the end of Text.
+*/
+#define HYUN_APP_TEXT_CMD_FIELDS(F, A) \
+    A(char, Text, HYUN_APP_UPLINK_MAX_TEXT)
+
+/*
+** Start a SIM mode pressure replay (see hyun_app_replay.h)
+*/
+#define HYUN_APP_REPLAY_START_FIELDS(F, A)                                              \
+    A(char, Filename, HYUN_APP_REPLAY_PATH_LEN) /* Profile on the flight file system */ \
+    F(uint16, Speed)                            /* 1 = real time, N = N x, 0 = as fast as possible */ \
+    F(uint16, PeriodMs)                         /* Profile sample period, 0 = 1000 ms */
+
+/*
+** Queue a command for execution at a MET. Cmd holds a complete ground
+** command packet for HYUN_APP_MID_GROUNDCMD_REQ, CmdLength bytes of it.
+*/
+#define HYUN_APP_TTAG_INSERT_FIELDS(F, A)                                                  \
+    F(uint32, TagId)                        /* Chosen by the ground, non-zero and unique */ \
+    F(uint32, MetSeconds)                   /* Execution time, MET */                     \
+    F(uint32, MetMicros)                    /* 0..999999 */                                \
+    F(uint16, CmdLength)                    /* Bytes used in Cmd */                        \
+    F(uint16, spare)                                                                       \
+    A(uint8, Cmd, HYUN_APP_TTAG_MAX_CMD)
+
+/*
+** Drop a queued command before it runs
+*/
+#define HYUN_APP_TTAG_CANCEL_FIELDS(F, A) \
+    F(uint32, TagId)
+
+/*
+** Queued time-tagged commands, soonest first, sent on TTAG_LIST
+*/
+#define HYUN_APP_TTAG_LIST_TLM_FIELDS(F, A)                                                  \
+    F(uint16, Pending)                               /* Entries used below */               \
+    F(uint16, spare)                                                                         \
+    A(uint32, TagId, HYUN_APP_TTAG_CAPACITY)                                                 \
+    A(uint32, MetSeconds, HYUN_APP_TTAG_CAPACITY)                                            \
+    A(uint32, MetMicros, HYUN_APP_TTAG_CAPACITY)                                             \
+    A(uint8, CommandCode, HYUN_APP_TTAG_CAPACITY)    /* CC of each queued command */
+
+/*
+** Run a named sequence of the sequence table
+*/
+#define HYUN_APP_SEQ_START_FIELDS(F, A) \
+    A(char, Name, HYUN_APP_SEQ_NAME_LEN) /* NUL terminated unless all of Name is used */
+
+/*
+** Send a file as chunks Offset / HYUN_APP_FILE_CHUNK_SIZE onwards. A
+** transfer cut by link loss or a reset is resumed with the offset the
+** receiver has contiguously, the same TransferId and the same file.
+*/
+#define HYUN_APP_FILE_START_FIELDS(F, A)                                                          \
+    F(uint32, TransferId)                  /* Chosen by the ground, non-zero */                   \
+    F(uint32, Offset)                      /* First byte to send, a multiple of the chunk size */ \
+    A(char, Path, HYUN_APP_FILE_PATH_LEN)  /* File on the flight file system */
+
+/*
+** Receiver state: every chunk below AckSeq is held, and bit i of
+** SackMask marks chunk AckSeq + 1 + i as held out of order
+*/
+#define HYUN_APP_FILE_ACK_FIELDS(F, A) \
+    F(uint32, TransferId)              \
+    F(uint32, AckSeq)                  \
+    F(uint32, SackMask)
+
+/*
+** Stop sending, the receiver keeps what it has
+*/
+#define HYUN_APP_FILE_CANCEL_FIELDS(F, A) \
+    F(uint32, TransferId)
+
+/*
+** One chunk, at byte Seq * HYUN_APP_FILE_CHUNK_SIZE of the file
+*/
+#define HYUN_APP_FILE_DATA_TLM_FIELDS(F, A)                                                     \
+    F(uint32, TransferId)                                                                       \
+    F(uint32, Seq)                                                                              \
+    F(uint32, FileSize)                       /* [bytes] */                                     \
+    F(uint16, Length)                         /* Bytes used in Data, short on the last chunk */ \
+    F(uint16, Flags)                          /* HYUN_APP_FILE_FLAG_xxx */                      \
+    A(uint8, Data, HYUN_APP_FILE_CHUNK_SIZE)
+
+/*
+** Housekeeping
+*/
+#define HYUN_APP_HK_TLM_FIELDS(F, A)                                                                         \
+    F(uint8, CommandErrorCounter)                                                                            \
+    F(uint8, CommandCounter)                                                                                 \
+    F(uint8, TelemetryEnabled)                        /* CX ON / OFF */                                      \
+    F(uint8, SimMode)                                 /* HYUN_APP_SIM_xxx */                                 \
+    F(uint32, SensorMsgCounter)                       /* Sensor packets accepted from HYUN_PIPE_1 */         \
+    F(uint32, SensorDropCounter)                      /* Samples overwritten before processing */            \
+    F(uint16, SensorErrCounter)                       /* Sensor packets rejected (length / MID) */           \
+    F(uint16, SensorLastBatch)                        /* Packets drained in the last cycle */                \
+    F(uint32, GpsSentenceCounter)                     /* NMEA sentences parsed into fixes */                 \
+    F(uint16, GpsChecksumErrCounter)                  /* NMEA sentences with a bad checksum */               \
+    F(uint16, GpsFormatErrCounter)                    /* NMEA sentences dropped as malformed */              \
+    F(float, BaroSpread)                              /* Max - min baro altitude over the filter window [m] */ \
+    F(float, Voltage)                                 /* Smoothed battery voltage [V] */                     \
+    F(uint32, DownlinkInBytes)                        /* Telemetry payload bytes given to a downlink codec */ \
+    F(uint32, DownlinkOutBytes)                       /* Bytes actually sent for them */                     \
+    F(uint32, ReplaySampleCounter)                    /* Pressure samples of the current / last replay */    \
+    A(uint16, DownlinkQueueDepth, HYUN_APP_DOWNLINK_CLASSES)     /* Packets waiting for link budget */       \
+    A(uint16, DownlinkQueueHighWater, HYUN_APP_DOWNLINK_CLASSES) /* Deepest queue since reset */             \
+    A(uint32, DownlinkDropCounter, HYUN_APP_DOWNLINK_CLASSES)    /* Packets dropped on a full queue */       \
+    F(uint32, DownlinkSentBytes)                      /* Bytes released to the radio */                      \
+    F(uint32, CdsCommitCounter)                       /* Critical Data Store writes */                       \
+    F(uint32, CdsRestoreUs)                           /* Time to register and restore the CDS [us] */        \
+    F(uint32, InitUs)                                 /* HYUN_APP_Init entry to ready for commands [us] */   \
+    F(uint32, TblLoadUs)                              /* Table file load, 0 while still pending [us] */      \
+    A(uint16, PoolHighWater, HYUN_APP_POOLS)          /* Most buffers in use at once */                      \
+    A(uint16, PoolExhaustedCounter, HYUN_APP_POOLS)   /* Packets skipped, no free buffer */                  \
+    F(uint32, UdpTlmDatagramCounter)                  /* Datagrams sent to the UDP telemetry port */         \
+    F(uint32, UdpTlmDropCounter)                      /* Packets too large or refused by the socket */       \
+    F(uint32, UdpTlmDatagramsPerSec)                  /* Send rate over the last second */                   \
+    F(uint32, UdpTlmBytesPerSec)                      /* Byte rate over the last second */                   \
+    F(uint32, UdpCmdPacketCounter)                    /* UDP commands put on the bus */                      \
+    F(uint32, UdpCmdRejectCounter)                    /* UDP datagrams with a bad header, length or MID */   \
+    F(uint32, UdpCmdDropCounter)                      /* UDP commands lost in the socket queue or SB */      \
+    F(uint32, UdpCmdPacketsPerSec)                    /* Command rate over the last second */                \
+    F(uint32, XbeeFrameCounter)                       /* XBee API frames written to the radio */             \
+    F(uint32, XbeeDropCounter)                        /* Frames the serial device did not take */            \
+    F(uint16, XbeeFramesPerSec)                       /* Frame rate over the last second */                  \
+    F(uint16, XbeeBytesPerSec)                        /* Wire bytes over the last second, escapes included */ \
+    F(uint16, XbeeBudgetBytesPerSec)                  /* What the baud rate carries, 0 = radio closed */     \
+    F(uint16, XbeeOverBudgetCounter)                  /* Seconds that needed more than the budget */         \
+    F(uint16, SubChangeCounter)                       /* Subscribe / unsubscribe / pipe recreate operations */ \
+    F(uint16, SubErrCounter)                          /* Table subscriptions SB refused */                   \
+    F(uint32, HandoffDropCounter)                     /* Requests / HK packets the data task had no room for */ \
+    F(uint16, TtagPending)                            /* Time-tagged commands queued */                      \
+    F(uint16, TtagExecCounter)                        /* Time-tagged commands dispatched */                  \
+    F(uint32, TtagLastJitterUs)                       /* Dispatch time - tagged time, last command [us] */   \
+    F(uint32, TtagMaxJitterUs)                        /* Worst dispatch time - tagged time [us] */           \
+    F(uint16, SeqRunCounter)                          /* Sequences run to the end */                         \
+    F(uint16, SeqAbortCounter)                        /* Sequences refused or stopped at a failed step */    \
+    F(uint32, SeqLastRunUs)                           /* Last sequence, all steps dispatched [us] */         \
+    F(uint32, RecordCounter)                          /* Packets appended to the on-board archive */         \
+    F(uint32, RecordDropCounter)                      /* Packets too large or lost with a failed write */    \
+    F(uint32, RecordBytes)                            /* Archive data written this run */                    \
+    F(uint32, FileTransferId)                         /* Transfer being sent, 0 = none */                    \
+    F(uint32, FileAckedBytes)                         /* Bytes the receiver holds contiguously */            \
+    F(uint16, FileResendCounter)                      /* Chunks sent again, all transfers */                 \
+    F(uint16, FileTimeoutCounter)                     /* Acknowledgement timeouts, all transfers */
+
+/*
+** Altitude / vertical velocity estimate
+*/
+#define HYUN_APP_ESTIMATE_TLM_FIELDS(F, A)                                     \
+    F(float, Altitude)          /* Estimated altitude [m] */                   \
+    F(float, Velocity)          /* Estimated vertical velocity, up positive [m/s] */ \
+    F(float, AltitudeVar)       /* Altitude variance [m^2] */                  \
+    F(float, VelocityVar)       /* Velocity variance [(m/s)^2] */              \
+    F(uint32, PredictCounter)   /* Predict steps since init */                 \
+    F(uint32, UpdateCounter)    /* Measurement updates since init */           \
+    F(uint8, NumStates)         /* Estimator model (2 or 3 states) */          \
+    F(uint8, Valid)             /* Non-zero once seeded by a baro sample */    \
+    F(uint8, FlightState)       /* HYUN_APP_FLIGHT_xxx */                      \
+    F(uint8, spare)                                                            \
+    F(uint32, TransitionCounter) /* Flight state changes since init */         \
+    F(uint32, LastLatencyUs)    /* Sample arrival -> last state change [us] */ \
+    F(uint32, MaxLatencyUs)     /* Worst sample arrival -> state change [us] */
+
+/*
+** Sensor frame resampled onto the common tick. The header time stamp is
+** the tick instant, not the send time.
+*/
+#define HYUN_APP_ALIGNED_TLM_FIELDS(F, A)                                                   \
+    F(uint32, FrameCounter)   /* Aligned frames emitted since init */                       \
+    F(uint32, AddedLatencyUs) /* Tick instant -> emission of this frame [us] */             \
+    F(float, Pressure)        /* Static pressure [Pa] */                                    \
+    F(float, Altitude)        /* Median filtered barometric altitude [m] */                 \
+    F(float, Temperature)     /* Baro sensor temperature [degC] */                          \
+    A(float, Accel, 3)        /* Body acceleration X/Y/Z [m/s^2] */                         \
+    A(float, Gyro, 3)         /* Body rate X/Y/Z [deg/s] */                                 \
+    F(int32, LatitudeE7)      /* Latitude [deg * 1e7] */                                    \
+    F(int32, LongitudeE7)     /* Longitude [deg * 1e7] */                                   \
+    F(float, GpsAltitude)     /* GPS altitude above MSL [m] */                              \
+    F(float, Voltage)         /* Battery voltage [V] */                                     \
+    F(uint8, GpsSatellites)   /* Satellites in use */                                       \
+    F(uint8, ValidMask)       /* HYUN_APP_ALIGN_xxx streams with data */                    \
+    F(uint8, HoldMask)        /* Streams held at their last sample instead of interpolated */ \
+    F(uint8, FlightState)     /* HYUN_APP_FLIGHT_xxx */
+
+/************************************************************************
+** Generators
+*************************************************************************/
+
+/*
+** Payload structs
+*/
+#define HYUN_APP_MSG_FIELD(Type, Name)        Type Name;
+#define HYUN_APP_MSG_ARRAY(Type, Name, Count) Type Name[Count];
+#define HYUN_APP_MSG_PAYLOAD(Name, Kind, Fields)               \
+    typedef struct                                             \
+    {                                                          \
+        Fields(HYUN_APP_MSG_FIELD, HYUN_APP_MSG_ARRAY)         \
+    } HYUN_APP_##Name##_Payload_t;
+
+HYUN_APP_PAYLOAD_DEFS(HYUN_APP_MSG_PAYLOAD)
+
+/*
+** Wire size of a payload, the sum of its field sizes
+*/
+#define HYUN_APP_MSG_FIELD_SIZE(Type, Name)        +sizeof(Type)
+#define HYUN_APP_MSG_ARRAY_SIZE(Type, Name, Count) +sizeof(Type) * (Count)
+#define HYUN_APP_MSG_WIRE_SIZE(Fields)             (0 Fields(HYUN_APP_MSG_FIELD_SIZE, HYUN_APP_MSG_ARRAY_SIZE))
+
+/*
+** Command code count and the set of codes used, one bit per code
+*/
+#define HYUN_APP_MSG_CMD_ONE(Name, CC, Type, Handler) +1
+#define HYUN_APP_MSG_CMD_BIT(Name, CC, Type, Handler) | (1u << (CC))
+#define HYUN_APP_CMD_COUNT                            (0 HYUN_APP_CMD_DEFS(HYUN_APP_MSG_CMD_ONE))
+#define HYUN_APP_CMD_CODE_SET                         (0 HYUN_APP_CMD_DEFS(HYUN_APP_MSG_CMD_BIT))
+
+#endif /* HYUN_APP_MSGDEFS_H */
@@ -0,0 +1,378 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_nmea.c
+**
+** Purpose:
+**   Byte-at-a-time NMEA GGA / RMC parser with incremental checksum and
+**   fixed-point coordinate conversion.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "hyun_app_nmea.h"
+
+/*
+** Parser states
+*/
+#define HYUN_APP_NMEA_WAIT_START 0
+#define HYUN_APP_NMEA_BODY       1
+#define HYUN_APP_NMEA_CKSUM_HI   2
+#define HYUN_APP_NMEA_CKSUM_LO   3
+
+#define HYUN_APP_NMEA_KEY(a, b, c) (((uint32)(a) << 16) | ((uint32)(b) << 8) | (uint32)(c))
+
+#define HYUN_APP_NMEA_GGA_FIELDS 9 /* Last field used: altitude */
+#define HYUN_APP_NMEA_RMC_FIELDS 6 /* Last field used: E/W */
+
+#define HYUN_APP_NMEA_INT_LIMIT 100000000u /* More integer digits than any used field */
+
+static const uint32 HYUN_APP_NmeaPow10[HYUN_APP_NMEA_FRAC_DIGITS + 1] = {1,      10,      100,      1000,
+                                                                         10000,  100000,  1000000,  10000000};
+
+static void  HYUN_APP_NmeaStart(HYUN_APP_NmeaParser_t *Parser);
+static void  HYUN_APP_NmeaAbort(HYUN_APP_NmeaParser_t *Parser);
+static void  HYUN_APP_NmeaEndField(HYUN_APP_NmeaParser_t *Parser);
+static int32 HYUN_APP_NmeaCoordE7(const HYUN_APP_NmeaField_t *Field);
+static int8  HYUN_APP_NmeaHex(uint8 c);
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_NmeaInit -- Reset parser state and counters            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_NmeaInit(HYUN_APP_NmeaParser_t *Parser)
+{
+    memset(Parser, 0, sizeof(*Parser));
+    Parser->State = HYUN_APP_NMEA_WAIT_START;
+
+} /* End of HYUN_APP_NmeaInit() */
+
+static void HYUN_APP_NmeaStart(HYUN_APP_NmeaParser_t *Parser)
+{
+    Parser->State      = HYUN_APP_NMEA_BODY;
+    Parser->Type       = HYUN_APP_NMEA_TYPE_NONE;
+    Parser->FieldIndex = 0;
+    Parser->Checksum   = 0;
+    Parser->Length     = 1;
+    Parser->TypeKey    = 0;
+
+    memset(&Parser->Field, 0, sizeof(Parser->Field));
+    memset(&Parser->Work, 0, sizeof(Parser->Work));
+}
+
+static void HYUN_APP_NmeaAbort(HYUN_APP_NmeaParser_t *Parser)
+{
+    Parser->FormatErrCounter++;
+    Parser->State = HYUN_APP_NMEA_WAIT_START;
+}
+
+static int8 HYUN_APP_NmeaHex(uint8 c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return (int8)(c - '0');
+    }
+    if (c >= 'A' && c <= 'F')
+    {
+        return (int8)(c - 'A' + 10);
+    }
+    return -1;
+}
+
+/*
+** ddmm.mmmm (or dddmm.mmmm) to degrees * 1e7 in integer arithmetic
+*/
+static int32 HYUN_APP_NmeaCoordE7(const HYUN_APP_NmeaField_t *Field)
+{
+    uint64 MinutesE7;
+    uint64 DegreesE7;
+
+    MinutesE7 = (uint64)(Field->IntPart % 100u) * 10000000u +
+                (uint64)Field->Frac * HYUN_APP_NmeaPow10[HYUN_APP_NMEA_FRAC_DIGITS - Field->FracDigits];
+    DegreesE7 = (uint64)(Field->IntPart / 100u) * 10000000u + MinutesE7 / 60u;
+
+    return (int32)DegreesE7;
+}
+
+/*
+** Apply a completed field to the fix under construction
+*/
+static void HYUN_APP_NmeaEndField(HYUN_APP_NmeaParser_t *Parser)
+{
+    const HYUN_APP_NmeaField_t *Field = &Parser->Field;
+    HYUN_APP_NmeaFix_t         *Work  = &Parser->Work;
+    float                       Value;
+
+    if (Field->Overflow)
+    {
+        HYUN_APP_NmeaAbort(Parser);
+        return;
+    }
+
+    if (Parser->FieldIndex == 0)
+    {
+        /* Address field, e.g. GPGGA / GNRMC. Other sentences are skipped. */
+        if (Parser->TypeKey == HYUN_APP_NMEA_KEY('G', 'G', 'A'))
+        {
+            Parser->Type = HYUN_APP_NMEA_TYPE_GGA;
+        }
+        else if (Parser->TypeKey == HYUN_APP_NMEA_KEY('R', 'M', 'C'))
+        {
+            Parser->Type = HYUN_APP_NMEA_TYPE_RMC;
+        }
+        else
+        {
+            Parser->State = HYUN_APP_NMEA_WAIT_START;
+        }
+        Work->Type = Parser->Type;
+        return;
+    }
+
+    if (Field->Len == 0)
+    {
+        return;
+    }
+
+    if (Parser->Type == HYUN_APP_NMEA_TYPE_GGA)
+    {
+        switch (Parser->FieldIndex)
+        {
+            case 2:
+                Work->LatitudeE7 = HYUN_APP_NmeaCoordE7(Field);
+                break;
+            case 3:
+                if (Field->Letter == 'S')
+                {
+                    Work->LatitudeE7 = -Work->LatitudeE7;
+                }
+                break;
+            case 4:
+                Work->LongitudeE7 = HYUN_APP_NmeaCoordE7(Field);
+                break;
+            case 5:
+                if (Field->Letter == 'W')
+                {
+                    Work->LongitudeE7 = -Work->LongitudeE7;
+                }
+                break;
+            case 6:
+                Work->FixValid = (Field->IntPart > 0);
+                break;
+            case 7:
+                Work->Satellites = (uint8)((Field->IntPart > 255u) ? 255u : Field->IntPart);
+                break;
+            case 9:
+                Value = (float)Field->IntPart + (float)Field->Frac / (float)HYUN_APP_NmeaPow10[Field->FracDigits];
+                Work->Altitude = Field->Negative ? -Value : Value;
+                break;
+            default:
+                break;
+        }
+    }
+    else
+    {
+        switch (Parser->FieldIndex)
+        {
+            case 2:
+                Work->FixValid = (Field->Letter == 'A');
+                break;
+            case 3:
+                Work->LatitudeE7 = HYUN_APP_NmeaCoordE7(Field);
+                break;
+            case 4:
+                if (Field->Letter == 'S')
+                {
+                    Work->LatitudeE7 = -Work->LatitudeE7;
+                }
+                break;
+            case 5:
+                Work->LongitudeE7 = HYUN_APP_NmeaCoordE7(Field);
+                break;
+            case 6:
+                if (Field->Letter == 'W')
+                {
+                    Work->LongitudeE7 = -Work->LongitudeE7;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_NmeaFeed                                                  */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Consume bytes until one GGA / RMC sentence completes with a good   */
+/*         checksum or the input runs out. Returns the bytes consumed; the    */
+/*         caller loops on the remainder. *FixReady tells whether *Fix holds  */
+/*         a new fix. Parser state carries over between calls.                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+size_t HYUN_APP_NmeaFeed(HYUN_APP_NmeaParser_t *Parser, const uint8 *Data, size_t Len, HYUN_APP_NmeaFix_t *Fix,
+                         bool *FixReady)
+{
+    HYUN_APP_NmeaField_t *Field = &Parser->Field;
+    size_t                i;
+    uint8                 c;
+    int8                  Nibble;
+
+    *FixReady = false;
+
+    for (i = 0; i < Len; i++)
+    {
+        c = Data[i];
+
+        if (c == '$')
+        {
+            /* Start of sentence always resynchronizes */
+            HYUN_APP_NmeaStart(Parser);
+            continue;
+        }
+
+        switch (Parser->State)
+        {
+            case HYUN_APP_NMEA_BODY:
+                if (++Parser->Length > HYUN_APP_NMEA_MAX_SENTENCE || c < 0x20 || c > 0x7E)
+                {
+                    HYUN_APP_NmeaAbort(Parser);
+                    break;
+                }
+
+                if (c == '*')
+                {
+                    HYUN_APP_NmeaEndField(Parser);
+                    if (Parser->State == HYUN_APP_NMEA_BODY)
+                    {
+                        Parser->State = HYUN_APP_NMEA_CKSUM_HI;
+                    }
+                    break;
+                }
+
+                Parser->Checksum ^= c;
+
+                if (c == ',')
+                {
+                    HYUN_APP_NmeaEndField(Parser);
+                    Parser->FieldIndex++;
+                    memset(Field, 0, sizeof(*Field));
+                    break;
+                }
+
+                Field->Len++;
+                if (Parser->FieldIndex == 0)
+                {
+                    Parser->TypeKey = ((Parser->TypeKey << 8) | c) & 0xFFFFFFu;
+                }
+                else if (c >= '0' && c <= '9')
+                {
+                    if (!Field->InFrac)
+                    {
+                        if (Field->IntPart >= HYUN_APP_NMEA_INT_LIMIT)
+                        {
+                            Field->Overflow = true;
+                        }
+                        Field->IntPart = Field->IntPart * 10u + (uint32)(c - '0');
+                    }
+                    else if (Field->FracDigits < HYUN_APP_NMEA_FRAC_DIGITS)
+                    {
+                        Field->Frac = Field->Frac * 10u + (uint32)(c - '0');
+                        Field->FracDigits++;
+                    }
+                }
+                else if (c == '.')
+                {
+                    Field->InFrac = true;
+                }
+                else if (c == '-')
+                {
+                    Field->Negative = true;
+                }
+                else
+                {
+                    Field->Letter = (char)c;
+                }
+                break;
+
+            case HYUN_APP_NMEA_CKSUM_HI:
+                Nibble = HYUN_APP_NmeaHex(c);
+                if (Nibble < 0)
+                {
+                    HYUN_APP_NmeaAbort(Parser);
+                    break;
+                }
+                Parser->RxChecksum = (uint8)(Nibble << 4);
+                Parser->State      = HYUN_APP_NMEA_CKSUM_LO;
+                break;
+
+            case HYUN_APP_NMEA_CKSUM_LO:
+                Nibble        = HYUN_APP_NmeaHex(c);
+                Parser->State = HYUN_APP_NMEA_WAIT_START;
+                if (Nibble < 0)
+                {
+                    Parser->FormatErrCounter++;
+                    break;
+                }
+
+                Parser->RxChecksum |= (uint8)Nibble;
+                if (Parser->RxChecksum != Parser->Checksum)
+                {
+                    Parser->ChecksumErrCounter++;
+                    break;
+                }
+
+                if ((Parser->Type == HYUN_APP_NMEA_TYPE_GGA && Parser->FieldIndex >= HYUN_APP_NMEA_GGA_FIELDS) ||
+                    (Parser->Type == HYUN_APP_NMEA_TYPE_RMC && Parser->FieldIndex >= HYUN_APP_NMEA_RMC_FIELDS))
+                {
+                    if (Parser->Type == HYUN_APP_NMEA_TYPE_GGA)
+                    {
+                        Parser->LastAltitude   = Parser->Work.Altitude;
+                        Parser->LastSatellites = Parser->Work.Satellites;
+                    }
+                    else
+                    {
+                        Parser->Work.Altitude   = Parser->LastAltitude;
+                        Parser->Work.Satellites = Parser->LastSatellites;
+                    }
+
+                    Parser->SentenceCounter++;
+                    *Fix      = Parser->Work;
+                    *FixReady = true;
+                    return i + 1;
+                }
+
+                Parser->FormatErrCounter++;
+                break;
+
+            default:
+                /* Outside a sentence: line endings and noise are skipped */
+                break;
+        }
+    }
+
+    return Len;
+
+} /* End of HYUN_APP_NmeaFeed() */
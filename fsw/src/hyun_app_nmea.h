@@ -0,0 +1,107 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Streaming NMEA 0183 parser (GGA / RMC)
+ *
+ * Bytes are consumed straight from the received SB buffer. Fields are
+ * decoded into fixed-point accumulators as they arrive and the checksum
+ * is folded in byte by byte, so nothing is copied and a sentence may be
+ * split across any number of packets.
+ */
+
+#ifndef HYUN_APP_NMEA_H
+#define HYUN_APP_NMEA_H
+
+#include "common_types.h"
+
+/***********************************************************************/
+#define HYUN_APP_NMEA_MAX_SENTENCE 82 /* Per NMEA 0183, '$' through <LF> */
+#define HYUN_APP_NMEA_FRAC_DIGITS  7  /* Fraction digits kept per field */
+
+#define HYUN_APP_NMEA_TYPE_NONE 0
+#define HYUN_APP_NMEA_TYPE_GGA  1
+#define HYUN_APP_NMEA_TYPE_RMC  2
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    int32 LatitudeE7;
+    int32 LongitudeE7;
+    float Altitude;
+    uint8 Satellites;
+    uint8 FixValid;
+    uint8 Type;
+} HYUN_APP_NmeaFix_t;
+
+/*
+** Decoded value of the field being received. IntPart holds the digits
+** before the decimal point, Frac the first FracDigits digits after it.
+*/
+typedef struct
+{
+    uint32 IntPart;
+    uint32 Frac;
+    uint8  FracDigits;
+    uint8  Len;
+    bool   InFrac;
+    bool   Negative;
+    bool   Overflow;
+    char   Letter;
+} HYUN_APP_NmeaField_t;
+
+typedef struct
+{
+    uint8  State;
+    uint8  Type;
+    uint8  FieldIndex;
+    uint8  Checksum;
+    uint8  RxChecksum;
+    uint8  Length;
+    uint32 TypeKey; /* Last three characters of the address field */
+
+    HYUN_APP_NmeaField_t Field;
+    HYUN_APP_NmeaFix_t   Work; /* Fix under construction */
+
+    /* GGA-only values carried into RMC fixes */
+    float LastAltitude;
+    uint8 LastSatellites;
+
+    uint32 SentenceCounter;
+    uint32 ChecksumErrCounter;
+    uint32 FormatErrCounter;
+} HYUN_APP_NmeaParser_t;
+
+/****************************************************************************/
+/*
+** NMEA parser prototypes
+*/
+void   HYUN_APP_NmeaInit(HYUN_APP_NmeaParser_t *Parser);
+size_t HYUN_APP_NmeaFeed(HYUN_APP_NmeaParser_t *Parser, const uint8 *Data, size_t Len, HYUN_APP_NmeaFix_t *Fix,
+                         bool *FixReady);
+
+#endif /* HYUN_APP_NMEA_H */
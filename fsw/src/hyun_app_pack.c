@@ -0,0 +1,185 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_pack.c
+**
+** Purpose:
+**   Byte swapping of 16/32/64-bit arrays to and from big-endian wire
+**   order. Shared between the flight software and the host benchmark.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "hyun_app_pack.h"
+
+#if defined(HYUN_APP_PACK_NEON)
+#include <arm_neon.h>
+#elif defined(HYUN_APP_PACK_SSSE3)
+#include <tmmintrin.h>
+#endif
+
+#define HYUN_APP_PACK_VECTOR 16 /* Bytes per SIMD step */
+
+/*
+** Byte order within each 16-byte vector for a 16, 32 and 64-bit swap
+*/
+#if defined(HYUN_APP_PACK_SSSE3)
+static const uint8 HYUN_APP_PackShuffle16[16] = {1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14};
+static const uint8 HYUN_APP_PackShuffle32[16] = {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12};
+static const uint8 HYUN_APP_PackShuffle64[16] = {7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8};
+#endif
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_PackSwapNN -- Swap Count elements from Src into Dst.   */
+/* Packing and unpacking are the same operation.                   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void HYUN_APP_PackSwap16(uint8 *Dst, const uint8 *Src, size_t Count)
+{
+    size_t Bytes = Count * sizeof(uint16);
+    size_t i     = 0;
+    uint16 Value;
+
+#if defined(HYUN_APP_PACK_NEON)
+    for (; i + HYUN_APP_PACK_VECTOR <= Bytes; i += HYUN_APP_PACK_VECTOR)
+    {
+        vst1q_u8(&Dst[i], vrev16q_u8(vld1q_u8(&Src[i])));
+    }
+#elif defined(HYUN_APP_PACK_SSSE3)
+    const __m128i Mask = _mm_loadu_si128((const __m128i *)HYUN_APP_PackShuffle16);
+
+    for (; i + HYUN_APP_PACK_VECTOR <= Bytes; i += HYUN_APP_PACK_VECTOR)
+    {
+        _mm_storeu_si128((__m128i *)&Dst[i], _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)&Src[i]), Mask));
+    }
+#endif
+
+    for (; i < Bytes; i += sizeof(Value))
+    {
+        memcpy(&Value, &Src[i], sizeof(Value));
+#if !(defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        Value = __builtin_bswap16(Value);
+#endif
+        memcpy(&Dst[i], &Value, sizeof(Value));
+    }
+
+} /* End of HYUN_APP_PackSwap16() */
+
+static void HYUN_APP_PackSwap32(uint8 *Dst, const uint8 *Src, size_t Count)
+{
+    size_t Bytes = Count * sizeof(uint32);
+    size_t i     = 0;
+    uint32 Value;
+
+#if defined(HYUN_APP_PACK_NEON)
+    for (; i + HYUN_APP_PACK_VECTOR <= Bytes; i += HYUN_APP_PACK_VECTOR)
+    {
+        vst1q_u8(&Dst[i], vrev32q_u8(vld1q_u8(&Src[i])));
+    }
+#elif defined(HYUN_APP_PACK_SSSE3)
+    const __m128i Mask = _mm_loadu_si128((const __m128i *)HYUN_APP_PackShuffle32);
+
+    for (; i + HYUN_APP_PACK_VECTOR <= Bytes; i += HYUN_APP_PACK_VECTOR)
+    {
+        _mm_storeu_si128((__m128i *)&Dst[i], _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)&Src[i]), Mask));
+    }
+#endif
+
+    for (; i < Bytes; i += sizeof(Value))
+    {
+        memcpy(&Value, &Src[i], sizeof(Value));
+#if !(defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        Value = __builtin_bswap32(Value);
+#endif
+        memcpy(&Dst[i], &Value, sizeof(Value));
+    }
+
+} /* End of HYUN_APP_PackSwap32() */
+
+static void HYUN_APP_PackSwap64(uint8 *Dst, const uint8 *Src, size_t Count)
+{
+    size_t Bytes = Count * sizeof(uint64);
+    size_t i     = 0;
+    uint64 Value;
+
+#if defined(HYUN_APP_PACK_NEON)
+    for (; i + HYUN_APP_PACK_VECTOR <= Bytes; i += HYUN_APP_PACK_VECTOR)
+    {
+        vst1q_u8(&Dst[i], vrev64q_u8(vld1q_u8(&Src[i])));
+    }
+#elif defined(HYUN_APP_PACK_SSSE3)
+    const __m128i Mask = _mm_loadu_si128((const __m128i *)HYUN_APP_PackShuffle64);
+
+    for (; i + HYUN_APP_PACK_VECTOR <= Bytes; i += HYUN_APP_PACK_VECTOR)
+    {
+        _mm_storeu_si128((__m128i *)&Dst[i], _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)&Src[i]), Mask));
+    }
+#endif
+
+    for (; i < Bytes; i += sizeof(Value))
+    {
+        memcpy(&Value, &Src[i], sizeof(Value));
+#if !(defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        Value = __builtin_bswap64(Value);
+#endif
+        memcpy(&Dst[i], &Value, sizeof(Value));
+    }
+
+} /* End of HYUN_APP_PackSwap64() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_PackBeNN / HYUN_APP_UnpackBeNN -- Host <-> wire order  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_PackBe16(uint8 *Out, const void *In, size_t Count)
+{
+    HYUN_APP_PackSwap16(Out, (const uint8 *)In, Count);
+}
+
+void HYUN_APP_PackBe32(uint8 *Out, const void *In, size_t Count)
+{
+    HYUN_APP_PackSwap32(Out, (const uint8 *)In, Count);
+}
+
+void HYUN_APP_PackBe64(uint8 *Out, const void *In, size_t Count)
+{
+    HYUN_APP_PackSwap64(Out, (const uint8 *)In, Count);
+}
+
+void HYUN_APP_UnpackBe16(void *Out, const uint8 *In, size_t Count)
+{
+    HYUN_APP_PackSwap16((uint8 *)Out, In, Count);
+}
+
+void HYUN_APP_UnpackBe32(void *Out, const uint8 *In, size_t Count)
+{
+    HYUN_APP_PackSwap32((uint8 *)Out, In, Count);
+}
+
+void HYUN_APP_UnpackBe64(void *Out, const uint8 *In, size_t Count)
+{
+    HYUN_APP_PackSwap64((uint8 *)Out, In, Count);
+}
@@ -0,0 +1,70 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Big-endian array pack / unpack
+ *
+ * Converts whole arrays of 16, 32 and 64-bit fields between host order
+ * and the big-endian wire order of CCSDS payloads. On little-endian
+ * hosts the byte swap runs 16 bytes at a time with NEON (ARM) or SSSE3
+ * (x86) when the compiler targets them, and with the compiler byte swap
+ * builtins otherwise. Big-endian hosts just copy.
+ *
+ * Neither side needs to be aligned, so the wire side can point anywhere
+ * into a packet. Source and destination must not overlap.
+ *
+ * Only depends on the OSAL base types. Like hyun_app_wire.c, its only
+ * user, it is built into the host tools under tools/ and not into the app.
+ */
+
+#ifndef HYUN_APP_PACK_H
+#define HYUN_APP_PACK_H
+
+#include "common_types.h"
+
+/***********************************************************************/
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define HYUN_APP_PACK_IMPL "copy"
+#elif defined(__ARM_NEON) && !defined(HYUN_APP_PACK_NO_SIMD)
+#define HYUN_APP_PACK_NEON
+#define HYUN_APP_PACK_IMPL "neon"
+#elif defined(__SSSE3__) && !defined(HYUN_APP_PACK_NO_SIMD)
+#define HYUN_APP_PACK_SSSE3
+#define HYUN_APP_PACK_IMPL "ssse3"
+#else
+#define HYUN_APP_PACK_IMPL "scalar"
+#endif
+
+/****************************************************************************/
+/*
+** Pack prototypes, Count is in elements
+*/
+void HYUN_APP_PackBe16(uint8 *Out, const void *In, size_t Count);
+void HYUN_APP_PackBe32(uint8 *Out, const void *In, size_t Count);
+void HYUN_APP_PackBe64(uint8 *Out, const void *In, size_t Count);
+void HYUN_APP_UnpackBe16(void *Out, const uint8 *In, size_t Count);
+void HYUN_APP_UnpackBe32(void *Out, const uint8 *In, size_t Count);
+void HYUN_APP_UnpackBe64(void *Out, const uint8 *In, size_t Count);
+
+#endif /* HYUN_APP_PACK_H */
@@ -0,0 +1,143 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_pool.c
+**
+** Purpose:
+**   Lock-free pool of preinitialized telemetry buffers. Uses the GCC
+**   __atomic builtins, as C99 has no atomics.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "hyun_app_pool.h"
+
+/*
+** Next head value: tag advanced by one, new first index
+*/
+#define HYUN_APP_POOL_HEAD(Old, Index) ((((Old) + 0x10000u) & 0xFFFF0000u) | (uint32)(Index))
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_PoolInit                                                  */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Set up every buffer with the packet header and chain them all into */
+/*         the free list. Must run before any task uses the pool.             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_PoolInit(HYUN_APP_MsgPool_t *Pool, CFE_SB_MsgId_t MsgId, size_t Size)
+{
+    int32  Status;
+    uint32 i;
+
+    memset(Pool, 0, sizeof(*Pool));
+
+    if (Size > HYUN_APP_POOL_SLOT_SIZE)
+    {
+        return CFE_SB_MSG_TOO_BIG;
+    }
+
+    for (i = 0; i < HYUN_APP_POOL_SLOTS; i++)
+    {
+        Status = CFE_MSG_Init(&Pool->Slot[i].Buf.Msg, MsgId, Size);
+        if (Status != CFE_SUCCESS)
+        {
+            return Status;
+        }
+
+        Pool->Next[i] = (i + 1 < HYUN_APP_POOL_SLOTS) ? (uint16)(i + 1) : HYUN_APP_POOL_NIL;
+    }
+
+    __atomic_store_n(&Pool->Head, 0, __ATOMIC_RELEASE);
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_PoolInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_PoolTake                                                  */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Pop a free buffer, or NULL when all are in use. The header is      */
+/*         intact; the payload still holds whatever its last user wrote.      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_MSG_Message_t *HYUN_APP_PoolTake(HYUN_APP_MsgPool_t *Pool)
+{
+    uint32 Old;
+    uint32 New;
+    uint32 Index;
+    uint32 InUse;
+    uint32 HighWater;
+
+    Old = __atomic_load_n(&Pool->Head, __ATOMIC_ACQUIRE);
+    do
+    {
+        Index = Old & 0xFFFFu;
+        if (Index == HYUN_APP_POOL_NIL)
+        {
+            __atomic_add_fetch(&Pool->ExhaustedCounter, 1, __ATOMIC_RELAXED);
+            return NULL;
+        }
+
+        New = HYUN_APP_POOL_HEAD(Old, __atomic_load_n(&Pool->Next[Index], __ATOMIC_RELAXED));
+    } while (!__atomic_compare_exchange_n(&Pool->Head, &Old, New, true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    InUse     = __atomic_add_fetch(&Pool->InUse, 1, __ATOMIC_RELAXED);
+    HighWater = __atomic_load_n(&Pool->HighWater, __ATOMIC_RELAXED);
+    while (InUse > HighWater &&
+           !__atomic_compare_exchange_n(&Pool->HighWater, &HighWater, InUse, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+
+    return &Pool->Slot[Index].Buf.Msg;
+
+} /* End of HYUN_APP_PoolTake() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_PoolRelease                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Push a buffer taken from this pool back onto the free list.        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HYUN_APP_PoolRelease(HYUN_APP_MsgPool_t *Pool, CFE_MSG_Message_t *MsgPtr)
+{
+    uint32 Old;
+    uint32 New;
+    uint32 Index;
+
+    Index = (uint32)((HYUN_APP_PoolSlot_t *)MsgPtr - Pool->Slot);
+
+    /* Counted out before it is visible as free, so InUse never overstates */
+    __atomic_sub_fetch(&Pool->InUse, 1, __ATOMIC_RELAXED);
+
+    Old = __atomic_load_n(&Pool->Head, __ATOMIC_RELAXED);
+    do
+    {
+        __atomic_store_n(&Pool->Next[Index], (uint16)(Old & 0xFFFFu), __ATOMIC_RELAXED);
+        New = HYUN_APP_POOL_HEAD(Old, Index);
+    } while (!__atomic_compare_exchange_n(&Pool->Head, &Old, New, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+} /* End of HYUN_APP_PoolRelease() */
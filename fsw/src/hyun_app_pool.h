@@ -0,0 +1,80 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Preinitialized message buffer pool
+ *
+ * A pool holds a fixed number of buffers for one packet type, each set up
+ * once with CFE_MSG_Init. The main task takes a buffer, fills the payload
+ * and hands it to the data task, which puts it back once the packet is
+ * queued for the downlink. A packet can be built again while an earlier
+ * copy still waits for the data task.
+ *
+ * The free list is a lock-free stack. Its head packs a slot index with a
+ * tag that changes on every update, so a compare-and-swap cannot succeed
+ * on a head that was popped and pushed back in between (ABA).
+ */
+
+#ifndef HYUN_APP_POOL_H
+#define HYUN_APP_POOL_H
+
+#include "cfe.h"
+
+/***********************************************************************/
+#define HYUN_APP_POOL_SLOTS     4   /* Buffers per pool */
+#define HYUN_APP_POOL_SLOT_SIZE 256 /* Largest packet a pool can hold [bytes] */
+
+#define HYUN_APP_POOL_NIL 0xFFFF /* Empty free list / end of list */
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef union
+{
+    CFE_SB_Buffer_t Buf;
+    uint8           Bytes[HYUN_APP_POOL_SLOT_SIZE];
+} HYUN_APP_PoolSlot_t;
+
+typedef struct
+{
+    uint32 Head; /* Tag << 16 | index of the first free slot */
+    uint16 Next[HYUN_APP_POOL_SLOTS];
+
+    uint32 InUse;
+    uint32 HighWater;
+    uint32 ExhaustedCounter; /* Takes that found the pool empty */
+
+    HYUN_APP_PoolSlot_t Slot[HYUN_APP_POOL_SLOTS];
+} HYUN_APP_MsgPool_t;
+
+/****************************************************************************/
+/*
+** Pool prototypes
+*/
+int32              HYUN_APP_PoolInit(HYUN_APP_MsgPool_t *Pool, CFE_SB_MsgId_t MsgId, size_t Size);
+CFE_MSG_Message_t *HYUN_APP_PoolTake(HYUN_APP_MsgPool_t *Pool);
+void               HYUN_APP_PoolRelease(HYUN_APP_MsgPool_t *Pool, CFE_MSG_Message_t *MsgPtr);
+
+#endif /* HYUN_APP_POOL_H */
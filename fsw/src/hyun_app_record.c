@@ -0,0 +1,268 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+** File: hyun_app_record.c
+**
+** Purpose:
+**   Appends sensor and telemetry packets to the on-board time-indexed
+**   archive, from the data task.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "hyun_app_events.h"
+#include "hyun_app.h"
+#include "hyun_app_record.h"
+
+/*
+** Stop recording for the rest of the run
+*/
+static void HYUN_APP_RecordStop(HYUN_APP_Record_t *Rec, const char *Reason)
+{
+    Rec->Active = false;
+
+    close(Rec->DataFd);
+    close(Rec->IndexFd);
+    Rec->DataFd  = -1;
+    Rec->IndexFd = -1;
+
+    CFE_EVS_SendEvent(HYUN_APP_RECORD_ERR_EID, CFE_EVS_EventType_ERROR, "Recorder stopped at %lu bytes: %s",
+                      (unsigned long)Rec->Block.Entry.Offset, Reason);
+}
+
+/*
+** Read the header of an existing file, or write one into an empty file
+*/
+static bool HYUN_APP_RecordHeader(int Fd, off_t End, uint32 Magic)
+{
+    HYUN_APP_ArchiveHdr_t Hdr;
+
+    if (End < (off_t)sizeof(Hdr))
+    {
+        HYUN_APP_ArchiveHdrInit(&Hdr, Magic);
+        return End == 0 && pwrite(Fd, &Hdr, sizeof(Hdr), 0) == (ssize_t)sizeof(Hdr);
+    }
+
+    return pread(Fd, &Hdr, sizeof(Hdr), 0) == (ssize_t)sizeof(Hdr) && HYUN_APP_ArchiveHdrValid(&Hdr, Magic);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_RecordFlush                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Write the block to the data file, then its index entry, and start  */
+/*         the next block behind it.                                          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static bool HYUN_APP_RecordFlush(HYUN_APP_Record_t *Rec)
+{
+    HYUN_APP_ArchiveIndex_t *Entry = &Rec->Block.Entry;
+
+    if (Entry->Count == 0)
+    {
+        return true;
+    }
+
+    if (pwrite(Rec->DataFd, Rec->Block.Data, Entry->Length, (off_t)Entry->Offset) != (ssize_t)Entry->Length ||
+        pwrite(Rec->IndexFd, Entry, sizeof(*Entry), (off_t)Rec->IndexOffset) != (ssize_t)sizeof(*Entry))
+    {
+        Rec->DropCounter += Entry->Count;
+        HYUN_APP_RecordStop(Rec, "write failed");
+        return false;
+    }
+
+    Rec->IndexOffset += sizeof(*Entry);
+    HYUN_APP_ArchiveBlockNext(&Rec->Block);
+
+    return true;
+
+} /* End of HYUN_APP_RecordFlush() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_RecordOpen                                                */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Open or create the archive, data task. An existing archive is      */
+/*         continued: new blocks go after the current end of the data file    */
+/*         and the running time bounds carry on from the last index entry.    */
+/*         A trailing partial entry left by a reset is overwritten.           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_RecordOpen(void)
+{
+    HYUN_APP_Record_t       *Rec  = &HYUN_APP_Data.Record;
+    HYUN_APP_ArchiveIndex_t  Last;
+    const char              *Fail = NULL;
+    off_t                    DataEnd  = 0;
+    off_t                    IndexEnd = 0;
+    uint64                   Entries = 0;
+
+    memset(Rec, 0, sizeof(*Rec));
+
+    Rec->DataFd  = open(HYUN_APP_RECORD_DATA_FILE, O_RDWR | O_CREAT, 0644);
+    Rec->IndexFd = open(HYUN_APP_RECORD_INDEX_FILE, O_RDWR | O_CREAT, 0644);
+
+    if (Rec->DataFd < 0 || Rec->IndexFd < 0)
+    {
+        Fail = "can not open";
+    }
+    else
+    {
+        DataEnd  = lseek(Rec->DataFd, 0, SEEK_END);
+        IndexEnd = lseek(Rec->IndexFd, 0, SEEK_END);
+
+        if (!HYUN_APP_RecordHeader(Rec->DataFd, DataEnd, HYUN_APP_ARCHIVE_DATA_MAGIC) ||
+            !HYUN_APP_RecordHeader(Rec->IndexFd, IndexEnd, HYUN_APP_ARCHIVE_INDEX_MAGIC))
+        {
+            Fail = "not an archive of this version";
+        }
+        else
+        {
+            if (IndexEnd > (off_t)sizeof(HYUN_APP_ArchiveHdr_t))
+            {
+                Entries = ((uint64)IndexEnd - sizeof(HYUN_APP_ArchiveHdr_t)) / sizeof(Last);
+            }
+            Rec->IndexOffset = sizeof(HYUN_APP_ArchiveHdr_t) + Entries * sizeof(Last);
+
+            if (Entries > 0 &&
+                pread(Rec->IndexFd, &Last, sizeof(Last), (off_t)(Rec->IndexOffset - sizeof(Last))) != (ssize_t)sizeof(Last))
+            {
+                Fail = "can not read the index";
+            }
+            else if (Entries > 0 && Last.Offset + Last.Length > (uint64)DataEnd)
+            {
+                Fail = "index ahead of the data file";
+            }
+        }
+    }
+
+    if (Fail != NULL)
+    {
+        if (Rec->DataFd >= 0)
+        {
+            close(Rec->DataFd);
+        }
+        if (Rec->IndexFd >= 0)
+        {
+            close(Rec->IndexFd);
+        }
+        Rec->DataFd  = -1;
+        Rec->IndexFd = -1;
+
+        CFE_EVS_SendEvent(HYUN_APP_RECORD_ERR_EID, CFE_EVS_EventType_ERROR, "Recorder off, %s: %s",
+                          HYUN_APP_RECORD_DATA_FILE, Fail);
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    DataEnd = (DataEnd < (off_t)sizeof(HYUN_APP_ArchiveHdr_t)) ? (off_t)sizeof(HYUN_APP_ArchiveHdr_t) : DataEnd;
+    HYUN_APP_ArchiveBlockInit(&Rec->Block, (uint64)DataEnd, (Entries > 0) ? &Last : NULL);
+    Rec->StartOffset = (uint64)DataEnd;
+    Rec->Active      = true;
+
+    CFE_EVS_SendEvent(HYUN_APP_RECORD_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "Recording to %s from %lu bytes, %lu blocks indexed", HYUN_APP_RECORD_DATA_FILE,
+                      (unsigned long)DataEnd, (unsigned long)Entries);
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_RecordOpen() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_RecordPacket                                              */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Append one packet, stamped with the MET it is recorded at. Writes  */
+/*         the block first if the packet does not fit in it.                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HYUN_APP_RecordPacket(const CFE_MSG_Message_t *MsgPtr)
+{
+    HYUN_APP_Record_t *Rec   = &HYUN_APP_Data.Record;
+    CFE_SB_MsgId_t     MsgId = CFE_SB_INVALID_MSG_ID;
+    size_t             Size  = 0;
+    uint64             TimeUs;
+
+    if (!Rec->Active)
+    {
+        return;
+    }
+
+    CFE_MSG_GetMsgId(MsgPtr, &MsgId);
+    CFE_MSG_GetSize(MsgPtr, &Size);
+    TimeUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+
+    if (Size > HYUN_APP_ARCHIVE_MAX_PACKET)
+    {
+        Rec->DropCounter++;
+        return;
+    }
+
+    if (Rec->Block.Entry.Offset + Rec->Block.Entry.Length + sizeof(HYUN_APP_ArchiveRec_t) + Size >
+        HYUN_APP_RECORD_MAX_BYTES)
+    {
+        if (HYUN_APP_RecordFlush(Rec))
+        {
+            HYUN_APP_RecordStop(Rec, "size limit reached");
+        }
+        return;
+    }
+
+    if (!HYUN_APP_ArchiveAppend(&Rec->Block, TimeUs, (uint16)CFE_SB_MsgIdToValue(MsgId), MsgPtr, (uint16)Size))
+    {
+        if (!HYUN_APP_RecordFlush(Rec))
+        {
+            return;
+        }
+
+        /* An empty block takes any packet up to HYUN_APP_ARCHIVE_MAX_PACKET */
+        HYUN_APP_ArchiveAppend(&Rec->Block, TimeUs, (uint16)CFE_SB_MsgIdToValue(MsgId), MsgPtr, (uint16)Size);
+    }
+
+    if (Rec->Block.Entry.Count == 1)
+    {
+        Rec->FlushDueUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET()) + HYUN_APP_RECORD_FLUSH_MS * 1000u;
+    }
+
+    Rec->RecordCounter++;
+
+} /* End of HYUN_APP_RecordPacket() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_RecordService -- Write a partly filled block once it   */
+/* has waited HYUN_APP_RECORD_FLUSH_MS, every data task cycle      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_RecordService(void)
+{
+    HYUN_APP_Record_t *Rec = &HYUN_APP_Data.Record;
+
+    if (Rec->Active && Rec->Block.Entry.Count > 0 &&
+        HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET()) >= Rec->FlushDueUs)
+    {
+        HYUN_APP_RecordFlush(Rec);
+    }
+
+} /* End of HYUN_APP_RecordService() */
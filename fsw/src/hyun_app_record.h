@@ -0,0 +1,84 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * On-board packet recorder, run by the data task
+ *
+ * Every sensor packet taken from HYUN_PIPE_1 and every telemetry packet
+ * handed to the downlink (before compression) is appended to the
+ * time-indexed archive described in hyun_app_archive.h, stamped with
+ * the MET at which it is recorded. That is within a cycle of its header
+ * time, and on the clock the ground queries by. Records collect
+ * in one RAM block; the block goes to the data file, followed by its
+ * index entry, when it is full or HYUN_APP_RECORD_FLUSH_MS after its
+ * first record, so at most that much is lost on a reset.
+ *
+ * An existing archive is continued after a restart. Recording stops for
+ * the rest of the run at HYUN_APP_RECORD_MAX_BYTES or on a write error.
+ */
+
+#ifndef HYUN_APP_RECORD_H
+#define HYUN_APP_RECORD_H
+
+#include "cfe.h"
+#include "hyun_app_archive.h"
+
+/***********************************************************************/
+#define HYUN_APP_RECORD_DATA_FILE  "/cf/hyun_rec.dat"
+#define HYUN_APP_RECORD_INDEX_FILE "/cf/hyun_rec.idx"
+
+#define HYUN_APP_RECORD_FLUSH_MS  1000
+#define HYUN_APP_RECORD_MAX_BYTES (64u * 1024u * 1024u) /* Data file size limit */
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    bool   Active;
+    int    DataFd;
+    int    IndexFd;
+    uint64 IndexOffset; /* Index file offset of the next entry */
+    uint64 FlushDueUs;  /* MET by which a partly filled block is written */
+    uint64 StartOffset; /* Data file end at open, where this run's records start */
+
+    /*
+    ** Reported in housekeeping
+    */
+    uint32 RecordCounter;
+    uint32 DropCounter; /* Packets too large, or lost with a failed block write */
+
+    HYUN_APP_ArchiveBlock_t Block;
+} HYUN_APP_Record_t;
+
+/****************************************************************************/
+/*
+** Recorder prototypes
+*/
+int32 HYUN_APP_RecordOpen(void);
+void  HYUN_APP_RecordPacket(const CFE_MSG_Message_t *MsgPtr);
+void  HYUN_APP_RecordService(void);
+
+#endif /* HYUN_APP_RECORD_H */
@@ -0,0 +1,320 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_replay.c
+**
+** Purpose:
+**   Replay of a recorded SIMP pressure profile from a memory mapped file.
+**   OSAL has no mmap, so the POSIX calls are used directly; the flight
+**   computer runs Linux.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "hyun_app_events.h"
+#include "hyun_app.h"
+#include "hyun_app_replay.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_ReplayStart                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Map the profile and start releasing samples. Only allowed once the */
+/*         ground has activated simulation mode.                              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 HYUN_APP_ReplayStart(const char *Filename, uint16 Speed, uint16 PeriodMs)
+{
+    HYUN_APP_Replay_t *Replay = &HYUN_APP_Data.Replay;
+    struct stat        Stat;
+    void              *Map;
+    int                Fd;
+
+    if (HYUN_APP_Data.SimMode != HYUN_APP_SIM_ACTIVE || Speed > HYUN_APP_REPLAY_MAX_SPEED)
+    {
+        CFE_EVS_SendEvent(HYUN_APP_REPLAY_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "Replay: rejected, SIM mode %u, speed %u", (unsigned int)HYUN_APP_Data.SimMode,
+                          (unsigned int)Speed);
+        return HYUN_APP_SENSOR_INVALID_ERR_CODE;
+    }
+
+    if (Replay->Active)
+    {
+        HYUN_APP_ReplayStop("restarted");
+    }
+
+    Fd = open(Filename, O_RDONLY);
+    if (Fd < 0 || fstat(Fd, &Stat) != 0 || Stat.st_size == 0)
+    {
+        CFE_EVS_SendEvent(HYUN_APP_REPLAY_ERR_EID, CFE_EVS_EventType_ERROR, "Replay: cannot open %s", Filename);
+        if (Fd >= 0)
+        {
+            close(Fd);
+        }
+        return HYUN_APP_SENSOR_INVALID_ERR_CODE;
+    }
+
+    Map = mmap(NULL, (size_t)Stat.st_size, PROT_READ, MAP_PRIVATE, Fd, 0);
+    if (Map == MAP_FAILED)
+    {
+        CFE_EVS_SendEvent(HYUN_APP_REPLAY_ERR_EID, CFE_EVS_EventType_ERROR, "Replay: cannot map %s", Filename);
+        close(Fd);
+        return HYUN_APP_SENSOR_INVALID_ERR_CODE;
+    }
+
+    /* The file is read front to back exactly once */
+    madvise(Map, (size_t)Stat.st_size, MADV_SEQUENTIAL);
+
+    memset(Replay, 0, sizeof(*Replay));
+    Replay->Active   = true;
+    Replay->Speed    = Speed;
+    Replay->Fd       = Fd;
+    Replay->Data     = Map;
+    Replay->Size     = (size_t)Stat.st_size;
+    Replay->PeriodUs = ((PeriodMs != 0) ? PeriodMs : HYUN_APP_REPLAY_DEFAULT_PERIOD) * 1000u;
+    Replay->StartUs  = HYUN_APP_SysTimeToUsec(CFE_TIME_GetTime());
+
+    CFE_EVS_SendEvent(HYUN_APP_REPLAY_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "Replay: %s, %lu bytes, speed %u, period %lu ms", Filename, (unsigned long)Replay->Size,
+                      (unsigned int)Speed, (unsigned long)(Replay->PeriodUs / 1000));
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_ReplayStart() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_ReplayStop -- Unmap and report the run                 */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_ReplayStop(const char *Reason)
+{
+    HYUN_APP_Replay_t *Replay = &HYUN_APP_Data.Replay;
+    uint64             WallUs;
+
+    if (!Replay->Active)
+    {
+        return;
+    }
+
+    WallUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetTime()) - Replay->StartUs;
+
+    munmap((void *)Replay->Data, Replay->Size);
+    close(Replay->Fd);
+
+    Replay->Active = false;
+    Replay->Data   = NULL;
+
+    /*
+    ** Profile time ran ahead of the clock at any speed above 1x. Restart
+    ** the estimator and the alignment, and drop the replayed baro history,
+    ** so the real samples that follow are not taken as stale.
+    */
+    HYUN_APP_KF_Init(&HYUN_APP_Data.Kf, HYUN_APP_Data.Kf.NumStates);
+    HYUN_APP_Data.Align.Started    = false;
+    HYUN_APP_Data.Sensor.Baro.Head = 0;
+    HYUN_APP_Data.Sensor.Baro.Tail = 0;
+    HYUN_APP_MedianInit(&HYUN_APP_Data.Sensor.BaroMedian, HYUN_APP_Data.Sensor.BaroMedian.Size);
+    HYUN_APP_MinMaxInit(&HYUN_APP_Data.Sensor.BaroMinMax, HYUN_APP_Data.Sensor.BaroMinMax.Size);
+
+    CFE_EVS_SendEvent(HYUN_APP_REPLAY_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "Replay: %s, %lu samples (%lu s profile) in %lu ms, %lu bad lines, %lu late cycles", Reason,
+                      (unsigned long)Replay->SampleCounter, (unsigned long)(Replay->NextProfileUs / 1000000u),
+                      (unsigned long)(WallUs / 1000u), (unsigned long)Replay->ErrCounter,
+                      (unsigned long)Replay->LateCounter);
+
+} /* End of HYUN_APP_ReplayStop() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_ReplayNextLine                                            */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Parse lines from the current offset until one holds a pressure.    */
+/*         The mapping is not NUL terminated, so every access is bounded by   */
+/*         Size. Returns false at the end of the file.                        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+static bool HYUN_APP_ReplayNextLine(HYUN_APP_Replay_t *Replay, uint32 *Pressure)
+{
+    const char *Line;
+    size_t      Len;
+    size_t      Field;
+    size_t      i;
+    uint32      Value;
+    bool        Digits;
+
+    while (Replay->Offset < Replay->Size)
+    {
+        Line = &Replay->Data[Replay->Offset];
+        Len  = 0;
+        while (Replay->Offset + Len < Replay->Size && Line[Len] != '\n')
+        {
+            Len++;
+        }
+        Replay->Offset += Len + 1;
+
+        if (Len > 0 && Line[Len - 1] == '\r')
+        {
+            Len--;
+        }
+        if (Len == 0 || Line[0] == '#')
+        {
+            continue;
+        }
+
+        /*
+        ** The pressure is the last field: "CMD,<TEAM_ID>,SIMP,<Pa>" or "<Pa>"
+        */
+        Field = Len;
+        while (Field > 0 && Line[Field - 1] != ',')
+        {
+            Field--;
+        }
+        if (Field > 0 && (Field < 6 || memcmp(&Line[Field - 6], ",SIMP,", 6) != 0 || memcmp(Line, "CMD,", 4) != 0))
+        {
+            Replay->ErrCounter++;
+            continue;
+        }
+
+        Value  = 0;
+        Digits = (Field < Len && Len - Field <= 6);
+        for (i = Field; Digits && i < Len; i++)
+        {
+            Digits = (Line[i] >= '0' && Line[i] <= '9');
+            Value  = (Value * 10) + (uint32)(Line[i] - '0');
+        }
+
+        if (!Digits || Value > HYUN_APP_UPLINK_MAX_SIMP)
+        {
+            Replay->ErrCounter++;
+            continue;
+        }
+
+        *Pressure = Value;
+        return true;
+    }
+
+    return false;
+
+} /* End of HYUN_APP_ReplayNextLine() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_ReplayCycle                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Release the next sample once its profile time is due at the        */
+/*         requested speed. Returns the number of samples pushed (0 or 1).    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+uint32 HYUN_APP_ReplayCycle(void)
+{
+    HYUN_APP_Replay_t *Replay = &HYUN_APP_Data.Replay;
+    uint64             ElapsedUs;
+    uint32             Pressure;
+
+    if (!Replay->Active)
+    {
+        return 0;
+    }
+
+    if (HYUN_APP_Data.SimMode != HYUN_APP_SIM_ACTIVE)
+    {
+        HYUN_APP_ReplayStop("SIM mode left");
+        return 0;
+    }
+
+    if (Replay->Speed != 0)
+    {
+        ElapsedUs = (HYUN_APP_SysTimeToUsec(CFE_TIME_GetTime()) - Replay->StartUs) * Replay->Speed;
+        if (ElapsedUs < Replay->NextProfileUs)
+        {
+            return 0;
+        }
+        if (ElapsedUs >= Replay->NextProfileUs + Replay->PeriodUs)
+        {
+            Replay->LateCounter++;
+        }
+    }
+
+    if (!HYUN_APP_ReplayNextLine(Replay, &Pressure))
+    {
+        HYUN_APP_ReplayStop("end of profile");
+        return 0;
+    }
+
+    HYUN_APP_SensorPushBaro(Replay->StartUs + Replay->NextProfileUs, (float)Pressure);
+
+    Replay->SampleCounter++;
+    Replay->NextProfileUs += Replay->PeriodUs;
+
+    return 1;
+
+} /* End of HYUN_APP_ReplayCycle() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_ReplayNowUs                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Sensor clock for the alignment. While a replay runs, samples carry */
+/*         profile time, so the clock is the time of the newest sample        */
+/*         released; otherwise it is WallUs.                                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+uint64 HYUN_APP_ReplayNowUs(uint64 WallUs)
+{
+    const HYUN_APP_Replay_t *Replay = &HYUN_APP_Data.Replay;
+
+    if (!Replay->Active)
+    {
+        return WallUs;
+    }
+
+    if (Replay->SampleCounter == 0)
+    {
+        return Replay->StartUs;
+    }
+
+    return Replay->StartUs + Replay->NextProfileUs - Replay->PeriodUs;
+
+} /* End of HYUN_APP_ReplayNowUs() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_ReplayCycleTimeout -- Period of the next sensor cycle  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 HYUN_APP_ReplayCycleTimeout(void)
+{
+    if (HYUN_APP_Data.Replay.Active && HYUN_APP_Data.Replay.Speed != 1)
+    {
+        return HYUN_APP_REPLAY_FAST_CYCLE_MS;
+    }
+
+    return HYUN_APP_CYCLE_TIMEOUT_MS;
+
+} /* End of HYUN_APP_ReplayCycleTimeout() */
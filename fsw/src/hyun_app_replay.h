@@ -0,0 +1,88 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * SIM mode pressure replay
+ *
+ * Streams a recorded pressure profile into the baro ring in place of the
+ * sensor. The profile file is memory mapped and parsed one line per
+ * sample, either the competition format "CMD,<TEAM_ID>,SIMP,<Pa>" or a
+ * bare pressure in Pa; blank lines and '#' comments are skipped.
+ *
+ * Samples carry profile time (start + n * period), so the estimator and
+ * the flight state machine see the recorded dynamics at any replay speed.
+ * At most one sample is released per cycle, matching the one baro sample
+ * per cycle of real flight, and the cycle is shortened while a fast
+ * replay runs.
+ *
+ * The alignment follows the same profile clock while a replay runs. When
+ * it stops, the estimator, the alignment and the baro history restart
+ * on the wall clock.
+ */
+
+#ifndef HYUN_APP_REPLAY_H
+#define HYUN_APP_REPLAY_H
+
+#include "cfe.h"
+#include "hyun_app_msgdefs.h"
+
+/***********************************************************************/
+#define HYUN_APP_REPLAY_DEFAULT_PERIOD 1000 /* [ms] SIMP profiles are 1 Hz */
+#define HYUN_APP_REPLAY_MAX_SPEED      1000
+#define HYUN_APP_REPLAY_FAST_CYCLE_MS  5 /* Sensor pipe timeout while replaying faster than 1x */
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    bool   Active;
+    uint16 Speed; /* Profile time per wall time, 0 = one sample every cycle */
+
+    int         Fd;
+    const char *Data; /* Mapped profile */
+    size_t      Size;
+    size_t      Offset; /* Next unparsed byte */
+
+    uint32 PeriodUs;
+    uint64 StartUs;       /* Wall clock at start, also profile time zero */
+    uint64 NextProfileUs; /* Profile time of the next sample */
+
+    uint32 SampleCounter;
+    uint32 ErrCounter;  /* Lines that are not a pressure sample */
+    uint32 LateCounter; /* Cycles that could not keep up with Speed */
+} HYUN_APP_Replay_t;
+
+/****************************************************************************/
+/*
+** Replay prototypes
+*/
+int32  HYUN_APP_ReplayStart(const char *Filename, uint16 Speed, uint16 PeriodMs);
+void   HYUN_APP_ReplayStop(const char *Reason);
+uint32 HYUN_APP_ReplayCycle(void);
+uint64 HYUN_APP_ReplayNowUs(uint64 WallUs);
+int32  HYUN_APP_ReplayCycleTimeout(void);
+
+#endif /* HYUN_APP_REPLAY_H */
@@ -0,0 +1,529 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_sensor.c
+**
+** Purpose:
+**   Sensor ingest pipeline, run by the data task. Waits on HYUN_PIPE_1,
+**   drains it, copies each sample into its per-sensor ring and runs the
+**   batch stage once per cycle, which also publishes the altitude
+**   estimate.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "hyun_app_events.h"
+#include "hyun_app.h"
+#include "hyun_app_sensor.h"
+
+/*
+** Claim the next write slot of a ring. When the ring is full the oldest
+** unprocessed sample is given up, which is counted as a drop.
+*/
+#define HYUN_APP_RING_PUSH(Ring, Size, Slot)                        \
+    do                                                              \
+    {                                                               \
+        if ((uint32)((Ring)->Head - (Ring)->Tail) >= (Size))        \
+        {                                                           \
+            (Ring)->Tail++;                                         \
+            HYUN_APP_Data.Sensor.DropCounter++;                     \
+        }                                                           \
+        (Slot) = HYUN_APP_RING_INDEX((Ring)->Head, (Size));         \
+        (Ring)->Head++;                                             \
+    } while (0)
+
+/*
+** Throughput budget at the nominal rates. One cycle of IMU and baro has
+** to fit the per-MID limits twice over, so a late cycle loses nothing in
+** SB; every limit together has to fit the pipe and a single batch; and
+** the fast rings have to hold a cycle plus the default alignment period
+** and latency bound, the history AlignEstimate walks back through.
+*/
+#define HYUN_APP_PER_CYCLE(RateHz) (((RateHz)*HYUN_APP_CYCLE_TIMEOUT_MS + 999) / 1000)
+
+CompileTimeAssert(HYUN_APP_IMU_MSG_LIMIT >= 2 * HYUN_APP_PER_CYCLE(HYUN_APP_IMU_RATE_HZ), HYUN_APP_ImuMsgLimitLow);
+CompileTimeAssert(HYUN_APP_BARO_MSG_LIMIT >= 2 * HYUN_APP_PER_CYCLE(HYUN_APP_BARO_RATE_HZ), HYUN_APP_BaroMsgLimitLow);
+CompileTimeAssert(HYUN_APP_IMU_MSG_LIMIT + HYUN_APP_BARO_MSG_LIMIT + HYUN_APP_GPS_MSG_LIMIT + HYUN_APP_VOLTAGE_MSG_LIMIT +
+                          HYUN_APP_GPS_RAW_MSG_LIMIT <=
+                      HYUN_PIPE_1_DEPTH,
+                  HYUN_APP_SensorPipeTooShallow);
+CompileTimeAssert(HYUN_PIPE_1_DEPTH <= HYUN_APP_SENSOR_MAX_BATCH, HYUN_APP_SensorBatchTooSmall);
+CompileTimeAssert(HYUN_APP_IMU_RING_SIZE >= HYUN_APP_IMU_RATE_HZ *
+                                                (HYUN_APP_CYCLE_TIMEOUT_MS + HYUN_APP_ALIGN_DEFAULT_PERIOD_MS +
+                                                 HYUN_APP_ALIGN_DEFAULT_MAX_LATENCY_MS) / 1000,
+                  HYUN_APP_ImuRingTooSmall);
+CompileTimeAssert(HYUN_APP_BARO_RING_SIZE >= HYUN_APP_BARO_RATE_HZ *
+                                                 (HYUN_APP_CYCLE_TIMEOUT_MS + HYUN_APP_ALIGN_DEFAULT_PERIOD_MS +
+                                                  HYUN_APP_ALIGN_DEFAULT_MAX_LATENCY_MS) / 1000,
+                  HYUN_APP_BaroRingTooSmall);
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* HYUN_APP_SensorInit() -- Create HYUN_PIPE_1 and subscribe to sensors       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_SensorInit(void)
+{
+    int32 status;
+
+    memset(&HYUN_APP_Data.Sensor, 0, sizeof(HYUN_APP_Data.Sensor));
+
+    HYUN_APP_MedianInit(&HYUN_APP_Data.Sensor.BaroMedian, HYUN_APP_FILTER_DEFAULT_WINDOW);
+    HYUN_APP_MinMaxInit(&HYUN_APP_Data.Sensor.BaroMinMax, HYUN_APP_FILTER_DEFAULT_WINDOW);
+    HYUN_APP_EmaInit(&HYUN_APP_Data.Sensor.VoltageEma, HYUN_APP_VOLTAGE_EMA_ALPHA);
+    HYUN_APP_NmeaInit(&HYUN_APP_Data.Sensor.Nmea);
+
+    /*
+    ** Sensor subscriptions start from the defaults and follow the table
+    */
+    status = HYUN_APP_SubInit(HYUN_APP_SUB_PIPE_SENSOR);
+
+    return (status);
+
+} /* End of HYUN_APP_SensorInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_SensorCycle                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Take packets from HYUN_PIPE_1 as they arrive until the end of this */
+/*         PeriodMs cycle (or HYUN_APP_SENSOR_MAX_BATCH packets), then        */
+/*         process the new samples as one batch. The cycle rate does not      */
+/*         follow the packet rate.                                            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 HYUN_APP_SensorCycle(int32 PeriodMs)
+{
+    HYUN_APP_SensorData_t *Sensor   = &HYUN_APP_Data.Sensor;
+    uint64                 PeriodUs = (uint64)PeriodMs * 1000u;
+    uint64                 NowUs;
+    int32                  status;
+    int32                  TimeoutMs;
+    uint16                 Count = 0;
+    CFE_SB_Buffer_t       *SBBufPtr;
+
+    /*
+    ** Deadlines follow each other by one period. After an overrun, or when
+    ** the period shrinks, the next cycle starts from now instead.
+    */
+    NowUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+    Sensor->CycleDeadlineUs += PeriodUs;
+    if (Sensor->CycleDeadlineUs <= NowUs || Sensor->CycleDeadlineUs > NowUs + PeriodUs)
+    {
+        Sensor->CycleDeadlineUs = NowUs + PeriodUs;
+    }
+
+    do
+    {
+        TimeoutMs = CFE_SB_POLL;
+        if (NowUs < Sensor->CycleDeadlineUs)
+        {
+            TimeoutMs = (int32)((Sensor->CycleDeadlineUs - NowUs + 999u) / 1000u);
+        }
+
+        status = CFE_SB_ReceiveBuffer(&SBBufPtr, HYUN_APP_Data.HYUN_PIPE_1, TimeoutMs);
+        if (status != CFE_SUCCESS)
+        {
+            break;
+        }
+
+        HYUN_APP_RecordPacket(&SBBufPtr->Msg);
+        HYUN_APP_SensorIngest(SBBufPtr);
+        Count++;
+
+        NowUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+
+    } while (Count < HYUN_APP_SENSOR_MAX_BATCH);
+
+    CFE_ES_PerfLogEntry(HYUN_APP_SENSOR_PERF_ID);
+
+    Sensor->LastBatch = Count;
+
+    HYUN_APP_ReplayCycle();
+
+    /*
+    ** Runs every cycle, with or without new samples, so a tick held back
+    ** by a late stream still goes out at its latency bound
+    */
+    HYUN_APP_SensorProcessBatch(Sensor);
+
+    CFE_ES_PerfLogExit(HYUN_APP_SENSOR_PERF_ID);
+
+    if (status == CFE_SB_NO_MESSAGE || status == CFE_SB_TIME_OUT || status == CFE_SUCCESS)
+    {
+        return CFE_SUCCESS;
+    }
+
+    return status;
+
+} /* End of HYUN_APP_SensorCycle() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_SensorIngest                                              */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Copy one sensor packet into its ring. Malformed packets are only   */
+/*         counted; at these rates an event per packet would flood EVS.       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 HYUN_APP_SensorIngest(const CFE_SB_Buffer_t *SBBufPtr)
+{
+    CFE_SB_MsgId_t        MsgId  = CFE_SB_INVALID_MSG_ID;
+    size_t                Size   = 0;
+    CFE_TIME_SysTime_t    Time   = {0, 0};
+    HYUN_APP_SensorData_t *Sensor = &HYUN_APP_Data.Sensor;
+    uint32                Slot;
+    uint64                TimeUs;
+    uint64                ArrivalUs;
+
+    CFE_MSG_GetMsgId(&SBBufPtr->Msg, &MsgId);
+    CFE_MSG_GetSize(&SBBufPtr->Msg, &Size);
+    CFE_MSG_GetMsgTime(&SBBufPtr->Msg, &Time);
+    TimeUs    = HYUN_APP_SysTimeToUsec(Time);
+    ArrivalUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+
+    switch (MsgId)
+    {
+        case HYUN_APP_MID_SENSOR_IMU:
+            if (Size == sizeof(HYUN_APP_ImuTlm_t) && HYUN_APP_Data.SimMode == HYUN_APP_SIM_ACTIVE)
+            {
+                /* A resting IMU would contradict the simulated profile */
+                return CFE_SUCCESS;
+            }
+            if (Size == sizeof(HYUN_APP_ImuTlm_t))
+            {
+                const HYUN_APP_ImuTlm_Payload_t *Imu = &((const HYUN_APP_ImuTlm_t *)SBBufPtr)->Payload;
+
+                HYUN_APP_RING_PUSH(&Sensor->Imu, HYUN_APP_IMU_RING_SIZE, Slot);
+                Sensor->Imu.TimeUs[Slot]    = TimeUs;
+                Sensor->Imu.ArrivalUs[Slot] = ArrivalUs;
+                Sensor->Imu.AccelX[Slot]    = Imu->Accel[0];
+                Sensor->Imu.AccelY[Slot] = Imu->Accel[1];
+                Sensor->Imu.AccelZ[Slot] = Imu->Accel[2];
+                Sensor->Imu.GyroX[Slot]  = Imu->Gyro[0];
+                Sensor->Imu.GyroY[Slot]  = Imu->Gyro[1];
+                Sensor->Imu.GyroZ[Slot]  = Imu->Gyro[2];
+                Sensor->MsgCounter++;
+                return CFE_SUCCESS;
+            }
+            break;
+
+        case HYUN_APP_MID_SENSOR_BARO:
+            if (Size == sizeof(HYUN_APP_BaroTlm_t) && HYUN_APP_Data.SimMode == HYUN_APP_SIM_ACTIVE)
+            {
+                /* Pressure comes from the ground in simulation mode */
+                return CFE_SUCCESS;
+            }
+            if (Size == sizeof(HYUN_APP_BaroTlm_t))
+            {
+                const HYUN_APP_BaroTlm_Payload_t *Baro = &((const HYUN_APP_BaroTlm_t *)SBBufPtr)->Payload;
+
+                HYUN_APP_RING_PUSH(&Sensor->Baro, HYUN_APP_BARO_RING_SIZE, Slot);
+                Sensor->Baro.TimeUs[Slot]      = TimeUs;
+                Sensor->Baro.ArrivalUs[Slot]   = ArrivalUs;
+                Sensor->Baro.Pressure[Slot]    = Baro->Pressure;
+                Sensor->Baro.Altitude[Slot]    = Baro->Altitude;
+                Sensor->Baro.Temperature[Slot] = Baro->Temperature;
+                Sensor->MsgCounter++;
+                return CFE_SUCCESS;
+            }
+            break;
+
+        case HYUN_APP_MID_SENSOR_GPS:
+            if (Size == sizeof(HYUN_APP_GpsTlm_t))
+            {
+                const HYUN_APP_GpsTlm_Payload_t *Gps = &((const HYUN_APP_GpsTlm_t *)SBBufPtr)->Payload;
+
+                HYUN_APP_RING_PUSH(&Sensor->Gps, HYUN_APP_GPS_RING_SIZE, Slot);
+                Sensor->Gps.TimeUs[Slot]      = TimeUs;
+                Sensor->Gps.LatitudeE7[Slot]  = Gps->LatitudeE7;
+                Sensor->Gps.LongitudeE7[Slot] = Gps->LongitudeE7;
+                Sensor->Gps.Altitude[Slot]    = Gps->Altitude;
+                Sensor->Gps.Satellites[Slot]  = Gps->Satellites;
+                Sensor->Gps.FixValid[Slot]    = Gps->FixValid;
+                Sensor->MsgCounter++;
+                return CFE_SUCCESS;
+            }
+            break;
+
+        case HYUN_APP_MID_SENSOR_VOLTAGE:
+            if (Size == sizeof(HYUN_APP_VoltageTlm_t))
+            {
+                HYUN_APP_RING_PUSH(&Sensor->Voltage, HYUN_APP_VOLTAGE_RING_SIZE, Slot);
+                Sensor->Voltage.TimeUs[Slot]  = TimeUs;
+                Sensor->Voltage.Voltage[Slot] = ((const HYUN_APP_VoltageTlm_t *)SBBufPtr)->Payload.Voltage;
+                Sensor->MsgCounter++;
+                return CFE_SUCCESS;
+            }
+            break;
+
+        case HYUN_APP_MID_SENSOR_GPS_RAW:
+            if (HYUN_APP_SensorIngestNmea((const HYUN_APP_GpsRawTlm_t *)SBBufPtr, Size, TimeUs) == CFE_SUCCESS)
+            {
+                Sensor->MsgCounter++;
+                return CFE_SUCCESS;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    Sensor->ErrCounter++;
+
+    return HYUN_APP_SENSOR_INVALID_ERR_CODE;
+
+} /* End of HYUN_APP_SensorIngest() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_SensorIngestNmea                                          */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Run the NMEA parser directly over the payload of a raw GPS packet  */
+/*         and push every completed fix into the GPS ring, stamped with the   */
+/*         packet time.                                                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 HYUN_APP_SensorIngestNmea(const HYUN_APP_GpsRawTlm_t *RawPtr, size_t Size, uint64 TimeUs)
+{
+    HYUN_APP_SensorData_t *Sensor = &HYUN_APP_Data.Sensor;
+    const uint8           *Data   = RawPtr->Payload.Data;
+    size_t                 Len    = RawPtr->Payload.Length;
+    size_t                 Used;
+    bool                   FixReady;
+    HYUN_APP_NmeaFix_t     Fix;
+    uint32                 Slot;
+
+    /* The header and Length must be present, and Length must fit in what was received */
+    if (Size < offsetof(HYUN_APP_GpsRawTlm_t, Payload.Data) ||
+        Len > Size - offsetof(HYUN_APP_GpsRawTlm_t, Payload.Data) || Len > sizeof(RawPtr->Payload.Data))
+    {
+        return HYUN_APP_SENSOR_INVALID_ERR_CODE;
+    }
+
+    CFE_ES_PerfLogEntry(HYUN_APP_NMEA_PERF_ID);
+
+    while (Len > 0)
+    {
+        Used = HYUN_APP_NmeaFeed(&Sensor->Nmea, Data, Len, &Fix, &FixReady);
+        Data += Used;
+        Len -= Used;
+
+        if (FixReady)
+        {
+            HYUN_APP_RING_PUSH(&Sensor->Gps, HYUN_APP_GPS_RING_SIZE, Slot);
+            Sensor->Gps.TimeUs[Slot]      = TimeUs;
+            Sensor->Gps.LatitudeE7[Slot]  = Fix.LatitudeE7;
+            Sensor->Gps.LongitudeE7[Slot] = Fix.LongitudeE7;
+            Sensor->Gps.Altitude[Slot]    = Fix.Altitude;
+            Sensor->Gps.Satellites[Slot]  = Fix.Satellites;
+            Sensor->Gps.FixValid[Slot]    = Fix.FixValid;
+        }
+    }
+
+    CFE_ES_PerfLogExit(HYUN_APP_NMEA_PERF_ID);
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_SensorIngestNmea() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_SensorPushBaro                                            */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Add a baro sample that did not come from the sensor (simulation    */
+/*         mode). Altitude follows the standard atmosphere; the temperature   */
+/*         of the last real sample is kept.                                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+void HYUN_APP_SensorPushBaro(uint64 TimeUs, float Pressure)
+{
+    HYUN_APP_SensorData_t *Sensor = &HYUN_APP_Data.Sensor;
+    float                  Temperature = 0.0f;
+    uint32                 Slot;
+
+    if (Sensor->Baro.Head != 0)
+    {
+        Temperature = Sensor->Baro.Temperature[HYUN_APP_RING_INDEX(Sensor->Baro.Head - 1, HYUN_APP_BARO_RING_SIZE)];
+    }
+
+    HYUN_APP_RING_PUSH(&Sensor->Baro, HYUN_APP_BARO_RING_SIZE, Slot);
+    Sensor->Baro.TimeUs[Slot]      = TimeUs;
+    Sensor->Baro.ArrivalUs[Slot]   = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+    Sensor->Baro.Pressure[Slot]    = Pressure;
+    Sensor->Baro.Altitude[Slot]    = HYUN_APP_PressureToAltitude(Pressure);
+    Sensor->Baro.Temperature[Slot] = Temperature;
+
+} /* End of HYUN_APP_SensorPushBaro() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_PressureToAltitude -- ISA altitude from pressure [Pa]  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+float HYUN_APP_PressureToAltitude(float Pressure)
+{
+    return HYUN_APP_ISA_H0 * (1.0f - powf(Pressure / HYUN_APP_ISA_P0, HYUN_APP_ISA_EXPONENT));
+
+} /* End of HYUN_APP_PressureToAltitude() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_SendEstimate                                              */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Publish the current estimate. Called once per aligned frame, after */
+/*         the estimator and flight steps, so the packet rate follows the     */
+/*         alignment period rather than the sensor packet rate.               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 HYUN_APP_SendEstimate(void)
+{
+    const HYUN_APP_KF_t            *Kf      = &HYUN_APP_Data.Kf;
+    HYUN_APP_EstimateTlm_Payload_t *Payload = &HYUN_APP_Data.EstimateTlm.Payload;
+
+    Payload->Altitude       = Kf->X[HYUN_APP_KF_STATE_ALT];
+    Payload->Velocity       = Kf->X[HYUN_APP_KF_STATE_VEL];
+    Payload->AltitudeVar    = Kf->P[HYUN_APP_KF_STATE_ALT][HYUN_APP_KF_STATE_ALT];
+    Payload->VelocityVar    = Kf->P[HYUN_APP_KF_STATE_VEL][HYUN_APP_KF_STATE_VEL];
+    Payload->PredictCounter = Kf->PredictCounter;
+    Payload->UpdateCounter  = Kf->UpdateCounter;
+    Payload->NumStates      = Kf->NumStates;
+    Payload->Valid          = Kf->Initialized;
+
+    Payload->FlightState       = HYUN_APP_Data.Flight.State;
+    Payload->TransitionCounter = HYUN_APP_Data.Flight.TransitionCounter;
+    Payload->LastLatencyUs     = HYUN_APP_Data.Flight.LastLatencyUs;
+    Payload->MaxLatencyUs      = HYUN_APP_Data.Flight.MaxLatencyUs;
+
+    CFE_SB_TimeStampMsg(&HYUN_APP_Data.EstimateTlm.TlmHeader.Msg);
+    return HYUN_APP_DownlinkSend(&HYUN_APP_Data.EstimateTlm.TlmHeader.Msg);
+
+} /* End of HYUN_APP_SendEstimate() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_SensorProcessBatch                                        */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Run the per-cycle processing over every sample that arrived since  */
+/*         the last batch, then mark those samples as consumed.               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+void HYUN_APP_SensorProcessBatch(HYUN_APP_SensorData_t *Sensor)
+{
+    int32             status;
+    HYUN_APP_Table_t *TblPtr = NULL;
+
+    /*
+    ** The table may not be loaded yet; filters then keep their default
+    ** window and the flight state machine waits.
+    */
+    status = CFE_TBL_GetAddress((void *)&TblPtr, HYUN_APP_Data.TblHandles[0]);
+    if (status < CFE_SUCCESS)
+    {
+        TblPtr = NULL;
+    }
+
+    /*
+    ** Downstream stages read Tail..Head of each ring here. The samples
+    ** stay in place until overwritten, so history remains available.
+    */
+    CFE_ES_PerfLogEntry(HYUN_APP_FILTER_PERF_ID);
+    HYUN_APP_SensorFilter(Sensor, TblPtr);
+    CFE_ES_PerfLogExit(HYUN_APP_FILTER_PERF_ID);
+
+    /*
+    ** Runs before the Tails move so the bracketing samples are still
+    ** known to be in the rings. Each aligned frame also steps the
+    ** estimator and then the flight state machine.
+    */
+    CFE_ES_PerfLogEntry(HYUN_APP_ALIGN_PERF_ID);
+    HYUN_APP_AlignProcess(TblPtr);
+    CFE_ES_PerfLogExit(HYUN_APP_ALIGN_PERF_ID);
+
+    if (TblPtr != NULL)
+    {
+        HYUN_APP_DownlinkConfig(TblPtr);
+        CFE_TBL_ReleaseAddress(HYUN_APP_Data.TblHandles[0]);
+    }
+
+    Sensor->Baro.Tail    = Sensor->Baro.Head;
+    Sensor->Imu.Tail     = Sensor->Imu.Head;
+    Sensor->Gps.Tail     = Sensor->Gps.Head;
+    Sensor->Voltage.Tail = Sensor->Voltage.Head;
+
+} /* End of HYUN_APP_SensorProcessBatch() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_SensorFilter                                              */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Median filter the new baro altitudes (spike rejection before the   */
+/*         estimator and apogee detection), track the baro spread and smooth  */
+/*         the battery voltage. Windows follow the table.                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+void HYUN_APP_SensorFilter(HYUN_APP_SensorData_t *Sensor, const HYUN_APP_Table_t *TblPtr)
+{
+    uint32 Seq;
+    uint32 Idx;
+
+    if (TblPtr != NULL && TblPtr->FilterWindow != Sensor->BaroMedian.Size)
+    {
+        HYUN_APP_MedianInit(&Sensor->BaroMedian, TblPtr->FilterWindow);
+        HYUN_APP_MinMaxInit(&Sensor->BaroMinMax, TblPtr->FilterWindow);
+    }
+
+    for (Seq = Sensor->Baro.Tail; Seq != Sensor->Baro.Head; Seq++)
+    {
+        Idx = HYUN_APP_RING_INDEX(Seq, HYUN_APP_BARO_RING_SIZE);
+
+        Sensor->Baro.AltitudeFilt[Idx] = HYUN_APP_MedianUpdate(&Sensor->BaroMedian, Sensor->Baro.Altitude[Idx]);
+        HYUN_APP_MinMaxUpdate(&Sensor->BaroMinMax, Sensor->Baro.Altitude[Idx]);
+    }
+
+    if (Sensor->Baro.Tail != Sensor->Baro.Head)
+    {
+        Sensor->BaroSpread = HYUN_APP_MinMaxGetMax(&Sensor->BaroMinMax) - HYUN_APP_MinMaxGetMin(&Sensor->BaroMinMax);
+    }
+
+    for (Seq = Sensor->Voltage.Tail; Seq != Sensor->Voltage.Head; Seq++)
+    {
+        Idx = HYUN_APP_RING_INDEX(Seq, HYUN_APP_VOLTAGE_RING_SIZE);
+        HYUN_APP_EmaUpdate(&Sensor->VoltageEma, Sensor->Voltage.Voltage[Idx]);
+    }
+
+} /* End of HYUN_APP_SensorFilter() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_SysTimeToUsec -- cFE time stamp to microseconds        */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint64 HYUN_APP_SysTimeToUsec(CFE_TIME_SysTime_t Time)
+{
+    return ((uint64)Time.Seconds * 1000000u) + CFE_TIME_Sub2MicroSecs(Time.Subseconds);
+
+} /* End of HYUN_APP_SysTimeToUsec() */
@@ -0,0 +1,180 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Sensor ingest pipeline on HYUN_PIPE_1, run by the data task
+ *
+ * Every sensor stream is kept in its own ring buffer laid out as a
+ * structure of arrays, so the batch stage walks contiguous float arrays
+ * instead of strided packets. Ring sizes must be powers of two.
+ */
+
+#ifndef HYUN_APP_SENSOR_H
+#define HYUN_APP_SENSOR_H
+
+#include "cfe.h"
+#include "hyun_app_msg.h"
+#include "hyun_app_table.h"
+#include "hyun_app_filter.h"
+#include "hyun_app_nmea.h"
+
+/***********************************************************************/
+/*
+** Nominal rates of the fast sensors, which the pipe, batch and rings
+** below are sized for (checked at build time in hyun_app_sensor.c)
+*/
+#define HYUN_APP_IMU_RATE_HZ  200
+#define HYUN_APP_BARO_RATE_HZ 20
+
+#define HYUN_APP_IMU_RING_SIZE     256 /* ~1.2 s of IMU at 200 Hz */
+#define HYUN_APP_BARO_RING_SIZE    64  /* ~3 s of baro at 20 Hz */
+#define HYUN_APP_GPS_RING_SIZE     16
+#define HYUN_APP_VOLTAGE_RING_SIZE 16
+
+#define HYUN_APP_SENSOR_MAX_BATCH 64 /* Max packets drained from HYUN_PIPE_1 per cycle */
+
+#define HYUN_APP_FILTER_DEFAULT_WINDOW 5    /* Used until the table is loaded */
+#define HYUN_APP_VOLTAGE_EMA_ALPHA     0.1f
+
+/*
+** Standard atmosphere, used for pressure-only (simulated) samples
+*/
+#define HYUN_APP_ISA_P0       101325.0f /* [Pa] */
+#define HYUN_APP_ISA_H0       44330.77f /* [m] */
+#define HYUN_APP_ISA_EXPONENT 0.190263f
+
+/*
+** Default per-MID message limits on HYUN_PIPE_1, until the table sets
+** SubPipe[HYUN_APP_SUB_PIPE_SENSOR]. Sized for one 50 ms cycle with a
+** 2x margin so a late cycle does not drop samples in SB.
+*/
+#define HYUN_APP_IMU_MSG_LIMIT     32
+#define HYUN_APP_BARO_MSG_LIMIT    8
+#define HYUN_APP_GPS_MSG_LIMIT     4
+#define HYUN_APP_VOLTAGE_MSG_LIMIT 4
+#define HYUN_APP_GPS_RAW_MSG_LIMIT 8 /* 9600 baud fills ~8 raw packets per second */
+
+#define HYUN_APP_RING_INDEX(Seq, Size) ((Seq) & ((Size)-1))
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+/*
+** Head is the next slot to write, Tail the next slot not yet seen by the
+** batch stage. Both run freely and are masked on access, so Head - Tail
+** is the number of pending samples even across wrap-around.
+*/
+typedef struct
+{
+    uint32 Head;
+    uint32 Tail;
+    uint64 TimeUs[HYUN_APP_BARO_RING_SIZE];
+    uint64 ArrivalUs[HYUN_APP_BARO_RING_SIZE]; /* MET when the data task took the sample */
+    float  Pressure[HYUN_APP_BARO_RING_SIZE];
+    float  Altitude[HYUN_APP_BARO_RING_SIZE];
+    float  AltitudeFilt[HYUN_APP_BARO_RING_SIZE]; /* Median filtered, filled by the batch stage */
+    float  Temperature[HYUN_APP_BARO_RING_SIZE];
+} HYUN_APP_BaroRing_t;
+
+typedef struct
+{
+    uint32 Head;
+    uint32 Tail;
+    uint64 TimeUs[HYUN_APP_IMU_RING_SIZE];
+    uint64 ArrivalUs[HYUN_APP_IMU_RING_SIZE]; /* MET when the data task took the sample */
+    float  AccelX[HYUN_APP_IMU_RING_SIZE];
+    float  AccelY[HYUN_APP_IMU_RING_SIZE];
+    float  AccelZ[HYUN_APP_IMU_RING_SIZE];
+    float  GyroX[HYUN_APP_IMU_RING_SIZE];
+    float  GyroY[HYUN_APP_IMU_RING_SIZE];
+    float  GyroZ[HYUN_APP_IMU_RING_SIZE];
+} HYUN_APP_ImuRing_t;
+
+typedef struct
+{
+    uint32 Head;
+    uint32 Tail;
+    uint64 TimeUs[HYUN_APP_GPS_RING_SIZE];
+    int32  LatitudeE7[HYUN_APP_GPS_RING_SIZE];
+    int32  LongitudeE7[HYUN_APP_GPS_RING_SIZE];
+    float  Altitude[HYUN_APP_GPS_RING_SIZE];
+    uint8  Satellites[HYUN_APP_GPS_RING_SIZE];
+    uint8  FixValid[HYUN_APP_GPS_RING_SIZE];
+} HYUN_APP_GpsRing_t;
+
+typedef struct
+{
+    uint32 Head;
+    uint32 Tail;
+    uint64 TimeUs[HYUN_APP_VOLTAGE_RING_SIZE];
+    float  Voltage[HYUN_APP_VOLTAGE_RING_SIZE];
+} HYUN_APP_VoltageRing_t;
+
+typedef struct
+{
+    /*
+    ** Counters reported in housekeeping
+    */
+    uint32 MsgCounter;
+    uint32 DropCounter;
+    uint16 ErrCounter;
+    uint16 LastBatch;
+
+    uint64 CycleDeadlineUs; /* MET at which the current cycle stops taking packets */
+
+    HYUN_APP_BaroRing_t    Baro;
+    HYUN_APP_ImuRing_t     Imu;
+    HYUN_APP_GpsRing_t     Gps;
+    HYUN_APP_VoltageRing_t Voltage;
+
+    /*
+    ** Noise rejection ahead of the estimator
+    */
+    HYUN_APP_NmeaParser_t Nmea;
+
+    HYUN_APP_Median_t BaroMedian;
+    HYUN_APP_MinMax_t BaroMinMax;
+    HYUN_APP_Ema_t    VoltageEma;
+    float             BaroSpread;
+
+} HYUN_APP_SensorData_t;
+
+/****************************************************************************/
+/*
+** Sensor pipeline prototypes
+*/
+int32 HYUN_APP_SensorInit(void);
+int32 HYUN_APP_SensorCycle(int32 PeriodMs);
+int32 HYUN_APP_SensorIngest(const CFE_SB_Buffer_t *SBBufPtr);
+int32 HYUN_APP_SensorIngestNmea(const HYUN_APP_GpsRawTlm_t *RawPtr, size_t Size, uint64 TimeUs);
+void  HYUN_APP_SensorProcessBatch(HYUN_APP_SensorData_t *Sensor);
+int32 HYUN_APP_SendEstimate(void);
+void  HYUN_APP_SensorFilter(HYUN_APP_SensorData_t *Sensor, const HYUN_APP_Table_t *TblPtr);
+void  HYUN_APP_SensorPushBaro(uint64 TimeUs, float Pressure);
+float HYUN_APP_PressureToAltitude(float Pressure);
+
+uint64 HYUN_APP_SysTimeToUsec(CFE_TIME_SysTime_t Time);
+
+#endif /* HYUN_APP_SENSOR_H */
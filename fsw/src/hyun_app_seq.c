@@ -0,0 +1,268 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+** File: hyun_app_seq.c
+**
+** Purpose:
+**   Named ground command sequences from the sequence table, each run in
+**   one pass through the ground command dispatch.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "hyun_app_events.h"
+#include "hyun_app.h"
+#include "hyun_app_seq.h"
+
+/*
+** Every command payload has to fit a step
+*/
+#define HYUN_APP_SEQ_ARGS_FIT(Name, CC, Type, Handler) \
+    CompileTimeAssert(sizeof(Type) - sizeof(CFE_MSG_CommandHeader_t) <= HYUN_APP_SEQ_MAX_ARGS, HYUN_APP_Seq##Name##TooLarge);
+
+HYUN_APP_CMD_DEFS(HYUN_APP_SEQ_ARGS_FIT)
+
+#undef HYUN_APP_SEQ_ARGS_FIT
+
+/*
+** Sequence of the table by name, NULL if there is none
+*/
+static const HYUN_APP_SeqDef_t *HYUN_APP_SeqFind(const HYUN_APP_SeqTable_t *TblPtr, const char *Name)
+{
+    uint32 i;
+
+    for (i = 0; i < HYUN_APP_SEQ_MAX_SEQUENCES; i++)
+    {
+        if (TblPtr->Seq[i].StepCount != 0 && strncmp(TblPtr->Seq[i].Name, Name, HYUN_APP_SEQ_NAME_LEN) == 0)
+        {
+            return &TblPtr->Seq[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_SeqTeamText -- "CMD,<TeamId>," and the text of a step  */
+/* into a TEXT_CMD payload. The table validation keeps it in size. */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void HYUN_APP_SeqTeamText(uint16 TeamId, const uint8 *Args, char *Text)
+{
+    char   Digits[5];
+    size_t Len = 4;
+    size_t n   = 0;
+
+    memset(Text, 0, HYUN_APP_UPLINK_MAX_TEXT);
+    memcpy(Text, "CMD,", 4);
+
+    do
+    {
+        Digits[n++] = (char)('0' + TeamId % 10);
+        TeamId /= 10;
+    } while (TeamId != 0);
+
+    while (n > 0)
+    {
+        Text[Len++] = Digits[--n];
+    }
+    Text[Len++] = ',';
+
+    memcpy(&Text[Len], Args, strnlen((const char *)Args, HYUN_APP_SEQ_MAX_TEXT));
+
+} /* End of HYUN_APP_SeqTeamText() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_SeqTblValidationFunc                                      */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Verify the sequence table. Used sequences have a unique name and   */
+/*         every step is a known command other than SEQ_START, with exactly   */
+/*         the payload length of its message type.                            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_SeqTblValidationFunc(void *TblData)
+{
+    int32                      ReturnCode = CFE_SUCCESS;
+    const HYUN_APP_SeqTable_t *TblPtr     = (const HYUN_APP_SeqTable_t *)TblData;
+    const HYUN_APP_SeqDef_t   *Def;
+    const HYUN_APP_SeqStep_t  *Step;
+    uint32                     i;
+    uint32                     j;
+
+    for (i = 0; i < HYUN_APP_SEQ_MAX_SEQUENCES; i++)
+    {
+        Def = &TblPtr->Seq[i];
+
+        if (Def->StepCount > HYUN_APP_SEQ_MAX_STEPS || (Def->StepCount == 0) != (Def->Name[0] == 0))
+        {
+            ReturnCode = HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+            continue;
+        }
+
+        for (j = 0; j < i; j++)
+        {
+            if (Def->StepCount != 0 && strncmp(TblPtr->Seq[j].Name, Def->Name, HYUN_APP_SEQ_NAME_LEN) == 0)
+            {
+                ReturnCode = HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+            }
+        }
+
+        for (j = 0; j < Def->StepCount; j++)
+        {
+            Step = &Def->Step[j];
+
+            if (Step->CommandCode >= HYUN_APP_CMD_COUNT || Step->CommandCode == HYUN_APP_SEQ_START_CC ||
+                sizeof(CFE_MSG_CommandHeader_t) + Step->ArgLength != HYUN_APP_CmdLength[Step->CommandCode])
+            {
+                ReturnCode = HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+            }
+
+            /*
+            ** Text steps leave out "CMD,<TEAM_ID>,", it is added when they run
+            */
+            if (Step->CommandCode == HYUN_APP_TEXT_CMD_CC &&
+                (strnlen((const char *)Step->Args, Step->ArgLength) > HYUN_APP_SEQ_MAX_TEXT ||
+                 strncmp((const char *)Step->Args, "CMD,", 4) == 0))
+            {
+                ReturnCode = HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE;
+            }
+        }
+    }
+
+    return ReturnCode;
+
+} /* End of HYUN_APP_SeqTblValidationFunc() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_SeqStartCmd                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Run the named sequence. Each step is built in a local packet and   */
+/*         dispatched directly, in table order, within this one command. The  */
+/*         first step its handler refuses ends the sequence. Text steps get   */
+/*         the team ID of the loaded HyunAppTable.                            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_SeqStartCmd(const HYUN_APP_SeqStartCmd_t *Msg)
+{
+    HYUN_APP_Seq_t            *Seq    = &HYUN_APP_Data.Seq;
+    HYUN_APP_SeqTable_t       *TblPtr = NULL;
+    HYUN_APP_Table_t          *AppTbl = NULL;
+    const HYUN_APP_SeqDef_t   *Def    = NULL;
+    const HYUN_APP_SeqStep_t  *Step   = NULL;
+    char                       Name[HYUN_APP_SEQ_NAME_LEN + 1];
+    uint16                     TeamId = 0;
+    uint64                     StartUs;
+    int32                      status;
+    uint32                     i;
+    union
+    {
+        CFE_SB_Buffer_t Buf;
+        uint8           Byte[sizeof(CFE_MSG_CommandHeader_t) + HYUN_APP_SEQ_MAX_ARGS];
+    } Cmd;
+
+    memcpy(Name, Msg->Payload.Name, HYUN_APP_SEQ_NAME_LEN);
+    Name[HYUN_APP_SEQ_NAME_LEN] = 0;
+
+    status = CFE_TBL_GetAddress((void *)&TblPtr, HYUN_APP_Data.TblHandles[HYUN_APP_SEQ_TBL_INDEX]);
+    if (status < CFE_SUCCESS)
+    {
+        Seq->AbortCounter++;
+        HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter++;
+        CFE_EVS_SendEvent(HYUN_APP_SEQ_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "Sequence %s refused: no sequence table, RC = 0x%08lX", Name, (unsigned long)status);
+        return status;
+    }
+
+    Def = HYUN_APP_SeqFind(TblPtr, Name);
+    if (Def == NULL)
+    {
+        CFE_TBL_ReleaseAddress(HYUN_APP_Data.TblHandles[HYUN_APP_SEQ_TBL_INDEX]);
+
+        Seq->AbortCounter++;
+        HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter++;
+        CFE_EVS_SendEvent(HYUN_APP_SEQ_ERR_EID, CFE_EVS_EventType_ERROR, "Sequence %s refused: not in the table",
+                          Name);
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    /*
+    ** Without the app table the team ID is not checked, any will do
+    */
+    if (CFE_TBL_GetAddress((void *)&AppTbl, HYUN_APP_Data.TblHandles[0]) >= CFE_SUCCESS)
+    {
+        TeamId = AppTbl->TeamId;
+        CFE_TBL_ReleaseAddress(HYUN_APP_Data.TblHandles[0]);
+    }
+
+    StartUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+
+    for (i = 0; i < Def->StepCount; i++)
+    {
+        Step = &Def->Step[i];
+
+        CFE_MSG_Init(&Cmd.Buf.Msg, CFE_SB_ValueToMsgId(HYUN_APP_MID_GROUNDCMD_REQ),
+                     sizeof(CFE_MSG_CommandHeader_t) + Step->ArgLength);
+        CFE_MSG_SetFcnCode(&Cmd.Buf.Msg, Step->CommandCode);
+        if (Step->CommandCode == HYUN_APP_TEXT_CMD_CC)
+        {
+            HYUN_APP_SeqTeamText(TeamId, Step->Args, (char *)&Cmd.Byte[sizeof(CFE_MSG_CommandHeader_t)]);
+        }
+        else
+        {
+            memcpy(&Cmd.Byte[sizeof(CFE_MSG_CommandHeader_t)], Step->Args, Step->ArgLength);
+        }
+
+        status = HYUN_APP_ProcessGroundCommand(&Cmd.Buf);
+        if (status != CFE_SUCCESS)
+        {
+            break;
+        }
+    }
+
+    Seq->LastRunUs = (uint32)(HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET()) - StartUs);
+
+    if (status != CFE_SUCCESS)
+    {
+        Seq->AbortCounter++;
+        HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter++;
+        CFE_EVS_SendEvent(HYUN_APP_SEQ_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "Sequence %s stopped at step %lu of %lu (CC %u), RC = 0x%08lX", Name,
+                          (unsigned long)(i + 1), (unsigned long)Def->StepCount, (unsigned int)Step->CommandCode,
+                          (unsigned long)status);
+    }
+    else
+    {
+        Seq->RunCounter++;
+        HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].CmdCounter++;
+        CFE_EVS_SendEvent(HYUN_APP_SEQ_INF_EID, CFE_EVS_EventType_INFORMATION, "Sequence %s: %lu steps in %lu us",
+                          Name, (unsigned long)Def->StepCount, (unsigned long)Seq->LastRunUs);
+    }
+
+    CFE_TBL_ReleaseAddress(HYUN_APP_Data.TblHandles[HYUN_APP_SEQ_TBL_INDEX]);
+
+    return status;
+
+} /* End of HYUN_APP_SeqStartCmd() */
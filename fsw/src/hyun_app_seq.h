@@ -0,0 +1,110 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Ground command sequences
+ *
+ * A second table holds named sequences, each a list of (CC, payload)
+ * steps for HYUN_APP_MID_GROUNDCMD_REQ. SEQ_START runs one of them in a
+ * single pass: every step is built in a local packet and handed straight
+ * to the ground command dispatch, so a procedure costs one uplinked
+ * command and one trip through the command pipe instead of one per step.
+ *
+ * The table validation checks every step against the command schema, so
+ * a step always passes the dispatch length check. Steps run in order
+ * until one is refused; the remaining steps are then skipped. Steps
+ * that queue work for the data task (SIMP, CAL, replay) complete there,
+ * after the sequence. A step may not start another sequence; it may
+ * queue a time-tagged command, including a tagged SEQ_START.
+ *
+ * A TEXT_CMD step holds the text after "CMD,<TEAM_ID>,", e.g. "CX,ON".
+ * The prefix is added from the TeamId of HyunAppTable when the step
+ * runs, so one sequence table serves any team.
+ */
+
+#ifndef HYUN_APP_SEQ_H
+#define HYUN_APP_SEQ_H
+
+#include "cfe.h"
+#include "hyun_app_msg.h"
+
+/***********************************************************************/
+#define HYUN_APP_SEQ_MAX_SEQUENCES 8
+#define HYUN_APP_SEQ_MAX_STEPS     8
+#define HYUN_APP_SEQ_MAX_ARGS      112 /* Largest command payload, TTAG_INSERT [bytes] */
+#define HYUN_APP_SEQ_MAX_TEXT      (HYUN_APP_UPLINK_MAX_TEXT - 10) /* Text step, room for "CMD,65535," */
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+/*
+** One command. Args is the payload in the layout of the command's
+** message type, ArgLength bytes of it.
+*/
+typedef struct
+{
+    uint8  CommandCode;
+    uint8  spare;
+    uint16 ArgLength;
+    uint8  Args[HYUN_APP_SEQ_MAX_ARGS];
+} HYUN_APP_SeqStep_t;
+
+/*
+** Unused sequences have StepCount 0 and an empty Name
+*/
+typedef struct
+{
+    char               Name[HYUN_APP_SEQ_NAME_LEN];
+    uint16             StepCount;
+    uint16             spare;
+    HYUN_APP_SeqStep_t Step[HYUN_APP_SEQ_MAX_STEPS];
+} HYUN_APP_SeqDef_t;
+
+/*
+** Sequence table structure
+*/
+typedef struct
+{
+    HYUN_APP_SeqDef_t Seq[HYUN_APP_SEQ_MAX_SEQUENCES];
+} HYUN_APP_SeqTable_t;
+
+/*
+** Reported in housekeeping
+*/
+typedef struct
+{
+    uint16 RunCounter;
+    uint16 AbortCounter;
+    uint32 LastRunUs;
+} HYUN_APP_Seq_t;
+
+/****************************************************************************/
+/*
+** Sequence prototypes
+*/
+int32 HYUN_APP_SeqTblValidationFunc(void *TblData);
+int32 HYUN_APP_SeqStartCmd(const HYUN_APP_SeqStartCmd_t *Msg);
+
+#endif /* HYUN_APP_SEQ_H */
@@ -0,0 +1,371 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_sub.c
+**
+** Purpose:
+**   Creates the command and sensor pipes and keeps their subscriptions
+**   in step with the table, by diff, without restarting the app.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "hyun_app_events.h"
+#include "hyun_app.h"
+#include "hyun_app_sub.h"
+
+/*
+** Used from init until the table is loaded, and whenever no table is
+** loaded at all. hyun_app_tbl.c starts from the same values.
+*/
+static const HYUN_APP_SubPipe_t HYUN_APP_SubDefaults[HYUN_APP_SUB_PIPES] = {
+    [HYUN_APP_SUB_PIPE_CMD] =
+        {
+            .Depth = HYUN_APP_PIPE_DEPTH,
+            .Entry =
+                {
+                    {.MsgId = HYUN_APP_MID_HOUSEKEEPING_REQ, .MsgLimit = HYUN_APP_HK_REQ_MSG_LIMIT},
+                    {.MsgId = HYUN_APP_MID_GROUNDCMD_REQ, .MsgLimit = HYUN_APP_GROUNDCMD_MSG_LIMIT},
+                },
+        },
+    [HYUN_APP_SUB_PIPE_SENSOR] =
+        {
+            .Depth = HYUN_PIPE_1_DEPTH,
+            .Entry =
+                {
+                    {.MsgId = HYUN_APP_MID_SENSOR_IMU, .MsgLimit = HYUN_APP_IMU_MSG_LIMIT},
+                    {.MsgId = HYUN_APP_MID_SENSOR_BARO, .MsgLimit = HYUN_APP_BARO_MSG_LIMIT},
+                    {.MsgId = HYUN_APP_MID_SENSOR_GPS, .MsgLimit = HYUN_APP_GPS_MSG_LIMIT},
+                    {.MsgId = HYUN_APP_MID_SENSOR_VOLTAGE, .MsgLimit = HYUN_APP_VOLTAGE_MSG_LIMIT},
+                    {.MsgId = HYUN_APP_MID_SENSOR_GPS_RAW, .MsgLimit = HYUN_APP_GPS_RAW_MSG_LIMIT},
+                },
+        },
+};
+
+/*
+** Pipe ID and name of HYUN_APP_SUB_PIPE_xxx
+*/
+static CFE_SB_PipeId_t *HYUN_APP_SubPipeId(uint32 Pipe)
+{
+    return (Pipe == HYUN_APP_SUB_PIPE_CMD) ? &HYUN_APP_Data.CommandPipe : &HYUN_APP_Data.HYUN_PIPE_1;
+}
+
+static const char *HYUN_APP_SubPipeName(uint32 Pipe)
+{
+    return (Pipe == HYUN_APP_SUB_PIPE_CMD) ? HYUN_APP_Data.Cold.PipeName : HYUN_PIPE_1_NAME;
+}
+
+/*
+** Index of MsgId in the pipe's entries, -1 when not listed
+*/
+static int32 HYUN_APP_SubFind(const HYUN_APP_SubPipe_t *SubPipe, uint16 MsgId)
+{
+    int32 i;
+
+    for (i = 0; i < HYUN_APP_SUB_MAX_MIDS; i++)
+    {
+        if (SubPipe->Entry[i].MsgId == MsgId)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_SubInit                                                   */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Create one pipe with its default depth and subscriptions.          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_SubInit(uint32 Pipe)
+{
+    HYUN_APP_Sub_t           *Sub     = &HYUN_APP_Data.Sub;
+    const HYUN_APP_SubPipe_t *Default = &HYUN_APP_SubDefaults[Pipe];
+    HYUN_APP_SubPipe_t       *Active  = &Sub->Active[Pipe];
+    int32                     status;
+    uint32                    i;
+
+    memset(Active, 0, sizeof(*Active));
+    Sub->Want[Pipe] = *Default;
+
+    status = CFE_SB_CreatePipe(HYUN_APP_SubPipeId(Pipe), Default->Depth, HYUN_APP_SubPipeName(Pipe));
+    if (status != CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("Hyun_app: Error creating pipe %s, RC = 0x%08lX\n", HYUN_APP_SubPipeName(Pipe),
+                             (unsigned long)status);
+        return (status);
+    }
+    Active->Depth = Default->Depth;
+
+    for (i = 0; i < HYUN_APP_SUB_MAX_MIDS; i++)
+    {
+        if (Default->Entry[i].MsgId == 0)
+        {
+            continue;
+        }
+
+        status = CFE_SB_SubscribeEx(CFE_SB_ValueToMsgId(Default->Entry[i].MsgId), *HYUN_APP_SubPipeId(Pipe),
+                                    CFE_SB_DEFAULT_QOS, Default->Entry[i].MsgLimit);
+        if (status != CFE_SUCCESS)
+        {
+            CFE_ES_WriteToSysLog("Hyun_app: Error Subscribing to MID 0x%04X on %s, RC = 0x%08lX\n",
+                                 (unsigned int)Default->Entry[i].MsgId, HYUN_APP_SubPipeName(Pipe),
+                                 (unsigned long)status);
+            return (status);
+        }
+        Active->Entry[i] = Default->Entry[i];
+    }
+
+    return (CFE_SUCCESS);
+
+} /* End of HYUN_APP_SubInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_SubConfig -- Take the subscriptions of the active      */
+/* table, main task. Nothing changes on SB until the pipe's reader */
+/* runs HYUN_APP_SubApply; a pipe still applying the previous      */
+/* table is left for the next call.                                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_SubConfig(const HYUN_APP_Table_t *TblPtr)
+{
+    HYUN_APP_Sub_t *Sub = &HYUN_APP_Data.Sub;
+    uint32          Pipe;
+
+    for (Pipe = 0; Pipe < HYUN_APP_SUB_PIPES; Pipe++)
+    {
+        if (__atomic_load_n(&Sub->ApplyPending[Pipe], __ATOMIC_ACQUIRE))
+        {
+            continue;
+        }
+
+        if (memcmp(&Sub->Want[Pipe], &TblPtr->SubPipe[Pipe], sizeof(Sub->Want[Pipe])) != 0)
+        {
+            memcpy(&Sub->Want[Pipe], &TblPtr->SubPipe[Pipe], sizeof(Sub->Want[Pipe]));
+            __atomic_store_n(&Sub->ApplyPending[Pipe], true, __ATOMIC_RELEASE);
+        }
+    }
+
+} /* End of HYUN_APP_SubConfig() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_SubApplyPipe                                              */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Bring one pipe from Active to Want. A new depth recreates the      */
+/*         pipe first and falls back to the old depth if SB refuses it.       */
+/*         A MID whose limit changed is unsubscribed and subscribed again,    */
+/*         which only affects messages sent in between; those already queued  */
+/*         stay on the pipe.                                                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HYUN_APP_SubApplyPipe(uint32 Pipe)
+{
+    HYUN_APP_Sub_t           *Sub     = &HYUN_APP_Data.Sub;
+    HYUN_APP_SubPipe_t       *Active  = &Sub->Active[Pipe];
+    const HYUN_APP_SubPipe_t *Want    = &Sub->Want[Pipe];
+    CFE_SB_PipeId_t          *PipeId  = HYUN_APP_SubPipeId(Pipe);
+    uint32                    Added   = 0;
+    uint32                    Removed = 0;
+    uint32                    Changed = 0;
+    uint16                    Depth;
+    int32                     status;
+    int32                     j;
+    uint32                    i;
+
+    if (Want->Depth != Active->Depth)
+    {
+        Depth = Active->Depth;
+        CFE_SB_DeletePipe(*PipeId);
+        memset(Active, 0, sizeof(*Active));
+
+        status = CFE_SB_CreatePipe(PipeId, Want->Depth, HYUN_APP_SubPipeName(Pipe));
+        if (status == CFE_SUCCESS)
+        {
+            Depth = Want->Depth;
+        }
+        else
+        {
+            Sub->ErrCounter[Pipe]++;
+            CFE_EVS_SendEvent(HYUN_APP_SUB_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "Pipe %s: depth %u refused, RC = 0x%08lX", HYUN_APP_SubPipeName(Pipe),
+                              (unsigned int)Want->Depth, (unsigned long)status);
+
+            status = CFE_SB_CreatePipe(PipeId, Depth, HYUN_APP_SubPipeName(Pipe));
+            if (status != CFE_SUCCESS)
+            {
+                CFE_EVS_SendEvent(HYUN_APP_SUB_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "Pipe %s lost, RC = 0x%08lX", HYUN_APP_SubPipeName(Pipe), (unsigned long)status);
+                return;
+            }
+        }
+
+        Active->Depth = Depth;
+        Sub->ChangeCounter[Pipe]++;
+        CFE_EVS_SendEvent(HYUN_APP_SUB_INF_EID, CFE_EVS_EventType_INFORMATION, "Pipe %s recreated with depth %u",
+                          HYUN_APP_SubPipeName(Pipe), (unsigned int)Depth);
+    }
+
+    /*
+    ** Drop MIDs no longer listed, resubscribe those with a new limit
+    */
+    for (i = 0; i < HYUN_APP_SUB_MAX_MIDS; i++)
+    {
+        if (Active->Entry[i].MsgId == 0)
+        {
+            continue;
+        }
+
+        j = HYUN_APP_SubFind(Want, Active->Entry[i].MsgId);
+        if (j >= 0 && Want->Entry[j].MsgLimit == Active->Entry[i].MsgLimit)
+        {
+            continue;
+        }
+
+        CFE_SB_Unsubscribe(CFE_SB_ValueToMsgId(Active->Entry[i].MsgId), *PipeId);
+        Sub->ChangeCounter[Pipe]++;
+
+        if (j < 0)
+        {
+            Active->Entry[i].MsgId = 0;
+            Removed++;
+            continue;
+        }
+
+        status = CFE_SB_SubscribeEx(CFE_SB_ValueToMsgId(Want->Entry[j].MsgId), *PipeId, CFE_SB_DEFAULT_QOS,
+                                    Want->Entry[j].MsgLimit);
+        if (status != CFE_SUCCESS)
+        {
+            Sub->ErrCounter[Pipe]++;
+            CFE_EVS_SendEvent(HYUN_APP_SUB_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "Pipe %s: cannot resubscribe MID 0x%04X, RC = 0x%08lX", HYUN_APP_SubPipeName(Pipe),
+                              (unsigned int)Want->Entry[j].MsgId, (unsigned long)status);
+            Active->Entry[i].MsgId = 0;
+            continue;
+        }
+        Active->Entry[i].MsgLimit = Want->Entry[j].MsgLimit;
+        Changed++;
+    }
+
+    /*
+    ** Subscribe MIDs SB does not deliver here yet. Every MID left in
+    ** Active is also in Want, so a free Active slot always exists.
+    */
+    for (j = 0; j < HYUN_APP_SUB_MAX_MIDS; j++)
+    {
+        if (Want->Entry[j].MsgId == 0 || HYUN_APP_SubFind(Active, Want->Entry[j].MsgId) >= 0)
+        {
+            continue;
+        }
+
+        status = CFE_SB_SubscribeEx(CFE_SB_ValueToMsgId(Want->Entry[j].MsgId), *PipeId, CFE_SB_DEFAULT_QOS,
+                                    Want->Entry[j].MsgLimit);
+        if (status != CFE_SUCCESS)
+        {
+            Sub->ErrCounter[Pipe]++;
+            CFE_EVS_SendEvent(HYUN_APP_SUB_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "Pipe %s: cannot subscribe MID 0x%04X, RC = 0x%08lX", HYUN_APP_SubPipeName(Pipe),
+                              (unsigned int)Want->Entry[j].MsgId, (unsigned long)status);
+            continue;
+        }
+
+        i                = (uint32)HYUN_APP_SubFind(Active, 0);
+        Active->Entry[i] = Want->Entry[j];
+        Sub->ChangeCounter[Pipe]++;
+        Added++;
+    }
+
+    if (Added != 0 || Removed != 0 || Changed != 0)
+    {
+        CFE_EVS_SendEvent(HYUN_APP_SUB_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "Pipe %s: %lu subscribed, %lu unsubscribed, %lu limits changed", HYUN_APP_SubPipeName(Pipe),
+                          (unsigned long)Added, (unsigned long)Removed, (unsigned long)Changed);
+    }
+
+} /* End of HYUN_APP_SubApplyPipe() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_SubApply -- Apply a changed table to one pipe. Runs in */
+/* the pipe's reader while no buffer from the pipe is held.        */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_SubApply(uint32 Pipe)
+{
+    if (!__atomic_load_n(&HYUN_APP_Data.Sub.ApplyPending[Pipe], __ATOMIC_ACQUIRE))
+    {
+        return;
+    }
+
+    HYUN_APP_SubApplyPipe(Pipe);
+
+    __atomic_store_n(&HYUN_APP_Data.Sub.ApplyPending[Pipe], false, __ATOMIC_RELEASE);
+
+} /* End of HYUN_APP_SubApply() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_SubValid                                                  */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Table check: depths in range, every listed MID once per pipe with  */
+/*         a limit the pipe can hold, and the command pipe keeps HK requests  */
+/*         and ground commands so a bad table can always be replaced.         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+bool HYUN_APP_SubValid(const HYUN_APP_SubPipe_t *SubPipe)
+{
+    const HYUN_APP_SubPipe_t *Cmd = &SubPipe[HYUN_APP_SUB_PIPE_CMD];
+    uint32                    Pipe;
+    uint32                    i;
+
+    for (Pipe = 0; Pipe < HYUN_APP_SUB_PIPES; Pipe++)
+    {
+        if (SubPipe[Pipe].Depth == 0 || SubPipe[Pipe].Depth > HYUN_APP_SUB_MAX_DEPTH)
+        {
+            return false;
+        }
+
+        for (i = 0; i < HYUN_APP_SUB_MAX_MIDS; i++)
+        {
+            if (SubPipe[Pipe].Entry[i].MsgId == 0)
+            {
+                continue;
+            }
+
+            if (SubPipe[Pipe].Entry[i].MsgLimit == 0 || SubPipe[Pipe].Entry[i].MsgLimit > SubPipe[Pipe].Depth ||
+                HYUN_APP_SubFind(&SubPipe[Pipe], SubPipe[Pipe].Entry[i].MsgId) != (int32)i)
+            {
+                return false;
+            }
+        }
+    }
+
+    return (HYUN_APP_SubFind(Cmd, HYUN_APP_MID_HOUSEKEEPING_REQ) >= 0 &&
+            HYUN_APP_SubFind(Cmd, HYUN_APP_MID_GROUNDCMD_REQ) >= 0);
+
+} /* End of HYUN_APP_SubValid() */
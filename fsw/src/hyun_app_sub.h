@@ -0,0 +1,78 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Table-driven Software Bus subscriptions
+ *
+ * The command pipe and HYUN_PIPE_1 are created with built-in defaults at
+ * init, before the table is loaded. Each table the app picks up is then
+ * compared against what SB currently holds and only the differences are
+ * applied: new MIDs are subscribed, dropped MIDs unsubscribed, and a MID
+ * whose limit changed is subscribed again with the new limit. A changed
+ * depth recreates the pipe, since SB cannot resize one.
+ *
+ * Each pipe is read by its own task (the command pipe by the main task,
+ * HYUN_PIPE_1 by the data task), so each pipe's changes are made by its
+ * reader between two receives, never while a buffer from the pipe is
+ * held. The main task posts a pipe's new Want and raises its
+ * ApplyPending flag with release order; the reader clears the flag once
+ * applied, and until then the main task leaves that Want alone.
+ */
+
+#ifndef HYUN_APP_SUB_H
+#define HYUN_APP_SUB_H
+
+#include "cfe.h"
+#include "hyun_app_table.h"
+
+/***********************************************************************/
+#define HYUN_APP_SUB_MAX_DEPTH 256 /* Deepest pipe the table may ask for */
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    HYUN_APP_SubPipe_t Active[HYUN_APP_SUB_PIPES]; /* What SB holds now */
+    HYUN_APP_SubPipe_t Want[HYUN_APP_SUB_PIPES];   /* Latest table, applied by HYUN_APP_SubApply */
+    bool               ApplyPending[HYUN_APP_SUB_PIPES];
+
+    /*
+    ** Per pipe, written by the pipe's reader only
+    */
+    uint16 ChangeCounter[HYUN_APP_SUB_PIPES]; /* Subscribe, unsubscribe and recreate operations */
+    uint16 ErrCounter[HYUN_APP_SUB_PIPES];
+} HYUN_APP_Sub_t;
+
+/****************************************************************************/
+/*
+** Subscription prototypes
+*/
+int32 HYUN_APP_SubInit(uint32 Pipe);
+void  HYUN_APP_SubConfig(const HYUN_APP_Table_t *TblPtr);
+void  HYUN_APP_SubApply(uint32 Pipe);
+bool  HYUN_APP_SubValid(const HYUN_APP_SubPipe_t *SubPipe);
+
+#endif /* HYUN_APP_SUB_H */
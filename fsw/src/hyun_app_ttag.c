@@ -0,0 +1,402 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_ttag.c
+**
+** Purpose:
+**   Queue of time-tagged ground commands, a min-heap on the execution
+**   MET, dispatched by the main task when due.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "hyun_app_events.h"
+#include "hyun_app.h"
+#include "hyun_app_ttag.h"
+
+CompileTimeAssert(HYUN_APP_TTAG_CAPACITY <= 255, HYUN_APP_TtagHeapIndexTooSmall);
+CompileTimeAssert(sizeof(HYUN_APP_TtagListTlm_t) <= HYUN_APP_POOL_SLOT_SIZE, HYUN_APP_TtagListTlmTooLarge);
+
+/*
+** Heap order: earlier time first, then earlier insertion
+*/
+static bool HYUN_APP_TtagBefore(const HYUN_APP_Ttag_t *Ttag, uint8 A, uint8 B)
+{
+    const HYUN_APP_TtagEntry_t *EntryA = &Ttag->Entry[A];
+    const HYUN_APP_TtagEntry_t *EntryB = &Ttag->Entry[B];
+
+    if (EntryA->ExecUs != EntryB->ExecUs)
+    {
+        return EntryA->ExecUs < EntryB->ExecUs;
+    }
+
+    return (int32)(EntryA->Seq - EntryB->Seq) < 0;
+}
+
+static void HYUN_APP_TtagSiftUp(HYUN_APP_Ttag_t *Ttag, uint32 Pos)
+{
+    uint8  Index = Ttag->Heap[Pos];
+    uint32 Parent;
+
+    while (Pos > 0)
+    {
+        Parent = (Pos - 1) / 2;
+        if (!HYUN_APP_TtagBefore(Ttag, Index, Ttag->Heap[Parent]))
+        {
+            break;
+        }
+        Ttag->Heap[Pos] = Ttag->Heap[Parent];
+        Pos             = Parent;
+    }
+
+    Ttag->Heap[Pos] = Index;
+}
+
+static void HYUN_APP_TtagSiftDown(HYUN_APP_Ttag_t *Ttag, uint32 Pos)
+{
+    uint8  Index = Ttag->Heap[Pos];
+    uint32 Child;
+
+    while ((Child = 2 * Pos + 1) < Ttag->Count)
+    {
+        if (Child + 1 < Ttag->Count && HYUN_APP_TtagBefore(Ttag, Ttag->Heap[Child + 1], Ttag->Heap[Child]))
+        {
+            Child++;
+        }
+        if (!HYUN_APP_TtagBefore(Ttag, Ttag->Heap[Child], Index))
+        {
+            break;
+        }
+        Ttag->Heap[Pos] = Ttag->Heap[Child];
+        Pos             = Child;
+    }
+
+    Ttag->Heap[Pos] = Index;
+}
+
+/*
+** Take the heap node at Pos out and free its entry
+*/
+static void HYUN_APP_TtagRemoveAt(HYUN_APP_Ttag_t *Ttag, uint32 Pos)
+{
+    Ttag->Entry[Ttag->Heap[Pos]].TagId = 0;
+
+    Ttag->Count--;
+    if (Pos == Ttag->Count)
+    {
+        return;
+    }
+
+    Ttag->Heap[Pos] = Ttag->Heap[Ttag->Count];
+    HYUN_APP_TtagSiftDown(Ttag, Pos);
+    HYUN_APP_TtagSiftUp(Ttag, Pos);
+}
+
+/*
+** Heap position of TagId, -1 when not queued
+*/
+static int32 HYUN_APP_TtagFind(const HYUN_APP_Ttag_t *Ttag, uint32 TagId)
+{
+    uint32 Pos;
+
+    for (Pos = 0; Pos < Ttag->Count; Pos++)
+    {
+        if (Ttag->Entry[Ttag->Heap[Pos]].TagId == TagId)
+        {
+            return (int32)Pos;
+        }
+    }
+
+    return -1;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_TtagInit -- Empty queue                                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_TtagInit(void)
+{
+    HYUN_APP_Ttag_t *Ttag = &HYUN_APP_Data.Ttag;
+
+    memset(Ttag, 0, sizeof(*Ttag));
+
+} /* End of HYUN_APP_TtagInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_TtagService                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Dispatch every queued command that is due, soonest first. Each     */
+/*         one is taken off the heap before it runs, so a tagged TTAG_CANCEL  */
+/*         or TTAG_LIST sees a consistent queue.                              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HYUN_APP_TtagService(void)
+{
+    HYUN_APP_Ttag_t     *Ttag = &HYUN_APP_Data.Ttag;
+    HYUN_APP_TtagEntry_t Due;
+    uint64               NowUs;
+    uint32               JitterUs;
+
+    while (Ttag->Count > 0)
+    {
+        NowUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+        if (Ttag->Entry[Ttag->Heap[0]].ExecUs > NowUs)
+        {
+            break;
+        }
+
+        Due = Ttag->Entry[Ttag->Heap[0]];
+        HYUN_APP_TtagRemoveAt(Ttag, 0);
+
+        JitterUs           = (uint32)(NowUs - Due.ExecUs);
+        Ttag->LastJitterUs = JitterUs;
+        if (JitterUs > Ttag->MaxJitterUs)
+        {
+            Ttag->MaxJitterUs = JitterUs;
+        }
+        Ttag->ExecCounter++;
+
+        CFE_EVS_SendEvent(HYUN_APP_TTAG_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "Time tag %lu dispatched %lu us after its time", (unsigned long)Due.TagId,
+                          (unsigned long)JitterUs);
+
+        HYUN_APP_ProcessGroundCommand(&Due.Cmd.Buf);
+    }
+
+} /* End of HYUN_APP_TtagService() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_TtagTimeout -- Command pipe wait that wakes the main   */
+/* task for the next due command, at most MaxMs                    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 HYUN_APP_TtagTimeout(int32 MaxMs)
+{
+    HYUN_APP_Ttag_t *Ttag = &HYUN_APP_Data.Ttag;
+    uint64           NowUs;
+    uint64           DueUs;
+    uint64           WaitMs;
+
+    if (Ttag->Count == 0)
+    {
+        return MaxMs;
+    }
+
+    NowUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+    DueUs = Ttag->Entry[Ttag->Heap[0]].ExecUs;
+    if (DueUs <= NowUs)
+    {
+        return CFE_SB_POLL;
+    }
+
+    /* Rounded up, waking early would only cost another wait */
+    WaitMs = (DueUs - NowUs + 999) / 1000;
+
+    return (WaitMs < (uint64)MaxMs) ? (int32)WaitMs : MaxMs;
+
+} /* End of HYUN_APP_TtagTimeout() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_TtagInsertCmd                                             */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Queue the embedded command. It must be a ground command packet     */
+/*         of the length given, not another TTAG_INSERT, with a time still    */
+/*         ahead and a tag not already queued.                                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_TtagInsertCmd(const HYUN_APP_TtagInsertCmd_t *Msg)
+{
+    HYUN_APP_Ttag_t                        *Ttag        = &HYUN_APP_Data.Ttag;
+    const HYUN_APP_TtagInsertCmd_Payload_t *Payload     = &Msg->Payload;
+    const CFE_MSG_Message_t                *CmdPtr      = (const CFE_MSG_Message_t *)Payload->Cmd;
+    HYUN_APP_TtagEntry_t                   *Entry;
+    CFE_SB_MsgId_t                          MsgId       = CFE_SB_INVALID_MSG_ID;
+    CFE_MSG_FcnCode_t                       CommandCode = 0;
+    size_t                                  Size        = 0;
+    const char                             *Reject      = NULL;
+    uint64                                  ExecUs;
+    uint32                                  i;
+
+    ExecUs = (uint64)Payload->MetSeconds * 1000000u + Payload->MetMicros;
+
+    if (Payload->CmdLength < sizeof(CFE_MSG_CommandHeader_t) || Payload->CmdLength > HYUN_APP_TTAG_MAX_CMD)
+    {
+        Reject = "bad command length";
+    }
+    else
+    {
+        CFE_MSG_GetMsgId(CmdPtr, &MsgId);
+        CFE_MSG_GetFcnCode(CmdPtr, &CommandCode);
+        CFE_MSG_GetSize(CmdPtr, &Size);
+
+        if (!CFE_SB_MsgId_Equal(MsgId, CFE_SB_ValueToMsgId(HYUN_APP_MID_GROUNDCMD_REQ)) ||
+            Size != Payload->CmdLength)
+        {
+            Reject = "not a ground command of that length";
+        }
+        else if (CommandCode == HYUN_APP_TTAG_INSERT_CC)
+        {
+            Reject = "nested TTAG_INSERT";
+        }
+        else if (Payload->TagId == 0 || HYUN_APP_TtagFind(Ttag, Payload->TagId) >= 0)
+        {
+            Reject = "tag zero or already queued";
+        }
+        else if (Payload->MetMicros >= 1000000u || ExecUs <= HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET()))
+        {
+            Reject = "time already passed";
+        }
+        else if (Ttag->Count >= HYUN_APP_TTAG_CAPACITY)
+        {
+            Reject = "queue full";
+        }
+    }
+
+    if (Reject != NULL)
+    {
+        HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter++;
+        CFE_EVS_SendEvent(HYUN_APP_TTAG_ERR_EID, CFE_EVS_EventType_ERROR, "Time tag %lu refused: %s",
+                          (unsigned long)Payload->TagId, Reject);
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    /* Count < capacity, so a free entry exists */
+    for (i = 0; Ttag->Entry[i].TagId != 0; i++)
+    {
+    }
+
+    Entry         = &Ttag->Entry[i];
+    Entry->ExecUs = ExecUs;
+    Entry->TagId  = Payload->TagId;
+    Entry->Seq    = Ttag->NextSeq++;
+    memset(Entry->Cmd.Byte, 0, sizeof(Entry->Cmd.Byte));
+    memcpy(Entry->Cmd.Byte, Payload->Cmd, Payload->CmdLength);
+
+    Ttag->Heap[Ttag->Count] = (uint8)i;
+    Ttag->Count++;
+    HYUN_APP_TtagSiftUp(Ttag, Ttag->Count - 1);
+
+    HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].CmdCounter++;
+    CFE_EVS_SendEvent(HYUN_APP_TTAG_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "Time tag %lu queued: CC %u at MET %lu.%06lu, %lu pending", (unsigned long)Payload->TagId,
+                      (unsigned int)CommandCode, (unsigned long)Payload->MetSeconds,
+                      (unsigned long)Payload->MetMicros, (unsigned long)Ttag->Count);
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_TtagInsertCmd() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_TtagCancelCmd -- Drop a queued command by its tag      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+int32 HYUN_APP_TtagCancelCmd(const HYUN_APP_TtagCancelCmd_t *Msg)
+{
+    HYUN_APP_Ttag_t *Ttag = &HYUN_APP_Data.Ttag;
+    int32            Pos;
+
+    Pos = (Msg->Payload.TagId == 0) ? -1 : HYUN_APP_TtagFind(Ttag, Msg->Payload.TagId);
+    if (Pos < 0)
+    {
+        HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter++;
+        CFE_EVS_SendEvent(HYUN_APP_TTAG_ERR_EID, CFE_EVS_EventType_ERROR, "Time tag %lu not queued",
+                          (unsigned long)Msg->Payload.TagId);
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    HYUN_APP_TtagRemoveAt(Ttag, (uint32)Pos);
+
+    HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].CmdCounter++;
+    CFE_EVS_SendEvent(HYUN_APP_TTAG_INF_EID, CFE_EVS_EventType_INFORMATION, "Time tag %lu cancelled, %lu pending",
+                      (unsigned long)Msg->Payload.TagId, (unsigned long)Ttag->Count);
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_TtagCancelCmd() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_TtagListCmd                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Send the queue soonest first. A copy of the heap is popped in      */
+/*         order, the queue itself is left as it is. The list is built in a   */
+/*         pool buffer, refused while every buffer still waits for downlink.  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_TtagListCmd(const HYUN_APP_TtagListCmd_t *Msg)
+{
+    HYUN_APP_Ttag_t                *Ttag = &HYUN_APP_Data.Ttag;
+    HYUN_APP_TtagListTlm_t         *ListTlm;
+    HYUN_APP_TtagListTlm_Payload_t *List;
+    HYUN_APP_Ttag_t                 Sorted;
+    const HYUN_APP_TtagEntry_t     *Entry;
+    CFE_MSG_FcnCode_t               CommandCode;
+    uint32                          i;
+
+    (void)Msg;
+
+    ListTlm = (HYUN_APP_TtagListTlm_t *)HYUN_APP_PoolTake(&HYUN_APP_Data.Pool[HYUN_APP_POOL_TTAG]);
+    if (ListTlm == NULL)
+    {
+        HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter++;
+        CFE_EVS_SendEvent(HYUN_APP_TTAG_ERR_EID, CFE_EVS_EventType_ERROR, "Time tag list: no free buffer");
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    List = &ListTlm->Payload;
+    memset(List, 0, sizeof(*List));
+
+    Sorted.Count = Ttag->Count;
+    memcpy(Sorted.Heap, Ttag->Heap, sizeof(Sorted.Heap));
+    memcpy(Sorted.Entry, Ttag->Entry, sizeof(Sorted.Entry));
+
+    for (i = 0; Sorted.Count > 0; i++)
+    {
+        Entry = &Sorted.Entry[Sorted.Heap[0]];
+
+        CommandCode = 0;
+        CFE_MSG_GetFcnCode(&Entry->Cmd.Buf.Msg, &CommandCode);
+
+        List->TagId[i]       = Entry->TagId;
+        List->MetSeconds[i]  = (uint32)(Entry->ExecUs / 1000000u);
+        List->MetMicros[i]   = (uint32)(Entry->ExecUs % 1000000u);
+        List->CommandCode[i] = (uint8)CommandCode;
+
+        HYUN_APP_TtagRemoveAt(&Sorted, 0);
+    }
+    List->Pending = (uint16)i;
+
+    CFE_SB_TimeStampMsg(&ListTlm->TlmHeader.Msg);
+    HYUN_APP_DataPostTlm(&HYUN_APP_Data.Pool[HYUN_APP_POOL_TTAG], &ListTlm->TlmHeader.Msg);
+
+    HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of HYUN_APP_TtagListCmd() */
@@ -0,0 +1,89 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Time-tagged ground commands
+ *
+ * TTAG_INSERT carries a complete ground command and the MET at which it
+ * is to run. Queued commands sit in a fixed-capacity min-heap keyed on
+ * the execution time, with the insertion order breaking ties, so the
+ * soonest command is always at the root. The main task sizes its wait
+ * on the command pipe to the root's due time and, once due, passes the
+ * command through the normal ground command dispatch, length check
+ * included. The delay between the tagged time and the dispatch is kept
+ * as the execution jitter.
+ *
+ * A tagged TTAG_INSERT is refused, so the queue can not feed itself; a
+ * tagged TTAG_CANCEL or TTAG_LIST is allowed.
+ */
+
+#ifndef HYUN_APP_TTAG_H
+#define HYUN_APP_TTAG_H
+
+#include "cfe.h"
+#include "hyun_app_msg.h"
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    uint64 ExecUs; /* MET */
+    uint32 TagId;  /* 0 marks a free entry */
+    uint32 Seq;    /* Insertion order, breaks ties between equal times */
+    union
+    {
+        CFE_SB_Buffer_t Buf;
+        uint8           Byte[HYUN_APP_TTAG_MAX_CMD];
+    } Cmd;
+} HYUN_APP_TtagEntry_t;
+
+typedef struct
+{
+    HYUN_APP_TtagEntry_t Entry[HYUN_APP_TTAG_CAPACITY];
+    uint8                Heap[HYUN_APP_TTAG_CAPACITY]; /* Entry indices, min-heap on (ExecUs, Seq) */
+    uint32               Count;
+    uint32               NextSeq;
+
+    /*
+    ** Reported in housekeeping
+    */
+    uint16 ExecCounter;
+    uint32 LastJitterUs;
+    uint32 MaxJitterUs;
+} HYUN_APP_Ttag_t;
+
+/****************************************************************************/
+/*
+** Time-tag prototypes
+*/
+void  HYUN_APP_TtagInit(void);
+void  HYUN_APP_TtagService(void);
+int32 HYUN_APP_TtagTimeout(int32 MaxMs);
+int32 HYUN_APP_TtagInsertCmd(const HYUN_APP_TtagInsertCmd_t *Msg);
+int32 HYUN_APP_TtagCancelCmd(const HYUN_APP_TtagCancelCmd_t *Msg);
+int32 HYUN_APP_TtagListCmd(const HYUN_APP_TtagListCmd_t *Msg);
+
+#endif /* HYUN_APP_TTAG_H */
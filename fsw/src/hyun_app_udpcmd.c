@@ -0,0 +1,363 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_udpcmd.c
+**
+** Purpose:
+**   Child task taking ground commands from a loopback UDP port. Uses the
+**   Linux recvmmsg call and the SO_RXQ_OVFL socket drop counter.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* recvmmsg */
+#endif
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "hyun_app_events.h"
+#include "hyun_app.h"
+#include "hyun_app_udpcmd.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_UdpCmdInit                                                */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Start the child task. The socket is opened by the task itself      */
+/*         once a table with a non-zero UdpCmdPort is applied.                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_UdpCmdInit(void)
+{
+    HYUN_APP_UdpCmd_t *Udp = &HYUN_APP_Data.UdpCmd;
+    int32              status;
+
+    memset(Udp, 0, sizeof(*Udp));
+    Udp->Socket = -1;
+
+    status = OS_MutSemCreate(&Udp->Mutex, "HYUN_UDPCMD_MUT", 0);
+    if (status != OS_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("Hyun_app: Error creating UDP command mutex, RC = 0x%08lX\n", (unsigned long)status);
+        return (status);
+    }
+
+    status = CFE_ES_CreateChildTask(&Udp->TaskId, HYUN_APP_UDPCMD_TASK_NAME, HYUN_APP_UdpCmdTask,
+                                    CFE_ES_TASK_STACK_ALLOCATE, HYUN_APP_UDPCMD_STACK_SIZE,
+                                    HYUN_APP_UDPCMD_PRIORITY, 0);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("Hyun_app: Error creating UDP command task, RC = 0x%08lX\n", (unsigned long)status);
+    }
+
+    return (status);
+
+} /* End of HYUN_APP_UdpCmdInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_UdpCmdConfig -- Request the table port, main task      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_UdpCmdConfig(const HYUN_APP_Table_t *TblPtr)
+{
+    HYUN_APP_UdpCmd_t *Udp = &HYUN_APP_Data.UdpCmd;
+
+    OS_MutSemTake(Udp->Mutex);
+    Udp->Port = TblPtr->UdpCmdPort;
+    OS_MutSemGive(Udp->Mutex);
+
+} /* End of HYUN_APP_UdpCmdConfig() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_UdpCmdValidate                                            */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Check the headers of a whole batch before anything is sent. A      */
+/*         packet is accepted when it is a complete CCSDS command for one of  */
+/*         the CommandPipe MIDs and its length field matches the datagram.    */
+/*         Returns the number accepted.                                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+uint32 HYUN_APP_UdpCmdValidate(HYUN_APP_UdpCmd_t *Udp, uint32 Count)
+{
+    const uint8 *Hdr;
+    uint16       StreamId;
+    uint16       PktLen;
+    uint32       Accepted = 0;
+    uint32       i;
+
+    for (i = 0; i < Count; i++)
+    {
+        Hdr      = Udp->Dgram[i].Byte;
+        StreamId = (uint16)((Hdr[0] << 8) | Hdr[1]);
+        PktLen   = (uint16)((Hdr[4] << 8) | Hdr[5]);
+
+        Udp->Accept[i] = Udp->Length[i] >= sizeof(CFE_MSG_CommandHeader_t) &&
+                         (StreamId == HYUN_APP_MID_GROUNDCMD_REQ || StreamId == HYUN_APP_MID_HOUSEKEEPING_REQ) &&
+                         (Hdr[2] & 0xC0) == 0xC0 && /* Unsegmented */
+                         PktLen + HYUN_APP_UDPCMD_LEN_OFFSET == Udp->Length[i];
+
+        Accepted += Udp->Accept[i];
+    }
+
+    return Accepted;
+
+} /* End of HYUN_APP_UdpCmdValidate() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_UdpCmdBind -- Reopen the socket on a new table port    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void HYUN_APP_UdpCmdBind(HYUN_APP_UdpCmd_t *Udp, uint16 Port)
+{
+    struct sockaddr_in Addr;
+    struct timeval     Timeout;
+    int                On = 1;
+
+    if (Udp->Socket >= 0)
+    {
+        close(Udp->Socket);
+        Udp->Socket = -1;
+    }
+
+    Udp->BoundPort   = Port;
+    Udp->SocketDrops = 0;
+
+    if (Port == 0)
+    {
+        CFE_EVS_SendEvent(HYUN_APP_UDP_INF_EID, CFE_EVS_EventType_INFORMATION, "UDP commands disabled");
+        return;
+    }
+
+    memset(&Addr, 0, sizeof(Addr));
+    Addr.sin_family      = AF_INET;
+    Addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    Addr.sin_port        = htons(Port);
+
+    Timeout.tv_sec  = 0;
+    Timeout.tv_usec = HYUN_APP_UDPCMD_CYCLE_MS * 1000;
+
+    Udp->Socket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (Udp->Socket < 0 || setsockopt(Udp->Socket, SOL_SOCKET, SO_RCVTIMEO, &Timeout, sizeof(Timeout)) != 0 ||
+        setsockopt(Udp->Socket, SOL_SOCKET, SO_RXQ_OVFL, &On, sizeof(On)) != 0 ||
+        bind(Udp->Socket, (struct sockaddr *)&Addr, sizeof(Addr)) != 0)
+    {
+        CFE_EVS_SendEvent(HYUN_APP_UDP_ERR_EID, CFE_EVS_EventType_ERROR, "UDP commands: cannot bind port %u, errno %d",
+                          (unsigned int)Port, errno);
+        if (Udp->Socket >= 0)
+        {
+            close(Udp->Socket);
+            Udp->Socket = -1;
+        }
+        return;
+    }
+
+    CFE_EVS_SendEvent(HYUN_APP_UDP_INF_EID, CFE_EVS_EventType_INFORMATION, "UDP commands on 127.0.0.1:%u",
+                      (unsigned int)Port);
+
+} /* End of HYUN_APP_UdpCmdBind() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_UdpCmdInject                                              */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Put the accepted packets of a batch on the bus. The sequence count */
+/*         is left as sent by the ground, as CI_LAB does.                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HYUN_APP_UdpCmdInject(HYUN_APP_UdpCmd_t *Udp, uint32 Count)
+{
+    CFE_SB_Buffer_t *BufPtr;
+    uint32           i;
+
+    for (i = 0; i < Count; i++)
+    {
+        if (!Udp->Accept[i])
+        {
+            Udp->RejectCounter++;
+            continue;
+        }
+
+        BufPtr = CFE_SB_AllocateMessageBuffer(Udp->Length[i]);
+        if (BufPtr == NULL)
+        {
+            Udp->DropCounter++;
+            continue;
+        }
+
+        memcpy(BufPtr, &Udp->Dgram[i], Udp->Length[i]);
+        if (CFE_SB_TransmitBuffer(BufPtr, false) != CFE_SUCCESS)
+        {
+            CFE_SB_ReleaseMessageBuffer(BufPtr);
+            Udp->DropCounter++;
+            continue;
+        }
+
+        Udp->PacketCounter++;
+        Udp->WindowPackets++;
+        Udp->ByteCounter += Udp->Length[i];
+    }
+
+} /* End of HYUN_APP_UdpCmdInject() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_UdpCmdRate -- Close the rate window once a second      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void HYUN_APP_UdpCmdRate(HYUN_APP_UdpCmd_t *Udp)
+{
+    uint64 NowUs     = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+    uint64 ElapsedUs = NowUs - Udp->WindowStartUs;
+
+    if (ElapsedUs < HYUN_APP_UDPCMD_RATE_WINDOW_US)
+    {
+        return;
+    }
+
+    Udp->PacketsPerSec = (uint32)((uint64)Udp->WindowPackets * 1000000u / ElapsedUs);
+    Udp->WindowStartUs = NowUs;
+    Udp->WindowPackets = 0;
+
+} /* End of HYUN_APP_UdpCmdRate() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_UdpCmdTask                                                */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Child task main loop. recvmmsg blocks for the first datagram up to */
+/*         the socket timeout and then takes whatever else is queued, up to   */
+/*         one batch. The kernel drop count arrives with each datagram.       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HYUN_APP_UdpCmdTask(void)
+{
+    HYUN_APP_UdpCmd_t *Udp = &HYUN_APP_Data.UdpCmd;
+    struct mmsghdr     Msgs[HYUN_APP_UDPCMD_BATCH];
+    struct iovec       Iov[HYUN_APP_UDPCMD_BATCH];
+    struct cmsghdr    *Cmsg;
+    uint32             Drops;
+    uint16             Port;
+    uint32             Count;
+    int                Rc;
+    uint32             i;
+
+    /* CMSG_SPACE is a multiple of the header alignment, so every row stays aligned */
+    uint8 Ctrl[HYUN_APP_UDPCMD_BATCH][CMSG_SPACE(sizeof(uint32))] __attribute__((aligned(__alignof__(struct cmsghdr))));
+
+    Udp->WindowStartUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+
+    while (HYUN_APP_Data.RunStatus == CFE_ES_RunStatus_APP_RUN)
+    {
+        OS_MutSemTake(Udp->Mutex);
+        Port = Udp->Port;
+        OS_MutSemGive(Udp->Mutex);
+
+        if (Port != Udp->BoundPort)
+        {
+            HYUN_APP_UdpCmdBind(Udp, Port);
+        }
+
+        if (Udp->Socket < 0)
+        {
+            OS_TaskDelay(HYUN_APP_UDPCMD_CYCLE_MS);
+            continue;
+        }
+
+        memset(Msgs, 0, sizeof(Msgs));
+        for (i = 0; i < HYUN_APP_UDPCMD_BATCH; i++)
+        {
+            Iov[i].iov_base                = Udp->Dgram[i].Byte;
+            Iov[i].iov_len                 = sizeof(Udp->Dgram[i].Byte);
+            Msgs[i].msg_hdr.msg_iov        = &Iov[i];
+            Msgs[i].msg_hdr.msg_iovlen     = 1;
+            Msgs[i].msg_hdr.msg_control    = Ctrl[i];
+            Msgs[i].msg_hdr.msg_controllen = sizeof(Ctrl[i]);
+        }
+
+        Rc = recvmmsg(Udp->Socket, Msgs, HYUN_APP_UDPCMD_BATCH, MSG_WAITFORONE, NULL);
+        if (Rc <= 0)
+        {
+            if (Rc < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            {
+                Udp->ErrCounter++;
+            }
+            HYUN_APP_UdpCmdRate(Udp);
+            continue;
+        }
+
+        CFE_ES_PerfLogEntry(HYUN_APP_UDPCMD_PERF_ID);
+
+        Count = (uint32)Rc;
+        for (i = 0; i < Count; i++)
+        {
+            /* A truncated datagram can not pass the length check */
+            Udp->Length[i] = (Msgs[i].msg_hdr.msg_flags & MSG_TRUNC) ? 0 : (uint16)Msgs[i].msg_len;
+        }
+
+        HYUN_APP_UdpCmdValidate(Udp, Count);
+        HYUN_APP_UdpCmdInject(Udp, Count);
+
+        /*
+        ** SO_RXQ_OVFL is the socket's running total of datagrams dropped
+        ** on a full receive queue; the last datagram has the newest value.
+        */
+        for (Cmsg = CMSG_FIRSTHDR(&Msgs[Count - 1].msg_hdr); Cmsg != NULL;
+             Cmsg = CMSG_NXTHDR(&Msgs[Count - 1].msg_hdr, Cmsg))
+        {
+            if (Cmsg->cmsg_level == SOL_SOCKET && Cmsg->cmsg_type == SO_RXQ_OVFL)
+            {
+                memcpy(&Drops, CMSG_DATA(Cmsg), sizeof(Drops));
+                Udp->DropCounter += Drops - Udp->SocketDrops;
+                Udp->SocketDrops = Drops;
+            }
+        }
+
+        Udp->BatchCounter++;
+        if (Count > Udp->MaxBatch)
+        {
+            Udp->MaxBatch = (uint16)Count;
+        }
+
+        HYUN_APP_UdpCmdRate(Udp);
+
+        CFE_ES_PerfLogExit(HYUN_APP_UDPCMD_PERF_ID);
+    }
+
+    if (Udp->Socket >= 0)
+    {
+        close(Udp->Socket);
+        Udp->Socket = -1;
+    }
+
+    CFE_ES_ExitChildTask();
+
+} /* End of HYUN_APP_UdpCmdTask() */
@@ -0,0 +1,108 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Local UDP command ingest for ground testing
+ *
+ * A child task receives CCSDS command packets on a loopback UDP port and
+ * puts them on the software bus, so the app can be load-tested without
+ * CI_LAB. Each wake takes up to one batch with recvmmsg, checks every
+ * header of the batch first and then sends the accepted packets, which
+ * SB routes to the CommandPipe.
+ */
+
+#ifndef HYUN_APP_UDPCMD_H
+#define HYUN_APP_UDPCMD_H
+
+#include "cfe.h"
+#include "hyun_app_table.h"
+
+/***********************************************************************/
+#define HYUN_APP_UDPCMD_TASK_NAME  "HYUN_UDPCMD"
+#define HYUN_APP_UDPCMD_STACK_SIZE 16384
+#define HYUN_APP_UDPCMD_PRIORITY   100
+
+#define HYUN_APP_UDPCMD_CYCLE_MS  100 /* Socket receive timeout, bounds shutdown and port changes */
+#define HYUN_APP_UDPCMD_BATCH     16  /* Datagrams per recvmmsg */
+#define HYUN_APP_UDPCMD_MAX_DGRAM 256 /* Larger datagrams are truncated and rejected [bytes] */
+
+#define HYUN_APP_UDPCMD_RATE_WINDOW_US 1000000
+
+/*
+** CCSDS v1 primary header, read straight from the datagram
+*/
+#define HYUN_APP_UDPCMD_PRI_HDR_LEN 6
+#define HYUN_APP_UDPCMD_LEN_OFFSET  7 /* Packet length field is total length - 7 */
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    CFE_ES_TaskId_t TaskId;
+    osal_id_t       Mutex; /* Guards Port */
+
+    uint16 Port;      /* Requested by the table, host byte order */
+    uint16 BoundPort; /* Child task only */
+    int    Socket;    /* Child task only */
+
+    /*
+    ** Batch received by the child task
+    */
+    uint16 Length[HYUN_APP_UDPCMD_BATCH];
+    bool   Accept[HYUN_APP_UDPCMD_BATCH];
+    union
+    {
+        CFE_SB_Buffer_t Buf;
+        uint8           Byte[HYUN_APP_UDPCMD_MAX_DGRAM];
+    } Dgram[HYUN_APP_UDPCMD_BATCH];
+
+    /*
+    ** Written by the child task only
+    */
+    uint32 PacketCounter; /* Commands put on the bus */
+    uint32 ByteCounter;
+    uint32 BatchCounter;
+    uint32 RejectCounter; /* Bad header, length or MID */
+    uint32 DropCounter;   /* Lost in the socket queue, or no SB buffer */
+    uint32 ErrCounter;
+    uint32 SocketDrops;   /* Last SO_RXQ_OVFL value seen */
+    uint16 MaxBatch;
+
+    uint64 WindowStartUs;
+    uint32 WindowPackets;
+    uint32 PacketsPerSec;
+} HYUN_APP_UdpCmd_t;
+
+/****************************************************************************/
+/*
+** UDP command ingest prototypes
+*/
+int32  HYUN_APP_UdpCmdInit(void);
+void   HYUN_APP_UdpCmdConfig(const HYUN_APP_Table_t *TblPtr);
+uint32 HYUN_APP_UdpCmdValidate(HYUN_APP_UdpCmd_t *Udp, uint32 Count);
+void   HYUN_APP_UdpCmdTask(void);
+
+#endif /* HYUN_APP_UDPCMD_H */
@@ -0,0 +1,361 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_udptlm.c
+**
+** Purpose:
+**   Child task forwarding selected telemetry to a local UDP port. OSAL
+**   sockets have no batched send, so the Linux sendmmsg call is used
+**   directly; the flight computer runs Linux.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* sendmmsg */
+#endif
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "hyun_app_events.h"
+#include "hyun_app.h"
+#include "hyun_app_udptlm.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_UdpTlmInit                                                */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Create the pipe, socket and child task. Nothing is subscribed or   */
+/*         sent until a table with a non-zero UdpTlmPort is applied.          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_UdpTlmInit(void)
+{
+    HYUN_APP_UdpTlm_t *Udp = &HYUN_APP_Data.UdpTlm;
+    int32              status;
+
+    memset(Udp, 0, sizeof(*Udp));
+    Udp->Socket = -1;
+
+    status = CFE_SB_CreatePipe(&Udp->Pipe, HYUN_APP_UDPTLM_PIPE_DEPTH, HYUN_APP_UDPTLM_PIPE_NAME);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("Hyun_app: Error creating UDP telemetry pipe, RC = 0x%08lX\n", (unsigned long)status);
+        return (status);
+    }
+
+    status = OS_MutSemCreate(&Udp->Mutex, "HYUN_UDPTLM_MUT", 0);
+    if (status != OS_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("Hyun_app: Error creating UDP telemetry mutex, RC = 0x%08lX\n", (unsigned long)status);
+        return (status);
+    }
+
+    Udp->Socket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (Udp->Socket < 0)
+    {
+        CFE_ES_WriteToSysLog("Hyun_app: Error creating UDP telemetry socket, errno %d\n", errno);
+        return (CFE_STATUS_EXTERNAL_RESOURCE_FAIL);
+    }
+
+    status = CFE_ES_CreateChildTask(&Udp->TaskId, HYUN_APP_UDPTLM_TASK_NAME, HYUN_APP_UdpTlmTask,
+                                    CFE_ES_TASK_STACK_ALLOCATE, HYUN_APP_UDPTLM_STACK_SIZE,
+                                    HYUN_APP_UDPTLM_PRIORITY, 0);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("Hyun_app: Error creating UDP telemetry task, RC = 0x%08lX\n", (unsigned long)status);
+    }
+
+    return (status);
+
+} /* End of HYUN_APP_UdpTlmInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_UdpTlmValidHost -- Table check of the destination      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool HYUN_APP_UdpTlmValidHost(const char *Host)
+{
+    struct in_addr Addr;
+
+    if (memchr(Host, '\0', HYUN_APP_UDPTLM_HOST_LEN) == NULL)
+    {
+        return false;
+    }
+
+    return (inet_pton(AF_INET, Host, &Addr) == 1);
+
+} /* End of HYUN_APP_UdpTlmValidHost() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_UdpTlmConfig                                              */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Apply the table destination and MID list. Runs in the main task;   */
+/*         only a changed configuration touches the subscriptions.            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HYUN_APP_UdpTlmConfig(const HYUN_APP_Table_t *TblPtr)
+{
+    HYUN_APP_UdpTlm_t *Udp   = &HYUN_APP_Data.UdpTlm;
+    struct in_addr     Addr  = {0};
+    uint32             Count = 0;
+    int32              status;
+    uint32             i;
+
+    if (Udp->Port == TblPtr->UdpTlmPort && strncmp(Udp->Host, TblPtr->UdpTlmHost, sizeof(Udp->Host)) == 0 &&
+        memcmp(Udp->MsgId, TblPtr->UdpTlmMsgId, sizeof(Udp->MsgId)) == 0)
+    {
+        return;
+    }
+
+    for (i = 0; i < HYUN_APP_UDPTLM_MAX_MIDS && Udp->Port != 0; i++)
+    {
+        if (Udp->MsgId[i] != 0)
+        {
+            CFE_SB_Unsubscribe(CFE_SB_ValueToMsgId(Udp->MsgId[i]), Udp->Pipe);
+        }
+    }
+
+    strncpy(Udp->Host, TblPtr->UdpTlmHost, sizeof(Udp->Host) - 1);
+    Udp->Host[sizeof(Udp->Host) - 1] = 0;
+    Udp->Port                        = TblPtr->UdpTlmPort;
+    memcpy(Udp->MsgId, TblPtr->UdpTlmMsgId, sizeof(Udp->MsgId));
+
+    inet_pton(AF_INET, Udp->Host, &Addr);
+
+    for (i = 0; i < HYUN_APP_UDPTLM_MAX_MIDS && Udp->Port != 0; i++)
+    {
+        if (Udp->MsgId[i] == 0)
+        {
+            continue;
+        }
+
+        status = CFE_SB_Subscribe(CFE_SB_ValueToMsgId(Udp->MsgId[i]), Udp->Pipe);
+        if (status != CFE_SUCCESS)
+        {
+            CFE_EVS_SendEvent(HYUN_APP_UDP_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "UDP telemetry: cannot subscribe MID 0x%04X, RC = 0x%08lX",
+                              (unsigned int)Udp->MsgId[i], (unsigned long)status);
+            continue;
+        }
+        Count++;
+    }
+
+    OS_MutSemTake(Udp->Mutex);
+    Udp->Enabled  = (Udp->Port != 0);
+    Udp->DestAddr = Addr.s_addr;
+    Udp->DestPort = htons(Udp->Port);
+    OS_MutSemGive(Udp->Mutex);
+
+    if (Udp->Port != 0)
+    {
+        CFE_EVS_SendEvent(HYUN_APP_UDP_INF_EID, CFE_EVS_EventType_INFORMATION, "UDP telemetry to %s:%u, %lu MIDs",
+                          Udp->Host, (unsigned int)Udp->Port, (unsigned long)Count);
+    }
+    else
+    {
+        CFE_EVS_SendEvent(HYUN_APP_UDP_INF_EID, CFE_EVS_EventType_INFORMATION, "UDP telemetry disabled");
+    }
+
+} /* End of HYUN_APP_UdpTlmConfig() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_UdpTlmFlush                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Send the first Count datagrams of the batch. sendmmsg may stop     */
+/*         early, so it is called again for the rest; datagrams the socket    */
+/*         refuses are dropped rather than blocking the task.                 */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void HYUN_APP_UdpTlmFlush(HYUN_APP_UdpTlm_t *Udp, uint32 Count)
+{
+    struct mmsghdr     Msgs[HYUN_APP_UDPTLM_BATCH];
+    struct iovec       Iov[HYUN_APP_UDPTLM_BATCH];
+    struct sockaddr_in Dest;
+    bool               Enabled;
+    uint32             Sent = 0;
+    int                Rc;
+    uint32             i;
+
+    memset(&Dest, 0, sizeof(Dest));
+    Dest.sin_family = AF_INET;
+
+    OS_MutSemTake(Udp->Mutex);
+    Enabled              = Udp->Enabled;
+    Dest.sin_addr.s_addr = Udp->DestAddr;
+    Dest.sin_port        = Udp->DestPort;
+    OS_MutSemGive(Udp->Mutex);
+
+    if (!Enabled)
+    {
+        /* Left over from before a disable */
+        return;
+    }
+
+    memset(Msgs, 0, sizeof(Msgs[0]) * Count);
+    for (i = 0; i < Count; i++)
+    {
+        Iov[i].iov_base               = Udp->Dgram[i];
+        Iov[i].iov_len                = Udp->Length[i];
+        Msgs[i].msg_hdr.msg_name      = &Dest;
+        Msgs[i].msg_hdr.msg_namelen   = sizeof(Dest);
+        Msgs[i].msg_hdr.msg_iov       = &Iov[i];
+        Msgs[i].msg_hdr.msg_iovlen    = 1;
+    }
+
+    while (Sent < Count)
+    {
+        Rc = sendmmsg(Udp->Socket, &Msgs[Sent], Count - Sent, MSG_DONTWAIT);
+        if (Rc < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (Rc <= 0)
+        {
+            Udp->ErrCounter++;
+            Udp->DropCounter += Count - Sent;
+            break;
+        }
+
+        for (i = Sent; i < Sent + (uint32)Rc; i++)
+        {
+            Udp->ByteCounter += Msgs[i].msg_len;
+            Udp->WindowBytes += Msgs[i].msg_len;
+        }
+        Sent += (uint32)Rc;
+    }
+
+    Udp->DatagramCounter += Sent;
+    Udp->WindowDatagrams += Sent;
+    Udp->BatchCounter++;
+    if (Count > Udp->MaxBatch)
+    {
+        Udp->MaxBatch = (uint16)Count;
+    }
+
+} /* End of HYUN_APP_UdpTlmFlush() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_UdpTlmRate -- Close the throughput window once a second */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void HYUN_APP_UdpTlmRate(HYUN_APP_UdpTlm_t *Udp)
+{
+    uint64 NowUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+    uint64 ElapsedUs;
+
+    ElapsedUs = NowUs - Udp->WindowStartUs;
+    if (ElapsedUs < HYUN_APP_UDPTLM_RATE_WINDOW_US)
+    {
+        return;
+    }
+
+    Udp->DatagramsPerSec = (uint32)((uint64)Udp->WindowDatagrams * 1000000u / ElapsedUs);
+    Udp->BytesPerSec     = (uint32)((uint64)Udp->WindowBytes * 1000000u / ElapsedUs);
+
+    Udp->WindowStartUs   = NowUs;
+    Udp->WindowDatagrams = 0;
+    Udp->WindowBytes     = 0;
+
+} /* End of HYUN_APP_UdpTlmRate() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_UdpTlmTask                                                */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Child task main loop. Wakes on the first packet, drains what else  */
+/*         is queued up to one batch and sends the batch in one call. The    */
+/*         packets are copied because an SB buffer is only valid until the    */
+/*         next receive on the pipe.                                          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HYUN_APP_UdpTlmTask(void)
+{
+    HYUN_APP_UdpTlm_t *Udp = &HYUN_APP_Data.UdpTlm;
+    CFE_SB_Buffer_t   *SBBufPtr;
+    size_t             Size;
+    uint32             Count;
+    int32              status;
+
+    Udp->WindowStartUs = HYUN_APP_SysTimeToUsec(CFE_TIME_GetMET());
+
+    while (HYUN_APP_Data.RunStatus == CFE_ES_RunStatus_APP_RUN)
+    {
+        status = CFE_SB_ReceiveBuffer(&SBBufPtr, Udp->Pipe, HYUN_APP_UDPTLM_CYCLE_MS);
+
+        CFE_ES_PerfLogEntry(HYUN_APP_UDPTLM_PERF_ID);
+
+        Count = 0;
+        while (status == CFE_SUCCESS)
+        {
+            Size = 0;
+            CFE_MSG_GetSize(&SBBufPtr->Msg, &Size);
+            if (Size > HYUN_APP_UDPTLM_MAX_DGRAM)
+            {
+                Udp->DropCounter++;
+            }
+            else
+            {
+                memcpy(Udp->Dgram[Count], SBBufPtr, Size);
+                Udp->Length[Count] = (uint16)Size;
+                Count++;
+            }
+
+            if (Count == HYUN_APP_UDPTLM_BATCH)
+            {
+                break;
+            }
+            status = CFE_SB_ReceiveBuffer(&SBBufPtr, Udp->Pipe, CFE_SB_POLL);
+        }
+
+        if (Count > 0)
+        {
+            HYUN_APP_UdpTlmFlush(Udp, Count);
+        }
+
+        HYUN_APP_UdpTlmRate(Udp);
+
+        CFE_ES_PerfLogExit(HYUN_APP_UDPTLM_PERF_ID);
+
+        if (status != CFE_SUCCESS && status != CFE_SB_TIME_OUT && status != CFE_SB_NO_MESSAGE)
+        {
+            CFE_EVS_SendEvent(HYUN_APP_UDP_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "UDP telemetry: pipe read error, RC = 0x%08lX, task exits", (unsigned long)status);
+            break;
+        }
+    }
+
+    close(Udp->Socket);
+    Udp->Socket = -1;
+
+    CFE_ES_ExitChildTask();
+
+} /* End of HYUN_APP_UdpTlmTask() */
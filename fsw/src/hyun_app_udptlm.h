@@ -0,0 +1,108 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Local UDP telemetry output for ground testing
+ *
+ * A child task subscribes its own pipe to the table-selected MIDs and
+ * forwards every packet as one UDP datagram, so telemetry reaches a
+ * ground tool on the test network without a TO app. Whatever is queued
+ * when the task wakes is copied out of SB and handed to the kernel in a
+ * single sendmmsg call.
+ */
+
+#ifndef HYUN_APP_UDPTLM_H
+#define HYUN_APP_UDPTLM_H
+
+#include "cfe.h"
+#include "hyun_app_table.h"
+
+/***********************************************************************/
+#define HYUN_APP_UDPTLM_PIPE_NAME  "HYUN_UDPTLM_PIPE"
+#define HYUN_APP_UDPTLM_PIPE_DEPTH 64
+#define HYUN_APP_UDPTLM_TASK_NAME  "HYUN_UDPTLM"
+#define HYUN_APP_UDPTLM_STACK_SIZE 16384
+#define HYUN_APP_UDPTLM_PRIORITY   100
+
+#define HYUN_APP_UDPTLM_CYCLE_MS  100 /* Max wait on the pipe, bounds shutdown and rate updates */
+#define HYUN_APP_UDPTLM_BATCH     16  /* Datagrams per sendmmsg */
+#define HYUN_APP_UDPTLM_MAX_DGRAM 512 /* Larger packets are dropped [bytes] */
+
+#define HYUN_APP_UDPTLM_RATE_WINDOW_US 1000000
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    CFE_ES_TaskId_t TaskId;
+    CFE_SB_PipeId_t Pipe;
+    osal_id_t       Mutex; /* Guards Enabled / DestAddr / DestPort */
+    int             Socket;
+
+    bool   Enabled;
+    uint32 DestAddr; /* Network byte order */
+    uint16 DestPort; /* Network byte order */
+
+    /*
+    ** Configuration last applied from the table
+    */
+    char   Host[HYUN_APP_UDPTLM_HOST_LEN];
+    uint16 Port;
+    uint16 MsgId[HYUN_APP_UDPTLM_MAX_MIDS];
+
+    /*
+    ** Batch built by the child task
+    */
+    uint16 Length[HYUN_APP_UDPTLM_BATCH];
+    uint8  Dgram[HYUN_APP_UDPTLM_BATCH][HYUN_APP_UDPTLM_MAX_DGRAM];
+
+    /*
+    ** Written by the child task only
+    */
+    uint32 DatagramCounter;
+    uint32 ByteCounter;
+    uint32 BatchCounter;
+    uint32 DropCounter; /* Too large, or refused by the socket */
+    uint32 ErrCounter;
+    uint16 MaxBatch;
+
+    uint64 WindowStartUs;
+    uint32 WindowDatagrams;
+    uint32 WindowBytes;
+    uint32 DatagramsPerSec;
+    uint32 BytesPerSec;
+} HYUN_APP_UdpTlm_t;
+
+/****************************************************************************/
+/*
+** UDP telemetry prototypes
+*/
+int32 HYUN_APP_UdpTlmInit(void);
+void  HYUN_APP_UdpTlmConfig(const HYUN_APP_Table_t *TblPtr);
+bool  HYUN_APP_UdpTlmValidHost(const char *Host);
+void  HYUN_APP_UdpTlmTask(void);
+
+#endif /* HYUN_APP_UDPTLM_H */
@@ -0,0 +1,301 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_uplink.c
+**
+** Purpose:
+**   Single-pass tokenizer and perfect-hash keyword lookup for the CANSAT
+**   text command set.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "hyun_app_uplink.h"
+
+/*
+** Perfect hash over the keyword set: (Len + 5 * first + 9 * last) & 15
+** maps every keyword to its own slot. Empty slots have Len 0. The
+** multipliers were found by exhaustive search; rerun it when adding a
+** keyword.
+*/
+#define HYUN_APP_UPLINK_HASH_SIZE 16
+#define HYUN_APP_UPLINK_HASH(Str, Len) \
+    (((Len) + 5u * (uint8)(Str)[0] + 9u * (uint8)(Str)[(Len)-1]) & (HYUN_APP_UPLINK_HASH_SIZE - 1))
+
+typedef struct
+{
+    char  Name[9];
+    uint8 Len;
+    uint8 Id;
+} HYUN_APP_UplinkKeyword_t;
+
+static const HYUN_APP_UplinkKeyword_t HYUN_APP_UplinkKeywords[HYUN_APP_UPLINK_HASH_SIZE] = {
+    [1]  = {"GPS", 3, HYUN_APP_UPLINK_KW_GPS},
+    [3]  = {"SIMP", 4, HYUN_APP_UPLINK_KW_SIMP},
+    [4]  = {"OFF", 3, HYUN_APP_UPLINK_KW_OFF},
+    [5]  = {"ST", 2, HYUN_APP_UPLINK_KW_ST},
+    [6]  = {"CMD", 3, HYUN_APP_UPLINK_KW_CMD},
+    [7]  = {"SIM", 3, HYUN_APP_UPLINK_KW_SIM},
+    [8]  = {"DISABLE", 7, HYUN_APP_UPLINK_KW_DISABLE},
+    [9]  = {"CX", 2, HYUN_APP_UPLINK_KW_CX},
+    [10] = {"ACTIVATE", 8, HYUN_APP_UPLINK_KW_ACTIVATE},
+    [11] = {"ON", 2, HYUN_APP_UPLINK_KW_ON},
+    [12] = {"ENABLE", 6, HYUN_APP_UPLINK_KW_ENABLE},
+    [14] = {"CAL", 3, HYUN_APP_UPLINK_KW_CAL},
+};
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_UplinkKeyword -- Keyword id, KW_NONE if not a keyword  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint8 HYUN_APP_UplinkKeyword(const char *Str, size_t Len)
+{
+    const HYUN_APP_UplinkKeyword_t *Entry;
+
+    if (Len == 0 || Len >= sizeof(Entry->Name))
+    {
+        return HYUN_APP_UPLINK_KW_NONE;
+    }
+
+    Entry = &HYUN_APP_UplinkKeywords[HYUN_APP_UPLINK_HASH(Str, Len)];
+    if (Entry->Len != Len || memcmp(Entry->Name, Str, Len) != 0)
+    {
+        return HYUN_APP_UPLINK_KW_NONE;
+    }
+
+    return Entry->Id;
+
+} /* End of HYUN_APP_UplinkKeyword() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_UplinkNumber -- Unsigned decimal field up to Max       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static bool HYUN_APP_UplinkNumber(const char *Str, size_t Len, uint32 Max, uint32 *Value)
+{
+    size_t i;
+
+    if (Len == 0 || Len > 9)
+    {
+        return false;
+    }
+
+    *Value = 0;
+    for (i = 0; i < Len; i++)
+    {
+        if (Str[i] < '0' || Str[i] > '9')
+        {
+            return false;
+        }
+        *Value = (*Value * 10) + (uint32)(Str[i] - '0');
+    }
+
+    return (*Value <= Max);
+
+} /* End of HYUN_APP_UplinkNumber() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_UplinkTime -- hh:mm:ss to seconds of day               */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static bool HYUN_APP_UplinkTime(const char *Str, size_t Len, uint32 *Value)
+{
+    uint32 Hours;
+    uint32 Minutes;
+    uint32 Seconds;
+
+    if (Len != 8 || Str[2] != ':' || Str[5] != ':' || !HYUN_APP_UplinkNumber(&Str[0], 2, 23, &Hours) ||
+        !HYUN_APP_UplinkNumber(&Str[3], 2, 59, &Minutes) || !HYUN_APP_UplinkNumber(&Str[6], 2, 59, &Seconds))
+    {
+        return false;
+    }
+
+    *Value = (Hours * 3600) + (Minutes * 60) + Seconds;
+    return true;
+
+} /* End of HYUN_APP_UplinkTime() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_UplinkParse                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Parse one text command. The text ends at Len, a NUL, CR or LF.     */
+/*         Field boundaries are found in a single scan, then each field is    */
+/*         classified once. A bad prefix, a control byte or a fifth field     */
+/*         stops the scan. The team ID is returned, not checked.              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 HYUN_APP_UplinkParse(const char *Text, size_t Len, HYUN_APP_UplinkCmd_t *Cmd)
+{
+    const char *Field[HYUN_APP_UPLINK_MAX_FIELDS];
+    size_t      FieldLen[HYUN_APP_UPLINK_MAX_FIELDS];
+    size_t      NumFields = 0;
+    size_t      Start     = 0;
+    size_t      i;
+    uint32      TeamId;
+    char        c;
+
+    memset(Cmd, 0, sizeof(*Cmd));
+
+    if (Len > HYUN_APP_UPLINK_MAX_TEXT)
+    {
+        Len = HYUN_APP_UPLINK_MAX_TEXT;
+    }
+
+    for (i = 0; i <= Len; i++)
+    {
+        c = (i < Len) ? Text[i] : '\0';
+
+        if (c == ',' || c == '\0' || c == '\r' || c == '\n')
+        {
+            if (NumFields == HYUN_APP_UPLINK_MAX_FIELDS)
+            {
+                return HYUN_APP_UPLINK_ERR_FORMAT;
+            }
+            Field[NumFields]    = &Text[Start];
+            FieldLen[NumFields] = i - Start;
+            NumFields++;
+            Start = i + 1;
+
+            /* Reject non-commands before scanning the rest of the line */
+            if (NumFields == 1 && HYUN_APP_UplinkKeyword(Field[0], FieldLen[0]) != HYUN_APP_UPLINK_KW_CMD)
+            {
+                return HYUN_APP_UPLINK_ERR_PREFIX;
+            }
+
+            if (c != ',')
+            {
+                break;
+            }
+        }
+        else if (c < ' ' || c > '~')
+        {
+            return HYUN_APP_UPLINK_ERR_FORMAT;
+        }
+        else if (NumFields == 0 && i >= sizeof("CMD") - 1)
+        {
+            /* First field already longer than CMD */
+            return HYUN_APP_UPLINK_ERR_PREFIX;
+        }
+    }
+
+    if (NumFields < 3)
+    {
+        return HYUN_APP_UPLINK_ERR_FORMAT;
+    }
+
+    if (!HYUN_APP_UplinkNumber(Field[1], FieldLen[1], 0xFFFF, &TeamId))
+    {
+        return HYUN_APP_UPLINK_ERR_TEAM;
+    }
+    Cmd->TeamId = (uint16)TeamId;
+
+    Cmd->Mnemonic = HYUN_APP_UplinkKeyword(Field[2], FieldLen[2]);
+
+    /*
+    ** CAL is the only command without an argument
+    */
+    if (Cmd->Mnemonic == HYUN_APP_UPLINK_KW_CAL)
+    {
+        return (NumFields == 3) ? HYUN_APP_UPLINK_SUCCESS : HYUN_APP_UPLINK_ERR_FORMAT;
+    }
+
+    if (NumFields != 4 && Cmd->Mnemonic >= HYUN_APP_UPLINK_KW_CX && Cmd->Mnemonic <= HYUN_APP_UPLINK_KW_SIMP)
+    {
+        return HYUN_APP_UPLINK_ERR_ARG;
+    }
+
+    switch (Cmd->Mnemonic)
+    {
+        case HYUN_APP_UPLINK_KW_CX:
+            Cmd->Arg = HYUN_APP_UplinkKeyword(Field[3], FieldLen[3]);
+            if (Cmd->Arg != HYUN_APP_UPLINK_KW_ON && Cmd->Arg != HYUN_APP_UPLINK_KW_OFF)
+            {
+                return HYUN_APP_UPLINK_ERR_ARG;
+            }
+            break;
+
+        case HYUN_APP_UPLINK_KW_ST:
+            Cmd->Arg = HYUN_APP_UplinkKeyword(Field[3], FieldLen[3]);
+            if (Cmd->Arg != HYUN_APP_UPLINK_KW_GPS)
+            {
+                Cmd->Arg = HYUN_APP_UPLINK_KW_NONE;
+                if (!HYUN_APP_UplinkTime(Field[3], FieldLen[3], &Cmd->Value))
+                {
+                    return HYUN_APP_UPLINK_ERR_ARG;
+                }
+            }
+            break;
+
+        case HYUN_APP_UPLINK_KW_SIM:
+            Cmd->Arg = HYUN_APP_UplinkKeyword(Field[3], FieldLen[3]);
+            if (Cmd->Arg != HYUN_APP_UPLINK_KW_ENABLE && Cmd->Arg != HYUN_APP_UPLINK_KW_ACTIVATE &&
+                Cmd->Arg != HYUN_APP_UPLINK_KW_DISABLE)
+            {
+                return HYUN_APP_UPLINK_ERR_ARG;
+            }
+            break;
+
+        case HYUN_APP_UPLINK_KW_SIMP:
+            if (!HYUN_APP_UplinkNumber(Field[3], FieldLen[3], HYUN_APP_UPLINK_MAX_SIMP, &Cmd->Value))
+            {
+                return HYUN_APP_UPLINK_ERR_ARG;
+            }
+            break;
+
+        default:
+            return HYUN_APP_UPLINK_ERR_MNEMONIC;
+    }
+
+    return HYUN_APP_UPLINK_SUCCESS;
+
+} /* End of HYUN_APP_UplinkParse() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_UplinkErrorName -- Parse status for events             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+const char *HYUN_APP_UplinkErrorName(int32 Status)
+{
+    switch (Status)
+    {
+        case HYUN_APP_UPLINK_SUCCESS:
+            return "OK";
+        case HYUN_APP_UPLINK_ERR_PREFIX:
+            return "PREFIX";
+        case HYUN_APP_UPLINK_ERR_TEAM:
+            return "TEAM";
+        case HYUN_APP_UPLINK_ERR_MNEMONIC:
+            return "MNEMONIC";
+        case HYUN_APP_UPLINK_ERR_ARG:
+            return "ARG";
+        default:
+            return "FORMAT";
+    }
+
+} /* End of HYUN_APP_UplinkErrorName() */
@@ -0,0 +1,98 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * CANSAT text uplink parser
+ *
+ * Commands relayed from the ground station as text, e.g.
+ *
+ *   CMD,<TEAM_ID>,CX,ON|OFF                  telemetry on / off
+ *   CMD,<TEAM_ID>,ST,<hh:mm:ss>|GPS          set mission time
+ *   CMD,<TEAM_ID>,SIM,ENABLE|ACTIVATE|DISABLE simulation mode
+ *   CMD,<TEAM_ID>,SIMP,<pressure Pa>         simulated pressure
+ *   CMD,<TEAM_ID>,CAL                        zero the altitude reference
+ *
+ * The text is split into fields in one pass and every keyword is looked
+ * up in a perfect hash over the mnemonic set, so each field costs one
+ * hash and at most one compare whatever the input.
+ *
+ * Only depends on the OSAL base types so the same source builds into the
+ * host benchmark under tools/.
+ */
+
+#ifndef HYUN_APP_UPLINK_H
+#define HYUN_APP_UPLINK_H
+
+#include "common_types.h"
+
+/***********************************************************************/
+#define HYUN_APP_UPLINK_MAX_TEXT   64
+#define HYUN_APP_UPLINK_MAX_FIELDS 4
+#define HYUN_APP_UPLINK_MAX_SIMP   200000 /* [Pa] */
+
+/*
+** Keywords, also used as the Mnemonic / Arg values of a parsed command
+*/
+#define HYUN_APP_UPLINK_KW_NONE     0
+#define HYUN_APP_UPLINK_KW_CMD      1
+#define HYUN_APP_UPLINK_KW_CX       2
+#define HYUN_APP_UPLINK_KW_ST       3
+#define HYUN_APP_UPLINK_KW_SIM      4
+#define HYUN_APP_UPLINK_KW_SIMP     5
+#define HYUN_APP_UPLINK_KW_CAL      6
+#define HYUN_APP_UPLINK_KW_ON       7
+#define HYUN_APP_UPLINK_KW_OFF      8
+#define HYUN_APP_UPLINK_KW_GPS      9
+#define HYUN_APP_UPLINK_KW_ENABLE   10
+#define HYUN_APP_UPLINK_KW_ACTIVATE 11
+#define HYUN_APP_UPLINK_KW_DISABLE  12
+
+#define HYUN_APP_UPLINK_SUCCESS      0
+#define HYUN_APP_UPLINK_ERR_PREFIX   -1 /* Does not start with CMD */
+#define HYUN_APP_UPLINK_ERR_TEAM     -2 /* Team ID not numeric or not ours */
+#define HYUN_APP_UPLINK_ERR_MNEMONIC -3 /* Unknown command */
+#define HYUN_APP_UPLINK_ERR_ARG      -4 /* Missing, unknown or out of range argument */
+#define HYUN_APP_UPLINK_ERR_FORMAT   -5 /* Field count, length or characters */
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    uint16 TeamId;
+    uint8  Mnemonic; /* HYUN_APP_UPLINK_KW_CX .. CAL */
+    uint8  Arg;      /* Keyword argument, HYUN_APP_UPLINK_KW_NONE for numeric ones */
+    uint32 Value;    /* ST: seconds of day, SIMP: pressure [Pa] */
+} HYUN_APP_UplinkCmd_t;
+
+/****************************************************************************/
+/*
+** Uplink parser prototypes
+*/
+uint8       HYUN_APP_UplinkKeyword(const char *Str, size_t Len);
+int32       HYUN_APP_UplinkParse(const char *Text, size_t Len, HYUN_APP_UplinkCmd_t *Cmd);
+const char *HYUN_APP_UplinkErrorName(int32 Status);
+
+#endif /* HYUN_APP_UPLINK_H */
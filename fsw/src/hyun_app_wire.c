@@ -0,0 +1,335 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_wire.c
+**
+** Purpose:
+**   Encode / decode of the schema payloads in big-endian wire order.
+**   Shared between the flight software and host tools.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "hyun_app_wire.h"
+#include "hyun_app_pack.h"
+
+/*
+** Element codecs, one pair per field type used in the schema. Count
+** elements are converted from In to Out; the return is the next wire
+** position. Fields shorter than one SIMD vector are swapped inline,
+** where a call into the pack library would cost more than it saves.
+*/
+#define HYUN_APP_WIRE_PACK_MIN 16 /* Bytes */
+
+static inline void HYUN_APP_WireStore16(uint8 *Out, uint16 Value)
+{
+    Out[0] = (uint8)(Value >> 8);
+    Out[1] = (uint8)Value;
+}
+
+static inline void HYUN_APP_WireStore32(uint8 *Out, uint32 Value)
+{
+    Out[0] = (uint8)(Value >> 24);
+    Out[1] = (uint8)(Value >> 16);
+    Out[2] = (uint8)(Value >> 8);
+    Out[3] = (uint8)Value;
+}
+
+static inline void HYUN_APP_WireStore64(uint8 *Out, uint64 Value)
+{
+    HYUN_APP_WireStore32(Out, (uint32)(Value >> 32));
+    HYUN_APP_WireStore32(Out + 4, (uint32)Value);
+}
+
+static inline uint16 HYUN_APP_WireLoad16(const uint8 *In)
+{
+    return (uint16)((In[0] << 8) | In[1]);
+}
+
+static inline uint32 HYUN_APP_WireLoad32(const uint8 *In)
+{
+    return ((uint32)In[0] << 24) | ((uint32)In[1] << 16) | ((uint32)In[2] << 8) | In[3];
+}
+
+static inline uint64 HYUN_APP_WireLoad64(const uint8 *In)
+{
+    return ((uint64)HYUN_APP_WireLoad32(In) << 32) | HYUN_APP_WireLoad32(In + 4);
+}
+
+static inline uint8 *HYUN_APP_WirePut_uint8(uint8 *Out, const uint8 *In, size_t Count)
+{
+    memcpy(Out, In, Count);
+    return Out + Count;
+}
+
+static inline uint8 *HYUN_APP_WirePut_char(uint8 *Out, const char *In, size_t Count)
+{
+    memcpy(Out, In, Count);
+    return Out + Count;
+}
+
+static inline uint8 *HYUN_APP_WirePut_uint16(uint8 *Out, const uint16 *In, size_t Count)
+{
+    size_t i;
+
+    if (Count * sizeof(*In) < HYUN_APP_WIRE_PACK_MIN)
+    {
+        for (i = 0; i < Count; i++)
+        {
+            HYUN_APP_WireStore16(&Out[i * sizeof(*In)], In[i]);
+        }
+    }
+    else
+    {
+        HYUN_APP_PackBe16(Out, In, Count);
+    }
+    return Out + Count * sizeof(*In);
+}
+
+static inline uint8 *HYUN_APP_WirePut_uint32(uint8 *Out, const uint32 *In, size_t Count)
+{
+    size_t i;
+
+    if (Count * sizeof(*In) < HYUN_APP_WIRE_PACK_MIN)
+    {
+        for (i = 0; i < Count; i++)
+        {
+            HYUN_APP_WireStore32(&Out[i * sizeof(*In)], In[i]);
+        }
+    }
+    else
+    {
+        HYUN_APP_PackBe32(Out, In, Count);
+    }
+    return Out + Count * sizeof(*In);
+}
+
+static inline uint8 *HYUN_APP_WirePut_uint64(uint8 *Out, const uint64 *In, size_t Count)
+{
+    size_t i;
+
+    if (Count * sizeof(*In) < HYUN_APP_WIRE_PACK_MIN)
+    {
+        for (i = 0; i < Count; i++)
+        {
+            HYUN_APP_WireStore64(&Out[i * sizeof(*In)], In[i]);
+        }
+    }
+    else
+    {
+        HYUN_APP_PackBe64(Out, In, Count);
+    }
+    return Out + Count * sizeof(*In);
+}
+
+static inline uint8 *HYUN_APP_WirePut_int32(uint8 *Out, const int32 *In, size_t Count)
+{
+    return HYUN_APP_WirePut_uint32(Out, (const uint32 *)In, Count);
+}
+
+static inline uint8 *HYUN_APP_WirePut_int64(uint8 *Out, const int64 *In, size_t Count)
+{
+    return HYUN_APP_WirePut_uint64(Out, (const uint64 *)In, Count);
+}
+
+static inline uint8 *HYUN_APP_WirePut_float(uint8 *Out, const float *In, size_t Count)
+{
+    uint32 Bits;
+    size_t i;
+
+    if (Count * sizeof(*In) < HYUN_APP_WIRE_PACK_MIN)
+    {
+        for (i = 0; i < Count; i++)
+        {
+            memcpy(&Bits, &In[i], sizeof(Bits));
+            HYUN_APP_WireStore32(&Out[i * sizeof(Bits)], Bits);
+        }
+    }
+    else
+    {
+        HYUN_APP_PackBe32(Out, In, Count);
+    }
+    return Out + Count * sizeof(*In);
+}
+
+static inline uint8 *HYUN_APP_WirePut_double(uint8 *Out, const double *In, size_t Count)
+{
+    uint64 Bits;
+    size_t i;
+
+    if (Count * sizeof(*In) < HYUN_APP_WIRE_PACK_MIN)
+    {
+        for (i = 0; i < Count; i++)
+        {
+            memcpy(&Bits, &In[i], sizeof(Bits));
+            HYUN_APP_WireStore64(&Out[i * sizeof(Bits)], Bits);
+        }
+    }
+    else
+    {
+        HYUN_APP_PackBe64(Out, In, Count);
+    }
+    return Out + Count * sizeof(*In);
+}
+
+static inline const uint8 *HYUN_APP_WireGet_uint8(const uint8 *In, uint8 *Out, size_t Count)
+{
+    memcpy(Out, In, Count);
+    return In + Count;
+}
+
+static inline const uint8 *HYUN_APP_WireGet_char(const uint8 *In, char *Out, size_t Count)
+{
+    memcpy(Out, In, Count);
+    return In + Count;
+}
+
+static inline const uint8 *HYUN_APP_WireGet_uint16(const uint8 *In, uint16 *Out, size_t Count)
+{
+    size_t i;
+
+    if (Count * sizeof(*Out) < HYUN_APP_WIRE_PACK_MIN)
+    {
+        for (i = 0; i < Count; i++)
+        {
+            Out[i] = HYUN_APP_WireLoad16(&In[i * sizeof(*Out)]);
+        }
+    }
+    else
+    {
+        HYUN_APP_UnpackBe16(Out, In, Count);
+    }
+    return In + Count * sizeof(*Out);
+}
+
+static inline const uint8 *HYUN_APP_WireGet_uint32(const uint8 *In, uint32 *Out, size_t Count)
+{
+    size_t i;
+
+    if (Count * sizeof(*Out) < HYUN_APP_WIRE_PACK_MIN)
+    {
+        for (i = 0; i < Count; i++)
+        {
+            Out[i] = HYUN_APP_WireLoad32(&In[i * sizeof(*Out)]);
+        }
+    }
+    else
+    {
+        HYUN_APP_UnpackBe32(Out, In, Count);
+    }
+    return In + Count * sizeof(*Out);
+}
+
+static inline const uint8 *HYUN_APP_WireGet_uint64(const uint8 *In, uint64 *Out, size_t Count)
+{
+    size_t i;
+
+    if (Count * sizeof(*Out) < HYUN_APP_WIRE_PACK_MIN)
+    {
+        for (i = 0; i < Count; i++)
+        {
+            Out[i] = HYUN_APP_WireLoad64(&In[i * sizeof(*Out)]);
+        }
+    }
+    else
+    {
+        HYUN_APP_UnpackBe64(Out, In, Count);
+    }
+    return In + Count * sizeof(*Out);
+}
+
+static inline const uint8 *HYUN_APP_WireGet_int32(const uint8 *In, int32 *Out, size_t Count)
+{
+    return HYUN_APP_WireGet_uint32(In, (uint32 *)Out, Count);
+}
+
+static inline const uint8 *HYUN_APP_WireGet_int64(const uint8 *In, int64 *Out, size_t Count)
+{
+    return HYUN_APP_WireGet_uint64(In, (uint64 *)Out, Count);
+}
+
+static inline const uint8 *HYUN_APP_WireGet_float(const uint8 *In, float *Out, size_t Count)
+{
+    uint32 Bits;
+    size_t i;
+
+    if (Count * sizeof(*Out) < HYUN_APP_WIRE_PACK_MIN)
+    {
+        for (i = 0; i < Count; i++)
+        {
+            Bits = HYUN_APP_WireLoad32(&In[i * sizeof(Bits)]);
+            memcpy(&Out[i], &Bits, sizeof(Bits));
+        }
+    }
+    else
+    {
+        HYUN_APP_UnpackBe32(Out, In, Count);
+    }
+    return In + Count * sizeof(*Out);
+}
+
+static inline const uint8 *HYUN_APP_WireGet_double(const uint8 *In, double *Out, size_t Count)
+{
+    uint64 Bits;
+    size_t i;
+
+    if (Count * sizeof(*Out) < HYUN_APP_WIRE_PACK_MIN)
+    {
+        for (i = 0; i < Count; i++)
+        {
+            Bits = HYUN_APP_WireLoad64(&In[i * sizeof(Bits)]);
+            memcpy(&Out[i], &Bits, sizeof(Bits));
+        }
+    }
+    else
+    {
+        HYUN_APP_UnpackBe64(Out, In, Count);
+    }
+    return In + Count * sizeof(*Out);
+}
+
+/*
+** Generated encoders and decoders, fields in schema order
+*/
+#define HYUN_APP_WIRE_PUT_FIELD(Type, Name)        Ptr = HYUN_APP_WirePut_##Type(Ptr, &In->Name, 1);
+#define HYUN_APP_WIRE_PUT_ARRAY(Type, Name, Count) Ptr = HYUN_APP_WirePut_##Type(Ptr, In->Name, Count);
+#define HYUN_APP_WIRE_GET_FIELD(Type, Name)        Ptr = HYUN_APP_WireGet_##Type(Ptr, &Out->Name, 1);
+#define HYUN_APP_WIRE_GET_ARRAY(Type, Name, Count) Ptr = HYUN_APP_WireGet_##Type(Ptr, Out->Name, Count);
+
+#define HYUN_APP_WIRE_FUNCTIONS(Name, Kind, Fields)                                   \
+    size_t HYUN_APP_##Name##Encode(const HYUN_APP_##Name##_Payload_t *In, uint8 *Out) \
+    {                                                                                 \
+        uint8 *Ptr = Out;                                                             \
+        Fields(HYUN_APP_WIRE_PUT_FIELD, HYUN_APP_WIRE_PUT_ARRAY)                      \
+        return (size_t)(Ptr - Out);                                                   \
+    }                                                                                 \
+                                                                                      \
+    size_t HYUN_APP_##Name##Decode(const uint8 *In, HYUN_APP_##Name##_Payload_t *Out) \
+    {                                                                                 \
+        const uint8 *Ptr = In;                                                        \
+        Fields(HYUN_APP_WIRE_GET_FIELD, HYUN_APP_WIRE_GET_ARRAY)                      \
+        return (size_t)(Ptr - In);                                                    \
+    }
+
+HYUN_APP_PAYLOAD_DEFS(HYUN_APP_WIRE_FUNCTIONS)
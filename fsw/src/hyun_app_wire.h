@@ -0,0 +1,62 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * Big-endian wire form of the schema payloads
+ *
+ * HYUN_APP_<Name>Encode / HYUN_APP_<Name>Decode are generated for every
+ * payload in HYUN_APP_PAYLOAD_DEFS. Multi-byte fields go out in network
+ * byte order like the CCSDS header in front of them, so ground tools do
+ * not depend on the flight computer's endianness. Both return the wire
+ * size, HYUN_APP_<Name>_WIRE_SIZE.
+ *
+ * The app downlinks payloads in host order, so the codecs are built into
+ * the ground and host tools under tools/ only, not into the app.
+ */
+
+#ifndef HYUN_APP_WIRE_H
+#define HYUN_APP_WIRE_H
+
+#include "common_types.h"
+#include "hyun_app_msgdefs.h"
+
+/***********************************************************************/
+#define HYUN_APP_WIRE_SIZE_ENUM(Name, Kind, Fields) HYUN_APP_##Name##_WIRE_SIZE = HYUN_APP_MSG_WIRE_SIZE(Fields),
+
+enum
+{
+    HYUN_APP_PAYLOAD_DEFS(HYUN_APP_WIRE_SIZE_ENUM)
+};
+
+/****************************************************************************/
+/*
+** Wire prototypes
+*/
+#define HYUN_APP_WIRE_PROTOTYPES(Name, Kind, Fields)                                   \
+    size_t HYUN_APP_##Name##Encode(const HYUN_APP_##Name##_Payload_t *In, uint8 *Out); \
+    size_t HYUN_APP_##Name##Decode(const uint8 *In, HYUN_APP_##Name##_Payload_t *Out);
+
+HYUN_APP_PAYLOAD_DEFS(HYUN_APP_WIRE_PROTOTYPES)
+
+#endif /* HYUN_APP_WIRE_H */
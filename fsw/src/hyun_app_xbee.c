@@ -0,0 +1,488 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: hyun_app_xbee.c
+**
+** Purpose:
+**   XBee API mode 2 framing and serial output for the downlink.
+**   Shared between the flight software and the host pty test.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE /* cfmakeraw, CRTSCTS */
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "hyun_app_xbee.h"
+
+/*
+** Baud rates the radio is configured for (ATBD 3..7)
+*/
+static const struct
+{
+    uint32  Baud;
+    speed_t Speed;
+} HYUN_APP_XbeeSpeeds[] = {{9600, B9600}, {19200, B19200}, {38400, B38400}, {57600, B57600}, {115200, B115200}};
+
+#define HYUN_APP_XBEE_NUM_SPEEDS (sizeof(HYUN_APP_XbeeSpeeds) / sizeof(HYUN_APP_XbeeSpeeds[0]))
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_XbeePut -- Write one byte, escaped when it must be      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static inline uint8 *HYUN_APP_XbeePut(uint8 *Out, uint8 Byte)
+{
+    if (Byte == HYUN_APP_XBEE_START || Byte == HYUN_APP_XBEE_ESCAPE || Byte == HYUN_APP_XBEE_XON ||
+        Byte == HYUN_APP_XBEE_XOFF)
+    {
+        *Out++ = HYUN_APP_XBEE_ESCAPE;
+        Byte ^= HYUN_APP_XBEE_ESCAPE_XOR;
+    }
+    *Out++ = Byte;
+
+    return Out;
+
+} /* End of HYUN_APP_XbeePut() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_XbeeInit -- Closed, nothing queued                     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_XbeeInit(HYUN_APP_Xbee_t *Xbee)
+{
+    memset(Xbee, 0, sizeof(*Xbee));
+    Xbee->Fd = -1;
+
+} /* End of HYUN_APP_XbeeInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_XbeeOpen                                                  */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Open the serial device raw 8N1 at the given baud rate. Writes are  */
+/*         non-blocking so a stalled radio costs frames, not the data task.   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_XbeeOpen(HYUN_APP_Xbee_t *Xbee, const char *Device, uint32 Baud, uint64 Dest64)
+{
+    struct termios Tio;
+    speed_t        Speed = B0;
+    uint32         i;
+
+    for (i = 0; i < HYUN_APP_XBEE_NUM_SPEEDS; i++)
+    {
+        if (HYUN_APP_XbeeSpeeds[i].Baud == Baud)
+        {
+            Speed = HYUN_APP_XbeeSpeeds[i].Speed;
+        }
+    }
+    if (Speed == B0)
+    {
+        return HYUN_APP_XBEE_ERR_BAUD;
+    }
+
+    HYUN_APP_XbeeClose(Xbee);
+
+    Xbee->Fd = open(Device, O_WRONLY | O_NOCTTY | O_NONBLOCK);
+    if (Xbee->Fd < 0)
+    {
+        return HYUN_APP_XBEE_ERR_DEVICE;
+    }
+
+    if (tcgetattr(Xbee->Fd, &Tio) != 0)
+    {
+        HYUN_APP_XbeeClose(Xbee);
+        return HYUN_APP_XBEE_ERR_DEVICE;
+    }
+
+    cfmakeraw(&Tio);
+    Tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+    Tio.c_cflag |= CLOCAL;
+    cfsetispeed(&Tio, Speed);
+    cfsetospeed(&Tio, Speed);
+
+    if (tcsetattr(Xbee->Fd, TCSANOW, &Tio) != 0)
+    {
+        HYUN_APP_XbeeClose(Xbee);
+        return HYUN_APP_XBEE_ERR_DEVICE;
+    }
+
+    Xbee->Baud   = Baud;
+    Xbee->Dest64 = Dest64;
+
+    return HYUN_APP_XBEE_SUCCESS;
+
+} /* End of HYUN_APP_XbeeOpen() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_XbeeValidBaud -- Table check of the baud rate          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool HYUN_APP_XbeeValidBaud(uint32 Baud)
+{
+    uint32 i;
+
+    for (i = 0; i < HYUN_APP_XBEE_NUM_SPEEDS; i++)
+    {
+        if (HYUN_APP_XbeeSpeeds[i].Baud == Baud)
+        {
+            return true;
+        }
+    }
+
+    return false;
+
+} /* End of HYUN_APP_XbeeValidBaud() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_XbeeClose -- Close the device, queued frames are lost  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_XbeeClose(HYUN_APP_Xbee_t *Xbee)
+{
+    if (Xbee->Fd >= 0)
+    {
+        close(Xbee->Fd);
+        Xbee->Fd = -1;
+    }
+
+    Xbee->DropCounter += Xbee->Count;
+    Xbee->Count = 0;
+    Xbee->Baud  = 0;
+
+} /* End of HYUN_APP_XbeeClose() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_XbeeEncode                                                */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Build one Transmit Request frame around Len bytes of RF data. The  */
+/*         checksum is summed while the bytes are escaped into Out, so the    */
+/*         data is read once. Returns the frame length or an error.           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_XbeeEncode(uint8 *Out, size_t OutSize, uint64 Dest64, const uint8 *Data, size_t Len)
+{
+    uint8 *Ptr = Out;
+    uint16 FrameLen;
+    uint8  Hdr[HYUN_APP_XBEE_TX_HDR_LEN];
+    uint8  Sum = 0;
+    size_t i;
+
+    if (Len > HYUN_APP_XBEE_MAX_RF_DATA || OutSize < HYUN_APP_XBEE_FRAME_SIZE(Len))
+    {
+        return HYUN_APP_XBEE_ERR_LENGTH;
+    }
+
+    FrameLen = (uint16)(HYUN_APP_XBEE_TX_HDR_LEN + Len);
+
+    Hdr[0] = HYUN_APP_XBEE_API_TX_REQUEST;
+    Hdr[1] = 0; /* Frame id 0, no transmit status back */
+    for (i = 0; i < 8; i++)
+    {
+        Hdr[2 + i] = (uint8)(Dest64 >> (56 - 8 * i));
+    }
+    Hdr[10] = (uint8)(HYUN_APP_XBEE_DEST16_UNKNOWN >> 8);
+    Hdr[11] = (uint8)(HYUN_APP_XBEE_DEST16_UNKNOWN & 0xFF);
+    Hdr[12] = 0; /* Broadcast radius, maximum hops */
+    Hdr[13] = 0; /* Transmit options */
+
+    *Ptr++ = HYUN_APP_XBEE_START;
+    Ptr    = HYUN_APP_XbeePut(Ptr, (uint8)(FrameLen >> 8));
+    Ptr    = HYUN_APP_XbeePut(Ptr, (uint8)(FrameLen & 0xFF));
+
+    for (i = 0; i < HYUN_APP_XBEE_TX_HDR_LEN; i++)
+    {
+        Sum += Hdr[i];
+        Ptr = HYUN_APP_XbeePut(Ptr, Hdr[i]);
+    }
+
+    for (i = 0; i < Len; i++)
+    {
+        Sum += Data[i];
+        Ptr = HYUN_APP_XbeePut(Ptr, Data[i]);
+    }
+
+    Ptr = HYUN_APP_XbeePut(Ptr, (uint8)(0xFF - Sum));
+
+    return (int32)(Ptr - Out);
+
+} /* End of HYUN_APP_XbeeEncode() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_XbeeDecode                                                */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Ground side of HYUN_APP_XbeeEncode. In must start at a start       */
+/*         delimiter; on success *Used is the escaped frame length and the RF */
+/*         data is copied to Data. ERR_SHORT asks for more input.             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_XbeeDecode(const uint8 *In, size_t InLen, size_t *Used, uint8 *Data, size_t DataSize,
+                          size_t *DataLen)
+{
+    uint8  Frame[2 + HYUN_APP_XBEE_TX_HDR_LEN + HYUN_APP_XBEE_MAX_RF_DATA + 1];
+    size_t Pos = 1;
+    size_t Got = 0;
+    size_t Need;
+    uint16 FrameLen;
+    uint8  Sum = 0;
+    uint8  Byte;
+    size_t i;
+
+    if (InLen == 0)
+    {
+        return HYUN_APP_XBEE_ERR_SHORT;
+    }
+    if (In[0] != HYUN_APP_XBEE_START)
+    {
+        return HYUN_APP_XBEE_ERR_FRAME;
+    }
+
+    /* Length, then frame data and checksum once the length is known */
+    Need = 2;
+    while (Got < Need)
+    {
+        if (Pos >= InLen)
+        {
+            return HYUN_APP_XBEE_ERR_SHORT;
+        }
+
+        Byte = In[Pos++];
+        if (Byte == HYUN_APP_XBEE_START)
+        {
+            return HYUN_APP_XBEE_ERR_FRAME;
+        }
+        if (Byte == HYUN_APP_XBEE_ESCAPE)
+        {
+            if (Pos >= InLen)
+            {
+                return HYUN_APP_XBEE_ERR_SHORT;
+            }
+            Byte = In[Pos++] ^ HYUN_APP_XBEE_ESCAPE_XOR;
+        }
+        Frame[Got++] = Byte;
+
+        if (Got == 2)
+        {
+            FrameLen = (uint16)((Frame[0] << 8) | Frame[1]);
+            if (FrameLen < HYUN_APP_XBEE_TX_HDR_LEN || FrameLen > HYUN_APP_XBEE_TX_HDR_LEN + HYUN_APP_XBEE_MAX_RF_DATA)
+            {
+                return HYUN_APP_XBEE_ERR_FRAME;
+            }
+            Need = 2 + (size_t)FrameLen + 1;
+        }
+    }
+
+    for (i = 2; i < Need; i++)
+    {
+        Sum += Frame[i];
+    }
+
+    *Used = Pos;
+
+    if (Sum != 0xFF)
+    {
+        return HYUN_APP_XBEE_ERR_CHECKSUM;
+    }
+    if (Frame[2] != HYUN_APP_XBEE_API_TX_REQUEST)
+    {
+        return HYUN_APP_XBEE_ERR_FRAME;
+    }
+
+    *DataLen = Need - 3 - HYUN_APP_XBEE_TX_HDR_LEN;
+    if (*DataLen > DataSize)
+    {
+        return HYUN_APP_XBEE_ERR_LENGTH;
+    }
+    memcpy(Data, &Frame[2 + HYUN_APP_XBEE_TX_HDR_LEN], *DataLen);
+
+    return HYUN_APP_XBEE_SUCCESS;
+
+} /* End of HYUN_APP_XbeeDecode() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_XbeeQueue                                                 */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Frame Len bytes of downlink data into the write queue, split at    */
+/*         the RF data limit. A full queue is flushed first.                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_XbeeQueue(HYUN_APP_Xbee_t *Xbee, const uint8 *Data, size_t Len)
+{
+    size_t Chunk;
+    int32  FrameLen;
+
+    if (Xbee->Fd < 0)
+    {
+        return HYUN_APP_XBEE_ERR_DEVICE;
+    }
+
+    while (Len > 0)
+    {
+        if (Xbee->Count == HYUN_APP_XBEE_QUEUE_FRAMES)
+        {
+            HYUN_APP_XbeeFlush(Xbee);
+        }
+
+        Chunk    = (Len > HYUN_APP_XBEE_MAX_RF_DATA) ? HYUN_APP_XBEE_MAX_RF_DATA : Len;
+        FrameLen = HYUN_APP_XbeeEncode(Xbee->Frame[Xbee->Count], sizeof(Xbee->Frame[0]), Xbee->Dest64, Data, Chunk);
+        if (FrameLen < 0)
+        {
+            Xbee->ErrCounter++;
+            return FrameLen;
+        }
+
+        Xbee->Length[Xbee->Count] = (uint16)FrameLen;
+        Xbee->Count++;
+
+        Data += Chunk;
+        Len -= Chunk;
+    }
+
+    return HYUN_APP_XBEE_SUCCESS;
+
+} /* End of HYUN_APP_XbeeQueue() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  HYUN_APP_XbeeFlush                                                 */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Write every queued frame with one writev, resuming after partial   */
+/*         writes. Once the device buffer is full the remaining frames are    */
+/*         dropped; a frame cut short is discarded by the radio at the next   */
+/*         start delimiter. Returns the number of frames written completely.  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 HYUN_APP_XbeeFlush(HYUN_APP_Xbee_t *Xbee)
+{
+    struct iovec Iov[HYUN_APP_XBEE_QUEUE_FRAMES];
+    uint32       First = 0;
+    uint32       Done  = 0;
+    ssize_t      Rc;
+    uint32       i;
+
+    if (Xbee->Count == 0)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < Xbee->Count; i++)
+    {
+        Iov[i].iov_base = Xbee->Frame[i];
+        Iov[i].iov_len  = Xbee->Length[i];
+    }
+
+    while (First < Xbee->Count)
+    {
+        Rc = writev(Xbee->Fd, &Iov[First], (int)(Xbee->Count - First));
+        if (Rc < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (Rc <= 0)
+        {
+            if (Rc < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                Xbee->ErrCounter++;
+            }
+            break;
+        }
+
+        Xbee->ByteCounter += (uint32)Rc;
+        Xbee->WindowBytes += (uint32)Rc;
+
+        /* Step over the frames written completely */
+        while (First < Xbee->Count && (size_t)Rc >= Iov[First].iov_len)
+        {
+            Rc -= (ssize_t)Iov[First].iov_len;
+            First++;
+            Done++;
+        }
+        if (First < Xbee->Count && Rc > 0)
+        {
+            Iov[First].iov_base = (uint8 *)Iov[First].iov_base + Rc;
+            Iov[First].iov_len -= (size_t)Rc;
+        }
+    }
+
+    Xbee->FrameCounter += Done;
+    Xbee->WindowFrames += Done;
+    Xbee->DropCounter += Xbee->Count - Done;
+    Xbee->Count = 0;
+
+    return (int32)Done;
+
+} /* End of HYUN_APP_XbeeFlush() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_XbeeBudget -- Bytes per second the baud rate carries   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32 HYUN_APP_XbeeBudget(const HYUN_APP_Xbee_t *Xbee)
+{
+    return Xbee->Baud / HYUN_APP_XBEE_BITS_PER_BYTE;
+
+} /* End of HYUN_APP_XbeeBudget() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HYUN_APP_XbeeRate -- Close the rate window once a second and    */
+/* check it against the baud rate budget                           */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void HYUN_APP_XbeeRate(HYUN_APP_Xbee_t *Xbee, uint64 NowUs)
+{
+    uint64 ElapsedUs = NowUs - Xbee->WindowStartUs;
+
+    if (ElapsedUs < HYUN_APP_XBEE_RATE_WINDOW_US)
+    {
+        return;
+    }
+
+    Xbee->FramesPerSec = (uint32)((uint64)Xbee->WindowFrames * 1000000u / ElapsedUs);
+    Xbee->BytesPerSec  = (uint32)((uint64)Xbee->WindowBytes * 1000000u / ElapsedUs);
+
+    if (Xbee->Fd >= 0 && Xbee->BytesPerSec > HYUN_APP_XbeeBudget(Xbee))
+    {
+        Xbee->OverBudgetCounter++;
+    }
+
+    Xbee->WindowStartUs = NowUs;
+    Xbee->WindowFrames  = 0;
+    Xbee->WindowBytes   = 0;
+
+} /* End of HYUN_APP_XbeeRate() */
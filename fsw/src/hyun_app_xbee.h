@@ -0,0 +1,121 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*******************************************************************************/
+
+/**
+ * @file
+ *
+ * XBee API frame output for the flight radio
+ *
+ * The radio runs in API mode 2 (escaped). Downlink bytes are cut into
+ * Transmit Request (0x10) frames of at most HYUN_APP_XBEE_MAX_RF_DATA
+ * bytes; the ground side concatenates the RF data back into the CCSDS
+ * stream. Each frame is escaped and checksummed in a single pass straight
+ * into its output slot, and all frames queued in a cycle are written to
+ * the serial device with one writev.
+ *
+ * Only depends on the OSAL base types and POSIX, so the same source
+ * builds into the pseudo-terminal test under tools/.
+ */
+
+#ifndef HYUN_APP_XBEE_H
+#define HYUN_APP_XBEE_H
+
+#include "common_types.h"
+
+/***********************************************************************/
+#define HYUN_APP_XBEE_START      0x7E
+#define HYUN_APP_XBEE_ESCAPE     0x7D
+#define HYUN_APP_XBEE_XON        0x11
+#define HYUN_APP_XBEE_XOFF       0x13
+#define HYUN_APP_XBEE_ESCAPE_XOR 0x20
+
+#define HYUN_APP_XBEE_API_TX_REQUEST 0x10
+#define HYUN_APP_XBEE_TX_HDR_LEN     14 /* API id, frame id, 64-bit and 16-bit address, radius, options */
+#define HYUN_APP_XBEE_DEST16_UNKNOWN 0xFFFE
+#define HYUN_APP_XBEE_BROADCAST      0x000000000000FFFFull
+
+#define HYUN_APP_XBEE_MAX_RF_DATA 100 /* Per frame, the lowest limit across XBee firmwares */
+
+/*
+** Worst case frame: start delimiter, then length, frame data and checksum
+** with every byte escaped
+*/
+#define HYUN_APP_XBEE_FRAME_SIZE(Len) (1 + 2 * (2 + HYUN_APP_XBEE_TX_HDR_LEN + (Len) + 1))
+#define HYUN_APP_XBEE_MAX_FRAME       HYUN_APP_XBEE_FRAME_SIZE(HYUN_APP_XBEE_MAX_RF_DATA)
+
+#define HYUN_APP_XBEE_QUEUE_FRAMES 8 /* Frames gathered into one writev */
+
+#define HYUN_APP_XBEE_BITS_PER_BYTE  10 /* 8N1 */
+#define HYUN_APP_XBEE_RATE_WINDOW_US 1000000
+
+#define HYUN_APP_XBEE_SUCCESS      0
+#define HYUN_APP_XBEE_ERR_LENGTH   -1 /* Data does not fit a frame or the caller buffer */
+#define HYUN_APP_XBEE_ERR_SHORT    -2 /* Frame not complete yet */
+#define HYUN_APP_XBEE_ERR_FRAME    -3 /* No start delimiter, bad escape or unexpected API id */
+#define HYUN_APP_XBEE_ERR_CHECKSUM -4
+#define HYUN_APP_XBEE_ERR_DEVICE   -5 /* Cannot open or configure the serial device */
+#define HYUN_APP_XBEE_ERR_BAUD     -6 /* Baud rate not supported */
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    int    Fd; /* -1 while closed */
+    uint32 Baud;
+    uint64 Dest64;
+
+    uint32 Count; /* Frames queued for the next writev */
+    uint16 Length[HYUN_APP_XBEE_QUEUE_FRAMES];
+    uint8  Frame[HYUN_APP_XBEE_QUEUE_FRAMES][HYUN_APP_XBEE_MAX_FRAME];
+
+    uint32 FrameCounter;
+    uint32 ByteCounter;  /* Bytes on the wire, framing and escapes included */
+    uint32 DropCounter;  /* Frames the device did not take */
+    uint32 ErrCounter;
+
+    uint64 WindowStartUs;
+    uint32 WindowFrames;
+    uint32 WindowBytes;
+    uint32 FramesPerSec;
+    uint32 BytesPerSec;
+    uint32 OverBudgetCounter; /* Rate windows that needed more than the baud rate carries */
+} HYUN_APP_Xbee_t;
+
+/****************************************************************************/
+/*
+** XBee prototypes
+*/
+void   HYUN_APP_XbeeInit(HYUN_APP_Xbee_t *Xbee);
+int32  HYUN_APP_XbeeOpen(HYUN_APP_Xbee_t *Xbee, const char *Device, uint32 Baud, uint64 Dest64);
+void   HYUN_APP_XbeeClose(HYUN_APP_Xbee_t *Xbee);
+bool   HYUN_APP_XbeeValidBaud(uint32 Baud);
+int32  HYUN_APP_XbeeEncode(uint8 *Out, size_t OutSize, uint64 Dest64, const uint8 *Data, size_t Len);
+int32  HYUN_APP_XbeeDecode(const uint8 *In, size_t InLen, size_t *Used, uint8 *Data, size_t DataSize,
+                           size_t *DataLen);
+int32  HYUN_APP_XbeeQueue(HYUN_APP_Xbee_t *Xbee, const uint8 *Data, size_t Len);
+int32  HYUN_APP_XbeeFlush(HYUN_APP_Xbee_t *Xbee);
+void   HYUN_APP_XbeeRate(HYUN_APP_Xbee_t *Xbee, uint64 NowUs);
+uint32 HYUN_APP_XbeeBudget(const HYUN_APP_Xbee_t *Xbee);
+
+#endif /* HYUN_APP_XBEE_H */
@@ -0,0 +1,80 @@
+/*
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+*/
+
+#include "cfe_tbl_filedef.h" /* Required to obtain the CFE_TBL_FILEDEF macro definition */
+#include "hyun_app_seq.h"
+
+/*
+** CANSAT text command step without "CMD,<TEAM_ID>,", which SEQ_START adds
+** from the loaded HyunAppTable. The text is NUL padded to the payload size.
+*/
+#define HYUN_APP_SEQ_TEXT_STEP(Text)                                                                      \
+    {                                                                                                     \
+        .CommandCode = HYUN_APP_TEXT_CMD_CC, .ArgLength = sizeof(HYUN_APP_TextCmd_Payload_t), .Args = Text \
+    }
+
+/*
+** Ground procedures run by SEQ_START
+*/
+HYUN_APP_SeqTable_t HyunAppSeqTable = {
+    .Seq =
+        {
+            {
+                .Name      = "SIM_START",
+                .StepCount = 3,
+                .Step =
+                    {
+                        HYUN_APP_SEQ_TEXT_STEP("SIM,ENABLE"),
+                        HYUN_APP_SEQ_TEXT_STEP("SIM,ACTIVATE"),
+                        HYUN_APP_SEQ_TEXT_STEP("CX,ON"),
+                    },
+            },
+            {
+                .Name      = "SIM_STOP",
+                .StepCount = 2,
+                .Step =
+                    {
+                        HYUN_APP_SEQ_TEXT_STEP("SIM,DISABLE"),
+                        {.CommandCode = HYUN_APP_REPLAY_STOP_CC},
+                    },
+            },
+            {
+                .Name      = "PAD_PREP",
+                .StepCount = 3,
+                .Step =
+                    {
+                        {.CommandCode = HYUN_APP_RESET_COUNTERS_CC},
+                        HYUN_APP_SEQ_TEXT_STEP("CAL"),
+                        HYUN_APP_SEQ_TEXT_STEP("CX,ON"),
+                    },
+            },
+        },
+};
+
+/*
+** The macro below identifies:
+**    1) the data structure type to use as the table image format
+**    2) the name of the table to be placed into the cFE Table File Header
+**    3) a brief description of the contents of the file image
+**    4) the desired name of the table image binary file that is cFE compatible
+*/
+CFE_TBL_FILEDEF(HyunAppSeqTable, HYUN_APP.HyunAppSeqTable, Ground Command Sequences, hyun_app_seq.tbl)
@@ -22,12 +22,82 @@
 
 #include "cfe_tbl_filedef.h" /* Required to obtain the CFE_TBL_FILEDEF macro definition */
 #include "hyun_app_table.h"
+#include "hyun_app_msgids.h"
+#include "hyun_app_codec.h"
 
 /*
 ** The following is an example of the declaration statement that defines the desired
 ** contents of the table image.
 */
-HYUN_APP_Table_t HyunAppTable = {1, 2};
+HYUN_APP_Table_t HyunAppTable = {
+    .Int1 = 1,
+    .Int2 = 2,
+
+    .LaunchAltitude  = 20.0f,
+    .LaunchVelocity  = 5.0f,
+    .ApogeeVelocity  = 0.0f,
+    .DescentVelocity = 3.0f,
+    .ReleaseAltitude = 100.0f,
+    .LandedAltitude  = 10.0f,
+    .LandedVelocity  = 1.0f,
+    .HysteresisCount = 3,
+
+    .FilterWindow = 5,
+
+    .AlignPeriodMs     = 100,
+    .AlignMaxLatencyMs = 100,
+
+    .DownlinkCodec =
+        {
+            {.MsgId = HYUN_APP_MID_ALIGNED_TLM, .Codec = HYUN_APP_CODEC_DELTA},
+            {.MsgId = HYUN_APP_MID_ESTIMATE_TLM, .Codec = HYUN_APP_CODEC_DELTA},
+        },
+
+    .LinkBytesPerSec = 1000, /* XBee at 9600 baud leaves ~1200 B/s */
+    .LinkBurstBytes  = 512,
+
+    .TeamId = 1000,
+
+    /* Set UdpTlmPort (e.g. 1235) on the ground test table only */
+    .UdpTlmHost  = "127.0.0.1",
+    .UdpTlmPort  = 0,
+    .UdpTlmMsgId = {HYUN_APP_MID_HOUSEKEEPING_RES, HYUN_APP_MID_ESTIMATE_TLM, HYUN_APP_MID_ALIGNED_TLM,
+                    HYUN_APP_MID_COMPRESSED_TLM},
+
+    /* Set UdpCmdPort (e.g. 1234) on the ground test table only */
+    .UdpCmdPort = 0,
+
+    /* Set XbeeDevice (e.g. "/dev/ttyS1") on the flight table */
+    .XbeeDevice   = "",
+    .XbeeBaud     = 9600,
+    .XbeeDestHigh = 0x00000000,
+    .XbeeDestLow  = 0x0000FFFF,
+
+    .SubPipe =
+        {
+            [HYUN_APP_SUB_PIPE_CMD] =
+                {
+                    .Depth = 32,
+                    .Entry =
+                        {
+                            {.MsgId = HYUN_APP_MID_HOUSEKEEPING_REQ, .MsgLimit = 4},
+                            {.MsgId = HYUN_APP_MID_GROUNDCMD_REQ, .MsgLimit = 16},
+                        },
+                },
+            [HYUN_APP_SUB_PIPE_SENSOR] =
+                {
+                    .Depth = 64,
+                    .Entry =
+                        {
+                            {.MsgId = HYUN_APP_MID_SENSOR_IMU, .MsgLimit = 32},
+                            {.MsgId = HYUN_APP_MID_SENSOR_BARO, .MsgLimit = 8},
+                            {.MsgId = HYUN_APP_MID_SENSOR_GPS, .MsgLimit = 4},
+                            {.MsgId = HYUN_APP_MID_SENSOR_VOLTAGE, .MsgLimit = 4},
+                            {.MsgId = HYUN_APP_MID_SENSOR_GPS_RAW, .MsgLimit = 8},
+                        },
+                },
+        },
+};
 
 /*
 ** The macro below identifies:
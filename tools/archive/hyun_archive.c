@@ -0,0 +1,485 @@
+/*
+** hyun_archive -- post-flight access to the HYUN_APP on-board archive
+**
+** Copy hyun_rec.dat and hyun_rec.idx off the flight computer; the index
+** is looked up next to the data file (.dat replaced by .idx) unless -i
+** names it. Times are in seconds of MET, the spacecraft elapsed time the
+** flight recorder stamps each packet with as it stores it.
+**
+**   hyun_archive info [-i index] <archive.dat>
+**       Blocks, records, time span and unindexed tail.
+**
+**   hyun_archive query [-i index] [-m mid] [-f from] [-t to] [-x] [-s] <archive.dat>
+**       Print every record of MID <mid> (default all) stamped within
+**       [from, to] MET seconds (default everything), -x with a hex dump
+**       of the packet.
+**       -s walks the whole archive instead of using the index.
+**
+**   hyun_archive selftest [-n seconds] [-q queries] [-d dir]
+**       Write a synthetic archive with the flight block writer, including
+**       late streams, a restart and an unindexed tail, and check indexed
+**       queries against full scans.
+*/
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "hyun_archive_read.h"
+#include "hyun_app_msgids.h"
+
+#define HYUN_ARCHIVE_PATH_LEN 512
+
+typedef struct
+{
+    int    Hex;
+    size_t Count;
+    uint64 Sum; /* Order-independent digest of the matches, selftest */
+} QueryOut_t;
+
+static double Now(void)
+{
+    struct timespec Ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &Ts);
+    return (double)Ts.tv_sec + (double)Ts.tv_nsec * 1e-9;
+}
+
+static uint64 SecToUs(const char *Text)
+{
+    return (uint64)(strtod(Text, NULL) * 1e6 + 0.5);
+}
+
+static void IndexPathFor(const char *DataPath, char *IndexPath)
+{
+    size_t Len = strlen(DataPath);
+
+    if (Len >= 4 && strcmp(DataPath + Len - 4, ".dat") == 0)
+    {
+        snprintf(IndexPath, HYUN_ARCHIVE_PATH_LEN, "%.*s.idx", (int)(Len - 4), DataPath);
+    }
+    else
+    {
+        snprintf(IndexPath, HYUN_ARCHIVE_PATH_LEN, "%s.idx", DataPath);
+    }
+}
+
+static int PrintRecord(void *Arg, uint64 TimeUs, uint16 MsgId, const uint8 *Packet, uint16 Length)
+{
+    QueryOut_t *Out = Arg;
+    uint16      i;
+
+    printf("%" PRIu64 ".%06" PRIu64 " 0x%04X %5u", TimeUs / 1000000, TimeUs % 1000000, MsgId, Length);
+    if (Out->Hex)
+    {
+        for (i = 0; i < Length; i++)
+        {
+            printf("%s%02X", (i % 32 == 0) ? "\n   " : " ", Packet[i]);
+        }
+    }
+    printf("\n");
+
+    Out->Count++;
+    return 0;
+}
+
+static int DigestRecord(void *Arg, uint64 TimeUs, uint16 MsgId, const uint8 *Packet, uint16 Length)
+{
+    QueryOut_t *Out = Arg;
+
+    Out->Count++;
+    Out->Sum += (TimeUs * 2654435761u) ^ ((uint64)MsgId << 48) ^ ((uint64)Length << 32) ^ Packet[Length - 1];
+    return 0;
+}
+
+static int Info(const char *DataPath, const char *IndexPath)
+{
+    HYUN_ARCHIVE_t       Archive;
+    HYUN_ARCHIVE_Stats_t Stats;
+    uint64               Records = 0;
+    uint64               MinUs   = UINT64_MAX;
+    uint64               MidMask = 0;
+    size_t               i;
+
+    if (HyunArchiveOpen(&Archive, DataPath, IndexPath) != 0)
+    {
+        return 1;
+    }
+
+    for (i = 0; i < Archive.Entries; i++)
+    {
+        Records += Archive.Index[i].Count;
+        MidMask |= Archive.Index[i].MidMask;
+        if (Archive.Index[i].MinTimeUs < MinUs)
+        {
+            MinUs = Archive.Index[i].MinTimeUs;
+        }
+    }
+
+    printf("data       %zu bytes\n", Archive.DataSize);
+    printf("blocks     %zu indexed, %" PRIu64 " records\n", Archive.Entries, Records);
+    if (Archive.Entries > 0)
+    {
+        printf("time       %.6f .. %.6f s\n", (double)MinUs * 1e-6,
+               (double)Archive.Index[Archive.Entries - 1].MaxTimeUs * 1e-6);
+        if (Archive.Index[Archive.Entries - 1].LateUs == HYUN_APP_ARCHIVE_LATE_UNBOUNDED)
+        {
+            printf("late       unbounded, queries scan to the end\n");
+        }
+        else
+        {
+            printf("late       %.3f ms\n", Archive.Index[Archive.Entries - 1].LateUs * 1e-3);
+        }
+        printf("mid mask   0x%016" PRIX64 "\n", MidMask);
+    }
+
+    HyunArchiveScan(&Archive, UINT64_MAX, UINT64_MAX, HYUN_ARCHIVE_ANY_MID, NULL, NULL, &Stats);
+    printf("tail       %zu bytes unindexed, %zu records\n", (size_t)(Archive.DataSize - Archive.TailOffset),
+           Stats.RecordsScanned - (size_t)Records);
+
+    HyunArchiveClose(&Archive);
+    return 0;
+}
+
+static int Query(const char *DataPath, const char *IndexPath, int MsgId, uint64 FromUs, uint64 ToUs, int Hex,
+                 int FullScan)
+{
+    HYUN_ARCHIVE_t       Archive;
+    HYUN_ARCHIVE_Stats_t Stats;
+    QueryOut_t           Out = {Hex, 0, 0};
+    double               Start;
+
+    if (HyunArchiveOpen(&Archive, DataPath, IndexPath) != 0)
+    {
+        return 1;
+    }
+
+    Start = Now();
+    if (FullScan)
+    {
+        HyunArchiveScan(&Archive, FromUs, ToUs, MsgId, PrintRecord, &Out, &Stats);
+    }
+    else
+    {
+        HyunArchiveQuery(&Archive, FromUs, ToUs, MsgId, PrintRecord, &Out, &Stats);
+    }
+
+    fprintf(stderr, "%zu records, %zu of %zu blocks read, %zu records scanned, %zu tail bytes, %.3f ms\n",
+            Out.Count, Stats.BlocksRead, Archive.Entries, Stats.RecordsScanned, Stats.TailBytes,
+            (Now() - Start) * 1e3);
+    if (Stats.BadRecords > 0)
+    {
+        fprintf(stderr, "%zu damaged records, rest of their block skipped\n", Stats.BadRecords);
+    }
+
+    HyunArchiveClose(&Archive);
+    return 0;
+}
+
+/*
+** Synthetic archive writer, mirrors the flight recorder
+*/
+typedef struct
+{
+    FILE                   *Data;
+    FILE                   *Index;
+    HYUN_APP_ArchiveBlock_t Block;
+    uint64                  FlushDueUs;
+    uint8                   Packet[256];
+} Writer_t;
+
+static void WriterFlush(Writer_t *W)
+{
+    if (W->Block.Entry.Count == 0)
+    {
+        return;
+    }
+
+    fseeko(W->Data, (off_t)W->Block.Entry.Offset, SEEK_SET);
+    fwrite(W->Block.Data, 1, W->Block.Entry.Length, W->Data);
+    fwrite(&W->Block.Entry, sizeof(W->Block.Entry), 1, W->Index);
+    HYUN_APP_ArchiveBlockNext(&W->Block);
+}
+
+static void WriterPacket(Writer_t *W, uint64 NowUs, uint64 TimeUs, uint16 MsgId, uint16 Length)
+{
+    uint16 i;
+
+    for (i = 0; i < Length; i++)
+    {
+        W->Packet[i] = (uint8)rand();
+    }
+
+    if (!HYUN_APP_ArchiveAppend(&W->Block, TimeUs, MsgId, W->Packet, Length))
+    {
+        WriterFlush(W);
+        HYUN_APP_ArchiveAppend(&W->Block, TimeUs, MsgId, W->Packet, Length);
+    }
+
+    if (W->Block.Entry.Count == 1)
+    {
+        W->FlushDueUs = NowUs + 1000000;
+    }
+}
+
+static uint64 Jitter(uint32 MaxUs)
+{
+    return (uint64)rand() % (MaxUs + 1);
+}
+
+static int SelfTest(uint32 Seconds, uint32 Queries, const char *Dir)
+{
+    static const uint16 Mids[] = {HYUN_APP_MID_SENSOR_IMU, HYUN_APP_MID_SENSOR_BARO, HYUN_APP_MID_SENSOR_GPS,
+                                  HYUN_APP_MID_HOUSEKEEPING_RES};
+    HYUN_APP_ArchiveHdr_t Hdr;
+    HYUN_ARCHIVE_t        Archive;
+    HYUN_ARCHIVE_Stats_t  QStats;
+    HYUN_ARCHIVE_Stats_t  SStats;
+    Writer_t              W;
+    QueryOut_t            QOut;
+    QueryOut_t            SOut;
+    char                  DataPath[HYUN_ARCHIVE_PATH_LEN];
+    char                  IndexPath[HYUN_ARCHIVE_PATH_LEN];
+    uint64                EndUs = (uint64)Seconds * 1000000;
+    uint64                NowUs;
+    uint64                FromUs;
+    uint64                ToUs;
+    size_t                BlocksIndexed = 0;
+    size_t                BlocksScanned = 0;
+    double                IndexTime     = 0.0;
+    double                ScanTime      = 0.0;
+    double                Start;
+    uint32                Tick;
+    uint32                q;
+    int                   MsgId;
+    int                   Fail = 0;
+
+    snprintf(DataPath, sizeof(DataPath), "%s/hyun_archive_selftest.dat", Dir);
+    IndexPathFor(DataPath, IndexPath);
+
+    W.Data  = fopen(DataPath, "w+b");
+    W.Index = fopen(IndexPath, "wb");
+    if (W.Data == NULL || W.Index == NULL)
+    {
+        perror(Dir);
+        return 1;
+    }
+
+    srand(1);
+    HYUN_APP_ArchiveHdrInit(&Hdr, HYUN_APP_ARCHIVE_DATA_MAGIC);
+    fwrite(&Hdr, sizeof(Hdr), 1, W.Data);
+    HYUN_APP_ArchiveHdrInit(&Hdr, HYUN_APP_ARCHIVE_INDEX_MAGIC);
+    fwrite(&Hdr, sizeof(Hdr), 1, W.Index);
+    HYUN_APP_ArchiveBlockInit(&W.Block, sizeof(Hdr), NULL);
+
+    /*
+    ** 200 Hz IMU, 20 Hz baro up to 30 ms late, 1 Hz GPS 150 ms late and
+    ** 1 Hz HK, appended in arrival order
+    */
+    for (Tick = 0, NowUs = 0; NowUs < EndUs; Tick++, NowUs += 5000)
+    {
+        WriterPacket(&W, NowUs, NowUs - (NowUs > 2000 ? Jitter(2000) : 0), HYUN_APP_MID_SENSOR_IMU, 40);
+        if (Tick % 10 == 0 && NowUs >= 30000)
+        {
+            WriterPacket(&W, NowUs, NowUs - Jitter(30000), HYUN_APP_MID_SENSOR_BARO, 32);
+        }
+        if (Tick % 200 == 100)
+        {
+            WriterPacket(&W, NowUs, NowUs - 150000, HYUN_APP_MID_SENSOR_GPS, 48);
+            WriterPacket(&W, NowUs, NowUs, HYUN_APP_MID_HOUSEKEEPING_RES, 200);
+        }
+
+        if (W.Block.Entry.Count > 0 && NowUs >= W.FlushDueUs)
+        {
+            WriterFlush(&W);
+        }
+
+        /*
+        ** Reset half way: the partly filled block reaches the data file
+        ** but not the index, recording then continues behind it
+        */
+        if (Tick == (uint32)(EndUs / 5000 / 2))
+        {
+            HYUN_APP_ArchiveIndex_t Last;
+
+            fseeko(W.Data, (off_t)W.Block.Entry.Offset, SEEK_SET);
+            fwrite(W.Block.Data, 1, W.Block.Entry.Length / 2, W.Data);
+
+            Last = W.Block.Entry;
+            fseeko(W.Data, 0, SEEK_END);
+            HYUN_APP_ArchiveBlockInit(&W.Block, (uint64)ftello(W.Data), &Last);
+        }
+    }
+
+    /* Reset at the end: the last block never gets its index entry */
+    fseeko(W.Data, (off_t)W.Block.Entry.Offset, SEEK_SET);
+    fwrite(W.Block.Data, 1, W.Block.Entry.Length, W.Data);
+    fclose(W.Data);
+    fclose(W.Index);
+
+    if (HyunArchiveOpen(&Archive, DataPath, IndexPath) != 0)
+    {
+        return 1;
+    }
+
+    printf("archive    %zu bytes, %zu blocks, late %.1f ms, tail %zu bytes\n", Archive.DataSize, Archive.Entries,
+           Archive.Index[Archive.Entries - 1].LateUs * 1e-3, (size_t)(Archive.DataSize - Archive.TailOffset));
+
+    for (q = 0; q <= Queries; q++)
+    {
+        if (q == 0)
+        {
+            /* All baro samples between 50 and 80 s */
+            FromUs = 50000000;
+            ToUs   = 80000000;
+            MsgId  = HYUN_APP_MID_SENSOR_BARO;
+        }
+        else
+        {
+            FromUs = (uint64)rand() % (EndUs + 1000000);
+            ToUs   = FromUs + (uint64)rand() % ((q % 10 == 0) ? EndUs : 10000000);
+            MsgId  = (q % 5 == 0) ? HYUN_ARCHIVE_ANY_MID : Mids[rand() % 4];
+        }
+
+        memset(&QOut, 0, sizeof(QOut));
+        memset(&SOut, 0, sizeof(SOut));
+
+        Start = Now();
+        HyunArchiveQuery(&Archive, FromUs, ToUs, MsgId, DigestRecord, &QOut, &QStats);
+        IndexTime += Now() - Start;
+
+        Start = Now();
+        HyunArchiveScan(&Archive, FromUs, ToUs, MsgId, DigestRecord, &SOut, &SStats);
+        ScanTime += Now() - Start;
+
+        BlocksIndexed += QStats.BlocksRead;
+        BlocksScanned += SStats.BlocksRead;
+
+        if (q == 0)
+        {
+            printf("baro 50-80 s: %zu records, %zu of %zu blocks read\n", QOut.Count, QStats.BlocksRead,
+                   Archive.Entries);
+            if (QOut.Count != 600)
+            {
+                printf("FAIL expected 600 baro records\n");
+                Fail = 1;
+            }
+        }
+
+        if (QOut.Count != SOut.Count || QOut.Sum != SOut.Sum)
+        {
+            printf("FAIL query %u: mid %d %.6f..%.6f s, index %zu records, scan %zu\n", q, MsgId, FromUs * 1e-6,
+                   ToUs * 1e-6, QOut.Count, SOut.Count);
+            Fail = 1;
+        }
+    }
+
+    printf("%u queries: index %zu blocks in %.3f ms, full scan %zu blocks in %.3f ms\n", Queries + 1, BlocksIndexed,
+           IndexTime * 1e3, BlocksScanned, ScanTime * 1e3);
+    printf("%s\n", Fail ? "FAIL" : "PASS");
+
+    HyunArchiveClose(&Archive);
+    unlink(DataPath);
+    unlink(IndexPath);
+
+    return Fail;
+}
+
+static void Usage(void)
+{
+    fprintf(stderr, "usage: hyun_archive info [-i index] <archive.dat>\n"
+                    "       hyun_archive query [-i index] [-m mid] [-f from] [-t to] [-x] [-s] <archive.dat>\n"
+                    "       (from / to in seconds of MET)\n"
+                    "       hyun_archive selftest [-n seconds] [-q queries] [-d dir]\n");
+}
+
+int main(int argc, char *argv[])
+{
+    char        IndexPath[HYUN_ARCHIVE_PATH_LEN] = "";
+    const char *Dir                              = "/tmp";
+    const char *Mode;
+    uint64      FromUs   = 0;
+    uint64      ToUs     = UINT64_MAX;
+    int         MsgId    = HYUN_ARCHIVE_ANY_MID;
+    int         Hex      = 0;
+    int         FullScan = 0;
+    uint32      Seconds  = 600;
+    uint32      Queries  = 200;
+    int         Opt;
+
+    if (argc < 2)
+    {
+        Usage();
+        return 2;
+    }
+
+    Mode = argv[1];
+    optind = 2;
+    while ((Opt = getopt(argc, argv, "i:m:f:t:xsn:q:d:")) != -1)
+    {
+        switch (Opt)
+        {
+            case 'i':
+                snprintf(IndexPath, sizeof(IndexPath), "%s", optarg);
+                break;
+            case 'm':
+                MsgId = (int)strtol(optarg, NULL, 0);
+                break;
+            case 'f':
+                FromUs = SecToUs(optarg);
+                break;
+            case 't':
+                ToUs = SecToUs(optarg);
+                break;
+            case 'x':
+                Hex = 1;
+                break;
+            case 's':
+                FullScan = 1;
+                break;
+            case 'n':
+                Seconds = (uint32)strtoul(optarg, NULL, 0);
+                break;
+            case 'q':
+                Queries = (uint32)strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                Dir = optarg;
+                break;
+            default:
+                Usage();
+                return 2;
+        }
+    }
+
+    if (strcmp(Mode, "selftest") == 0 && optind == argc)
+    {
+        return SelfTest(Seconds < 120 ? 120 : Seconds, Queries, Dir);
+    }
+
+    if (optind != argc - 1)
+    {
+        Usage();
+        return 2;
+    }
+
+    if (IndexPath[0] == 0)
+    {
+        IndexPathFor(argv[optind], IndexPath);
+    }
+
+    if (strcmp(Mode, "info") == 0)
+    {
+        return Info(argv[optind], IndexPath);
+    }
+    if (strcmp(Mode, "query") == 0)
+    {
+        return Query(argv[optind], IndexPath, MsgId, FromUs, ToUs, Hex, FullScan);
+    }
+
+    Usage();
+    return 2;
+}
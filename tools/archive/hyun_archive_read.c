@@ -0,0 +1,274 @@
+/*
+** hyun_archive_read -- range queries on a HYUN_APP packet archive
+*/
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "hyun_archive_read.h"
+
+static const void *MapFile(const char *Path, size_t *Size, int Optional)
+{
+    struct stat Stat;
+    void       *Map;
+    int         Fd;
+
+    *Size = 0;
+
+    Fd = open(Path, O_RDONLY);
+    if (Fd < 0)
+    {
+        if (!Optional)
+        {
+            perror(Path);
+        }
+        return NULL;
+    }
+
+    if (fstat(Fd, &Stat) != 0 || Stat.st_size < (off_t)sizeof(HYUN_APP_ArchiveHdr_t))
+    {
+        fprintf(stderr, "%s: too short for an archive\n", Path);
+        close(Fd);
+        return NULL;
+    }
+
+    Map = mmap(NULL, (size_t)Stat.st_size, PROT_READ, MAP_PRIVATE, Fd, 0);
+    close(Fd);
+    if (Map == MAP_FAILED)
+    {
+        perror(Path);
+        return NULL;
+    }
+
+    *Size = (size_t)Stat.st_size;
+    return Map;
+}
+
+int HyunArchiveOpen(HYUN_ARCHIVE_t *Archive, const char *DataPath, const char *IndexPath)
+{
+    const HYUN_APP_ArchiveIndex_t *Last;
+    const uint8                   *IndexMap;
+    HYUN_APP_ArchiveHdr_t          Hdr;
+
+    memset(Archive, 0, sizeof(*Archive));
+
+    Archive->Data = MapFile(DataPath, &Archive->DataSize, 0);
+    if (Archive->Data == NULL)
+    {
+        return -1;
+    }
+
+    memcpy(&Hdr, Archive->Data, sizeof(Hdr));
+    if (!HYUN_APP_ArchiveHdrValid(&Hdr, HYUN_APP_ARCHIVE_DATA_MAGIC))
+    {
+        fprintf(stderr, "%s: not an archive data file of version %u in this byte order\n", DataPath,
+                HYUN_APP_ARCHIVE_VERSION);
+        HyunArchiveClose(Archive);
+        return -1;
+    }
+    Archive->TailOffset = sizeof(Hdr);
+
+    /*
+    ** Without an index every query is a full scan
+    */
+    IndexMap = MapFile(IndexPath, &Archive->IndexMapSize, 1);
+    if (IndexMap == NULL)
+    {
+        fprintf(stderr, "%s: no index, scanning the whole archive\n", IndexPath);
+        return 0;
+    }
+
+    memcpy(&Hdr, IndexMap, sizeof(Hdr));
+    if (!HYUN_APP_ArchiveHdrValid(&Hdr, HYUN_APP_ARCHIVE_INDEX_MAGIC))
+    {
+        fprintf(stderr, "%s: not an archive index of version %u in this byte order\n", IndexPath,
+                HYUN_APP_ARCHIVE_VERSION);
+        munmap((void *)IndexMap, Archive->IndexMapSize);
+        HyunArchiveClose(Archive);
+        return -1;
+    }
+
+    /* Entries follow the 16-byte header, so they are 8-byte aligned in the mapping */
+    Archive->Index   = (const HYUN_APP_ArchiveIndex_t *)(IndexMap + sizeof(Hdr));
+    Archive->Entries = (Archive->IndexMapSize - sizeof(Hdr)) / sizeof(HYUN_APP_ArchiveIndex_t);
+
+    /* The data file is written first, but a copy may still have been cut short */
+    while (Archive->Entries > 0)
+    {
+        Last = &Archive->Index[Archive->Entries - 1];
+        if (Last->Offset >= sizeof(Hdr) && Last->Offset + Last->Length <= Archive->DataSize)
+        {
+            Archive->TailOffset = Last->Offset + Last->Length;
+            break;
+        }
+        Archive->Entries--;
+    }
+
+    return 0;
+}
+
+void HyunArchiveClose(HYUN_ARCHIVE_t *Archive)
+{
+    if (Archive->Data != NULL)
+    {
+        munmap((void *)Archive->Data, Archive->DataSize);
+    }
+    if (Archive->Index != NULL)
+    {
+        munmap((void *)((const uint8 *)Archive->Index - sizeof(HYUN_APP_ArchiveHdr_t)), Archive->IndexMapSize);
+    }
+    memset(Archive, 0, sizeof(*Archive));
+}
+
+/*
+** Visit the matching records between two data file offsets. Sets *Stop
+** when the visitor asks to end the query.
+*/
+static size_t ScanRange(const HYUN_ARCHIVE_t *Archive, uint64 Start, uint64 End, uint64 FromUs, uint64 ToUs,
+                        int MsgId, HYUN_ARCHIVE_Visit_t Visit, void *Arg, HYUN_ARCHIVE_Stats_t *Stats, int *Stop)
+{
+    HYUN_APP_ArchiveRec_t Rec;
+    uint64                Offset  = Start;
+    size_t                Matches = 0;
+
+    while (Offset + sizeof(Rec) <= End)
+    {
+        memcpy(&Rec, Archive->Data + Offset, sizeof(Rec));
+        if (Rec.Sync != HYUN_APP_ARCHIVE_SYNC || Offset + sizeof(Rec) + Rec.Length > End)
+        {
+            Stats->BadRecords++;
+            break;
+        }
+
+        Stats->RecordsScanned++;
+
+        if (Rec.TimeUs >= FromUs && Rec.TimeUs <= ToUs && (MsgId < 0 || Rec.MsgId == (uint16)MsgId))
+        {
+            Matches++;
+            if (Visit != NULL && Visit(Arg, Rec.TimeUs, Rec.MsgId, Archive->Data + Offset + sizeof(Rec), Rec.Length))
+            {
+                *Stop = 1;
+                break;
+            }
+        }
+
+        Offset += sizeof(Rec) + Rec.Length;
+    }
+
+    return Matches;
+}
+
+static size_t ScanTail(const HYUN_ARCHIVE_t *Archive, uint64 FromUs, uint64 ToUs, int MsgId,
+                       HYUN_ARCHIVE_Visit_t Visit, void *Arg, HYUN_ARCHIVE_Stats_t *Stats)
+{
+    int Stop = 0;
+
+    if (Archive->TailOffset >= Archive->DataSize)
+    {
+        return 0;
+    }
+
+    Stats->TailBytes += Archive->DataSize - Archive->TailOffset;
+
+    return ScanRange(Archive, Archive->TailOffset, Archive->DataSize, FromUs, ToUs, MsgId, Visit, Arg, Stats, &Stop);
+}
+
+size_t HyunArchiveQuery(const HYUN_ARCHIVE_t *Archive, uint64 FromUs, uint64 ToUs, int MsgId,
+                        HYUN_ARCHIVE_Visit_t Visit, void *Arg, HYUN_ARCHIVE_Stats_t *Stats)
+{
+    const HYUN_APP_ArchiveIndex_t *Entry;
+    HYUN_ARCHIVE_Stats_t           Unused;
+    uint64                         Mask;
+    uint32                         LateUs;
+    size_t                         Lo      = 0;
+    size_t                         Hi      = Archive->Entries;
+    size_t                         Mid;
+    size_t                         Matches = 0;
+    int                            Stop    = 0;
+
+    if (Stats == NULL)
+    {
+        Stats = &Unused;
+    }
+    memset(Stats, 0, sizeof(*Stats));
+
+    Mask   = (MsgId < 0) ? ~(uint64)0 : HYUN_APP_ARCHIVE_MID_BIT((uint16)MsgId);
+    LateUs = (Archive->Entries > 0) ? Archive->Index[Archive->Entries - 1].LateUs : 0;
+
+    /*
+    ** First block whose running maximum reaches FromUs, nothing before it
+    ** is that recent
+    */
+    while (Lo < Hi)
+    {
+        Mid = Lo + (Hi - Lo) / 2;
+        if (Archive->Index[Mid].MaxTimeUs < FromUs)
+        {
+            Lo = Mid + 1;
+        }
+        else
+        {
+            Hi = Mid;
+        }
+    }
+
+    for (; Lo < Archive->Entries && !Stop; Lo++)
+    {
+        Entry = &Archive->Index[Lo];
+
+        if ((Entry->MidMask & Mask) != 0 && Entry->MinTimeUs <= ToUs)
+        {
+            Stats->BlocksRead++;
+            Matches += ScanRange(Archive, Entry->Offset, Entry->Offset + Entry->Length, FromUs, ToUs, MsgId, Visit,
+                                 Arg, Stats, &Stop);
+        }
+
+        /* Every later record is at least MaxTimeUs - LateUs */
+        if (LateUs != HYUN_APP_ARCHIVE_LATE_UNBOUNDED && Entry->MaxTimeUs > ToUs && Entry->MaxTimeUs - ToUs > LateUs)
+        {
+            break;
+        }
+    }
+
+    if (!Stop)
+    {
+        Matches += ScanTail(Archive, FromUs, ToUs, MsgId, Visit, Arg, Stats);
+    }
+
+    return Matches;
+}
+
+size_t HyunArchiveScan(const HYUN_ARCHIVE_t *Archive, uint64 FromUs, uint64 ToUs, int MsgId,
+                       HYUN_ARCHIVE_Visit_t Visit, void *Arg, HYUN_ARCHIVE_Stats_t *Stats)
+{
+    const HYUN_APP_ArchiveIndex_t *Entry;
+    HYUN_ARCHIVE_Stats_t           Unused;
+    size_t                         i;
+    size_t                         Matches = 0;
+    int                            Stop    = 0;
+
+    if (Stats == NULL)
+    {
+        Stats = &Unused;
+    }
+    memset(Stats, 0, sizeof(*Stats));
+
+    for (i = 0; i < Archive->Entries && !Stop; i++)
+    {
+        Entry = &Archive->Index[i];
+        Stats->BlocksRead++;
+        Matches += ScanRange(Archive, Entry->Offset, Entry->Offset + Entry->Length, FromUs, ToUs, MsgId, Visit, Arg,
+                             Stats, &Stop);
+    }
+
+    if (!Stop)
+    {
+        Matches += ScanTail(Archive, FromUs, ToUs, MsgId, Visit, Arg, Stats);
+    }
+
+    return Matches;
+}
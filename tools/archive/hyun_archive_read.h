@@ -0,0 +1,49 @@
+/*
+** hyun_archive_read -- range queries on a HYUN_APP packet archive
+**
+** The data and index files are mapped read-only. A query binary searches
+** the index for the first block that can hold the start time, skips
+** blocks whose MID mask can not match, and stops once the index proves
+** no later block can hold anything up to the end time (see
+** hyun_app_archive.h). Data past the last indexed block, left by a reset
+** before its index entry was written, is scanned record by record.
+*/
+#ifndef HYUN_ARCHIVE_READ_H
+#define HYUN_ARCHIVE_READ_H
+
+#include "hyun_app_archive.h"
+
+#define HYUN_ARCHIVE_ANY_MID (-1)
+
+typedef struct
+{
+    const uint8                   *Data;
+    size_t                         DataSize;
+    const HYUN_APP_ArchiveIndex_t *Index; /* NULL without an index file */
+    size_t                         Entries;
+    size_t                         IndexMapSize;
+    uint64                         TailOffset; /* First data byte not covered by the index */
+} HYUN_ARCHIVE_t;
+
+typedef struct
+{
+    size_t BlocksRead;
+    size_t RecordsScanned;
+    size_t TailBytes;  /* Unindexed bytes scanned */
+    size_t BadRecords; /* Records with a bad sync or length, rest of the block skipped */
+} HYUN_ARCHIVE_Stats_t;
+
+/*
+** Called for every matching record in file order; a non-zero return ends
+** the query
+*/
+typedef int (*HYUN_ARCHIVE_Visit_t)(void *Arg, uint64 TimeUs, uint16 MsgId, const uint8 *Packet, uint16 Length);
+
+int    HyunArchiveOpen(HYUN_ARCHIVE_t *Archive, const char *DataPath, const char *IndexPath);
+void   HyunArchiveClose(HYUN_ARCHIVE_t *Archive);
+size_t HyunArchiveQuery(const HYUN_ARCHIVE_t *Archive, uint64 FromUs, uint64 ToUs, int MsgId,
+                        HYUN_ARCHIVE_Visit_t Visit, void *Arg, HYUN_ARCHIVE_Stats_t *Stats);
+size_t HyunArchiveScan(const HYUN_ARCHIVE_t *Archive, uint64 FromUs, uint64 ToUs, int MsgId,
+                       HYUN_ARCHIVE_Visit_t Visit, void *Arg, HYUN_ARCHIVE_Stats_t *Stats);
+
+#endif /* HYUN_ARCHIVE_READ_H */
@@ -0,0 +1,412 @@
+/*
+** hyun_cmd_latency -- command latency with the sensor pipe saturated
+**
+**   hyun_cmd_latency [commands] [batch_us] [period_us] [bound_us]
+**
+** A sender thread writes time stamped commands into a pipe standing in
+** for the command pipe, on average one every period_us, with random
+** spacing so commands land at any point of a data cycle. Sensor data is
+** never short:
+** every data cycle finds a full batch and spends batch_us on it.
+**
+**   single  One task, as before the split: wait on the command pipe,
+**           run the command, then process a sensor batch.
+**   split   The command task blocks on the command pipe only and hands
+**           requests and an HK packet to the data task through the
+**           flight HYUN_APP_Handoff_t queues; the data task runs at a
+**           lower priority and executes requests at the top of a cycle.
+**
+** Latency is measured from the send time stamp to the command task
+** picking the command up, and in split mode also to the data task
+** executing the request. The split run fails if any request is lost or
+** reordered, or if the command latency p99 exceeds bound_us.
+**
+** Run as root for SCHED_FIFO priorities; otherwise the data task is only
+** niced, which the scheduler honours less strictly.
+*/
+
+#define _GNU_SOURCE /* gettid */
+
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "hyun_app_handoff.h"
+
+#define LAT_MAX_COMMANDS 100000
+#define LAT_CYCLE_MS     50 /* Command pipe wait, HYUN_APP_CYCLE_TIMEOUT_MS */
+#define LAT_HK_SIZE      168
+
+#define LAT_PRIO_CMD  20 /* SCHED_FIFO, higher runs first */
+#define LAT_PRIO_DATA 10
+
+typedef struct
+{
+    uint32 Seq;
+    uint64 SentNs;
+} LatCmd_t;
+
+typedef struct
+{
+    uint32 Commands;
+    uint32 BatchUs;
+    uint32 PeriodUs;
+    bool   Split;
+
+    int CmdPipe[2];
+
+    volatile bool Stop;
+    bool          Fifo;
+
+    HYUN_APP_Handoff_t Request;
+    HYUN_APP_Handoff_t Tlm;
+
+    uint64 PickNs[LAT_MAX_COMMANDS]; /* Send to command task */
+    uint64 ExecNs[LAT_MAX_COMMANDS]; /* Send to execution */
+    uint32 Executed;
+    uint32 OutOfOrder;
+    uint32 TlmCounter;
+    uint32 Refused;
+    uint32 Batches;
+} LatRun_t;
+
+static LatRun_t Run;
+
+static uint64 NowNs(void)
+{
+    struct timespec Ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &Ts);
+    return (uint64)Ts.tv_sec * 1000000000u + (uint64)Ts.tv_nsec;
+}
+
+/*
+** Processing one saturated sensor batch: the CPU is busy for BatchUs
+*/
+static void SensorBatch(void)
+{
+    uint64 EndNs = NowNs() + (uint64)Run.BatchUs * 1000u;
+
+    while (NowNs() < EndNs)
+    {
+    }
+
+    Run.Batches++;
+}
+
+static void Execute(const LatCmd_t *Cmd)
+{
+    if (Cmd->Seq != Run.Executed)
+    {
+        Run.OutOfOrder++;
+    }
+
+    Run.ExecNs[Cmd->Seq] = NowNs() - Cmd->SentNs;
+    Run.Executed++;
+}
+
+/*
+** Wait for one command, up to TimeoutMs. False on timeout.
+*/
+static bool ReceiveCommand(LatCmd_t *Cmd, int TimeoutMs)
+{
+    struct pollfd Pfd = {.fd = Run.CmdPipe[0], .events = POLLIN};
+
+    if (poll(&Pfd, 1, TimeoutMs) <= 0)
+    {
+        return false;
+    }
+
+    return read(Run.CmdPipe[0], Cmd, sizeof(*Cmd)) == (ssize_t)sizeof(*Cmd);
+}
+
+static void SetPriority(int FifoPrio, int Nice)
+{
+    struct sched_param Param = {.sched_priority = FifoPrio};
+
+    if (Run.Fifo && pthread_setschedparam(pthread_self(), SCHED_FIFO, &Param) == 0)
+    {
+        return;
+    }
+
+    Run.Fifo = false;
+    setpriority(PRIO_PROCESS, (id_t)gettid(), Nice);
+}
+
+static void *SenderTask(void *Arg)
+{
+    LatCmd_t     Cmd;
+    uint64       NextNs = NowNs();
+    unsigned int Seed   = 1;
+    uint32       i;
+
+    (void)Arg;
+    SetPriority(LAT_PRIO_CMD + 1, -1);
+
+    for (i = 0; i < Run.Commands; i++)
+    {
+        /* Uniform in [period / 2, 3 * period / 2) */
+        NextNs += (uint64)Run.PeriodUs * 500u + (uint64)(rand_r(&Seed) % (Run.PeriodUs + 1)) * 1000u;
+        while (NowNs() < NextNs)
+        {
+            usleep(100);
+        }
+
+        Cmd.Seq    = i;
+        Cmd.SentNs = NowNs();
+        if (write(Run.CmdPipe[1], &Cmd, sizeof(Cmd)) != (ssize_t)sizeof(Cmd))
+        {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+** The app before the split: commands and sensor batches on one task
+*/
+static void *SingleTask(void *Arg)
+{
+    LatCmd_t Cmd;
+
+    (void)Arg;
+    SetPriority(LAT_PRIO_CMD, 0);
+
+    while (Run.Executed < Run.Commands)
+    {
+        if (ReceiveCommand(&Cmd, LAT_CYCLE_MS))
+        {
+            Run.PickNs[Cmd.Seq] = NowNs() - Cmd.SentNs;
+            Execute(&Cmd);
+        }
+
+        SensorBatch();
+    }
+
+    return NULL;
+}
+
+static void *CommandTask(void *Arg)
+{
+    LatCmd_t Cmd;
+    uint8    Hk[LAT_HK_SIZE];
+    uint32   Received = 0;
+
+    (void)Arg;
+    SetPriority(LAT_PRIO_CMD, 0);
+    memset(Hk, 0xA5, sizeof(Hk));
+
+    while (Received < Run.Commands)
+    {
+        if (!ReceiveCommand(&Cmd, LAT_CYCLE_MS))
+        {
+            continue;
+        }
+
+        Run.PickNs[Cmd.Seq] = NowNs() - Cmd.SentNs;
+        Received++;
+
+        /* The flight task rejects the command here; the test retries so every request can be checked */
+        while (!HYUN_APP_HandoffPut(&Run.Request, &Cmd, sizeof(Cmd)))
+        {
+            Run.Refused++;
+            usleep(100);
+        }
+
+        HYUN_APP_HandoffPut(&Run.Tlm, Hk, sizeof(Hk));
+    }
+
+    return NULL;
+}
+
+static void *DataTask(void *Arg)
+{
+    const void *Record;
+    size_t      Size;
+
+    (void)Arg;
+    SetPriority(LAT_PRIO_DATA, 19);
+
+    while (!Run.Stop)
+    {
+        while ((Record = HYUN_APP_HandoffPeek(&Run.Request, &Size)) != NULL)
+        {
+            Execute((const LatCmd_t *)Record);
+            HYUN_APP_HandoffRelease(&Run.Request);
+        }
+
+        SensorBatch();
+
+        while ((Record = HYUN_APP_HandoffPeek(&Run.Tlm, &Size)) != NULL)
+        {
+            if (Size == LAT_HK_SIZE && ((const uint8 *)Record)[LAT_HK_SIZE - 1] == 0xA5)
+            {
+                Run.TlmCounter++;
+            }
+            HYUN_APP_HandoffRelease(&Run.Tlm);
+        }
+    }
+
+    return NULL;
+}
+
+static int CompareU64(const void *A, const void *B)
+{
+    uint64 a = *(const uint64 *)A;
+    uint64 b = *(const uint64 *)B;
+
+    return (a > b) - (a < b);
+}
+
+/*
+** Sorts Ns in place and prints p50 / p99 / max, returns p99 [us]
+*/
+static double Report(const char *Name, uint64 *Ns, uint32 Count)
+{
+    double P50;
+    double P99;
+    double Max;
+
+    qsort(Ns, Count, sizeof(*Ns), CompareU64);
+
+    P50 = (double)Ns[Count / 2] / 1000.0;
+    P99 = (double)Ns[(Count * 99) / 100] / 1000.0;
+    Max = (double)Ns[Count - 1] / 1000.0;
+
+    printf("%-22s %10.1f %10.1f %10.1f\n", Name, P50, P99, Max);
+
+    return P99;
+}
+
+static void RunMode(bool Split)
+{
+    pthread_t Sender;
+    pthread_t Cmd;
+    pthread_t Data;
+
+    Run.Split      = Split;
+    Run.Stop       = false;
+    Run.Executed   = 0;
+    Run.OutOfOrder = 0;
+    Run.TlmCounter = 0;
+    Run.Refused    = 0;
+    Run.Batches    = 0;
+    HYUN_APP_HandoffInit(&Run.Request);
+    HYUN_APP_HandoffInit(&Run.Tlm);
+
+    if (pipe(Run.CmdPipe) != 0)
+    {
+        perror("pipe");
+        exit(2);
+    }
+
+    if (Split)
+    {
+        pthread_create(&Data, NULL, DataTask, NULL);
+        pthread_create(&Cmd, NULL, CommandTask, NULL);
+    }
+    else
+    {
+        pthread_create(&Cmd, NULL, SingleTask, NULL);
+    }
+    pthread_create(&Sender, NULL, SenderTask, NULL);
+
+    pthread_join(Sender, NULL);
+    pthread_join(Cmd, NULL);
+
+    if (Split)
+    {
+        /* Let the data task finish the queued requests */
+        while (__atomic_load_n(&Run.Executed, __ATOMIC_ACQUIRE) < Run.Commands)
+        {
+            usleep(1000);
+        }
+        Run.Stop = true;
+        pthread_join(Data, NULL);
+    }
+
+    close(Run.CmdPipe[0]);
+    close(Run.CmdPipe[1]);
+}
+
+int main(int argc, char *argv[])
+{
+    double BoundUs = 1000.0;
+    double SplitP99;
+    int    Fail = 0;
+
+    Run.Commands = 500;
+    Run.BatchUs  = 5000;
+    Run.PeriodUs = 7000;
+
+    if (argc > 1)
+    {
+        Run.Commands = (uint32)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2)
+    {
+        Run.BatchUs = (uint32)strtoul(argv[2], NULL, 0);
+    }
+    if (argc > 3)
+    {
+        Run.PeriodUs = (uint32)strtoul(argv[3], NULL, 0);
+    }
+    if (argc > 4)
+    {
+        BoundUs = strtod(argv[4], NULL);
+    }
+    if (Run.Commands == 0 || Run.Commands > LAT_MAX_COMMANDS)
+    {
+        fprintf(stderr, "commands must be 1..%u\n", (unsigned)LAT_MAX_COMMANDS);
+        return 2;
+    }
+
+    Run.Fifo = true;
+
+    printf("%u commands every %u us, sensor batch %u us, %s priorities\n", (unsigned)Run.Commands,
+           (unsigned)Run.PeriodUs, (unsigned)Run.BatchUs, "SCHED_FIFO if permitted, else nice");
+    printf("%-22s %10s %10s %10s\n", "latency [us]", "p50", "p99", "max");
+
+    RunMode(false);
+    Report("single: command", Run.PickNs, Run.Commands);
+    if (Run.OutOfOrder != 0)
+    {
+        Fail = 1;
+    }
+
+    RunMode(true);
+    SplitP99 = Report("split: command", Run.PickNs, Run.Commands);
+    Report("split: request run", Run.ExecNs, Run.Commands);
+
+    printf("scheduling %s, %u batches, %u requests refused, %u HK packets handed over\n",
+           Run.Fifo ? "SCHED_FIFO" : "nice", (unsigned)Run.Batches, (unsigned)Run.Refused,
+           (unsigned)Run.TlmCounter);
+
+    if (Run.Executed != Run.Commands || Run.OutOfOrder != 0)
+    {
+        printf("FAIL: %u of %u requests executed, %u out of order\n", (unsigned)Run.Executed,
+               (unsigned)Run.Commands, (unsigned)Run.OutOfOrder);
+        Fail = 1;
+    }
+
+    if (SplitP99 > BoundUs)
+    {
+        printf("FAIL: split command latency p99 %.1f us above %.1f us\n", SplitP99, BoundUs);
+        Fail = 1;
+    }
+
+    if (!Fail)
+    {
+        printf("PASS\n");
+    }
+
+    return Fail;
+}
@@ -0,0 +1,150 @@
+/*
+** hyun_counter_bench -- counter increments under multi-task load
+**
+**   hyun_counter_bench [increments per task]
+**
+** Each thread increments only its own command counter, as the app tasks
+** do, and the totals are summed at the end like the HK request. The
+** packed layout keeps every task's counter in one cache line, as the
+** single CmdCounter / ErrCounter pair did; the sharded layout is the
+** flight HYUN_APP_Counters_t. Run it on at least HYUN_APP_MAX_TASKS
+** cores, false sharing cannot show on fewer.
+*/
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "hyun_app_counters.h"
+
+typedef struct
+{
+    uint32 CmdCounter[HYUN_APP_MAX_TASKS];
+    uint32 ErrCounter[HYUN_APP_MAX_TASKS];
+} PackedCounters_t;
+
+typedef struct
+{
+    volatile uint32 *Counter;
+    uint32           Increments;
+} BenchTask_t;
+
+static PackedCounters_t    Packed;
+static HYUN_APP_Counters_t Sharded;
+
+static double Now(void)
+{
+    struct timespec Ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &Ts);
+    return (double)Ts.tv_sec + (double)Ts.tv_nsec * 1e-9;
+}
+
+static void *BenchTask(void *Arg)
+{
+    BenchTask_t *Task = Arg;
+    uint32       i;
+
+    for (i = 0; i < Task->Increments; i++)
+    {
+        (*Task->Counter)++;
+    }
+
+    return NULL;
+}
+
+/*
+** Runs Tasks incrementing threads, returns ns per increment
+*/
+static double RunBench(bool UseShards, uint32 Tasks, uint32 Increments, uint32 *Total)
+{
+    pthread_t   Thread[HYUN_APP_MAX_TASKS];
+    BenchTask_t Task[HYUN_APP_MAX_TASKS];
+    uint32      CmdCounter;
+    uint32      ErrCounter;
+    double      Start;
+    double      Elapsed;
+    uint32      i;
+
+    memset(&Packed, 0, sizeof(Packed));
+    HYUN_APP_CountersInit(&Sharded);
+
+    for (i = 0; i < Tasks; i++)
+    {
+        Task[i].Counter    = UseShards ? &Sharded.Shard[i].CmdCounter : &Packed.CmdCounter[i];
+        Task[i].Increments = Increments;
+    }
+
+    Start = Now();
+    for (i = 0; i < Tasks; i++)
+    {
+        pthread_create(&Thread[i], NULL, BenchTask, &Task[i]);
+    }
+
+    for (i = 0; i < Tasks; i++)
+    {
+        pthread_join(Thread[i], NULL);
+    }
+    Elapsed = Now() - Start;
+
+    if (UseShards)
+    {
+        HYUN_APP_CountersSum(&Sharded, &CmdCounter, &ErrCounter);
+    }
+    else
+    {
+        for (CmdCounter = 0, i = 0; i < Tasks; i++)
+        {
+            CmdCounter += Packed.CmdCounter[i];
+        }
+    }
+
+    *Total = CmdCounter;
+
+    return Elapsed * 1e9 / ((double)Increments * Tasks);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32 Increments = 20000000;
+    uint32 Tasks;
+    uint32 Total;
+    double PackedNs;
+    double ShardNs;
+    int    Fail = 0;
+
+    if (argc > 1)
+    {
+        Increments = (uint32)strtoul(argv[1], NULL, 0);
+    }
+
+    printf("shard size %zu bytes, counters struct %zu bytes\n", sizeof(HYUN_APP_CounterShard_t),
+           sizeof(HYUN_APP_Counters_t));
+    printf("%-6s %14s %14s %8s\n", "tasks", "packed ns/inc", "sharded ns/inc", "speedup");
+
+    for (Tasks = 1; Tasks <= HYUN_APP_MAX_TASKS; Tasks++)
+    {
+        PackedNs = RunBench(false, Tasks, Increments, &Total);
+        if (Total != Tasks * Increments)
+        {
+            Fail = 1;
+        }
+
+        ShardNs = RunBench(true, Tasks, Increments, &Total);
+        if (Total != Tasks * Increments)
+        {
+            Fail = 1;
+        }
+
+        printf("%-6u %14.3f %14.3f %7.2fx\n", (unsigned)Tasks, PackedNs, ShardNs, PackedNs / ShardNs);
+    }
+
+    if (Fail)
+    {
+        printf("counter sum mismatch\n");
+    }
+
+    return Fail;
+}
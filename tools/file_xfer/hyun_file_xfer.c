@@ -0,0 +1,796 @@
+/*
+** hyun_file_xfer -- end-to-end test of the HYUN_APP chunked file downlink
+**
+** Runs the flight sliding window (hyun_app_filewin.c) and the flight wire
+** encoding of FILE_DATA_TLM / FILE_ACK against a ground receiver stand-in
+** over a simulated link, in simulated time. The sender side mirrors the
+** data task: every cycle it tops up the file class queue to
+** HYUN_APP_FILE_MAX_QUEUED chunks read with pread, then releases packets
+** against a token bucket at the link budget left by higher-priority
+** telemetry. The receiver writes chunks into the output file with
+** pwrite and answers with cumulative + selective acknowledgements.
+**
+** The link loses packets in both directions, delays and reorders them,
+** can go down completely for a while, and the sender can be reset in the
+** middle of a transfer; the ground then starts it again from the offset
+** it holds contiguously. The output file must match the input byte for
+** byte.
+**
+**   hyun_file_xfer run [options]
+**       One transfer. -f file (default: -s bytes of random data), -r link
+**       budget [bytes/s], -b background telemetry [bytes/s], -l / -u
+**       downlink / uplink loss [%], -D delay [ms], -j jitter [ms],
+**       -o at,len outage [s], -R at,len sender reset [s], -S seed,
+**       -d work directory.
+**
+**   hyun_file_xfer selftest [-d dir]
+**       A fixed set of link conditions, PASS when every file arrives
+**       intact and a resume from the end of a file ends the transfer.
+*/
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "hyun_app_filewin.h"
+#include "hyun_app_wire.h"
+#include "hyun_app_msgids.h"
+
+#define XFER_PATH_LEN  512
+#define XFER_TLM_HDR   16 /* cFE 7 telemetry header */
+#define XFER_CMD_HDR   8
+#define XFER_CHUNK_PKT (XFER_TLM_HDR + HYUN_APP_FileDataTlm_WIRE_SIZE)
+#define XFER_ACK_PKT   (XFER_CMD_HDR + HYUN_APP_FileAckCmd_WIRE_SIZE)
+#define XFER_CYCLE_US  10000 /* Data task cycle */
+#define XFER_TICK_US   1000
+#define XFER_CHANNEL   256 /* Packets on the way in one direction */
+#define XFER_ID        0x46494C45u
+
+/*
+** Command codes from the schema
+*/
+#define XFER_CC_ENUM(Name, CC, Type, Handler) XFER_##Name##_CC = (CC),
+enum
+{
+    HYUN_APP_CMD_DEFS(XFER_CC_ENUM)
+};
+
+typedef struct
+{
+    const char *Name;
+    uint32      Size;        /* Random file of this size unless a file is given */
+    uint32      Rate;        /* Link budget [bytes/s] */
+    uint32      Background;  /* Higher-priority telemetry [bytes/s] */
+    uint32      DownLossPct; /* Chunks lost */
+    uint32      UpLossPct;   /* Acknowledgements lost */
+    uint32      DelayMs;     /* One way */
+    uint32      JitterMs;    /* Added at random, reorders packets */
+    uint32      OutageAtS;
+    uint32      OutageS; /* Nothing gets through either way */
+    uint32      ResetAtS;
+    uint32      ResetS; /* Sender down, then resumed by the ground */
+    uint32      AckEvery;
+    uint32      AckIntervalMs;
+    uint32      LimitS;
+} Link_t;
+
+typedef struct
+{
+    uint64 DueUs;
+    uint32 Size;
+    uint8  Bytes[XFER_CHUNK_PKT];
+} Packet_t;
+
+typedef struct
+{
+    Packet_t Slot[XFER_CHANNEL];
+    uint32   Count;
+    uint32   Lost;
+} Channel_t;
+
+typedef struct
+{
+    bool               Active;
+    int                Fd;
+    uint32             FileSize;
+    HYUN_APP_FileWin_t Win;
+
+    Packet_t Queue[HYUN_APP_FILE_MAX_QUEUED];
+    uint32   Head;
+    uint32   Tail;
+    uint64   Credit; /* [byte-us] like the flight token bucket */
+    uint32   BurstBytes;
+
+    uint32 ChunkPackets; /* Chunk packets put on the link, all instances */
+    uint32 Resent;
+    uint32 Timeouts;
+    uint32 Starts;
+} Sender_t;
+
+typedef struct
+{
+    int    Fd;
+    bool   Known; /* FileSize learned from a chunk */
+    uint32 FileSize;
+    uint32 Chunks;
+    uint8 *Have;
+    uint32 AckSeq;
+    uint32 NewSinceAck;
+    bool   DupPending;
+    uint64 LastAckUs;
+
+    uint32 Received;
+    uint32 Duplicates;
+    uint32 Acks;
+} Receiver_t;
+
+typedef struct
+{
+    bool   Pass;
+    double Seconds;
+    double IdealSeconds;
+    double Efficiency; /* File bytes / chunk packet bytes put on the link */
+} Result_t;
+
+static uint32 RandState = 1;
+
+/*
+** xorshift32, so a seed gives the same run everywhere
+*/
+static uint32 Rand(void)
+{
+    RandState ^= RandState << 13;
+    RandState ^= RandState >> 17;
+    RandState ^= RandState << 5;
+    return RandState;
+}
+
+static bool Chance(uint32 Pct)
+{
+    return (Rand() % 100u) < Pct;
+}
+
+static void PutBe16(uint8 *Ptr, uint16 Value)
+{
+    Ptr[0] = (uint8)(Value >> 8);
+    Ptr[1] = (uint8)Value;
+}
+
+static uint16 GetBe16(const uint8 *Ptr)
+{
+    return (uint16)((Ptr[0] << 8) | Ptr[1]);
+}
+
+static bool LinkDown(const Link_t *Link, uint64 NowUs)
+{
+    uint64 AtUs = (uint64)Link->OutageAtS * 1000000u;
+
+    return Link->OutageS != 0 && NowUs >= AtUs && NowUs < AtUs + (uint64)Link->OutageS * 1000000u;
+}
+
+/*
+** Put a packet on the link: lost at random or during an outage,
+** otherwise delivered after the delay plus some jitter
+*/
+static void ChannelSend(Channel_t *Chan, const Link_t *Link, uint32 LossPct, const uint8 *Bytes, uint32 Size,
+                        uint64 NowUs)
+{
+    Packet_t *Pkt;
+
+    if (LinkDown(Link, NowUs) || Chance(LossPct) || Chan->Count == XFER_CHANNEL)
+    {
+        Chan->Lost++;
+        return;
+    }
+
+    Pkt        = &Chan->Slot[Chan->Count++];
+    Pkt->DueUs = NowUs + (uint64)Link->DelayMs * 1000u;
+    if (Link->JitterMs != 0)
+    {
+        Pkt->DueUs += (uint64)(Rand() % (Link->JitterMs * 1000u));
+    }
+    Pkt->Size = Size;
+    memcpy(Pkt->Bytes, Bytes, Size);
+}
+
+/*
+** Take one packet that is due, in any order
+*/
+static bool ChannelReceive(Channel_t *Chan, uint64 NowUs, Packet_t *Out)
+{
+    uint32 i;
+
+    for (i = 0; i < Chan->Count; i++)
+    {
+        if (Chan->Slot[i].DueUs <= NowUs)
+        {
+            *Out           = Chan->Slot[i];
+            Chan->Slot[i] = Chan->Slot[--Chan->Count];
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+** Flight side: HYUN_APP_FileStop, or a reset losing all state
+*/
+static void SenderStop(Sender_t *Snd)
+{
+    if (Snd->Active)
+    {
+        close(Snd->Fd);
+        Snd->Active = false;
+    }
+}
+
+/*
+** Flight side: HYUN_APP_FileStart
+*/
+static int SenderStart(Sender_t *Snd, const char *Path, uint32 Offset, uint32 Rate)
+{
+    struct stat Stat;
+    uint32      Chunks;
+
+    Snd->Fd = open(Path, O_RDONLY);
+    if (Snd->Fd < 0 || fstat(Snd->Fd, &Stat) != 0 || Offset % HYUN_APP_FILE_CHUNK_SIZE != 0 ||
+        Offset > (uint32)Stat.st_size)
+    {
+        perror(Path);
+        return -1;
+    }
+
+    Chunks = ((uint32)Stat.st_size + HYUN_APP_FILE_CHUNK_SIZE - 1) / HYUN_APP_FILE_CHUNK_SIZE;
+    if (Chunks == 0)
+    {
+        Chunks = 1;
+    }
+
+    Snd->Active   = true;
+    Snd->FileSize = (uint32)Stat.st_size;
+    Snd->Head     = 0;
+    Snd->Tail     = 0;
+    Snd->Credit   = 0;
+    Snd->Starts++;
+
+    HYUN_APP_FileWinInit(&Snd->Win, Chunks, Offset / HYUN_APP_FILE_CHUNK_SIZE, HYUN_APP_FILE_WINDOW,
+                         HYUN_APP_FileWinTimeout(HYUN_APP_FILE_WINDOW, XFER_CHUNK_PKT, Rate));
+
+    /* Resumed from the end of the file, nothing left to acknowledge */
+    if (HYUN_APP_FileWinDone(&Snd->Win))
+    {
+        SenderStop(Snd);
+    }
+    return 0;
+}
+
+/*
+** Flight side, one data task cycle: HYUN_APP_FileService, then
+** HYUN_APP_DownlinkService for the file class
+*/
+static int SenderCycle(Sender_t *Snd, const Link_t *Link, Channel_t *Down, uint64 NowUs, uint64 ElapsedUs)
+{
+    HYUN_APP_FileDataTlm_Payload_t Payload;
+    Packet_t                      *Pkt;
+    uint32                         Sent;
+    uint32                         Timeouts;
+    uint32                         Offset;
+    int32                          Seq;
+
+    while (Snd->Active && Snd->Head - Snd->Tail < HYUN_APP_FILE_MAX_QUEUED)
+    {
+        Sent     = Snd->Win.SentCounter;
+        Timeouts = Snd->Win.TimeoutCounter;
+
+        Seq = HYUN_APP_FileWinNext(&Snd->Win, NowUs);
+
+        Snd->Timeouts += Snd->Win.TimeoutCounter - Timeouts;
+        if (Seq == HYUN_APP_FILEWIN_NONE)
+        {
+            break;
+        }
+
+        memset(&Payload, 0, sizeof(Payload));
+        Offset             = (uint32)Seq * HYUN_APP_FILE_CHUNK_SIZE;
+        Payload.TransferId = XFER_ID;
+        Payload.Seq        = (uint32)Seq;
+        Payload.FileSize   = Snd->FileSize;
+        Payload.Length     = HYUN_APP_FILE_CHUNK_SIZE;
+        if (Snd->FileSize - Offset < HYUN_APP_FILE_CHUNK_SIZE)
+        {
+            Payload.Length = (uint16)(Snd->FileSize - Offset);
+        }
+        if ((uint32)Seq + 1 == Snd->Win.Chunks)
+        {
+            Payload.Flags |= HYUN_APP_FILE_FLAG_LAST;
+        }
+        if (Snd->Win.SentCounter == Sent)
+        {
+            Payload.Flags |= HYUN_APP_FILE_FLAG_RESENT;
+            Snd->Resent++;
+        }
+
+        if (pread(Snd->Fd, Payload.Data, Payload.Length, Offset) != (ssize_t)Payload.Length)
+        {
+            perror("pread");
+            return -1;
+        }
+
+        Pkt = &Snd->Queue[Snd->Head++ % HYUN_APP_FILE_MAX_QUEUED];
+        memset(Pkt->Bytes, 0, XFER_TLM_HDR);
+        PutBe16(&Pkt->Bytes[0], HYUN_APP_MID_FILE_DATA_TLM);
+        PutBe16(&Pkt->Bytes[4], XFER_CHUNK_PKT - 7);
+        HYUN_APP_FileDataTlmEncode(&Payload, &Pkt->Bytes[XFER_TLM_HDR]);
+        Pkt->Size = XFER_CHUNK_PKT;
+    }
+
+    /*
+    ** Critical and HK telemetry always go first, the file class gets
+    ** what they leave of the budget
+    */
+    Snd->Credit += ElapsedUs * (Link->Rate - Link->Background);
+    if (Snd->Credit > (uint64)Snd->BurstBytes * 1000000u)
+    {
+        Snd->Credit = (uint64)Snd->BurstBytes * 1000000u;
+    }
+
+    while (Snd->Head != Snd->Tail)
+    {
+        Pkt = &Snd->Queue[Snd->Tail % HYUN_APP_FILE_MAX_QUEUED];
+        if (Snd->Credit < (uint64)Pkt->Size * 1000000u)
+        {
+            break;
+        }
+        Snd->Credit -= (uint64)Pkt->Size * 1000000u;
+        Snd->Tail++;
+        Snd->ChunkPackets++;
+
+        ChannelSend(Down, Link, Link->DownLossPct, Pkt->Bytes, Pkt->Size, NowUs);
+    }
+
+    return 0;
+}
+
+/*
+** Ground side: store a chunk, note duplicates
+*/
+static int ReceiverChunk(Receiver_t *Rcv, const Packet_t *Pkt)
+{
+    HYUN_APP_FileDataTlm_Payload_t Payload;
+
+    if (Pkt->Size != XFER_CHUNK_PKT || GetBe16(&Pkt->Bytes[0]) != HYUN_APP_MID_FILE_DATA_TLM)
+    {
+        return 0;
+    }
+    HYUN_APP_FileDataTlmDecode(&Pkt->Bytes[XFER_TLM_HDR], &Payload);
+    if (Payload.TransferId != XFER_ID || Payload.Length > HYUN_APP_FILE_CHUNK_SIZE)
+    {
+        return 0;
+    }
+
+    if (!Rcv->Known)
+    {
+        Rcv->Known    = true;
+        Rcv->FileSize = Payload.FileSize;
+        Rcv->Chunks   = (Payload.FileSize + HYUN_APP_FILE_CHUNK_SIZE - 1) / HYUN_APP_FILE_CHUNK_SIZE;
+        Rcv->Chunks   = (Rcv->Chunks == 0) ? 1 : Rcv->Chunks;
+        Rcv->Have     = calloc(Rcv->Chunks, 1);
+        if (Rcv->Have == NULL || ftruncate(Rcv->Fd, Payload.FileSize) != 0)
+        {
+            perror("receiver");
+            return -1;
+        }
+    }
+
+    if (Payload.Seq >= Rcv->Chunks)
+    {
+        return 0;
+    }
+
+    if (Rcv->Have[Payload.Seq])
+    {
+        Rcv->Duplicates++;
+        Rcv->DupPending = true;
+        return 0;
+    }
+
+    if (pwrite(Rcv->Fd, Payload.Data, Payload.Length, (off_t)Payload.Seq * HYUN_APP_FILE_CHUNK_SIZE) !=
+        (ssize_t)Payload.Length)
+    {
+        perror("pwrite");
+        return -1;
+    }
+
+    Rcv->Have[Payload.Seq] = 1;
+    Rcv->Received++;
+    Rcv->NewSinceAck++;
+    while (Rcv->AckSeq < Rcv->Chunks && Rcv->Have[Rcv->AckSeq])
+    {
+        Rcv->AckSeq++;
+    }
+    return 0;
+}
+
+/*
+** Ground side: acknowledge every few chunks, after a quiet interval, and
+** at once on a duplicate, which is the sender probing
+*/
+static void ReceiverAck(Receiver_t *Rcv, const Link_t *Link, Channel_t *Up, uint64 NowUs)
+{
+    HYUN_APP_FileAckCmd_Payload_t Payload;
+    uint8                         Bytes[XFER_ACK_PKT];
+    uint32                        i;
+
+    if (Rcv->NewSinceAck < Link->AckEvery && !Rcv->DupPending &&
+        (Rcv->NewSinceAck == 0 || NowUs - Rcv->LastAckUs < (uint64)Link->AckIntervalMs * 1000u))
+    {
+        return;
+    }
+
+    Payload.TransferId = XFER_ID;
+    Payload.AckSeq     = Rcv->AckSeq;
+    Payload.SackMask   = 0;
+    for (i = 0; i < 32 && Rcv->AckSeq + 1 + i < Rcv->Chunks; i++)
+    {
+        if (Rcv->Have[Rcv->AckSeq + 1 + i])
+        {
+            Payload.SackMask |= 1u << i;
+        }
+    }
+
+    memset(Bytes, 0, XFER_CMD_HDR);
+    PutBe16(&Bytes[0], HYUN_APP_MID_GROUNDCMD_REQ);
+    PutBe16(&Bytes[4], XFER_ACK_PKT - 7);
+    Bytes[6] = XFER_FILE_ACK_CC;
+    HYUN_APP_FileAckCmdEncode(&Payload, &Bytes[XFER_CMD_HDR]);
+
+    ChannelSend(Up, Link, Link->UpLossPct, Bytes, sizeof(Bytes), NowUs);
+
+    Rcv->NewSinceAck = 0;
+    Rcv->DupPending  = false;
+    Rcv->LastAckUs   = NowUs;
+    Rcv->Acks++;
+}
+
+static int WriteRandomFile(const char *Path, uint32 Size)
+{
+    FILE  *Fp = fopen(Path, "wb");
+    uint32 i;
+
+    if (Fp == NULL)
+    {
+        perror(Path);
+        return -1;
+    }
+    for (i = 0; i < Size; i++)
+    {
+        fputc((int)(Rand() & 0xFF), Fp);
+    }
+    fclose(Fp);
+    return 0;
+}
+
+static bool SameFile(const char *PathA, const char *PathB)
+{
+    FILE *A    = fopen(PathA, "rb");
+    FILE *B    = fopen(PathB, "rb");
+    bool  Same = (A != NULL && B != NULL);
+    int   Ca   = 0;
+    int   Cb   = 0;
+
+    while (Same && Ca != EOF)
+    {
+        Ca   = fgetc(A);
+        Cb   = fgetc(B);
+        Same = (Ca == Cb);
+    }
+
+    if (A != NULL)
+    {
+        fclose(A);
+    }
+    if (B != NULL)
+    {
+        fclose(B);
+    }
+    return Same;
+}
+
+/*
+** One transfer from start to the last acknowledgement
+*/
+static int Transfer(const Link_t *Link, const char *InPath, const char *OutPath, Result_t *Res)
+{
+    static Channel_t Down;
+    static Channel_t Up;
+    Sender_t         Snd;
+    Receiver_t       Rcv;
+    Packet_t         Pkt;
+    HYUN_APP_FileAckCmd_Payload_t Ack;
+    uint64           NowUs       = 0;
+    uint64           LastCycleUs = 0;
+    uint64           ResetAtUs   = (uint64)Link->ResetAtS * 1000000u;
+    uint64           ResumeAtUs  = ResetAtUs + (uint64)Link->ResetS * 1000000u;
+    uint64           LimitUs     = (uint64)Link->LimitS * 1000000u;
+    int              Reset       = 0; /* 1 while the sender is down, 2 once resumed */
+    struct stat      Stat;
+
+    memset(&Down, 0, sizeof(Down));
+    memset(&Up, 0, sizeof(Up));
+    memset(&Snd, 0, sizeof(Snd));
+    memset(&Rcv, 0, sizeof(Rcv));
+    memset(Res, 0, sizeof(*Res));
+
+    Snd.BurstBytes = 2 * XFER_CHUNK_PKT;
+
+    Rcv.Fd = open(OutPath, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (Rcv.Fd < 0 || SenderStart(&Snd, InPath, 0, Link->Rate) != 0)
+    {
+        perror(OutPath);
+        return -1;
+    }
+
+    while (Snd.Active || Reset == 1)
+    {
+        if (NowUs >= LimitUs)
+        {
+            break;
+        }
+
+        if (Link->ResetS != 0 && Reset == 0 && NowUs >= ResetAtUs && Snd.Active)
+        {
+            /* Flight reset: the transfer and the queued chunks are gone */
+            SenderStop(&Snd);
+            Reset = 1;
+        }
+        if (Reset == 1 && NowUs >= ResumeAtUs)
+        {
+            /* The ground resumes from what it holds contiguously */
+            if (SenderStart(&Snd, InPath, Rcv.AckSeq * HYUN_APP_FILE_CHUNK_SIZE, Link->Rate) != 0)
+            {
+                return -1;
+            }
+            Reset = 2;
+        }
+
+        while (ChannelReceive(&Down, NowUs, &Pkt))
+        {
+            if (ReceiverChunk(&Rcv, &Pkt) != 0)
+            {
+                return -1;
+            }
+        }
+        if (Rcv.Known)
+        {
+            ReceiverAck(&Rcv, Link, &Up, NowUs);
+        }
+
+        while (ChannelReceive(&Up, NowUs, &Pkt))
+        {
+            if (!Snd.Active || Pkt.Bytes[6] != XFER_FILE_ACK_CC)
+            {
+                continue;
+            }
+            HYUN_APP_FileAckCmdDecode(&Pkt.Bytes[XFER_CMD_HDR], &Ack);
+            if (Ack.TransferId == XFER_ID)
+            {
+                HYUN_APP_FileWinAck(&Snd.Win, Ack.AckSeq, Ack.SackMask, NowUs);
+            }
+            if (HYUN_APP_FileWinDone(&Snd.Win))
+            {
+                SenderStop(&Snd);
+            }
+        }
+
+        if (NowUs - LastCycleUs >= XFER_CYCLE_US)
+        {
+            if (SenderCycle(&Snd, Link, &Down, NowUs, NowUs - LastCycleUs) != 0)
+            {
+                return -1;
+            }
+            LastCycleUs = NowUs;
+        }
+
+        NowUs += XFER_TICK_US;
+    }
+
+    close(Rcv.Fd);
+    free(Rcv.Have);
+    stat(InPath, &Stat);
+
+    Res->Seconds      = (double)NowUs * 1e-6;
+    Res->IdealSeconds = (double)Snd.Win.Chunks * XFER_CHUNK_PKT / (double)(Link->Rate - Link->Background);
+    Res->Efficiency   = (Snd.ChunkPackets != 0) ? (double)Stat.st_size / ((double)Snd.ChunkPackets * XFER_CHUNK_PKT) : 0;
+    Res->Pass         = !Snd.Active && HYUN_APP_FileWinDone(&Snd.Win) && SameFile(InPath, OutPath);
+
+    printf("%-16s %8lu B %7.1f s (ideal %6.1f) eff %5.1f%% sent %5lu resent %4lu timeouts %3lu dup %4lu "
+           "acks %4lu lost %4lu/%-4lu starts %lu  %s\n",
+           Link->Name, (unsigned long)Stat.st_size, Res->Seconds, Res->IdealSeconds, Res->Efficiency * 100.0,
+           (unsigned long)Snd.ChunkPackets, (unsigned long)Snd.Resent, (unsigned long)Snd.Timeouts,
+           (unsigned long)Rcv.Duplicates, (unsigned long)Rcv.Acks, (unsigned long)Down.Lost,
+           (unsigned long)Up.Lost, (unsigned long)Snd.Starts, Res->Pass ? "ok" : "FAIL");
+
+    return 0;
+}
+
+static const Link_t DefaultLink = {
+    "run", 100000, 2000, 500, 0, 0, 200, 0, 0, 0, 0, 0, 4, 250, 3600,
+};
+
+static int SelfTest(const char *Dir)
+{
+    /* Name, size, rate, background, loss down / up %, delay, jitter, outage, reset, ack every / ms, limit */
+    static const Link_t Cases[] = {
+        {"clean", 100000, 2000, 500, 0, 0, 200, 0, 0, 0, 0, 0, 4, 250, 3600},
+        {"lossy", 100000, 2000, 500, 10, 10, 200, 300, 0, 0, 0, 0, 4, 250, 3600},
+        {"heavy", 100000, 2000, 500, 30, 30, 200, 300, 0, 0, 0, 0, 4, 250, 3600},
+        {"outage", 100000, 2000, 500, 5, 5, 200, 100, 20, 30, 0, 0, 4, 250, 3600},
+        {"reset", 100000, 2000, 500, 5, 5, 200, 100, 0, 0, 30, 5, 4, 250, 3600},
+        {"outage+reset", 100000, 2000, 500, 5, 5, 200, 100, 20, 30, 35, 5, 4, 250, 3600},
+        {"long-delay", 100000, 2000, 500, 10, 10, 1000, 300, 0, 0, 0, 0, 4, 250, 3600},
+        {"fast", 1000000, 20000, 2000, 10, 10, 50, 10, 0, 0, 0, 0, 4, 250, 3600},
+        {"one-byte", 1, 2000, 500, 30, 30, 200, 0, 0, 0, 0, 0, 4, 250, 3600},
+        {"empty", 0, 2000, 500, 30, 30, 200, 0, 0, 0, 0, 0, 4, 250, 3600},
+        {"chunk-multiple", 192 * 50, 2000, 500, 10, 10, 200, 100, 0, 0, 0, 0, 4, 250, 3600},
+    };
+    char     InPath[XFER_PATH_LEN];
+    char     OutPath[XFER_PATH_LEN];
+    Result_t Res;
+    Sender_t Snd;
+    int      Fail = 0;
+    size_t   i;
+
+    snprintf(InPath, sizeof(InPath), "%s/hyun_file_xfer.in", Dir);
+    snprintf(OutPath, sizeof(OutPath), "%s/hyun_file_xfer.out", Dir);
+
+    for (i = 0; i < sizeof(Cases) / sizeof(Cases[0]); i++)
+    {
+        RandState = 0x9E3779B9u + (uint32)i;
+        if (WriteRandomFile(InPath, Cases[i].Size) != 0 || Transfer(&Cases[i], InPath, OutPath, &Res) != 0)
+        {
+            return 1;
+        }
+        Fail |= !Res.Pass;
+    }
+
+    /* A resume from the end of a chunk-aligned file is delivered at once */
+    memset(&Snd, 0, sizeof(Snd));
+    if (WriteRandomFile(InPath, 4 * HYUN_APP_FILE_CHUNK_SIZE) != 0 ||
+        SenderStart(&Snd, InPath, 4 * HYUN_APP_FILE_CHUNK_SIZE, DefaultLink.Rate) != 0)
+    {
+        return 1;
+    }
+    printf("%-16s %8lu B resumed at the end: %s\n", "resume-at-end", (unsigned long)(4 * HYUN_APP_FILE_CHUNK_SIZE),
+           Snd.Active ? "FAIL" : "ok");
+    Fail |= Snd.Active;
+    SenderStop(&Snd);
+
+    unlink(InPath);
+    unlink(OutPath);
+
+    printf("%s\n", Fail ? "FAIL" : "PASS");
+    return Fail;
+}
+
+static void ParsePair(const char *Text, uint32 *At, uint32 *Len)
+{
+    char *End;
+
+    *At  = (uint32)strtoul(Text, &End, 0);
+    *Len = (*End == ',') ? (uint32)strtoul(End + 1, NULL, 0) : 0;
+}
+
+static void Usage(void)
+{
+    fprintf(stderr, "usage: hyun_file_xfer run [-f file | -s bytes] [-r bytes/s] [-b bytes/s] [-l %%] [-u %%]\n"
+                    "                          [-D ms] [-j ms] [-o at,len] [-R at,len] [-S seed] [-d dir]\n"
+                    "       hyun_file_xfer selftest [-d dir]\n");
+}
+
+int main(int argc, char *argv[])
+{
+    Link_t      Link   = DefaultLink;
+    const char *Dir    = "/tmp";
+    const char *InFile = NULL;
+    char        InPath[XFER_PATH_LEN];
+    char        OutPath[XFER_PATH_LEN];
+    Result_t    Res;
+    const char *Mode;
+    int         Opt;
+
+    if (argc < 2)
+    {
+        Usage();
+        return 2;
+    }
+
+    Mode   = argv[1];
+    optind = 2;
+    while ((Opt = getopt(argc, argv, "f:s:r:b:l:u:D:j:o:R:S:d:")) != -1)
+    {
+        switch (Opt)
+        {
+            case 'f':
+                InFile = optarg;
+                break;
+            case 's':
+                Link.Size = (uint32)strtoul(optarg, NULL, 0);
+                break;
+            case 'r':
+                Link.Rate = (uint32)strtoul(optarg, NULL, 0);
+                break;
+            case 'b':
+                Link.Background = (uint32)strtoul(optarg, NULL, 0);
+                break;
+            case 'l':
+                Link.DownLossPct = (uint32)strtoul(optarg, NULL, 0);
+                break;
+            case 'u':
+                Link.UpLossPct = (uint32)strtoul(optarg, NULL, 0);
+                break;
+            case 'D':
+                Link.DelayMs = (uint32)strtoul(optarg, NULL, 0);
+                break;
+            case 'j':
+                Link.JitterMs = (uint32)strtoul(optarg, NULL, 0);
+                break;
+            case 'o':
+                ParsePair(optarg, &Link.OutageAtS, &Link.OutageS);
+                break;
+            case 'R':
+                ParsePair(optarg, &Link.ResetAtS, &Link.ResetS);
+                break;
+            case 'S':
+                /* xorshift never leaves a zero state */
+                RandState = (uint32)strtoul(optarg, NULL, 0);
+                if (RandState == 0)
+                {
+                    RandState = 1;
+                }
+                break;
+            case 'd':
+                Dir = optarg;
+                break;
+            default:
+                Usage();
+                return 2;
+        }
+    }
+
+    if (optind != argc)
+    {
+        Usage();
+        return 2;
+    }
+
+    if (strcmp(Mode, "selftest") == 0)
+    {
+        return SelfTest(Dir);
+    }
+    if (strcmp(Mode, "run") != 0 || Link.Rate <= Link.Background || Link.DownLossPct >= 100 ||
+        Link.UpLossPct >= 100)
+    {
+        Usage();
+        return 2;
+    }
+
+    snprintf(OutPath, sizeof(OutPath), "%s/hyun_file_xfer.out", Dir);
+    if (InFile == NULL)
+    {
+        snprintf(InPath, sizeof(InPath), "%s/hyun_file_xfer.in", Dir);
+        if (WriteRandomFile(InPath, Link.Size) != 0)
+        {
+            return 1;
+        }
+        InFile = InPath;
+    }
+
+    if (Transfer(&Link, InFile, OutPath, &Res) != 0)
+    {
+        return 1;
+    }
+    return Res.Pass ? 0 : 1;
+}
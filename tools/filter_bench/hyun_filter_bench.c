@@ -0,0 +1,288 @@
+/*
+** hyun_filter_bench -- check and time the HYUN_APP streaming filters
+**
+**   hyun_filter_bench [seconds of 1 kHz input per run]
+**
+** Every window size 1 .. HYUN_APP_FILTER_MAX_WINDOW is first checked
+** against a brute-force reference over the same random input: median
+** and min / max must match exactly, the moving average and EMA within
+** float round-off. The input is quantised so the window holds ties.
+**
+** Then a 1 kHz stream is fed in 50 sample batches, as the data task
+** would drain a cycle of it, and each filter is timed per sample, per
+** batch and for the worst batch. The last column is the share of one
+** core the filter takes at 1 kHz.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "hyun_app_filter.h"
+
+#define BENCH_RATE_HZ     1000
+#define BENCH_BATCH       50 /* Samples per 50 ms cycle at 1 kHz */
+#define BENCH_CHECK_COUNT 3000
+
+typedef enum
+{
+    FILT_MOVAVG,
+    FILT_EMA,
+    FILT_MEDIAN,
+    FILT_MINMAX,
+    FILT_COUNT
+} Filt_t;
+
+static const char *FiltName[FILT_COUNT] = {"moving average", "EMA", "median", "min/max"};
+
+typedef struct
+{
+    HYUN_APP_MovAvg_t MovAvg;
+    HYUN_APP_Ema_t    Ema;
+    HYUN_APP_Median_t Median;
+    HYUN_APP_MinMax_t MinMax;
+} Filters_t;
+
+static uint32 RandState = 0x9E3779B9u;
+
+static volatile float Sink;
+
+static uint32 Rand(void)
+{
+    RandState ^= RandState << 13;
+    RandState ^= RandState >> 17;
+    RandState ^= RandState << 5;
+    return RandState;
+}
+
+/*
+** Baro-like input: slow drift, noise and the odd spike, on a 0.25 m grid
+*/
+static float Sample(uint32 n)
+{
+    float X = 500.0f + 0.01f * (float)n + (float)(Rand() % 9) - 4.0f;
+
+    if (Rand() % 50 == 0)
+    {
+        X += (Rand() & 1) ? 80.0f : -80.0f;
+    }
+    return floorf(X * 4.0f) / 4.0f;
+}
+
+static double Now(void)
+{
+    struct timespec Ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &Ts);
+    return (double)Ts.tv_sec + (double)Ts.tv_nsec * 1e-9;
+}
+
+static int CompareFloat(const void *A, const void *B)
+{
+    float a = *(const float *)A;
+    float b = *(const float *)B;
+
+    return (a > b) - (a < b);
+}
+
+/*
+** Brute force over the last Count samples of History
+*/
+static void Reference(const float *History, uint32 Count, float *Median, float *Min, float *Max, double *Mean)
+{
+    float  Sorted[HYUN_APP_FILTER_MAX_WINDOW];
+    double Sum = 0.0;
+    uint32 i;
+
+    memcpy(Sorted, History, Count * sizeof(float));
+    qsort(Sorted, Count, sizeof(float), CompareFloat);
+
+    for (i = 0; i < Count; i++)
+    {
+        Sum += History[i];
+    }
+
+    *Median = (Count & 1) ? Sorted[Count / 2] : 0.5f * (Sorted[Count / 2 - 1] + Sorted[Count / 2]);
+    *Min    = Sorted[0];
+    *Max    = Sorted[Count - 1];
+    *Mean   = Sum / Count;
+}
+
+/*
+** Returns the number of mismatches for one window size
+*/
+static unsigned Check(uint16 Size)
+{
+    static float History[BENCH_CHECK_COUNT];
+    Filters_t    F;
+    unsigned     Errors = 0;
+    uint32       n;
+    uint32       Count;
+    float        Median;
+    float        Min;
+    float        Max;
+    float        Avg;
+    float        Ema;
+    double       RefMean;
+    double       RefEma = 0.0;
+    const float  Alpha  = 0.1f;
+    float        RefMedian;
+    float        RefMin;
+    float        RefMax;
+
+    HYUN_APP_MovAvgInit(&F.MovAvg, Size);
+    HYUN_APP_EmaInit(&F.Ema, Alpha);
+    HYUN_APP_MedianInit(&F.Median, Size);
+    HYUN_APP_MinMaxInit(&F.MinMax, Size);
+
+    for (n = 0; n < BENCH_CHECK_COUNT; n++)
+    {
+        History[n] = Sample(n);
+
+        Avg    = HYUN_APP_MovAvgUpdate(&F.MovAvg, History[n]);
+        Ema    = HYUN_APP_EmaUpdate(&F.Ema, History[n]);
+        Median = HYUN_APP_MedianUpdate(&F.Median, History[n]);
+        HYUN_APP_MinMaxUpdate(&F.MinMax, History[n]);
+        Min = HYUN_APP_MinMaxGetMin(&F.MinMax);
+        Max = HYUN_APP_MinMaxGetMax(&F.MinMax);
+
+        Count  = (n + 1 < Size) ? n + 1 : Size;
+        RefEma = (n == 0) ? History[0] : RefEma + Alpha * (History[n] - RefEma);
+        Reference(&History[n + 1 - Count], Count, &RefMedian, &RefMin, &RefMax, &RefMean);
+
+        if (Median != RefMedian || Min != RefMin || Max != RefMax || fabs(Avg - RefMean) > 1e-3 * fabs(RefMean) ||
+            fabs(Ema - RefEma) > 1e-3 * fabs(RefEma))
+        {
+            if (Errors == 0)
+            {
+                printf("window %u sample %u: median %g/%g min %g/%g max %g/%g mean %g/%g ema %g/%g\n",
+                       (unsigned)Size, (unsigned)n, Median, RefMedian, Min, RefMin, Max, RefMax, Avg, RefMean, Ema,
+                       RefEma);
+            }
+            Errors++;
+        }
+    }
+
+    return Errors;
+}
+
+/*
+** Feed Samples samples in batches, returns ns per sample and the worst
+** batch in ns
+*/
+static double Time(Filt_t Which, uint16 Size, const float *Input, uint32 Samples, double *WorstBatchNs)
+{
+    Filters_t F;
+    uint32    n;
+    uint32    b;
+    double    Start;
+    double    BatchStart;
+    double    Ns;
+
+    HYUN_APP_MovAvgInit(&F.MovAvg, Size);
+    HYUN_APP_EmaInit(&F.Ema, 0.1f);
+    HYUN_APP_MedianInit(&F.Median, Size);
+    HYUN_APP_MinMaxInit(&F.MinMax, Size);
+
+    *WorstBatchNs = 0.0;
+    Start         = Now();
+
+    for (n = 0; n < Samples; n += BENCH_BATCH)
+    {
+        BatchStart = Now();
+        for (b = n; b < n + BENCH_BATCH && b < Samples; b++)
+        {
+            switch (Which)
+            {
+                case FILT_MOVAVG:
+                    Sink = HYUN_APP_MovAvgUpdate(&F.MovAvg, Input[b]);
+                    break;
+                case FILT_EMA:
+                    Sink = HYUN_APP_EmaUpdate(&F.Ema, Input[b]);
+                    break;
+                case FILT_MEDIAN:
+                    Sink = HYUN_APP_MedianUpdate(&F.Median, Input[b]);
+                    break;
+                default:
+                    HYUN_APP_MinMaxUpdate(&F.MinMax, Input[b]);
+                    Sink = HYUN_APP_MinMaxGetMax(&F.MinMax) - HYUN_APP_MinMaxGetMin(&F.MinMax);
+                    break;
+            }
+        }
+        Ns = (Now() - BatchStart) * 1e9;
+        if (Ns > *WorstBatchNs)
+        {
+            *WorstBatchNs = Ns;
+        }
+    }
+
+    return (Now() - Start) * 1e9 / Samples;
+}
+
+int main(int argc, char *argv[])
+{
+    static const uint16 Sizes[] = {5, 16, 64};
+    uint32              Seconds = 600;
+    uint32              Samples;
+    float              *Input;
+    unsigned            Errors = 0;
+    unsigned            Bad;
+    uint16              Size;
+    size_t              s;
+    int                 f;
+    uint32              n;
+    double              Ns;
+    double              Worst;
+    char                Window[8];
+
+    if (argc > 1)
+    {
+        Seconds = (uint32)strtoul(argv[1], NULL, 0);
+    }
+    Samples = Seconds * BENCH_RATE_HZ;
+    Input   = malloc(Samples * sizeof(float));
+    if (Input == NULL || Samples == 0)
+    {
+        fprintf(stderr, "usage: hyun_filter_bench [seconds of 1 kHz input per run]\n");
+        return 2;
+    }
+
+    for (Size = 1; Size <= HYUN_APP_FILTER_MAX_WINDOW; Size++)
+    {
+        Bad = Check(Size);
+        if (Bad != 0)
+        {
+            printf("window %2u: %u mismatches against the reference\n", (unsigned)Size, Bad);
+        }
+        Errors += Bad;
+    }
+    printf("reference check, windows 1..%u x %u samples: %s\n\n", (unsigned)HYUN_APP_FILTER_MAX_WINDOW,
+           (unsigned)BENCH_CHECK_COUNT, Errors ? "FAILED" : "ok");
+
+    for (n = 0; n < Samples; n++)
+    {
+        Input[n] = Sample(n);
+    }
+
+    printf("%u s at %u Hz in %u sample batches\n", (unsigned)Seconds, (unsigned)BENCH_RATE_HZ, (unsigned)BENCH_BATCH);
+    printf("filter          window  ns/sample  ns/batch  worst batch ns  load at 1 kHz\n");
+    for (f = 0; f < FILT_COUNT; f++)
+    {
+        for (s = 0; s < sizeof(Sizes) / sizeof(Sizes[0]); s++)
+        {
+            if (f == FILT_EMA && s > 0)
+            {
+                break; /* No window */
+            }
+            Ns = Time((Filt_t)f, Sizes[s], Input, Samples, &Worst);
+            snprintf(Window, sizeof(Window), "%u", (unsigned)Sizes[s]);
+            printf("%-14s  %6s  %9.1f  %8.0f  %14.0f  %11.5f%%\n", FiltName[f], (f == FILT_EMA) ? "-" : Window, Ns,
+                   Ns * BENCH_BATCH, Worst, Ns * BENCH_RATE_HZ * 1e-9 * 100.0);
+        }
+    }
+
+    free(Input);
+    return Errors ? 1 : 0;
+}
@@ -0,0 +1,23 @@
+/*
+** Host build stand-in for the OSAL common_types.h, just enough for the
+** portable HYUN_APP modules to build outside cFS.
+*/
+#ifndef HYUN_TOOLS_COMMON_TYPES_H
+#define HYUN_TOOLS_COMMON_TYPES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int8_t   int8;
+typedef int16_t  int16;
+typedef int32_t  int32;
+typedef int64_t  int64;
+typedef uint8_t  uint8;
+typedef uint16_t uint16;
+typedef uint32_t uint32;
+typedef uint64_t uint64;
+
+#define CompileTimeAssert(Condition, Message) typedef char Message[(Condition) ? 1 : -1]
+
+#endif /* HYUN_TOOLS_COMMON_TYPES_H */
@@ -0,0 +1,625 @@
+/*
+** hyun_kf_replay -- cost and accuracy of the HYUN_APP altitude estimator
+**
+** Replays a flight profile through the flight Kalman filter
+** (hyun_app_kf.c) the way the data task feeds it: the sensor streams
+** are resampled onto the alignment tick (-t, with the -L latency bound,
+** both at the table defaults); every aligned frame steps through the IMU
+** samples since the previous tick and fuses the baro at the tick, a 50 ms
+** cycle of frames per batch. -t 0 steps the raw samples in time order
+** instead. The estimate taken at the end of every cycle is compared with
+** the true altitude and velocity.
+**
+** Without -f the profile is a built-in CANSAT flight (pad, boost, coast,
+** apogee, descent at 15 m/s then 5 m/s, landing) with IMU at 200 Hz and
+** baro at 20 Hz. With -f a recorded SIMP pressure profile is replayed
+** instead, in the CANSAT simulation format ("CMD,<TEAM_ID>,SIMP,<Pa>"
+** or a bare pressure, '#' comments), one sample per -p ms. Its altitude,
+** linearly interpolated, is the truth and there is no IMU stream.
+**
+**   hyun_kf_replay [-f profile] [-p period ms] [-t tick ms] [-L latency ms]
+**                  [-n baro sigma m] [-a accel sigma m/s^2] [-r timing runs]
+**                  [-S seed]
+**
+** Both estimator models are run. The result is reported as ns per
+** update and per cycle batch, and as RMS / max altitude and velocity
+** error after the first 2 s. On the built-in flight, exits 1 if an
+** estimate is no better than the raw barometer.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "hyun_app_kf.h"
+
+#define REPLAY_CYCLE_US   50000u   /* Data task cycle */
+#define REPLAY_IMU_US     5000u    /* 200 Hz */
+#define REPLAY_BARO_US    50000u   /* 20 Hz */
+#define REPLAY_SETTLE_US  2000000u /* Errors are not counted before this */
+#define REPLAY_MAX_SAMPLE 65536u
+
+#define REPLAY_TICK_MS    100 /* Table default AlignPeriodMs */
+#define REPLAY_LATENCY_MS 100 /* Table default AlignMaxLatencyMs */
+
+/*
+** Same standard atmosphere as HYUN_APP_PressureToAltitude
+*/
+#define REPLAY_ISA_P0       101325.0
+#define REPLAY_ISA_H0       44330.77
+#define REPLAY_ISA_EXPONENT 0.190263
+
+typedef struct
+{
+    uint64 TimeUs;
+    uint8  Mask; /* HYUN_APP_KF_MEAS_* */
+    float  Altitude;
+    float  VertAccel;
+} Obs_t;
+
+/*
+** Truth, one point per profile step
+*/
+typedef struct
+{
+    uint32  Count;
+    uint32  StepUs;
+    double *Alt;
+    double *Vel;
+    double *Accel;
+    bool    HasImu;
+} Truth_t;
+
+typedef struct
+{
+    double Ns;      /* Per update */
+    double BatchNs; /* Per cycle */
+    double WorstBatchNs;
+    double AltRms;
+    double AltMax;
+    double VelRms;
+    double VelMax;
+} Result_t;
+
+static uint32 RandState = 0x9E3779B9u;
+
+static uint32 Rand(void)
+{
+    RandState ^= RandState << 13;
+    RandState ^= RandState >> 17;
+    RandState ^= RandState << 5;
+    return RandState;
+}
+
+/*
+** Box-Muller, one normal deviate per call
+*/
+static double Gauss(double Sigma)
+{
+    double U1 = ((double)Rand() + 1.0) / 4294967297.0;
+    double U2 = ((double)Rand() + 1.0) / 4294967297.0;
+
+    return Sigma * sqrt(-2.0 * log(U1)) * cos(2.0 * M_PI * U2);
+}
+
+static double Now(void)
+{
+    struct timespec Ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &Ts);
+    return (double)Ts.tv_sec + (double)Ts.tv_nsec * 1e-9;
+}
+
+static bool TruthAlloc(Truth_t *T, uint32 Count, uint32 StepUs)
+{
+    T->Count  = Count;
+    T->StepUs = StepUs;
+    T->Alt    = calloc(Count, sizeof(double));
+    T->Vel    = calloc(Count, sizeof(double));
+    T->Accel  = calloc(Count, sizeof(double));
+    return T->Alt != NULL && T->Vel != NULL && T->Accel != NULL;
+}
+
+/*
+** Built-in flight at the IMU rate
+*/
+static bool TruthFlight(Truth_t *T)
+{
+    const double Dt    = REPLAY_IMU_US * 1e-6;
+    double       Alt   = 0.0;
+    double       Vel   = 0.0;
+    double       Accel = 0.0;
+    double       t;
+    uint32       i;
+    bool         Apogee = false;
+
+    if (!TruthAlloc(T, (uint32)(90.0 / Dt), REPLAY_IMU_US))
+    {
+        return false;
+    }
+    T->HasImu = true;
+
+    for (i = 0; i < T->Count; i++)
+    {
+        t = i * Dt;
+
+        if (t < 5.0)
+        {
+            Accel = 0.0; /* Pad */
+        }
+        else if (t < 7.0)
+        {
+            Accel = 50.0; /* Boost */
+        }
+        else if (!Apogee)
+        {
+            Accel  = -9.81; /* Coast */
+            Apogee = (Vel <= 0.0);
+        }
+        else if (Alt <= 0.0)
+        {
+            Accel = -Vel / Dt; /* Touchdown stops the payload within one IMU sample */
+        }
+        else if (Vel > -15.0 && Alt > 100.0)
+        {
+            Accel = -9.81; /* Falling until the parachute is loaded */
+        }
+        else if (Alt > 100.0)
+        {
+            Accel = 0.0;
+        }
+        else
+        {
+            Accel = (Vel < -5.0) ? 10.0 : 0.0; /* Second parachute */
+        }
+
+        T->Alt[i]   = Alt;
+        T->Vel[i]   = Vel;
+        T->Accel[i] = Accel;
+
+        Alt += Vel * Dt + 0.5 * Accel * Dt * Dt;
+        Vel += Accel * Dt;
+    }
+
+    return true;
+}
+
+/*
+** Recorded SIMP profile, one pressure per line
+*/
+static bool TruthProfile(Truth_t *T, const char *Path, uint32 PeriodMs)
+{
+    static double Alt[REPLAY_MAX_SAMPLE];
+    char          Line[128];
+    const char   *Field;
+    FILE         *Fp;
+    uint32        Count = 0;
+    uint32        i;
+    double        Pa;
+
+    Fp = fopen(Path, "r");
+    if (Fp == NULL)
+    {
+        perror(Path);
+        return false;
+    }
+
+    while (Count < REPLAY_MAX_SAMPLE && fgets(Line, sizeof(Line), Fp) != NULL)
+    {
+        if (Line[0] == '#' || Line[0] == '\n' || Line[0] == '\r')
+        {
+            continue;
+        }
+        Field = strrchr(Line, ',');
+        Field = (Field != NULL) ? Field + 1 : Line;
+        Pa    = strtod(Field, NULL);
+        if (Pa <= 0.0)
+        {
+            continue;
+        }
+        Alt[Count++] = REPLAY_ISA_H0 * (1.0 - pow(Pa / REPLAY_ISA_P0, REPLAY_ISA_EXPONENT));
+    }
+    fclose(Fp);
+
+    if (Count < 2 || !TruthAlloc(T, Count, PeriodMs * 1000u))
+    {
+        fprintf(stderr, "%s: fewer than 2 pressure samples\n", Path);
+        return false;
+    }
+    T->HasImu = false;
+
+    for (i = 0; i < Count; i++)
+    {
+        T->Alt[i] = Alt[i];
+        T->Vel[i] = (i + 1 < Count) ? (Alt[i + 1] - Alt[i]) / (PeriodMs * 1e-3) : T->Vel[i - 1];
+    }
+
+    return true;
+}
+
+static double TruthAt(const Truth_t *T, const double *Series, uint64 TimeUs)
+{
+    uint32 i    = (uint32)(TimeUs / T->StepUs);
+    double Frac = (double)(TimeUs % T->StepUs) / T->StepUs;
+
+    if (i + 1 >= T->Count)
+    {
+        return Series[T->Count - 1];
+    }
+    if (Series == T->Vel && !T->HasImu)
+    {
+        return Series[i]; /* Piecewise linear altitude: velocity is a step */
+    }
+    return Series[i] + (Series[i + 1] - Series[i]) * Frac;
+}
+
+/*
+** Noisy measurements merged in time order, IMU before baro on a tie
+*/
+static uint32 Observe(const Truth_t *T, double BaroSigma, double AccelSigma, Obs_t **ObsOut, double *BaroRms)
+{
+    uint64 EndUs    = (uint64)(T->Count - 1) * T->StepUs;
+    uint32 Max      = (uint32)(EndUs / REPLAY_IMU_US + EndUs / REPLAY_BARO_US + 2);
+    uint64 BaroStep = T->HasImu ? REPLAY_BARO_US : T->StepUs;
+    Obs_t *Obs      = calloc(Max, sizeof(Obs_t));
+    uint64 ImuUs    = 0;
+    uint64 BaroUs   = 0;
+    uint32 n        = 0;
+    uint32 Baros    = 0;
+    double Err;
+    double Sum = 0.0;
+
+    while (Obs != NULL && n < Max && (ImuUs <= EndUs || BaroUs <= EndUs))
+    {
+        if (T->HasImu && ImuUs <= EndUs && ImuUs <= BaroUs)
+        {
+            Obs[n].TimeUs    = ImuUs;
+            Obs[n].Mask      = HYUN_APP_KF_MEAS_ACCEL;
+            Obs[n].VertAccel = (float)(TruthAt(T, T->Accel, ImuUs) + Gauss(AccelSigma));
+            ImuUs += REPLAY_IMU_US;
+        }
+        else if (BaroUs <= EndUs)
+        {
+            Err              = Gauss(BaroSigma);
+            Obs[n].TimeUs    = BaroUs;
+            Obs[n].Mask      = HYUN_APP_KF_MEAS_BARO;
+            Obs[n].Altitude  = (float)(TruthAt(T, T->Alt, BaroUs) + Err);
+            BaroUs += BaroStep;
+            Sum += Err * Err;
+            Baros++;
+        }
+        else
+        {
+            break;
+        }
+        n++;
+    }
+
+    *ObsOut  = Obs;
+    *BaroRms = (Baros != 0) ? sqrt(Sum / Baros) : 0.0;
+    return n;
+}
+
+/*
+** Next sample of one stream at or after TimeUs, from *Idx on. False if
+** the stream has none.
+*/
+static bool NextSample(const Obs_t *Raw, uint32 Count, uint8 Mask, uint32 *Idx, uint64 TimeUs)
+{
+    while (*Idx < Count && ((Raw[*Idx].Mask & Mask) == 0 || Raw[*Idx].TimeUs < TimeUs))
+    {
+        (*Idx)++;
+    }
+    return *Idx < Count;
+}
+
+/*
+** Latest sample of one stream before Idx, false if none
+*/
+static bool PrevSample(const Obs_t *Raw, uint8 Mask, uint32 Idx, uint32 *Prev)
+{
+    while (Idx > 0)
+    {
+        Idx--;
+        if (Raw[Idx].Mask & Mask)
+        {
+            *Prev = Idx;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+** Resample the raw streams onto a TickUs grid as HYUN_APP_AlignProcess
+** does. A tick goes out once every fast stream has a sample at or after
+** it, or MaxLatencyUs after the tick. As in HYUN_APP_AlignEstimate, each
+** tick steps the estimator through every IMU sample since the previous
+** tick, then fuses the interpolated baro at the tick; a baro that had
+** not reached the tick by then is held and left out.
+*/
+static uint32 Align(const Obs_t *Raw, uint32 Count, bool HasImu, uint32 TickUs, uint32 MaxLatencyUs, Obs_t **Out)
+{
+    uint64 EndUs    = Raw[Count - 1].TimeUs;
+    uint32 Max      = (uint32)(EndUs / TickUs + 1) + Count;
+    Obs_t *Obs      = calloc(Max, sizeof(Obs_t));
+    uint32 BaroNext = 0;
+    uint32 ImuNext  = 0;
+    uint32 ImuStep  = 0;
+    uint32 Lo;
+    uint32 n = 0;
+    uint64 TickAt;
+    uint64 EmitUs;
+    bool   HaveBaro;
+    bool   HaveImu;
+    double Frac;
+
+    for (TickAt = TickUs; Obs != NULL && n < Max && TickAt <= EndUs; TickAt += TickUs)
+    {
+        HaveBaro = NextSample(Raw, Count, HYUN_APP_KF_MEAS_BARO, &BaroNext, TickAt);
+        HaveImu  = HasImu && NextSample(Raw, Count, HYUN_APP_KF_MEAS_ACCEL, &ImuNext, TickAt);
+
+        EmitUs = TickAt + MaxLatencyUs;
+        if (HaveBaro && (!HasImu || HaveImu))
+        {
+            EmitUs = Raw[BaroNext].TimeUs;
+            if (HasImu && Raw[ImuNext].TimeUs > EmitUs)
+            {
+                EmitUs = Raw[ImuNext].TimeUs;
+            }
+            if (EmitUs > TickAt + MaxLatencyUs)
+            {
+                EmitUs = TickAt + MaxLatencyUs;
+            }
+        }
+
+        for (; HasImu && ImuStep < Count && Raw[ImuStep].TimeUs <= TickAt && n < Max; ImuStep++)
+        {
+            if (Raw[ImuStep].Mask & HYUN_APP_KF_MEAS_ACCEL)
+            {
+                Obs[n++] = Raw[ImuStep];
+            }
+        }
+
+        Obs[n].TimeUs = TickAt;
+        Obs[n].Mask   = 0;
+
+        if (HaveBaro && Raw[BaroNext].TimeUs <= EmitUs)
+        {
+            Obs[n].Mask |= HYUN_APP_KF_MEAS_BARO;
+            Obs[n].Altitude = Raw[BaroNext].Altitude;
+            if (Raw[BaroNext].TimeUs > TickAt && PrevSample(Raw, HYUN_APP_KF_MEAS_BARO, BaroNext, &Lo))
+            {
+                Frac = (double)(TickAt - Raw[Lo].TimeUs) / (double)(Raw[BaroNext].TimeUs - Raw[Lo].TimeUs);
+                Obs[n].Altitude = (float)(Raw[Lo].Altitude + (Raw[BaroNext].Altitude - Raw[Lo].Altitude) * Frac);
+            }
+        }
+        n++;
+    }
+
+    *Out = Obs;
+    return n;
+}
+
+/*
+** One pass over the profile, a batch per cycle. With T the estimate is
+** scored at the end of every cycle, otherwise each batch is timed.
+*/
+static void Run(const Obs_t *Obs, uint32 Count, uint8 NumStates, const Truth_t *T, Result_t *Res)
+{
+    HYUN_APP_KF_t Kf;
+    uint32        i = 0;
+    uint32        First;
+    uint32        Scored = 0;
+    uint64        CycleEndUs;
+    double        Start;
+    double        Ns;
+    double        AltErr;
+    double        VelErr;
+    double        AltSum = 0.0;
+    double        VelSum = 0.0;
+
+    HYUN_APP_KF_Init(&Kf, NumStates);
+
+    for (CycleEndUs = REPLAY_CYCLE_US; i < Count; CycleEndUs += REPLAY_CYCLE_US)
+    {
+        First = i;
+        Start = Now();
+        for (; i < Count && Obs[i].TimeUs < CycleEndUs; i++)
+        {
+            HYUN_APP_KF_Step(&Kf, Obs[i].TimeUs, Obs[i].Mask, Obs[i].Altitude, Obs[i].VertAccel);
+        }
+
+        if (T == NULL)
+        {
+            Ns = (Now() - Start) * 1e9;
+            if (i != First && Ns > Res->WorstBatchNs)
+            {
+                Res->WorstBatchNs = Ns;
+            }
+            continue;
+        }
+
+        if (i == First || CycleEndUs < REPLAY_SETTLE_US)
+        {
+            continue;
+        }
+
+        /* The estimate published for the cycle is at its newest sample */
+        AltErr = fabs(Kf.X[HYUN_APP_KF_STATE_ALT] - TruthAt(T, T->Alt, Kf.LastTimeUs));
+        VelErr = fabs(Kf.X[HYUN_APP_KF_STATE_VEL] - TruthAt(T, T->Vel, Kf.LastTimeUs));
+        AltSum += AltErr * AltErr;
+        VelSum += VelErr * VelErr;
+        Res->AltMax = (AltErr > Res->AltMax) ? AltErr : Res->AltMax;
+        Res->VelMax = (VelErr > Res->VelMax) ? VelErr : Res->VelMax;
+        Scored++;
+    }
+
+    if (Scored != 0)
+    {
+        Res->AltRms = sqrt(AltSum / Scored);
+        Res->VelRms = sqrt(VelSum / Scored);
+    }
+}
+
+static void Bench(const Obs_t *Obs, uint32 Count, uint8 NumStates, uint32 Runs, Result_t *Res)
+{
+    HYUN_APP_KF_t Kf;
+    uint32        r;
+    uint32        i;
+    double        Start;
+    double        Elapsed;
+    uint64        Cycles = (Obs[Count - 1].TimeUs / REPLAY_CYCLE_US) + 1;
+
+    Start = Now();
+    for (r = 0; r < Runs; r++)
+    {
+        HYUN_APP_KF_Init(&Kf, NumStates);
+        for (i = 0; i < Count; i++)
+        {
+            HYUN_APP_KF_Step(&Kf, Obs[i].TimeUs, Obs[i].Mask, Obs[i].Altitude, Obs[i].VertAccel);
+        }
+        if (Kf.X[0] != Kf.X[0])
+        {
+            printf("estimate diverged\n");
+        }
+    }
+    Elapsed = Now() - Start;
+
+    Res->Ns      = Elapsed * 1e9 / ((double)Count * Runs);
+    Res->BatchNs = Elapsed * 1e9 / ((double)Cycles * Runs);
+
+    /* Worst single cycle, timed batch by batch */
+    Run(Obs, Count, NumStates, NULL, Res);
+}
+
+static void Usage(void)
+{
+    fprintf(stderr, "usage: hyun_kf_replay [-f profile] [-p period ms] [-t tick ms] [-L latency ms]\n"
+                    "                      [-n baro sigma m] [-a accel sigma m/s^2] [-r timing runs] [-S seed]\n");
+}
+
+int main(int argc, char *argv[])
+{
+    const char *Path       = NULL;
+    uint32      PeriodMs   = 1000;
+    double      BaroSigma  = 0.5;
+    double      AccelSigma = 0.7;
+    uint32      Runs       = 200;
+    uint32      TickMs     = REPLAY_TICK_MS;
+    uint32      LatencyMs  = REPLAY_LATENCY_MS;
+    Truth_t     Truth;
+    Obs_t      *Raw;
+    Obs_t      *Obs;
+    uint32      RawCount;
+    uint32      Count;
+    double      BaroRms;
+    Result_t    Res;
+    uint8       NumStates;
+    int         Opt;
+    int         Status = 0;
+
+    while ((Opt = getopt(argc, argv, "f:p:t:L:n:a:r:S:")) != -1)
+    {
+        switch (Opt)
+        {
+            case 'f':
+                Path = optarg;
+                break;
+            case 'p':
+                PeriodMs = (uint32)strtoul(optarg, NULL, 0);
+                break;
+            case 't':
+                TickMs = (uint32)strtoul(optarg, NULL, 0);
+                break;
+            case 'L':
+                LatencyMs = (uint32)strtoul(optarg, NULL, 0);
+                break;
+            case 'n':
+                BaroSigma = strtod(optarg, NULL);
+                break;
+            case 'a':
+                AccelSigma = strtod(optarg, NULL);
+                break;
+            case 'r':
+                Runs = (uint32)strtoul(optarg, NULL, 0);
+                break;
+            case 'S':
+                /* xorshift never leaves a zero state */
+                RandState = (uint32)strtoul(optarg, NULL, 0);
+                if (RandState == 0)
+                {
+                    RandState = 1;
+                }
+                break;
+            default:
+                Usage();
+                return 2;
+        }
+    }
+    if (PeriodMs == 0 || Runs == 0)
+    {
+        Usage();
+        return 2;
+    }
+
+    if (Path != NULL ? !TruthProfile(&Truth, Path, PeriodMs) : !TruthFlight(&Truth))
+    {
+        return 1;
+    }
+
+    RawCount = Observe(&Truth, BaroSigma, AccelSigma, &Raw, &BaroRms);
+    if (Raw == NULL || RawCount == 0)
+    {
+        fprintf(stderr, "no observations\n");
+        return 1;
+    }
+
+    Obs   = Raw;
+    Count = RawCount;
+    if (TickMs != 0)
+    {
+        Count = Align(Raw, RawCount, Truth.HasImu, TickMs * 1000u, LatencyMs * 1000u, &Obs);
+        if (Obs == NULL || Count == 0)
+        {
+            fprintf(stderr, "no aligned frames\n");
+            return 1;
+        }
+    }
+
+    printf("profile %s: %.1f s, %u samples, %s, raw baro error %.2f m RMS\n",
+           Path != NULL ? Path : "built-in flight", (Truth.Count - 1) * Truth.StepUs * 1e-6, (unsigned)RawCount,
+           Truth.HasImu ? "IMU 200 Hz + baro 20 Hz" : "baro only", BaroRms);
+    if (TickMs != 0)
+    {
+        printf("aligned onto a %u ms tick, %u ms latency bound: %u steps\n", (unsigned)TickMs, (unsigned)LatencyMs,
+               (unsigned)Count);
+    }
+    printf("\n");
+    printf("model     ns/update  ns/cycle  worst cycle ns   alt RMS  alt max   vel RMS  vel max\n");
+
+    for (NumStates = 2; NumStates <= 3; NumStates++)
+    {
+        memset(&Res, 0, sizeof(Res));
+        Run(Obs, Count, NumStates, &Truth, &Res);
+        Bench(Obs, Count, NumStates, Runs, &Res);
+
+        printf("%u-state   %9.1f  %8.1f  %14.0f   %5.2f m  %5.2f m  %5.2f m/s %5.2f m/s %s\n", NumStates, Res.Ns,
+               Res.BatchNs, Res.WorstBatchNs, Res.AltRms, Res.AltMax, Res.VelRms, Res.VelMax,
+               (Path != NULL || Res.AltRms < BaroRms) ? "" : "WORSE THAN RAW");
+        if (Path == NULL && Res.AltRms >= BaroRms)
+        {
+            Status = 1;
+        }
+    }
+
+    if (Obs != Raw)
+    {
+        free(Obs);
+    }
+    free(Raw);
+    return Status;
+}
@@ -0,0 +1,351 @@
+/*
+** hyun_nmea_fuzz -- correctness, fuzzing and throughput of the HYUN_APP
+** NMEA parser
+**
+** Builds the flight parser (hyun_app_nmea.c) as is. The Makefile builds
+** this file twice: hyun_nmea_fuzz with ASan / UBSan for the split and
+** fuzz modes, and hyun_nmea_bench without sanitizers for timing.
+**
+**   split
+**       A GGA + RMC stream is fed cut at every pair of offsets, the way
+**       sentences straddle SB packets. Both fixes must come out every
+**       time, with the coordinates, altitude and satellites expected.
+**
+**   fuzz [iterations] [seed]
+**       Random bytes, and valid sentences with bytes flipped, dropped,
+**       duplicated or truncated, fed in random chunk sizes. Every call
+**       must consume at least one byte, counters may only grow and every
+**       fix must come from a sentence that passed its checksum.
+**
+**   bench [seconds]
+**       Sentences per second on a stream of valid GGA / RMC sentences
+**       fed in 64 byte packets.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "hyun_app_nmea.h"
+
+#define FUZZ_MAX_BUFFER 1024
+#define BENCH_PACKET    64 /* Payload of one raw GPS SB packet */
+
+static const char *const Bodies[] = {
+    "GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,",
+    "GPRMC,123520,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W",
+    "GNGGA,001043.00,3723.2475,S,12158.3416,W,2,12,0.7,-12.5,M,-25.0,M,,",
+    "GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00",
+};
+
+static uint32 RandState = 0x9E3779B9u;
+
+static volatile int32 Sink;
+
+static uint32 Rand(void)
+{
+    RandState ^= RandState << 13;
+    RandState ^= RandState >> 17;
+    RandState ^= RandState << 5;
+    return RandState;
+}
+
+static double Now(void)
+{
+    struct timespec Ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &Ts);
+    return (double)Ts.tv_sec + (double)Ts.tv_nsec * 1e-9;
+}
+
+/*
+** "$<Body>*hh\r\n" into Out, returns its length
+*/
+static size_t Sentence(const char *Body, char *Out, size_t Size)
+{
+    uint8       Checksum = 0;
+    const char *p;
+
+    for (p = Body; *p != '\0'; p++)
+    {
+        Checksum ^= (uint8)*p;
+    }
+    return (size_t)snprintf(Out, Size, "$%s*%02X\r\n", Body, Checksum);
+}
+
+/*
+** Feed Len bytes, collecting every fix. Returns false if the parser
+** breaks one of its contracts.
+*/
+static bool Feed(HYUN_APP_NmeaParser_t *Parser, const uint8 *Data, size_t Len, HYUN_APP_NmeaFix_t *Fixes,
+                 uint32 MaxFixes, uint32 *FixCount)
+{
+    HYUN_APP_NmeaFix_t Fix;
+    bool               FixReady;
+    size_t             Used;
+    uint32             Sentences;
+
+    while (Len > 0)
+    {
+        Sentences = Parser->SentenceCounter;
+        Used      = HYUN_APP_NmeaFeed(Parser, Data, Len, &Fix, &FixReady);
+
+        if (Used == 0 || Used > Len)
+        {
+            printf("feed consumed %zu of %zu bytes\n", Used, Len);
+            return false;
+        }
+        if (FixReady != (Parser->SentenceCounter == Sentences + 1) || (!FixReady && Used != Len))
+        {
+            printf("fix reported without a sentence, or input left over without a fix\n");
+            return false;
+        }
+        if (FixReady)
+        {
+            if (Fix.Type != HYUN_APP_NMEA_TYPE_GGA && Fix.Type != HYUN_APP_NMEA_TYPE_RMC)
+            {
+                printf("fix of unknown type %u\n", (unsigned)Fix.Type);
+                return false;
+            }
+            if (*FixCount < MaxFixes)
+            {
+                Fixes[*FixCount] = Fix;
+            }
+            (*FixCount)++;
+            Sink = Fix.LatitudeE7 ^ Fix.LongitudeE7;
+        }
+
+        Data += Used;
+        Len -= Used;
+    }
+
+    return true;
+}
+
+static bool FixIs(const HYUN_APP_NmeaFix_t *Fix, uint8 Type, int32 Lat, int32 Lon, float Alt, uint8 Sats)
+{
+    return Fix->Type == Type && Fix->LatitudeE7 == Lat && Fix->LongitudeE7 == Lon && Fix->Altitude == Alt &&
+           Fix->Satellites == Sats && Fix->FixValid;
+}
+
+/*
+** 4807.038 N = 48 + 7.038 / 60 deg, 01131.000 E = 11 + 31 / 60 deg
+*/
+static int Split(void)
+{
+    HYUN_APP_NmeaParser_t Parser;
+    HYUN_APP_NmeaFix_t    Fixes[2];
+    char                  Stream[256];
+    size_t                Len;
+    size_t                a;
+    size_t                b;
+    uint32                Count;
+    unsigned              Bad   = 0;
+    unsigned              Cases = 0;
+    bool                  Ok;
+
+    Len = Sentence(Bodies[0], Stream, sizeof(Stream));
+    Len += Sentence(Bodies[1], &Stream[Len], sizeof(Stream) - Len);
+
+    for (a = 0; a <= Len; a++)
+    {
+        for (b = a; b <= Len; b++)
+        {
+            HYUN_APP_NmeaInit(&Parser);
+            Count = 0;
+
+            Ok = Feed(&Parser, (const uint8 *)Stream, a, Fixes, 2, &Count) &&
+                 Feed(&Parser, (const uint8 *)&Stream[a], b - a, Fixes, 2, &Count) &&
+                 Feed(&Parser, (const uint8 *)&Stream[b], Len - b, Fixes, 2, &Count);
+
+            Ok = Ok && Count == 2 && FixIs(&Fixes[0], HYUN_APP_NMEA_TYPE_GGA, 481173000, 115166666, 545.4f, 8) &&
+                 FixIs(&Fixes[1], HYUN_APP_NMEA_TYPE_RMC, 481173000, 115166666, 545.4f, 8) &&
+                 Parser.ChecksumErrCounter == 0 && Parser.FormatErrCounter == 0;
+            if (!Ok && Bad++ == 0)
+            {
+                printf("split at %zu,%zu: %u fixes\n", a, b, (unsigned)Count);
+            }
+            Cases++;
+        }
+    }
+
+    printf("split: %u cuts of a %zu byte GGA+RMC stream: %s\n", Cases, Len, Bad ? "FAILED" : "ok");
+    return Bad ? 1 : 0;
+}
+
+/*
+** One fuzz input: noise, or valid sentences with damage
+*/
+static size_t FuzzInput(uint8 *Buf, size_t Size)
+{
+    size_t Len = 0;
+    size_t n;
+    size_t i;
+    size_t Edits;
+
+    if (Rand() % 4 == 0)
+    {
+        n = Rand() % Size;
+        for (i = 0; i < n; i++)
+        {
+            /* Biased towards the characters the parser acts on */
+            Buf[i] = (Rand() & 1) ? (uint8)Rand() : (uint8)"$,*.-0123456789ABCDEFGNRMSW\r\n"[Rand() % 30];
+        }
+        return n;
+    }
+
+    while (Len + 100 < Size && Rand() % 3 != 0)
+    {
+        Len += Sentence(Bodies[Rand() % 4], (char *)&Buf[Len], Size - Len);
+    }
+
+    Edits = Rand() % 6;
+    for (n = 0; n < Edits && Len > 1; n++)
+    {
+        i = Rand() % Len;
+        switch (Rand() % 5)
+        {
+            case 0:
+                Buf[i] ^= (uint8)(1u << (Rand() % 8));
+                break;
+            case 1:
+                memmove(&Buf[i], &Buf[i + 1], Len - i - 1);
+                Len--;
+                break;
+            case 2:
+                if (Len + 1 < Size)
+                {
+                    memmove(&Buf[i + 1], &Buf[i], Len - i);
+                    Len++;
+                }
+                break;
+            case 3:
+                Len = i;
+                break;
+            default:
+                /* Long run of digits, pushes fields past their limits */
+                while (i < Len && i < Size && Rand() % 20 != 0)
+                {
+                    Buf[i++] = (uint8)('0' + Rand() % 10);
+                }
+                break;
+        }
+    }
+
+    return Len;
+}
+
+static int Fuzz(uint32 Iterations)
+{
+    static uint8          Buf[FUZZ_MAX_BUFFER];
+    HYUN_APP_NmeaParser_t Parser;
+    HYUN_APP_NmeaParser_t Before;
+    size_t                Len;
+    size_t                Off;
+    size_t                Chunk;
+    uint32                Count = 0;
+    uint32                Bytes = 0;
+    uint32                n;
+
+    HYUN_APP_NmeaInit(&Parser);
+
+    for (n = 0; n < Iterations; n++)
+    {
+        Len = FuzzInput(Buf, sizeof(Buf));
+        Bytes += (uint32)Len;
+
+        for (Off = 0; Off < Len; Off += Chunk)
+        {
+            Chunk  = 1 + Rand() % 96;
+            Chunk  = (Chunk > Len - Off) ? Len - Off : Chunk;
+            Before = Parser;
+
+            if (!Feed(&Parser, &Buf[Off], Chunk, NULL, 0, &Count) ||
+                Parser.SentenceCounter < Before.SentenceCounter ||
+                Parser.ChecksumErrCounter < Before.ChecksumErrCounter ||
+                Parser.FormatErrCounter < Before.FormatErrCounter)
+            {
+                printf("fuzz: iteration %u failed\n", (unsigned)n);
+                return 1;
+            }
+        }
+
+        /* Restart now and then, as after a processor reset */
+        if (Rand() % 64 == 0)
+        {
+            HYUN_APP_NmeaInit(&Parser);
+        }
+    }
+
+    printf("fuzz: %u inputs, %u bytes, %u fixes: ok\n", (unsigned)Iterations, (unsigned)Bytes, (unsigned)Count);
+    return 0;
+}
+
+static int Bench(uint32 Seconds)
+{
+    static uint8          Stream[64 * 1024];
+    HYUN_APP_NmeaParser_t Parser;
+    size_t                Len = 0;
+    size_t                Off;
+    size_t                Chunk;
+    uint32                Count = 0;
+    uint64                Sentences;
+    uint64                Bytes = 0;
+    double                Start;
+    double                Elapsed;
+
+    while (Len + 100 < sizeof(Stream))
+    {
+        Len += Sentence(Bodies[(Len / 100) % 2], (char *)&Stream[Len], sizeof(Stream) - Len);
+    }
+
+    HYUN_APP_NmeaInit(&Parser);
+    Start = Now();
+    do
+    {
+        for (Off = 0; Off < Len; Off += Chunk)
+        {
+            Chunk = (Len - Off < BENCH_PACKET) ? Len - Off : BENCH_PACKET;
+            if (!Feed(&Parser, &Stream[Off], Chunk, NULL, 0, &Count))
+            {
+                return 1;
+            }
+        }
+        Bytes += Len;
+        Elapsed = Now() - Start;
+    } while (Elapsed < Seconds);
+
+    Sentences = Parser.SentenceCounter;
+    printf("bench: %.2f M sentences/s, %.1f MB/s, %.0f ns per sentence\n", Sentences / Elapsed * 1e-6,
+           Bytes / Elapsed * 1e-6, Elapsed * 1e9 / Sentences);
+    return (Parser.ChecksumErrCounter != 0 || Parser.FormatErrCounter != 0) ? 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc >= 2 && strcmp(argv[1], "split") == 0)
+    {
+        return Split();
+    }
+    if (argc >= 2 && strcmp(argv[1], "fuzz") == 0)
+    {
+        if (argc >= 4)
+        {
+            /* xorshift never leaves a zero state */
+            RandState = (uint32)strtoul(argv[3], NULL, 0);
+            if (RandState == 0)
+            {
+                RandState = 1;
+            }
+        }
+        return Fuzz((argc >= 3) ? (uint32)strtoul(argv[2], NULL, 0) : 200000u);
+    }
+    if (argc >= 2 && strcmp(argv[1], "bench") == 0)
+    {
+        return Bench((argc >= 3) ? (uint32)strtoul(argv[2], NULL, 0) : 3u);
+    }
+
+    fprintf(stderr, "usage: hyun_nmea_fuzz split | fuzz [iterations] [seed] | bench [seconds]\n");
+    return 2;
+}
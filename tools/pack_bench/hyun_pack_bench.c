@@ -0,0 +1,333 @@
+/*
+** hyun_pack_bench -- big-endian array pack / unpack throughput
+**
+**   hyun_pack_bench [megabytes per run]
+**
+** Every width is first checked against the byte-shift reference for
+** odd counts and unaligned wire buffers. Then each array size is timed
+** with the reference loop (the element codecs hyun_app_wire.c used
+** before) and with the pack library, in both directions. The last
+** section times the generated HK and estimate encoders / decoders.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "hyun_app_pack.h"
+#include "hyun_app_wire.h"
+
+#define BENCH_MAX_COUNT 4096
+#define BENCH_MAX_BYTES (BENCH_MAX_COUNT * 8)
+
+typedef void (*PackFunc_t)(uint8 *Out, const void *In, size_t Count);
+typedef void (*UnpackFunc_t)(void *Out, const uint8 *In, size_t Count);
+
+static uint8 Host[BENCH_MAX_BYTES + 16];
+static uint8 Wire[BENCH_MAX_BYTES + 16];
+static uint8 Back[BENCH_MAX_BYTES + 16];
+
+static volatile uint8 Sink;
+
+static double Now(void)
+{
+    struct timespec Ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &Ts);
+    return (double)Ts.tv_sec + (double)Ts.tv_nsec * 1e-9;
+}
+
+/*
+** Reference: one element at a time with shifts, big-endian out
+*/
+static void RefPack16(uint8 *Out, const void *In, size_t Count)
+{
+    const uint16 *Src = In;
+    size_t        i;
+
+    for (i = 0; i < Count; i++)
+    {
+        *Out++ = (uint8)(Src[i] >> 8);
+        *Out++ = (uint8)Src[i];
+    }
+}
+
+static void RefPack32(uint8 *Out, const void *In, size_t Count)
+{
+    const uint32 *Src = In;
+    size_t        i;
+
+    for (i = 0; i < Count; i++)
+    {
+        *Out++ = (uint8)(Src[i] >> 24);
+        *Out++ = (uint8)(Src[i] >> 16);
+        *Out++ = (uint8)(Src[i] >> 8);
+        *Out++ = (uint8)Src[i];
+    }
+}
+
+static void RefPack64(uint8 *Out, const void *In, size_t Count)
+{
+    const uint64 *Src = In;
+    size_t        i;
+    int           b;
+
+    for (i = 0; i < Count; i++)
+    {
+        for (b = 56; b >= 0; b -= 8)
+        {
+            *Out++ = (uint8)(Src[i] >> b);
+        }
+    }
+}
+
+static void RefUnpack16(void *Out, const uint8 *In, size_t Count)
+{
+    uint16 *Dst = Out;
+    size_t  i;
+
+    for (i = 0; i < Count; i++, In += 2)
+    {
+        Dst[i] = (uint16)((In[0] << 8) | In[1]);
+    }
+}
+
+static void RefUnpack32(void *Out, const uint8 *In, size_t Count)
+{
+    uint32 *Dst = Out;
+    size_t  i;
+
+    for (i = 0; i < Count; i++, In += 4)
+    {
+        Dst[i] = ((uint32)In[0] << 24) | ((uint32)In[1] << 16) | ((uint32)In[2] << 8) | In[3];
+    }
+}
+
+static void RefUnpack64(void *Out, const uint8 *In, size_t Count)
+{
+    uint64 *Dst = Out;
+    size_t  i;
+    int     b;
+
+    for (i = 0; i < Count; i++)
+    {
+        Dst[i] = 0;
+        for (b = 0; b < 8; b++)
+        {
+            Dst[i] = (Dst[i] << 8) | *In++;
+        }
+    }
+}
+
+typedef struct
+{
+    size_t       Width;
+    PackFunc_t   RefPack;
+    UnpackFunc_t RefUnpack;
+    PackFunc_t   Pack;
+    UnpackFunc_t Unpack;
+} Width_t;
+
+static const Width_t Widths[] = {
+    {2, RefPack16, RefUnpack16, HYUN_APP_PackBe16, HYUN_APP_UnpackBe16},
+    {4, RefPack32, RefUnpack32, HYUN_APP_PackBe32, HYUN_APP_UnpackBe32},
+    {8, RefPack64, RefUnpack64, HYUN_APP_PackBe64, HYUN_APP_UnpackBe64},
+};
+
+#define BENCH_WIDTHS (sizeof(Widths) / sizeof(Widths[0]))
+
+/*
+** Library against reference for every count up to 67 elements at every
+** wire offset 0..7. Returns the number of mismatches.
+*/
+static unsigned Verify(const Width_t *W)
+{
+    static uint8 Expect[BENCH_MAX_BYTES];
+    unsigned     Errors = 0;
+    size_t       Count;
+    size_t       Offset;
+
+    for (Count = 0; Count < 68; Count++)
+    {
+        for (Offset = 0; Offset < 8; Offset++)
+        {
+            W->RefPack(Expect, Host, Count);
+            memset(Wire, 0xA5, sizeof(Wire));
+            W->Pack(&Wire[Offset], Host, Count);
+            if (memcmp(&Wire[Offset], Expect, Count * W->Width) != 0 || Wire[Offset + Count * W->Width] != 0xA5)
+            {
+                Errors++;
+            }
+
+            memset(Back, 0, sizeof(Back));
+            W->Unpack(&Back[Offset], &Wire[Offset], Count);
+            if (memcmp(&Back[Offset], Host, Count * W->Width) != 0)
+            {
+                Errors++;
+            }
+        }
+    }
+
+    return Errors;
+}
+
+/*
+** Returns GB/s of host data converted
+*/
+static double TimePack(PackFunc_t Pack, size_t Count, size_t Width, size_t Bytes)
+{
+    size_t Reps = Bytes / (Count * Width);
+    size_t r;
+    double Start;
+
+    Start = Now();
+    for (r = 0; r < Reps; r++)
+    {
+        Pack(Wire, Host, Count);
+        Sink = Wire[r % (Count * Width)];
+    }
+    return (double)(Reps * Count * Width) / (Now() - Start) * 1e-9;
+}
+
+static double TimeUnpack(UnpackFunc_t Unpack, size_t Count, size_t Width, size_t Bytes)
+{
+    size_t Reps = Bytes / (Count * Width);
+    size_t r;
+    double Start;
+
+    Start = Now();
+    for (r = 0; r < Reps; r++)
+    {
+        Unpack(Back, Wire, Count);
+        Sink = Back[r % (Count * Width)];
+    }
+    return (double)(Reps * Count * Width) / (Now() - Start) * 1e-9;
+}
+
+static int SchemaBench(size_t Iterations)
+{
+    HYUN_APP_HkTlm_Payload_t       Hk;
+    HYUN_APP_HkTlm_Payload_t       HkBack;
+    HYUN_APP_EstimateTlm_Payload_t Est;
+    HYUN_APP_EstimateTlm_Payload_t EstBack;
+    size_t                         i;
+    double                         Start;
+    double                         EncNs;
+    double                         DecNs;
+    int                            Status = 0;
+
+    for (i = 0; i < sizeof(Hk); i++)
+    {
+        ((uint8 *)&Hk)[i] = (uint8)(i * 7 + 1);
+    }
+    for (i = 0; i < sizeof(Est); i++)
+    {
+        ((uint8 *)&Est)[i] = (uint8)(i * 13 + 5);
+    }
+
+    HYUN_APP_HkTlmEncode(&Hk, Wire);
+    HYUN_APP_HkTlmDecode(Wire, &HkBack);
+    HYUN_APP_EstimateTlmEncode(&Est, Wire);
+    HYUN_APP_EstimateTlmDecode(Wire, &EstBack);
+    if (memcmp(&Hk, &HkBack, sizeof(Hk)) != 0 || memcmp(&Est, &EstBack, sizeof(Est)) != 0)
+    {
+        printf("schema round trip FAILED\n");
+        Status = 1;
+    }
+
+    Start = Now();
+    for (i = 0; i < Iterations; i++)
+    {
+        Hk.CommandCounter = (uint8)i;
+        HYUN_APP_HkTlmEncode(&Hk, Wire);
+        Sink = Wire[0];
+    }
+    EncNs = (Now() - Start) * 1e9 / (double)Iterations;
+
+    Start = Now();
+    for (i = 0; i < Iterations; i++)
+    {
+        Wire[0] = (uint8)i;
+        HYUN_APP_HkTlmDecode(Wire, &HkBack);
+        Sink = HkBack.CommandCounter;
+    }
+    DecNs = (Now() - Start) * 1e9 / (double)Iterations;
+    printf("HkTlm       %4u bytes  encode %7.1f ns  decode %7.1f ns\n", (unsigned)HYUN_APP_HkTlm_WIRE_SIZE, EncNs,
+           DecNs);
+
+    Start = Now();
+    for (i = 0; i < Iterations; i++)
+    {
+        HYUN_APP_EstimateTlmEncode(&Est, Wire);
+        Sink = Wire[0];
+    }
+    EncNs = (Now() - Start) * 1e9 / (double)Iterations;
+
+    Start = Now();
+    for (i = 0; i < Iterations; i++)
+    {
+        Wire[0] = (uint8)i;
+        HYUN_APP_EstimateTlmDecode(Wire, &EstBack);
+        Sink = ((uint8 *)&EstBack)[0];
+    }
+    DecNs = (Now() - Start) * 1e9 / (double)Iterations;
+    printf("EstimateTlm %4u bytes  encode %7.1f ns  decode %7.1f ns\n", (unsigned)HYUN_APP_EstimateTlm_WIRE_SIZE,
+           EncNs, DecNs);
+
+    return Status;
+}
+
+int main(int argc, char *argv[])
+{
+    static const size_t Counts[] = {4, 16, 64, 256, 4096};
+    size_t              Bytes    = 256;
+    size_t              w;
+    size_t              c;
+    unsigned            Errors = 0;
+    unsigned            Bad;
+
+    if (argc > 1)
+    {
+        Bytes = strtoul(argv[1], NULL, 0);
+    }
+    Bytes *= 1024 * 1024;
+
+    for (c = 0; c < sizeof(Host); c++)
+    {
+        Host[c] = (uint8)(c * 31 + 17);
+    }
+
+    printf("pack implementation: %s\n", HYUN_APP_PACK_IMPL);
+    for (w = 0; w < BENCH_WIDTHS; w++)
+    {
+        Bad = Verify(&Widths[w]);
+        printf("verify %2u-bit: %s\n", (unsigned)(Widths[w].Width * 8), Bad ? "FAILED" : "ok");
+        Errors += Bad;
+    }
+
+    printf("\nwidth  count      pack GB/s (ref -> lib)      unpack GB/s (ref -> lib)\n");
+    for (w = 0; w < BENCH_WIDTHS; w++)
+    {
+        const Width_t *W = &Widths[w];
+
+        for (c = 0; c < sizeof(Counts) / sizeof(Counts[0]); c++)
+        {
+            double RefPack   = TimePack(W->RefPack, Counts[c], W->Width, Bytes);
+            double Pack      = TimePack(W->Pack, Counts[c], W->Width, Bytes);
+            double RefUnpack = TimeUnpack(W->RefUnpack, Counts[c], W->Width, Bytes);
+            double Unpack    = TimeUnpack(W->Unpack, Counts[c], W->Width, Bytes);
+
+            printf("%3u  %6u   %6.2f -> %6.2f (x%4.1f)     %6.2f -> %6.2f (x%4.1f)\n", (unsigned)(W->Width * 8),
+                   (unsigned)Counts[c], RefPack, Pack, Pack / RefPack, RefUnpack, Unpack, Unpack / RefUnpack);
+        }
+    }
+
+    printf("\n");
+    if (SchemaBench(2000000) != 0)
+    {
+        Errors++;
+    }
+
+    return Errors ? 1 : 0;
+}
@@ -0,0 +1,416 @@
+/*
+** hyun_tlm_codec -- host side of the HYUN_APP downlink compression
+**
+** Recordings are raw CCSDS packets back to back, as captured from the
+** ground station (one telemetry header of -H bytes in front of every
+** payload, 16 by default for cFE 7).
+**
+**   hyun_tlm_codec decode [-H hdr] <in> <out>
+**       Expand every HYUN_APP_MID_COMPRESSED_TLM packet of <in> back into
+**       the original packet, copy all other packets unchanged.
+**
+**   hyun_tlm_codec bench [-H hdr] [-n loops] <in>
+**       Compress an uncompressed recording with every codec, check the
+**       round trip and report ratio and throughput.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "hyun_app_codec.h"
+#include "hyun_app_msgids.h"
+
+#define HYUN_TLM_PRIMARY_HDR  6
+#define HYUN_TLM_FRAME_HDR    12 /* HYUN_APP_CodecFrame_t up to Data */
+#define HYUN_TLM_MAX_STREAMS  32
+#define HYUN_TLM_MAX_PACKET   65542
+
+typedef struct
+{
+    uint8 *Buf;
+    size_t Size;
+} HYUN_TLM_File_t;
+
+typedef struct
+{
+    uint16 StreamId;
+    size_t Offset; /* Of the packet in the recording */
+    size_t Length;
+} HYUN_TLM_Packet_t;
+
+static size_t HdrSize = 16;
+
+/*
+** Packet helpers
+*/
+static uint16 GetBe16(const uint8 *Ptr)
+{
+    return (uint16)((Ptr[0] << 8) | Ptr[1]);
+}
+
+static void PutBe16(uint8 *Ptr, uint16 Value)
+{
+    Ptr[0] = (uint8)(Value >> 8);
+    Ptr[1] = (uint8)Value;
+}
+
+static uint16 GetLe16(const uint8 *Ptr)
+{
+    return (uint16)(Ptr[0] | (Ptr[1] << 8));
+}
+
+static int ReadFile(const char *Path, HYUN_TLM_File_t *File)
+{
+    FILE *Fp = fopen(Path, "rb");
+    long  Size;
+
+    if (Fp == NULL)
+    {
+        perror(Path);
+        return -1;
+    }
+
+    fseek(Fp, 0, SEEK_END);
+    Size = ftell(Fp);
+    fseek(Fp, 0, SEEK_SET);
+
+    File->Buf  = malloc((size_t)Size + 1);
+    File->Size = (size_t)Size;
+    if (File->Buf == NULL || fread(File->Buf, 1, File->Size, Fp) != File->Size)
+    {
+        fprintf(stderr, "%s: read failed\n", Path);
+        fclose(Fp);
+        return -1;
+    }
+
+    fclose(Fp);
+    return 0;
+}
+
+/*
+** Split a recording into packets. Returns the packet count, a truncated
+** last packet is reported and ignored.
+*/
+static size_t SplitPackets(const HYUN_TLM_File_t *File, HYUN_TLM_Packet_t **Packets)
+{
+    size_t Count = 0;
+    size_t Alloc = 1024;
+    size_t Off   = 0;
+    size_t Len;
+
+    *Packets = malloc(Alloc * sizeof(**Packets));
+
+    while (Off + HYUN_TLM_PRIMARY_HDR <= File->Size)
+    {
+        Len = (size_t)GetBe16(&File->Buf[Off + 4]) + 7;
+        if (Off + Len > File->Size)
+        {
+            fprintf(stderr, "truncated packet at offset %zu ignored\n", Off);
+            break;
+        }
+
+        if (Count == Alloc)
+        {
+            Alloc *= 2;
+            *Packets = realloc(*Packets, Alloc * sizeof(**Packets));
+        }
+
+        (*Packets)[Count].StreamId = GetBe16(&File->Buf[Off]);
+        (*Packets)[Count].Offset   = Off;
+        (*Packets)[Count].Length   = Len;
+        Count++;
+
+        Off += Len;
+    }
+
+    return Count;
+}
+
+static HYUN_APP_CodecStream_t *FindStream(HYUN_APP_CodecStream_t *Streams, size_t *NumStreams, uint16 MsgId,
+                                          uint8 Codec)
+{
+    size_t i;
+
+    for (i = 0; i < *NumStreams; i++)
+    {
+        if (Streams[i].MsgId == MsgId)
+        {
+            return &Streams[i];
+        }
+    }
+
+    if (*NumStreams == HYUN_TLM_MAX_STREAMS)
+    {
+        return NULL;
+    }
+
+    HYUN_APP_CodecStreamInit(&Streams[*NumStreams], MsgId, Codec);
+    return &Streams[(*NumStreams)++];
+}
+
+/*
+** decode
+*/
+static int Decode(const char *InPath, const char *OutPath)
+{
+    HYUN_TLM_File_t        File;
+    HYUN_TLM_Packet_t     *Packets;
+    HYUN_APP_CodecStream_t Streams[HYUN_TLM_MAX_STREAMS];
+    HYUN_APP_CodecStream_t *Stream;
+    HYUN_APP_CodecFrame_t  Frame;
+    uint8                  Out[HYUN_TLM_MAX_PACKET];
+    size_t                 NumStreams = 0;
+    size_t                 Count;
+    size_t                 i;
+    size_t                 Expanded = 0;
+    size_t                 Failed   = 0;
+    const uint8           *Pkt;
+    FILE                  *Fp;
+    int32                  Status;
+
+    if (ReadFile(InPath, &File) != 0)
+    {
+        return 1;
+    }
+
+    Fp = fopen(OutPath, "wb");
+    if (Fp == NULL)
+    {
+        perror(OutPath);
+        return 1;
+    }
+
+    Count = SplitPackets(&File, &Packets);
+
+    for (i = 0; i < Count; i++)
+    {
+        Pkt = &File.Buf[Packets[i].Offset];
+
+        if (Packets[i].StreamId != HYUN_APP_MID_COMPRESSED_TLM)
+        {
+            fwrite(Pkt, 1, Packets[i].Length, Fp);
+            continue;
+        }
+
+        if (Packets[i].Length < HdrSize + HYUN_TLM_FRAME_HDR)
+        {
+            Failed++;
+            continue;
+        }
+
+        memset(&Frame, 0, sizeof(Frame));
+        Frame.MsgId     = GetLe16(&Pkt[HdrSize]);
+        Frame.Codec     = Pkt[HdrSize + 2];
+        Frame.Flags     = Pkt[HdrSize + 3];
+        Frame.RawLength = GetLe16(&Pkt[HdrSize + 4]);
+        Frame.Length    = GetLe16(&Pkt[HdrSize + 6]);
+        Frame.Seq       = GetLe16(&Pkt[HdrSize + 8]);
+
+        if (Frame.Length > sizeof(Frame.Data) || HdrSize + HYUN_TLM_FRAME_HDR + Frame.Length > Packets[i].Length)
+        {
+            Failed++;
+            continue;
+        }
+        memcpy(Frame.Data, &Pkt[HdrSize + HYUN_TLM_FRAME_HDR], Frame.Length);
+
+        Stream = FindStream(Streams, &NumStreams, Frame.MsgId, Frame.Codec);
+        if (Stream == NULL)
+        {
+            Failed++;
+            continue;
+        }
+
+        Status = HYUN_APP_CodecDecodeFrame(Stream, &Frame, &Out[HdrSize], sizeof(Out) - HdrSize);
+        if (Status != HYUN_APP_CODEC_SUCCESS)
+        {
+            Failed++;
+            continue;
+        }
+
+        /* Original header: same sequence and time, original MID and length */
+        memcpy(Out, Pkt, HdrSize);
+        PutBe16(&Out[0], Frame.MsgId);
+        PutBe16(&Out[4], (uint16)(HdrSize + Frame.RawLength - 7));
+        fwrite(Out, 1, HdrSize + Frame.RawLength, Fp);
+        Expanded++;
+    }
+
+    fclose(Fp);
+
+    printf("%zu packets, %zu expanded, %zu not decodable\n", Count, Expanded, Failed);
+    return (Failed == 0) ? 0 : 2;
+}
+
+/*
+** bench
+*/
+static double Now(void)
+{
+    struct timespec Ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &Ts);
+    return (double)Ts.tv_sec + (double)Ts.tv_nsec * 1e-9;
+}
+
+static int BenchCodec(const HYUN_TLM_File_t *File, const HYUN_TLM_Packet_t *Packets, size_t Count, uint8 Codec,
+                      const char *Name, int Loops)
+{
+    HYUN_APP_CodecStream_t       EncStreams[HYUN_TLM_MAX_STREAMS];
+    HYUN_APP_CodecStream_t       DecStreams[HYUN_TLM_MAX_STREAMS];
+    HYUN_APP_CodecStream_t      *Stream;
+    HYUN_APP_CodecFrame_t       *Coded;
+    uint8                        Out[HYUN_APP_CODEC_MAX_PAYLOAD];
+    size_t                       NumEnc;
+    size_t                       NumDec;
+    size_t                       RawBytes  = 0;
+    size_t                       LinkRaw   = 0;
+    size_t                       LinkCoded = 0;
+    size_t                       Used      = 0;
+    size_t                       i;
+    int                          Loop;
+    double                       EncTime = 0;
+    double                       DecTime = 0;
+    double                       Start;
+    int                          Errors = 0;
+
+    Coded = malloc(Count * sizeof(*Coded));
+
+    for (Loop = 0; Loop < Loops; Loop++)
+    {
+        NumEnc = 0;
+        NumDec = 0;
+
+        Start = Now();
+        for (i = 0; i < Count; i++)
+        {
+            Stream = FindStream(EncStreams, &NumEnc, Packets[i].StreamId, Codec);
+            if (Stream == NULL || Packets[i].Length < HdrSize ||
+                HYUN_APP_CodecEncodeFrame(Stream, &File->Buf[Packets[i].Offset + HdrSize],
+                                          Packets[i].Length - HdrSize, &Coded[i]) != HYUN_APP_CODEC_SUCCESS)
+            {
+                Coded[i].RawLength = 0xFFFF; /* Passed through uncompressed */
+            }
+        }
+        EncTime += Now() - Start;
+
+        Start = Now();
+        for (i = 0; i < Count; i++)
+        {
+            if (Coded[i].RawLength == 0xFFFF)
+            {
+                continue;
+            }
+            Stream = FindStream(DecStreams, &NumDec, Coded[i].MsgId, Coded[i].Codec);
+            if (HYUN_APP_CodecDecodeFrame(Stream, &Coded[i], Out, sizeof(Out)) != HYUN_APP_CODEC_SUCCESS)
+            {
+                Errors++;
+            }
+            else if (Loop == 0 && memcmp(Out, &File->Buf[Packets[i].Offset + HdrSize], Coded[i].RawLength) != 0)
+            {
+                Errors++;
+            }
+        }
+        DecTime += Now() - Start;
+    }
+
+    for (i = 0; i < Count; i++)
+    {
+        LinkRaw += Packets[i].Length;
+        if (Coded[i].RawLength == 0xFFFF)
+        {
+            LinkCoded += Packets[i].Length;
+            continue;
+        }
+        RawBytes += Coded[i].RawLength;
+        LinkCoded += HdrSize + HYUN_TLM_FRAME_HDR + Coded[i].Length;
+        if (Coded[i].Codec != HYUN_APP_CODEC_NONE)
+        {
+            Used++;
+        }
+    }
+
+    printf("%-6s %8zu %8zu %10zu %10zu %7.3f %10.1f %10.1f %s\n", Name, Count, Used, LinkRaw, LinkCoded,
+           (double)LinkRaw / (double)(LinkCoded ? LinkCoded : 1), (double)RawBytes * Loops / EncTime / 1e6,
+           (double)RawBytes * Loops / DecTime / 1e6, Errors ? "ROUND TRIP FAILED" : "ok");
+
+    free(Coded);
+    return Errors;
+}
+
+static int Bench(const char *InPath, int Loops)
+{
+    HYUN_TLM_File_t    File;
+    HYUN_TLM_Packet_t *Packets;
+    size_t             Count;
+    int                Errors = 0;
+
+    if (ReadFile(InPath, &File) != 0)
+    {
+        return 1;
+    }
+
+    Count = SplitPackets(&File, &Packets);
+
+    printf("%-6s %8s %8s %10s %10s %7s %10s %10s\n", "codec", "packets", "coded", "link_raw", "link_coded", "ratio",
+           "enc_MB/s", "dec_MB/s");
+    Errors += BenchCodec(&File, Packets, Count, HYUN_APP_CODEC_DELTA, "delta", Loops);
+    Errors += BenchCodec(&File, Packets, Count, HYUN_APP_CODEC_LZ, "lz", Loops);
+
+    return (Errors == 0) ? 0 : 2;
+}
+
+static void Usage(void)
+{
+    fprintf(stderr, "usage: hyun_tlm_codec decode [-H hdr] <in> <out>\n"
+                    "       hyun_tlm_codec bench [-H hdr] [-n loops] <in>\n");
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *Cmd;
+    int         Loops = 100;
+    int         Opt;
+
+    if (argc < 2)
+    {
+        Usage();
+    }
+    Cmd = argv[1];
+    optind = 2;
+
+    while ((Opt = getopt(argc, argv, "H:n:")) != -1)
+    {
+        switch (Opt)
+        {
+            case 'H':
+                HdrSize = (size_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'n':
+                Loops = atoi(optarg);
+                break;
+            default:
+                Usage();
+        }
+    }
+
+    if (HdrSize < HYUN_TLM_PRIMARY_HDR || Loops < 1)
+    {
+        Usage();
+    }
+
+    if (strcmp(Cmd, "decode") == 0 && argc - optind == 2)
+    {
+        return Decode(argv[optind], argv[optind + 1]);
+    }
+    if (strcmp(Cmd, "bench") == 0 && argc - optind == 1)
+    {
+        return Bench(argv[optind], Loops);
+    }
+
+    Usage();
+    return 1;
+}
@@ -0,0 +1,160 @@
+/*
+** hyun_udp_flood -- load the UDP command ingest task over loopback
+**
+**   hyun_udp_flood port [packets] [rate] [bad_every]
+**
+** Sends HYUN_APP NOOP commands to 127.0.0.1:port in sendmmsg batches.
+** rate is in packets per second, 0 sends as fast as the socket allows.
+** With bad_every N, every Nth packet carries a wrong length field and
+** must show up in UdpCmdRejectCounter instead of CommandCounter.
+**
+** Compare the sent count with UdpCmdPacketCounter, UdpCmdDropCounter and
+** UdpCmdPacketsPerSec in HK to see what the app kept up with.
+*/
+
+#define _GNU_SOURCE /* sendmmsg */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "hyun_app_msgids.h"
+
+#define FLOOD_BATCH   16
+#define FLOOD_CMD_LEN 8 /* CCSDS v1 primary header + function code + checksum */
+#define FLOOD_NOOP_CC 0
+
+static double Now(void)
+{
+    struct timespec Ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &Ts);
+    return (double)Ts.tv_sec + (double)Ts.tv_nsec * 1e-9;
+}
+
+/*
+** NOOP command with the cFE v1 checksum (XOR of all bytes is 0xFF)
+*/
+static void BuildNoop(uint8_t *Pkt, uint16_t Seq, int Bad)
+{
+    uint16_t Len = FLOOD_CMD_LEN - 7 + (Bad ? 1 : 0);
+    uint8_t  Sum = 0xFF;
+    int      i;
+
+    Pkt[0] = (uint8_t)(HYUN_APP_MID_GROUNDCMD_REQ >> 8);
+    Pkt[1] = (uint8_t)(HYUN_APP_MID_GROUNDCMD_REQ & 0xFF);
+    Pkt[2] = (uint8_t)(0xC0 | ((Seq >> 8) & 0x3F));
+    Pkt[3] = (uint8_t)(Seq & 0xFF);
+    Pkt[4] = (uint8_t)(Len >> 8);
+    Pkt[5] = (uint8_t)(Len & 0xFF);
+    Pkt[6] = FLOOD_NOOP_CC;
+    Pkt[7] = 0;
+
+    for (i = 0; i < FLOOD_CMD_LEN; i++)
+    {
+        Sum ^= Pkt[i];
+    }
+    Pkt[7] = Sum;
+}
+
+int main(int argc, char *argv[])
+{
+    static uint8_t     Pkt[FLOOD_BATCH][FLOOD_CMD_LEN];
+    struct mmsghdr     Msgs[FLOOD_BATCH];
+    struct iovec       Iov[FLOOD_BATCH];
+    struct sockaddr_in Dest;
+    long               Packets  = (argc > 2) ? atol(argv[2]) : 100000;
+    double             Rate     = (argc > 3) ? atof(argv[3]) : 0.0;
+    long               BadEvery = (argc > 4) ? atol(argv[4]) : 0;
+    long               Sent     = 0;
+    long               Bad      = 0;
+    long               Refused  = 0;
+    long               n;
+    double             Start;
+    double             Elapsed;
+    double             Ahead;
+    int                Sock;
+    int                Count;
+    int                Rc;
+    int                i;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s port [packets] [rate] [bad_every]\n", argv[0]);
+        return 2;
+    }
+
+    memset(&Dest, 0, sizeof(Dest));
+    Dest.sin_family      = AF_INET;
+    Dest.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    Dest.sin_port        = htons((uint16_t)atoi(argv[1]));
+
+    Sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (Sock < 0)
+    {
+        perror("socket");
+        return 1;
+    }
+
+    Start = Now();
+    while (Sent + Refused < Packets)
+    {
+        Count = (Packets - Sent - Refused < FLOOD_BATCH) ? (int)(Packets - Sent - Refused) : FLOOD_BATCH;
+
+        memset(Msgs, 0, sizeof(Msgs));
+        for (i = 0; i < Count; i++)
+        {
+            n = Sent + Refused + i;
+            BuildNoop(Pkt[i], (uint16_t)n, BadEvery > 0 && (n % BadEvery) == BadEvery - 1);
+
+            Iov[i].iov_base             = Pkt[i];
+            Iov[i].iov_len              = FLOOD_CMD_LEN;
+            Msgs[i].msg_hdr.msg_name    = &Dest;
+            Msgs[i].msg_hdr.msg_namelen = sizeof(Dest);
+            Msgs[i].msg_hdr.msg_iov     = &Iov[i];
+            Msgs[i].msg_hdr.msg_iovlen  = 1;
+        }
+
+        Rc = sendmmsg(Sock, Msgs, (unsigned int)Count, 0);
+        if (Rc < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            /* Nobody bound (ECONNREFUSED from an earlier datagram) or no buffer */
+            Refused += Count;
+            continue;
+        }
+
+        for (i = 0; i < Rc; i++)
+        {
+            n = Sent + Refused + i;
+            Bad += (BadEvery > 0 && (n % BadEvery) == BadEvery - 1);
+        }
+        Sent += Rc;
+
+        if (Rate > 0.0)
+        {
+            Ahead = (double)(Sent + Refused) / Rate - (Now() - Start);
+            if (Ahead > 0.0)
+            {
+                usleep((useconds_t)(Ahead * 1e6));
+            }
+        }
+    }
+    Elapsed = Now() - Start;
+
+    printf("sent %ld (%ld bad) refused %ld in %.3f s, %.0f packets/s\n", Sent, Bad, Refused, Elapsed,
+           (double)Sent / Elapsed);
+
+    close(Sock);
+    return 0;
+}
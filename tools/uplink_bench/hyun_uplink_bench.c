@@ -0,0 +1,140 @@
+/*
+** hyun_uplink_bench -- throughput of HYUN_APP_UplinkParse
+**
+**   hyun_uplink_bench [iterations]
+**
+** Every input class is parsed from the same fixed size buffer the flight
+** command carries, so the numbers include the scan of unused bytes.
+** Malformed classes must all be rejected; any accepted one is reported.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "hyun_app_uplink.h"
+
+#define BENCH_CORPUS 256
+
+typedef struct
+{
+    const char *Name;
+    bool        ExpectValid;
+    char        Text[BENCH_CORPUS][HYUN_APP_UPLINK_MAX_TEXT];
+} BenchClass_t;
+
+static const char *ValidCmds[] = {"CMD,1000,CX,ON",       "CMD,1000,CX,OFF",      "CMD,1000,ST,13:35:59",
+                                  "CMD,1000,ST,GPS",      "CMD,1000,SIM,ENABLE",  "CMD,1000,SIM,ACTIVATE",
+                                  "CMD,1000,SIM,DISABLE", "CMD,1000,SIMP,101325", "CMD,1000,CAL"};
+
+#define NUM_VALID (sizeof(ValidCmds) / sizeof(ValidCmds[0]))
+
+static double Now(void)
+{
+    struct timespec Ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &Ts);
+    return (double)Ts.tv_sec + (double)Ts.tv_nsec * 1e-9;
+}
+
+static void Fill(BenchClass_t *Class, int Kind)
+{
+    const char *Src;
+    size_t      Len;
+    size_t      i;
+    size_t      j;
+
+    memset(Class->Text, 0, sizeof(Class->Text));
+
+    for (i = 0; i < BENCH_CORPUS; i++)
+    {
+        Src = ValidCmds[i % NUM_VALID];
+        Len = strlen(Src);
+        memcpy(Class->Text[i], Src, Len);
+
+        switch (Kind)
+        {
+            case 1: /* Random printable garbage of full length */
+                for (j = 0; j < HYUN_APP_UPLINK_MAX_TEXT; j++)
+                {
+                    Class->Text[i][j] = (char)(' ' + rand() % 95);
+                }
+                Class->Text[i][0] = 'X';
+                break;
+
+            case 2: /* Last field missing */
+                *strrchr(Class->Text[i], ',') = '\0';
+                break;
+
+            case 3: /* One byte of the mnemonic or argument flipped */
+                Class->Text[i][9 + rand() % (Len - 9)] ^= 0x20;
+                break;
+
+            case 4: /* Binary noise after a valid prefix */
+                for (j = 4; j < HYUN_APP_UPLINK_MAX_TEXT; j++)
+                {
+                    Class->Text[i][j] = (char)(rand() & 0xFF);
+                }
+                break;
+
+            case 5: /* Too many fields */
+                memcpy(&Class->Text[i][Len], ",EXTRA,FIELD", 12);
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    static BenchClass_t Classes[] = {
+        {.Name = "valid", .ExpectValid = true},          {.Name = "garbage", .ExpectValid = false},
+        {.Name = "truncated", .ExpectValid = false},     {.Name = "flipped_byte", .ExpectValid = false},
+        {.Name = "binary_tail", .ExpectValid = false},   {.Name = "extra_fields", .ExpectValid = false},
+    };
+    HYUN_APP_UplinkCmd_t Cmd;
+    long                 Iterations = (argc > 1) ? atol(argv[1]) : 200000;
+    size_t               NumClasses = sizeof(Classes) / sizeof(Classes[0]);
+    size_t               c;
+    size_t               i;
+    long                 n;
+    long                 Mismatch;
+    double               Start;
+    double               Elapsed;
+    int                  Failed = 0;
+    volatile int32       Sink   = 0;
+
+    srand(1);
+
+    printf("%-14s %10s %10s %9s\n", "class", "parses", "ns/parse", "mismatch");
+
+    for (c = 0; c < NumClasses; c++)
+    {
+        Fill(&Classes[c], (int)c);
+
+        Mismatch = 0;
+        for (i = 0; i < BENCH_CORPUS; i++)
+        {
+            if ((HYUN_APP_UplinkParse(Classes[c].Text[i], HYUN_APP_UPLINK_MAX_TEXT, &Cmd) == HYUN_APP_UPLINK_SUCCESS) !=
+                Classes[c].ExpectValid)
+            {
+                Mismatch++;
+            }
+        }
+
+        Start = Now();
+        for (n = 0; n < Iterations; n++)
+        {
+            Sink += HYUN_APP_UplinkParse(Classes[c].Text[n % BENCH_CORPUS], HYUN_APP_UPLINK_MAX_TEXT, &Cmd);
+        }
+        Elapsed = Now() - Start;
+
+        printf("%-14s %10ld %10.1f %9ld\n", Classes[c].Name, Iterations, Elapsed * 1e9 / (double)Iterations, Mismatch);
+        Failed |= (Mismatch != 0);
+    }
+
+    return Failed;
+}
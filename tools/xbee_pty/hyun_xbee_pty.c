@@ -0,0 +1,207 @@
+/*
+** hyun_xbee_pty -- XBee frame output against a pseudo-terminal
+**
+**   hyun_xbee_pty [baud] [packets]
+**
+** The flight framing code opens the slave side of a pty as if it were
+** the radio UART; the master side reads the frames back, checks every
+** checksum and compares the reassembled RF data with what was sent.
+** A pty does not pace at the baud rate, so besides the measured encode
+** and write rate the tool reports what the baud budget carries for each
+** packet class, framing and escapes included.
+*/
+
+#define _XOPEN_SOURCE 600 /* posix_openpt */
+#define _DEFAULT_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "hyun_app_xbee.h"
+
+#define PTY_PACKET_MAX  256
+#define PTY_CYCLE       4 /* Packets per flush, like one downlink service call */
+
+typedef struct
+{
+    const char *Name;
+    size_t      Size;
+    int         Kind; /* 0 telemetry-like, 1 random, 2 all delimiters */
+} PtyClass_t;
+
+static double Now(void)
+{
+    struct timespec Ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &Ts);
+    return (double)Ts.tv_sec + (double)Ts.tv_nsec * 1e-9;
+}
+
+static void Fill(uint8 *Pkt, size_t Size, int Kind, long Seq)
+{
+    size_t i;
+
+    for (i = 0; i < Size; i++)
+    {
+        switch (Kind)
+        {
+            case 0: /* CCSDS header, counters and slowly changing floats */
+                Pkt[i] = (i < 6) ? (uint8)(0x08 + i) : (uint8)((Seq + i * 7) & 0x3F);
+                break;
+            case 1:
+                Pkt[i] = (uint8)(rand() & 0xFF);
+                break;
+            default:
+                Pkt[i] = HYUN_APP_XBEE_START;
+                break;
+        }
+    }
+}
+
+static int Drain(int Master, uint8 *Buf, size_t Size, size_t *Len)
+{
+    ssize_t Rc;
+
+    while (*Len < Size)
+    {
+        Rc = read(Master, Buf + *Len, Size - *Len);
+        if (Rc <= 0)
+        {
+            return (Rc < 0 && errno != EAGAIN) ? -1 : 0;
+        }
+        *Len += (size_t)Rc;
+    }
+    return 0;
+}
+
+static int RunClass(const PtyClass_t *Class, int Master, const char *Slave, uint32 Baud, long Packets)
+{
+    static uint8    Sent[1 << 21];
+    static uint8    Wire[1 << 22];
+    static uint8    Back[1 << 21];
+    HYUN_APP_Xbee_t Xbee;
+    uint8           Pkt[PTY_PACKET_MAX];
+    size_t          SentLen = 0;
+    size_t          WireLen = 0;
+    size_t          BackLen = 0;
+    size_t          Pos     = 0;
+    size_t          Used;
+    size_t          DataLen;
+    long            BadFrames = 0;
+    long            n;
+    double          Start;
+    double          Elapsed;
+    double          WirePerPkt;
+    int32           Rc;
+
+    HYUN_APP_XbeeInit(&Xbee);
+    if (HYUN_APP_XbeeOpen(&Xbee, Slave, Baud, HYUN_APP_XBEE_BROADCAST) != HYUN_APP_XBEE_SUCCESS)
+    {
+        fprintf(stderr, "cannot open %s\n", Slave);
+        return 1;
+    }
+
+    if ((size_t)Packets * Class->Size > sizeof(Sent))
+    {
+        Packets = (long)(sizeof(Sent) / Class->Size);
+    }
+
+    Start = Now();
+    for (n = 0; n < Packets; n++)
+    {
+        Fill(Pkt, Class->Size, Class->Kind, n);
+        memcpy(&Sent[SentLen], Pkt, Class->Size);
+        SentLen += Class->Size;
+
+        HYUN_APP_XbeeQueue(&Xbee, Pkt, Class->Size);
+        if ((n % PTY_CYCLE) == PTY_CYCLE - 1 || n == Packets - 1)
+        {
+            HYUN_APP_XbeeFlush(&Xbee);
+            if (Drain(Master, Wire, sizeof(Wire), &WireLen) != 0)
+            {
+                perror("read");
+                return 1;
+            }
+        }
+    }
+    Elapsed = Now() - Start;
+
+    usleep(10000);
+    Drain(Master, Wire, sizeof(Wire), &WireLen);
+
+    /* Decode the wire stream back into RF data */
+    while (Pos < WireLen)
+    {
+        Rc = HYUN_APP_XbeeDecode(&Wire[Pos], WireLen - Pos, &Used, &Back[BackLen], sizeof(Back) - BackLen, &DataLen);
+        if (Rc == HYUN_APP_XBEE_SUCCESS)
+        {
+            BackLen += DataLen;
+            Pos += Used;
+        }
+        else if (Rc == HYUN_APP_XBEE_ERR_SHORT)
+        {
+            break;
+        }
+        else
+        {
+            BadFrames++;
+            Pos++;
+            while (Pos < WireLen && Wire[Pos] != HYUN_APP_XBEE_START)
+            {
+                Pos++;
+            }
+        }
+    }
+
+    WirePerPkt = (double)WireLen / (double)Packets;
+    printf("%-10s %5zu %8ld %8lu %8lu %10.0f %10.0f %7.2f %9.1f %s\n", Class->Name, Class->Size, Packets,
+           (unsigned long)Xbee.FrameCounter, (unsigned long)Xbee.DropCounter, (double)Xbee.FrameCounter / Elapsed,
+           (double)WireLen / Elapsed, WirePerPkt / (double)Class->Size,
+           (double)HYUN_APP_XbeeBudget(&Xbee) / WirePerPkt,
+           (BackLen == SentLen && memcmp(Back, Sent, SentLen) == 0 && BadFrames == 0) ? "ok" : "MISMATCH");
+
+    HYUN_APP_XbeeClose(&Xbee);
+
+    return (BackLen == SentLen && memcmp(Back, Sent, SentLen) == 0 && BadFrames == 0) ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    static const PtyClass_t Classes[] = {
+        {"char20", 36, 0}, {"hk", 200, 0}, {"random", 120, 1}, {"worst", 100, 2},
+    };
+    uint32 Baud    = (argc > 1) ? (uint32)atol(argv[1]) : 9600;
+    long   Packets = (argc > 2) ? atol(argv[2]) : 2000;
+    char   Slave[64];
+    int    Master;
+    int    Failed = 0;
+    size_t c;
+
+    srand(1);
+
+    Master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (Master < 0 || grantpt(Master) != 0 || unlockpt(Master) != 0)
+    {
+        perror("posix_openpt");
+        return 1;
+    }
+    snprintf(Slave, sizeof(Slave), "%s", ptsname(Master));
+    fcntl(Master, F_SETFL, fcntl(Master, F_GETFL) | O_NONBLOCK);
+
+    printf("%s at %lu baud, %lu B/s budget\n", Slave, (unsigned long)Baud, (unsigned long)(Baud / 10));
+    printf("%-10s %5s %8s %8s %8s %10s %10s %7s %9s\n", "class", "size", "packets", "frames", "drops", "frames/s",
+           "bytes/s", "wire/pl", "pkt/s@bd");
+
+    for (c = 0; c < sizeof(Classes) / sizeof(Classes[0]); c++)
+    {
+        Failed |= RunClass(&Classes[c], Master, Slave, Baud, Packets);
+    }
+
+    close(Master);
+    return Failed;
+}
@@ -0,0 +1,408 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2019 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_hyun_app_align.c
+**
+** Purpose:
+** Coverage Unit Test cases for the HYUN_APP sensor alignment
+**
+** Notes:
+** Built with the estimator; the replay clock, flight state machine
+** and telemetry senders are replaced by counting stand-ins below.
+*/
+
+/*
+ * Includes
+ */
+
+#include <string.h>
+
+#include "hyun_app_coveragetest_common.h"
+#include "ut_hyun_app.h"
+
+HYUN_APP_Data_t HYUN_APP_Data;
+
+/*
+ * MET returned by the HYUN_APP_SysTimeToUsec stand-in
+ */
+static uint64 UT_NowUs;
+
+static uint32 UT_FlightProcessCount;
+static uint64 UT_FlightArrivalUs;
+static uint32 UT_SendEstimateCount;
+static uint32 UT_DownlinkSendCount;
+
+uint64 HYUN_APP_SysTimeToUsec(CFE_TIME_SysTime_t Time)
+{
+    (void)Time;
+
+    return UT_NowUs;
+}
+
+uint64 HYUN_APP_ReplayNowUs(uint64 WallUs)
+{
+    return WallUs;
+}
+
+int32 HYUN_APP_FlightProcess(const HYUN_APP_Table_t *TblPtr, uint64 ArrivalUs)
+{
+    (void)TblPtr;
+
+    UT_FlightProcessCount++;
+    UT_FlightArrivalUs = ArrivalUs;
+    return CFE_SUCCESS;
+}
+
+int32 HYUN_APP_SendEstimate(void)
+{
+    UT_SendEstimateCount++;
+    return CFE_SUCCESS;
+}
+
+int32 HYUN_APP_DownlinkSend(CFE_MSG_Message_t *MsgPtr)
+{
+    (void)MsgPtr;
+
+    UT_DownlinkSendCount++;
+    return CFE_SUCCESS;
+}
+
+/*
+ * Ring writers, arrival 1 ms (baro) / 0.5 ms (IMU) after the sample time
+ */
+static void UT_Align_PushBaro(uint64 TimeUs, float Altitude)
+{
+    HYUN_APP_BaroRing_t *Baro = &HYUN_APP_Data.Sensor.Baro;
+    uint32               Idx  = HYUN_APP_RING_INDEX(Baro->Head, HYUN_APP_BARO_RING_SIZE);
+
+    Baro->TimeUs[Idx]       = TimeUs;
+    Baro->ArrivalUs[Idx]    = TimeUs + 1000;
+    Baro->Pressure[Idx]     = 101325.0f - 12.0f * Altitude;
+    Baro->Altitude[Idx]     = Altitude;
+    Baro->AltitudeFilt[Idx] = Altitude;
+    Baro->Temperature[Idx]  = 20.0f;
+    Baro->Head++;
+}
+
+static void UT_Align_PushImu(uint64 TimeUs, float AccelZ)
+{
+    HYUN_APP_ImuRing_t *Imu = &HYUN_APP_Data.Sensor.Imu;
+    uint32              Idx = HYUN_APP_RING_INDEX(Imu->Head, HYUN_APP_IMU_RING_SIZE);
+
+    Imu->TimeUs[Idx]    = TimeUs;
+    Imu->ArrivalUs[Idx] = TimeUs + 500;
+    Imu->AccelX[Idx]    = 0.0f;
+    Imu->AccelY[Idx]    = 0.0f;
+    Imu->AccelZ[Idx]    = AccelZ;
+    Imu->GyroX[Idx]     = 0.0f;
+    Imu->GyroY[Idx]     = 0.0f;
+    Imu->GyroZ[Idx]     = 0.0f;
+    Imu->Head++;
+}
+
+static void UT_Align_PushGps(uint64 TimeUs, int32 LatitudeE7, bool FixValid)
+{
+    HYUN_APP_GpsRing_t *Gps = &HYUN_APP_Data.Sensor.Gps;
+    uint32              Idx = HYUN_APP_RING_INDEX(Gps->Head, HYUN_APP_GPS_RING_SIZE);
+
+    Gps->TimeUs[Idx]      = TimeUs;
+    Gps->LatitudeE7[Idx]  = LatitudeE7;
+    Gps->LongitudeE7[Idx] = -LatitudeE7;
+    Gps->Altitude[Idx]    = 0.0f;
+    Gps->Satellites[Idx]  = 7;
+    Gps->FixValid[Idx]    = FixValid;
+    Gps->Head++;
+}
+
+/*
+ * Baro every 50 ms and IMU every 5 ms over [FromUs, ToUs], on the pad
+ */
+static void UT_Align_Fill(uint64 FromUs, uint64 ToUs)
+{
+    uint64 t;
+
+    for (t = FromUs; t <= ToUs; t += 5000)
+    {
+        if (t % 50000 == 0)
+        {
+            UT_Align_PushBaro(t, 0.0f);
+        }
+        UT_Align_PushImu(t, HYUN_APP_KF_GRAVITY);
+    }
+}
+
+/*
+**********************************************************************************
+**          TEST CASE FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_HYUN_APP_AlignInit(void)
+{
+    /*
+     * Test Case For:
+     * void HYUN_APP_AlignInit(HYUN_APP_Align_t *Align)
+     */
+    HYUN_APP_Align_t Align;
+
+    memset(&Align, 0xA5, sizeof(Align));
+    HYUN_APP_AlignInit(&Align);
+
+    UtAssert_True(!Align.Started, "Waiting for the first sample");
+    UtAssert_True(Align.PeriodUs == HYUN_APP_ALIGN_DEFAULT_PERIOD_MS * 1000u, "PeriodUs (%lu) is the default",
+                  (unsigned long)Align.PeriodUs);
+    UtAssert_True(Align.MaxLatencyUs == HYUN_APP_ALIGN_DEFAULT_MAX_LATENCY_MS * 1000u,
+                  "MaxLatencyUs (%lu) is the default", (unsigned long)Align.MaxLatencyUs);
+    UtAssert_True(Align.FrameCounter == 0 && Align.HoldCounter == 0 && Align.SkipCounter == 0, "Counters cleared");
+}
+
+void Test_HYUN_APP_AlignSample(void)
+{
+    /*
+     * Test Case For:
+     * uint8 HYUN_APP_AlignSample(const HYUN_APP_SensorData_t *Sensor, uint64 TickUs,
+     *                            HYUN_APP_AlignedTlm_Payload_t *Out)
+     */
+    HYUN_APP_AlignedTlm_Payload_t Frame;
+    uint64                        t;
+    uint8                         HoldMask;
+
+    memset(&Frame, 0, sizeof(Frame));
+
+    /* Nothing in the rings */
+    HoldMask = HYUN_APP_AlignSample(&HYUN_APP_Data.Sensor, 50000, &Frame);
+    UtAssert_True(HoldMask == 0 && Frame.ValidMask == 0, "No streams without data");
+
+    UT_Align_PushBaro(0, 0.0f);
+    UT_Align_PushBaro(100000, 10.0f);
+    for (t = 0; t <= 100000; t += 5000)
+    {
+        UT_Align_PushImu(t, (float)t * 1.0e-3f);
+    }
+
+    /* Bracketed: linear interpolation */
+    HoldMask = HYUN_APP_AlignSample(&HYUN_APP_Data.Sensor, 52500, &Frame);
+    UtAssert_True(HoldMask == 0, "HoldMask (0x%x) == 0", (unsigned int)HoldMask);
+    UtAssert_True(Frame.ValidMask == HYUN_APP_ALIGN_FAST_STREAMS, "ValidMask (0x%x) == baro | IMU",
+                  (unsigned int)Frame.ValidMask);
+    UtAssert_DoubleCmpAbs(Frame.Altitude, 5.25f, 1.0e-4, "Altitude (%f) == 5.25", (double)Frame.Altitude);
+    UtAssert_DoubleCmpAbs(Frame.Accel[2], 52.5f, 1.0e-3, "AccelZ (%f) == 52.5", (double)Frame.Accel[2]);
+
+    /* On a sample: that sample */
+    HYUN_APP_AlignSample(&HYUN_APP_Data.Sensor, 100000, &Frame);
+    UtAssert_True(Frame.Altitude == 10.0f, "Altitude (%f) == 10 on the sample", (double)Frame.Altitude);
+
+    /* Past the newest sample: held */
+    HoldMask = HYUN_APP_AlignSample(&HYUN_APP_Data.Sensor, 150000, &Frame);
+    UtAssert_True(HoldMask == HYUN_APP_ALIGN_FAST_STREAMS, "HoldMask (0x%x) == baro | IMU", (unsigned int)HoldMask);
+    UtAssert_True(Frame.Altitude == 10.0f, "Altitude (%f) held at the newest sample", (double)Frame.Altitude);
+    UtAssert_DoubleCmpAbs(Frame.Accel[2], 100.0f, 1.0e-3, "AccelZ (%f) held at the newest sample",
+                          (double)Frame.Accel[2]);
+
+    /* GPS coordinates are interpolated between valid fixes only */
+    UT_Align_PushGps(0, 100, true);
+    UT_Align_PushGps(1000000, 300, true);
+    HYUN_APP_AlignSample(&HYUN_APP_Data.Sensor, 500000, &Frame);
+    UtAssert_True(Frame.ValidMask & HYUN_APP_ALIGN_GPS, "GPS valid");
+    UtAssert_True(Frame.LatitudeE7 == 200 && Frame.LongitudeE7 == -200, "LatitudeE7 (%ld) == 200",
+                  (long)Frame.LatitudeE7);
+    UtAssert_True(Frame.GpsSatellites == 7, "GpsSatellites (%u) == 7", (unsigned int)Frame.GpsSatellites);
+
+    UT_Align_PushGps(2000000, 900, false);
+    HYUN_APP_AlignSample(&HYUN_APP_Data.Sensor, 1500000, &Frame);
+    UtAssert_True(Frame.LatitudeE7 == 300, "LatitudeE7 (%ld) held before an invalid fix", (long)Frame.LatitudeE7);
+    UtAssert_True(!(Frame.HoldMask & HYUN_APP_ALIGN_GPS), "Still bracketed, not a hold");
+    UtAssert_True(!(Frame.ValidMask & HYUN_APP_ALIGN_VOLTAGE), "No voltage samples");
+}
+
+void Test_HYUN_APP_AlignEstimate(void)
+{
+    /*
+     * Test Case For:
+     * uint64 HYUN_APP_AlignEstimate(HYUN_APP_KF_t *Kf, const HYUN_APP_SensorData_t *Sensor, uint64 TickUs,
+     *                               const HYUN_APP_AlignedTlm_Payload_t *Frame)
+     */
+    HYUN_APP_AlignedTlm_Payload_t Frame;
+    HYUN_APP_KF_t                 Kf;
+    uint64                        ArrivalUs;
+    uint64                        t;
+
+    HYUN_APP_KF_Init(&Kf, 2);
+    UT_Align_PushBaro(0, 0.0f);
+    UT_Align_PushBaro(100000, 10.0f);
+    for (t = 5000; t <= 150000; t += 5000)
+    {
+        UT_Align_PushImu(t, HYUN_APP_KF_GRAVITY);
+    }
+
+    /* Every IMU sample up to the tick, then the baro at the tick */
+    HYUN_APP_AlignSample(&HYUN_APP_Data.Sensor, 100000, &Frame);
+    ArrivalUs = HYUN_APP_AlignEstimate(&Kf, &HYUN_APP_Data.Sensor, 100000, &Frame);
+    UtAssert_True(Kf.PredictCounter == 19, "PredictCounter (%lu) == 19", (unsigned long)Kf.PredictCounter);
+    UtAssert_True(Kf.LastTimeUs == 100000, "LastTimeUs (%lu) == 100000", (unsigned long)Kf.LastTimeUs);
+    UtAssert_True(Kf.Initialized && Kf.X[HYUN_APP_KF_STATE_ALT] == 10.0f, "Seeded by the baro (%f)",
+                  (double)Kf.X[HYUN_APP_KF_STATE_ALT]);
+    UtAssert_True(ArrivalUs == 101000, "ArrivalUs (%lu) is the baro arrival", (unsigned long)ArrivalUs);
+
+    /* A held baro is not fused again, the newest IMU sample sets the arrival */
+    HYUN_APP_AlignSample(&HYUN_APP_Data.Sensor, 200000, &Frame);
+    ArrivalUs = HYUN_APP_AlignEstimate(&Kf, &HYUN_APP_Data.Sensor, 200000, &Frame);
+    UtAssert_True(Kf.PredictCounter == 30, "PredictCounter (%lu) == 30", (unsigned long)Kf.PredictCounter);
+    UtAssert_True(Kf.UpdateCounter == 0, "UpdateCounter (%lu) == 0", (unsigned long)Kf.UpdateCounter);
+    UtAssert_True(ArrivalUs == 150500, "ArrivalUs (%lu) == 150500", (unsigned long)ArrivalUs);
+
+    /* Nothing new: only the prediction to the tick */
+    HYUN_APP_AlignSample(&HYUN_APP_Data.Sensor, 300000, &Frame);
+    ArrivalUs = HYUN_APP_AlignEstimate(&Kf, &HYUN_APP_Data.Sensor, 300000, &Frame);
+    UtAssert_True(ArrivalUs == 0, "ArrivalUs (%lu) == 0", (unsigned long)ArrivalUs);
+    UtAssert_True(Kf.PredictCounter == 31 && Kf.LastTimeUs == 300000, "Predicted to the tick");
+}
+
+void Test_HYUN_APP_AlignProcess(void)
+{
+    /*
+     * Test Case For:
+     * int32 HYUN_APP_AlignProcess(const HYUN_APP_Table_t *TblPtr)
+     */
+    HYUN_APP_Align_t *Align = &HYUN_APP_Data.Align;
+
+    /* Not started on empty rings */
+    UT_NowUs = 1000000;
+    UtAssert_True(HYUN_APP_AlignProcess(NULL) == CFE_SUCCESS, "AlignProcess() == CFE_SUCCESS");
+    UtAssert_True(!Align->Started && UT_SendEstimateCount == 0, "Nothing emitted without data");
+
+    /* The first sample starts the grid */
+    UT_Align_Fill(0, 0);
+    UT_NowUs = 0;
+    HYUN_APP_AlignProcess(NULL);
+    UtAssert_True(Align->Started && Align->FrameCounter == 1, "FrameCounter (%lu) == 1",
+                  (unsigned long)Align->FrameCounter);
+    UtAssert_True(Align->NextTickUs == 100000, "NextTickUs (%lu) == 100000", (unsigned long)Align->NextTickUs);
+
+    /* Complete ticks are emitted, the pending one waits */
+    UT_Align_Fill(5000, 250000);
+    UT_NowUs = 260000;
+    HYUN_APP_AlignProcess(NULL);
+    UtAssert_True(Align->FrameCounter == 3, "FrameCounter (%lu) == 3", (unsigned long)Align->FrameCounter);
+    UtAssert_True(Align->LastLatencyUs == 60000, "LastLatencyUs (%lu) == 60000", (unsigned long)Align->LastLatencyUs);
+    UtAssert_True(HYUN_APP_Data.AlignedTlm.Payload.FrameCounter == 3, "Frame counter in the telemetry");
+
+    UT_NowUs = 350000;
+    HYUN_APP_AlignProcess(NULL);
+    UtAssert_True(Align->FrameCounter == 3 && Align->HoldCounter == 0, "Tick 300 ms waits for the fast streams");
+
+    /* At the latency bound the tick goes out held */
+    UT_NowUs = 400000;
+    HYUN_APP_AlignProcess(NULL);
+    UtAssert_True(Align->FrameCounter == 4 && Align->HoldCounter == 1, "HoldCounter (%lu) == 1",
+                  (unsigned long)Align->HoldCounter);
+    UtAssert_True(Align->LastLatencyUs == 100000, "LastLatencyUs (%lu) == 100000", (unsigned long)Align->LastLatencyUs);
+    UtAssert_True(Align->MaxAddedLatencyUs == 160000, "MaxAddedLatencyUs (%lu) from the 100 ms tick",
+                  (unsigned long)Align->MaxAddedLatencyUs);
+
+    /* A stall skips to the ticks still within the bound */
+    UT_NowUs = 5000000;
+    HYUN_APP_AlignProcess(NULL);
+    UtAssert_True(Align->SkipCounter == 45, "SkipCounter (%lu) == 45", (unsigned long)Align->SkipCounter);
+    UtAssert_True(Align->FrameCounter == 5, "FrameCounter (%lu) == 5", (unsigned long)Align->FrameCounter);
+    UtAssert_True(Align->NextTickUs == 5000000, "NextTickUs (%lu) == 5000000", (unsigned long)Align->NextTickUs);
+
+    /* Without a table the flight state machine does not run */
+    UtAssert_True(UT_SendEstimateCount == 5, "SendEstimate count (%lu) == 5", (unsigned long)UT_SendEstimateCount);
+    UtAssert_True(UT_FlightProcessCount == 0, "FlightProcess not called");
+    UtAssert_True(UT_DownlinkSendCount == 0, "No frames while telemetry is off");
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_MSG_SetMsgTime)) == 5, "Every frame stamped with its tick");
+}
+
+void Test_HYUN_APP_AlignProcess_Table(void)
+{
+    /*
+     * Test Case For:
+     * Period and latency bound from the table, flight and downlink per frame
+     */
+    HYUN_APP_Align_t *Align = &HYUN_APP_Data.Align;
+    HYUN_APP_Table_t  Tbl;
+
+    memset(&Tbl, 0, sizeof(Tbl));
+    Tbl.AlignPeriodMs     = 50;
+    Tbl.AlignMaxLatencyMs = 20;
+
+    HYUN_APP_Data.TelemetryEnabled = true;
+
+    UT_Align_Fill(0, 0);
+    UT_NowUs = 0;
+    HYUN_APP_AlignProcess(&Tbl);
+    UtAssert_True(Align->PeriodUs == 50000 && Align->MaxLatencyUs == 20000, "Period and bound from the table");
+
+    UT_Align_Fill(5000, 200000);
+    UT_NowUs = 205000;
+    HYUN_APP_AlignProcess(&Tbl);
+    UtAssert_True(Align->FrameCounter == 5, "FrameCounter (%lu) == 5", (unsigned long)Align->FrameCounter);
+    UtAssert_True(UT_FlightProcessCount == 5, "FlightProcess count (%lu) == 5", (unsigned long)UT_FlightProcessCount);
+    UtAssert_True(UT_FlightArrivalUs == 201000, "ArrivalUs (%lu) of the 200 ms baro",
+                  (unsigned long)UT_FlightArrivalUs);
+    UtAssert_True(UT_DownlinkSendCount == 5, "DownlinkSend count (%lu) == 5", (unsigned long)UT_DownlinkSendCount);
+
+    /* The 250 ms tick is held after 20 ms */
+    UT_NowUs = 269000;
+    HYUN_APP_AlignProcess(&Tbl);
+    UtAssert_True(Align->FrameCounter == 5, "Waiting within the bound");
+    UT_NowUs = 270000;
+    HYUN_APP_AlignProcess(&Tbl);
+    UtAssert_True(Align->FrameCounter == 6 && Align->HoldCounter == 1, "Held at the bound");
+    UtAssert_True(HYUN_APP_Data.AlignedTlm.Payload.HoldMask == HYUN_APP_ALIGN_FAST_STREAMS,
+                  "HoldMask (0x%x) == baro | IMU", (unsigned int)HYUN_APP_Data.AlignedTlm.Payload.HoldMask);
+}
+
+/*
+ * Setup function prior to every test
+ */
+void Hyun_UT_Setup(void)
+{
+    UT_ResetState(0);
+
+    memset(&HYUN_APP_Data, 0, sizeof(HYUN_APP_Data));
+    HYUN_APP_KF_Init(&HYUN_APP_Data.Kf, 2);
+    HYUN_APP_AlignInit(&HYUN_APP_Data.Align);
+
+    UT_NowUs              = 0;
+    UT_FlightProcessCount = 0;
+    UT_FlightArrivalUs    = 0;
+    UT_SendEstimateCount  = 0;
+    UT_DownlinkSendCount  = 0;
+}
+
+/*
+ * Teardown function after every test
+ */
+void Hyun_UT_TearDown(void) {}
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    ADD_TEST(HYUN_APP_AlignInit);
+    ADD_TEST(HYUN_APP_AlignSample);
+    ADD_TEST(HYUN_APP_AlignEstimate);
+    ADD_TEST(HYUN_APP_AlignProcess);
+    ADD_TEST(HYUN_APP_AlignProcess_Table);
+}
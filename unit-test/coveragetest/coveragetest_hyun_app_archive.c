@@ -0,0 +1,211 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2019 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_hyun_app_archive.c
+**
+** Purpose:
+** Coverage Unit Test cases for the HYUN_APP time-indexed packet archive
+**
+** Notes:
+** Only the block and index bookkeeping is covered here; file I/O and
+** range queries are exercised by the host reader under tools/.
+*/
+
+/*
+ * Includes
+ */
+
+#include <string.h>
+
+#include "hyun_app_coveragetest_common.h"
+#include "hyun_app_archive.h"
+
+static HYUN_APP_ArchiveBlock_t UT_Block;
+
+/*
+**********************************************************************************
+**          TEST CASE FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_HYUN_APP_ArchiveHdrInit(void)
+{
+    /*
+     * Test Case For:
+     * void HYUN_APP_ArchiveHdrInit(HYUN_APP_ArchiveHdr_t *Hdr, uint32 Magic)
+     * bool HYUN_APP_ArchiveHdrValid(const HYUN_APP_ArchiveHdr_t *Hdr, uint32 Magic)
+     */
+    HYUN_APP_ArchiveHdr_t Hdr;
+
+    memset(&Hdr, 0xA5, sizeof(Hdr));
+    HYUN_APP_ArchiveHdrInit(&Hdr, HYUN_APP_ARCHIVE_DATA_MAGIC);
+
+    UtAssert_True(Hdr.Magic == HYUN_APP_ARCHIVE_DATA_MAGIC, "Data file magic");
+    UtAssert_True(Hdr.Version == HYUN_APP_ARCHIVE_VERSION, "Version (%u)", (unsigned int)Hdr.Version);
+    UtAssert_True(Hdr.HeaderSize == sizeof(Hdr), "HeaderSize (%u)", (unsigned int)Hdr.HeaderSize);
+    UtAssert_True(Hdr.EntrySize == 0 && Hdr.spare == 0, "No entry size in the data file");
+    UtAssert_True(HYUN_APP_ArchiveHdrValid(&Hdr, HYUN_APP_ARCHIVE_DATA_MAGIC), "Data header valid");
+    UtAssert_True(!HYUN_APP_ArchiveHdrValid(&Hdr, HYUN_APP_ARCHIVE_INDEX_MAGIC), "Not an index header");
+
+    HYUN_APP_ArchiveHdrInit(&Hdr, HYUN_APP_ARCHIVE_INDEX_MAGIC);
+    UtAssert_True(Hdr.EntrySize == sizeof(HYUN_APP_ArchiveIndex_t), "Index EntrySize (%lu)",
+                  (unsigned long)Hdr.EntrySize);
+    UtAssert_True(HYUN_APP_ArchiveHdrValid(&Hdr, HYUN_APP_ARCHIVE_INDEX_MAGIC), "Index header valid");
+
+    /* Another version or entry layout is refused */
+    Hdr.Version++;
+    UtAssert_True(!HYUN_APP_ArchiveHdrValid(&Hdr, HYUN_APP_ARCHIVE_INDEX_MAGIC), "Wrong version refused");
+    HYUN_APP_ArchiveHdrInit(&Hdr, HYUN_APP_ARCHIVE_INDEX_MAGIC);
+    Hdr.EntrySize += 8;
+    UtAssert_True(!HYUN_APP_ArchiveHdrValid(&Hdr, HYUN_APP_ARCHIVE_INDEX_MAGIC), "Wrong EntrySize refused");
+}
+
+void Test_HYUN_APP_ArchiveAppend(void)
+{
+    /*
+     * Test Case For:
+     * bool HYUN_APP_ArchiveAppend(HYUN_APP_ArchiveBlock_t *Block, uint64 TimeUs, uint16 MsgId, const void *Packet,
+     *                             uint16 Length)
+     */
+    HYUN_APP_ArchiveRec_t Rec;
+    uint8                 Packet[HYUN_APP_ARCHIVE_BLOCK_SIZE];
+
+    memset(Packet, 0x3C, sizeof(Packet));
+
+    UtAssert_True(HYUN_APP_ArchiveAppend(&UT_Block, 1000, 0x0801, Packet, 20), "First record");
+    UtAssert_True(HYUN_APP_ArchiveAppend(&UT_Block, 3000, 0x0842, Packet, 4), "Second record");
+
+    /* Records are packed, header then packet */
+    memcpy(&Rec, &UT_Block.Data[0], sizeof(Rec));
+    UtAssert_True(Rec.TimeUs == 1000 && Rec.MsgId == 0x0801 && Rec.Length == 20, "First record header");
+    UtAssert_True(Rec.Sync == HYUN_APP_ARCHIVE_SYNC, "First record sync word");
+    UtAssert_True(UT_Block.Data[sizeof(Rec)] == 0x3C && UT_Block.Data[sizeof(Rec) + 19] == 0x3C, "First packet");
+    memcpy(&Rec, &UT_Block.Data[sizeof(Rec) + 20], sizeof(Rec));
+    UtAssert_True(Rec.TimeUs == 3000 && Rec.MsgId == 0x0842 && Rec.Sync == HYUN_APP_ARCHIVE_SYNC,
+                  "Second record follows the first packet");
+
+    UtAssert_True(UT_Block.Entry.Count == 2, "Count (%lu) == 2", (unsigned long)UT_Block.Entry.Count);
+    UtAssert_True(UT_Block.Entry.Length == 2 * sizeof(Rec) + 24, "Length (%lu)", (unsigned long)UT_Block.Entry.Length);
+    UtAssert_True(UT_Block.Entry.MidMask == (HYUN_APP_ARCHIVE_MID_BIT(0x0801) | HYUN_APP_ARCHIVE_MID_BIT(0x0842)),
+                  "MidMask holds both MIDs");
+    UtAssert_True(UT_Block.Entry.MinTimeUs == 1000 && UT_Block.Entry.MaxTimeUs == 3000, "Time bounds");
+    UtAssert_True(UT_Block.Entry.LateUs == 0, "In order, nothing late");
+
+    /* A step back lowers the minimum and is kept as LateUs, the maximum stays */
+    UtAssert_True(HYUN_APP_ArchiveAppend(&UT_Block, 500, 0x0801, Packet, 0), "Late record");
+    UtAssert_True(UT_Block.Entry.MinTimeUs == 500 && UT_Block.Entry.MaxTimeUs == 3000, "Bounds after step back");
+    UtAssert_True(UT_Block.Entry.LateUs == 2500, "LateUs (%lu) == 2500", (unsigned long)UT_Block.Entry.LateUs);
+    UtAssert_True(HYUN_APP_ArchiveAppend(&UT_Block, 2000, 0x0801, Packet, 0), "Smaller step back");
+    UtAssert_True(UT_Block.Entry.LateUs == 2500, "LateUs keeps the largest step");
+
+    /* A step back past the 32-bit range saturates */
+    UtAssert_True(HYUN_APP_ArchiveAppend(&UT_Block, 0x200000000ull, 0x0801, Packet, 0), "Time jumps ahead");
+    UtAssert_True(HYUN_APP_ArchiveAppend(&UT_Block, 100, 0x0801, Packet, 0), "Time base restarted");
+    UtAssert_True(UT_Block.Entry.LateUs == HYUN_APP_ARCHIVE_LATE_UNBOUNDED, "LateUs unbounded");
+
+    /* Oversized packets never fit, even in an empty block */
+    HYUN_APP_ArchiveBlockInit(&UT_Block, 0, NULL);
+    UtAssert_True(!HYUN_APP_ArchiveAppend(&UT_Block, 1000, 0x0801, Packet, HYUN_APP_ARCHIVE_MAX_PACKET + 1),
+                  "Oversized packet refused");
+    UtAssert_True(UT_Block.Entry.Count == 0 && UT_Block.Entry.Length == 0, "Block untouched");
+    UtAssert_True(HYUN_APP_ArchiveAppend(&UT_Block, 1000, 0x0801, Packet, HYUN_APP_ARCHIVE_MAX_PACKET),
+                  "Largest packet fills the block");
+    UtAssert_True(UT_Block.Entry.Length == HYUN_APP_ARCHIVE_BLOCK_SIZE, "Block full");
+    UtAssert_True(!HYUN_APP_ArchiveAppend(&UT_Block, 1000, 0x0801, Packet, 0), "Not even an empty record fits");
+}
+
+void Test_HYUN_APP_ArchiveBlockNext(void)
+{
+    /*
+     * Test Case For:
+     * void HYUN_APP_ArchiveBlockInit(HYUN_APP_ArchiveBlock_t *Block, uint64 Offset,
+     *                                const HYUN_APP_ArchiveIndex_t *Last)
+     * void HYUN_APP_ArchiveBlockNext(HYUN_APP_ArchiveBlock_t *Block)
+     */
+    HYUN_APP_ArchiveIndex_t Last;
+    uint8                   Packet[100];
+    uint64                  TimeUs = 10000;
+    uint32                  Records;
+    uint32                  Length;
+
+    memset(Packet, 0, sizeof(Packet));
+
+    /* Fill the first block the way the recorder does */
+    HYUN_APP_ArchiveBlockInit(&UT_Block, sizeof(HYUN_APP_ArchiveHdr_t), NULL);
+    while (HYUN_APP_ArchiveAppend(&UT_Block, TimeUs, 0x0801, Packet, sizeof(Packet)))
+    {
+        TimeUs += 1000;
+    }
+
+    Records = HYUN_APP_ARCHIVE_BLOCK_SIZE / (sizeof(HYUN_APP_ArchiveRec_t) + sizeof(Packet));
+    Length  = Records * (sizeof(HYUN_APP_ArchiveRec_t) + sizeof(Packet));
+    UtAssert_True(UT_Block.Entry.Count == Records, "Count (%lu) == %lu", (unsigned long)UT_Block.Entry.Count,
+                  (unsigned long)Records);
+    UtAssert_True(UT_Block.Entry.Length == Length, "Length (%lu)", (unsigned long)UT_Block.Entry.Length);
+
+    /* The next block follows in the file and carries the running fields */
+    UT_Block.Entry.LateUs = 700;
+    Last                  = UT_Block.Entry;
+    HYUN_APP_ArchiveBlockNext(&UT_Block);
+
+    UtAssert_True(UT_Block.Entry.Offset == sizeof(HYUN_APP_ArchiveHdr_t) + Length, "Offset advanced");
+    UtAssert_True(UT_Block.Entry.Count == 0 && UT_Block.Entry.Length == 0, "Block emptied");
+    UtAssert_True(UT_Block.Entry.MinTimeUs == 0 && UT_Block.Entry.MidMask == 0, "Block fields cleared");
+    UtAssert_True(UT_Block.Entry.MaxTimeUs == Last.MaxTimeUs && UT_Block.Entry.LateUs == 700,
+                  "Running MaxTimeUs / LateUs kept");
+
+    UtAssert_True(HYUN_APP_ArchiveAppend(&UT_Block, TimeUs - 3000, 0x0843, Packet, 0), "Late into the next block");
+    UtAssert_True(UT_Block.Entry.MinTimeUs == TimeUs - 3000, "MinTimeUs of this block only");
+    UtAssert_True(UT_Block.Entry.LateUs == 2000, "LateUs (%lu) against the running maximum",
+                  (unsigned long)UT_Block.Entry.LateUs);
+    UtAssert_True(UT_Block.Entry.MidMask == HYUN_APP_ARCHIVE_MID_BIT(0x0843), "MidMask of this block only");
+
+    /* Reopening an archive resumes from its last index entry */
+    HYUN_APP_ArchiveBlockInit(&UT_Block, 123456, &Last);
+    UtAssert_True(UT_Block.Entry.Offset == 123456 && UT_Block.Entry.Count == 0, "Resumed at the data file end");
+    UtAssert_True(UT_Block.Entry.MaxTimeUs == Last.MaxTimeUs && UT_Block.Entry.LateUs == Last.LateUs,
+                  "Running fields resumed");
+    UtAssert_True(UT_Block.Entry.MinTimeUs == 0 && UT_Block.Entry.MidMask == 0, "Block fields not resumed");
+}
+
+/*
+ * Setup function prior to every test
+ */
+void Hyun_UT_Setup(void)
+{
+    UT_ResetState(0);
+    HYUN_APP_ArchiveBlockInit(&UT_Block, 0, NULL);
+}
+
+/*
+ * Teardown function after every test
+ */
+void Hyun_UT_TearDown(void) {}
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    ADD_TEST(HYUN_APP_ArchiveHdrInit);
+    ADD_TEST(HYUN_APP_ArchiveAppend);
+    ADD_TEST(HYUN_APP_ArchiveBlockNext);
+}
@@ -0,0 +1,339 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2019 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_hyun_app_codec.c
+**
+** Purpose:
+** Coverage Unit Test cases for the HYUN_APP downlink codecs
+*/
+
+/*
+ * Includes
+ */
+
+#include <string.h>
+
+#include "hyun_app_coveragetest_common.h"
+#include "hyun_app_codec.h"
+
+#define UT_CODEC_TEXT "$HYUN,1042,ASCENT,00123.4,00012.5,4807.0380N,01131.0000E,07,8.12*3A\r\n"
+
+/*
+ * Repeatable noise for incompressible payloads
+ */
+static void UT_Codec_Noise(uint8 *Out, size_t Len, uint32 Seed)
+{
+    size_t i;
+
+    for (i = 0; i < Len; i++)
+    {
+        Seed   = Seed * 1103515245u + 12345u;
+        Out[i] = (uint8)(Seed >> 16);
+    }
+}
+
+/*
+ * Telemetry-like payload: a counter, one moving float, then status words
+ * that rarely change
+ */
+static void UT_Codec_Payload(uint8 *Out, size_t Len, uint32 Frame)
+{
+    float  Value = 100.0f + 0.25f * (float)(Frame % 8);
+    uint32 Word;
+    size_t Off;
+
+    memcpy(Out, &Frame, sizeof(Frame));
+    memcpy(&Out[4], &Value, sizeof(Value));
+    for (Off = 8; Off + 4 <= Len; Off += 4)
+    {
+        Word = (uint32)Off;
+        memcpy(&Out[Off], &Word, sizeof(Word));
+    }
+}
+
+/*
+**********************************************************************************
+**          TEST CASE FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_HYUN_APP_Delta(void)
+{
+    /*
+     * Test Case For:
+     * size_t HYUN_APP_DeltaEncode(const uint8 *Ref, const uint8 *In, size_t Len, uint8 *Out, size_t OutSize)
+     * size_t HYUN_APP_DeltaDecode(const uint8 *Ref, const uint8 *In, size_t InLen, uint8 *Out, size_t OutLen)
+     */
+    uint8  Ref[HYUN_APP_CODEC_MAX_PAYLOAD];
+    uint8  In[HYUN_APP_CODEC_MAX_PAYLOAD];
+    uint8  Out[HYUN_APP_CODEC_MAX_PAYLOAD];
+    uint8  Data[HYUN_APP_CODEC_MAX_DATA];
+    size_t Size;
+    size_t Len;
+
+    /* Unchanged words cost one byte each, a tail shorter than a word included */
+    UT_Codec_Noise(Ref, sizeof(Ref), 1);
+    memcpy(In, Ref, sizeof(In));
+    Size = HYUN_APP_DeltaEncode(Ref, In, 13, Data, sizeof(Data));
+    UtAssert_True(Size == 4, "Size (%lu) == 4", (unsigned long)Size);
+
+    /* Random payloads of every length round trip, including worst case words */
+    for (Len = 1; Len <= HYUN_APP_CODEC_MAX_PAYLOAD; Len++)
+    {
+        UT_Codec_Noise(In, Len, (uint32)Len);
+        Size = HYUN_APP_DeltaEncode(Ref, In, Len, Data, sizeof(Data));
+        memset(Out, 0, sizeof(Out));
+        if (Size == 0 || HYUN_APP_DeltaDecode(Ref, Data, Size, Out, Len) != Size || memcmp(In, Out, Len) != 0)
+        {
+            break;
+        }
+    }
+    UtAssert_True(Len > HYUN_APP_CODEC_MAX_PAYLOAD, "Round trip for every length (stopped at %lu)",
+                  (unsigned long)Len);
+
+    /* Small signed changes stay small */
+    memset(Ref, 0, 8);
+    memset(In, 0, 8);
+    In[0] = 1;
+    In[4] = 0xFF;
+    In[5] = 0xFF;
+    In[6] = 0xFF;
+    In[7] = 0xFF;
+    Size  = HYUN_APP_DeltaEncode(Ref, In, 8, Data, sizeof(Data));
+    UtAssert_True(Size == 2 && Data[0] == 2 && Data[1] == 1, "+1 / -1 zigzag to 2 / 1");
+
+    /* Output too small */
+    UT_Codec_Noise(In, 16, 7);
+    UtAssert_True(HYUN_APP_DeltaEncode(Ref, In, 16, Data, 3) == 0, "Encode fails when OutSize is too small");
+
+    /* Truncated or overlong varints */
+    Size = HYUN_APP_DeltaEncode(Ref, In, 16, Data, sizeof(Data));
+    UtAssert_True(HYUN_APP_DeltaDecode(Ref, Data, Size - 1, Out, 16) == 0, "Truncated input rejected");
+    memset(Data, 0x80, 6);
+    UtAssert_True(HYUN_APP_DeltaDecode(Ref, Data, 6, Out, 4) == 0, "Varint longer than 5 bytes rejected");
+}
+
+void Test_HYUN_APP_Lz(void)
+{
+    /*
+     * Test Case For:
+     * size_t HYUN_APP_LzEncode(const uint8 *In, size_t Len, uint8 *Out, size_t OutSize)
+     * size_t HYUN_APP_LzDecode(const uint8 *In, size_t InLen, uint8 *Out, size_t OutSize)
+     */
+    uint8  In[1200];
+    uint8  Out[1200];
+    uint8  Data[1400];
+    size_t Len;
+    size_t Size;
+
+    /* Repeated text frames compress and round trip */
+    Len = 0;
+    while (Len + sizeof(UT_CODEC_TEXT) - 1 <= 4 * (sizeof(UT_CODEC_TEXT) - 1))
+    {
+        memcpy(&In[Len], UT_CODEC_TEXT, sizeof(UT_CODEC_TEXT) - 1);
+        Len += sizeof(UT_CODEC_TEXT) - 1;
+    }
+    Size = HYUN_APP_LzEncode(In, Len, Data, sizeof(Data));
+    UtAssert_True(Size > 0 && Size < Len / 2, "Size (%lu) < half of %lu", (unsigned long)Size, (unsigned long)Len);
+    UtAssert_True(HYUN_APP_LzDecode(Data, Size, Out, sizeof(Out)) == Len && memcmp(In, Out, Len) == 0,
+                  "Text round trip");
+
+    /* A long run is one overlapping match with a 255-extended length */
+    memset(In, 'a', 1000);
+    Size = HYUN_APP_LzEncode(In, 1000, Data, sizeof(Data));
+    UtAssert_True(Size > 0 && Size < 16, "Run of 1000 in %lu bytes", (unsigned long)Size);
+    UtAssert_True(HYUN_APP_LzDecode(Data, Size, Out, sizeof(Out)) == 1000 && memcmp(In, Out, 1000) == 0,
+                  "Run round trip");
+
+    /* Noise is all literals, longer than one token can count */
+    UT_Codec_Noise(In, 1000, 3);
+    Size = HYUN_APP_LzEncode(In, 1000, Data, sizeof(Data));
+    UtAssert_True(Size > 1000, "Noise grows (%lu)", (unsigned long)Size);
+    UtAssert_True(HYUN_APP_LzDecode(Data, Size, Out, sizeof(Out)) == 1000 && memcmp(In, Out, 1000) == 0,
+                  "Noise round trip");
+    UtAssert_True(HYUN_APP_LzEncode(In, 1000, Data, 1000) == 0, "Encode fails when OutSize is too small");
+
+    /* Empty and short inputs */
+    Size = HYUN_APP_LzEncode(In, 3, Data, sizeof(Data));
+    UtAssert_True(Size == 4 && HYUN_APP_LzDecode(Data, Size, Out, 3) == 3, "Three literals");
+    UtAssert_True(HYUN_APP_LzEncode(In, 0, Data, sizeof(Data)) == 1, "Empty input is one token");
+
+    /* Corrupt blocks fail cleanly */
+    memset(In, 'a', 100);
+    Size = HYUN_APP_LzEncode(In, 100, Data, sizeof(Data));
+    UtAssert_True(HYUN_APP_LzDecode(Data, Size, Out, 50) == 0, "Output too small");
+    UtAssert_True(HYUN_APP_LzDecode(Data, 3, Out, sizeof(Out)) == 0, "Truncated offset");
+    Data[2] = 0;
+    Data[3] = 0;
+    UtAssert_True(HYUN_APP_LzDecode(Data, Size, Out, sizeof(Out)) == 0, "Offset 0");
+    Data[2] = 5;
+    UtAssert_True(HYUN_APP_LzDecode(Data, Size, Out, sizeof(Out)) == 0, "Offset before the start of the output");
+    Data[0] = 0xF0;
+    UtAssert_True(HYUN_APP_LzDecode(Data, 1, Out, sizeof(Out)) == 0, "Missing literal length extension");
+}
+
+void Test_HYUN_APP_CodecFrame_Delta(void)
+{
+    /*
+     * Test Case For:
+     * void  HYUN_APP_CodecStreamInit(HYUN_APP_CodecStream_t *Stream, uint16 MsgId, uint8 Codec)
+     * int32 HYUN_APP_CodecEncodeFrame(HYUN_APP_CodecStream_t *Stream, const uint8 *Payload, size_t Len,
+     *                                 HYUN_APP_CodecFrame_t *Frame)
+     * int32 HYUN_APP_CodecDecodeFrame(HYUN_APP_CodecStream_t *Stream, const HYUN_APP_CodecFrame_t *Frame,
+     *                                 uint8 *Payload, size_t PayloadSize)
+     */
+    HYUN_APP_CodecStream_t Tx;
+    HYUN_APP_CodecStream_t Rx;
+    HYUN_APP_CodecFrame_t  Frame;
+    uint8                  In[64];
+    uint8                  Out[64];
+    uint32                 n;
+    uint32                 Bad    = 0;
+    uint32                 Keys   = 0;
+    size_t                 Linked = 0;
+
+    HYUN_APP_CodecStreamInit(&Tx, 0x0881, HYUN_APP_CODEC_DELTA);
+    HYUN_APP_CodecStreamInit(&Rx, 0x0881, HYUN_APP_CODEC_DELTA);
+
+    for (n = 0; n < 3 * HYUN_APP_CODEC_KEYFRAME_INTERVAL; n++)
+    {
+        UT_Codec_Payload(In, sizeof(In), n);
+        if (HYUN_APP_CodecEncodeFrame(&Tx, In, sizeof(In), &Frame) != HYUN_APP_CODEC_SUCCESS ||
+            HYUN_APP_CodecDecodeFrame(&Rx, &Frame, Out, sizeof(Out)) != HYUN_APP_CODEC_SUCCESS ||
+            memcmp(In, Out, sizeof(In)) != 0 || Frame.MsgId != 0x0881 || Frame.Seq != n ||
+            Frame.Codec != HYUN_APP_CODEC_DELTA)
+        {
+            Bad++;
+        }
+        if (Frame.Flags & HYUN_APP_CODEC_FLAG_KEY)
+        {
+            Keys++;
+        }
+        Linked += Frame.Length;
+    }
+
+    UtAssert_True(Bad == 0, "Every frame DELTA coded and round trips (%lu bad)", (unsigned long)Bad);
+    UtAssert_True(Keys == 3, "Keys (%lu) == one per HYUN_APP_CODEC_KEYFRAME_INTERVAL", (unsigned long)Keys);
+    UtAssert_True(Linked < n * sizeof(In) / 3, "Linked bytes (%lu) under a third of the raw size",
+                  (unsigned long)Linked);
+
+    /* A lost frame stops the decoder until the next key frame */
+    UT_Codec_Payload(In, sizeof(In), n++);
+    HYUN_APP_CodecEncodeFrame(&Tx, In, sizeof(In), &Frame);
+    while ((Tx.Seq % HYUN_APP_CODEC_KEYFRAME_INTERVAL) != 0)
+    {
+        UT_Codec_Payload(In, sizeof(In), n++);
+        HYUN_APP_CodecEncodeFrame(&Tx, In, sizeof(In), &Frame);
+        if (HYUN_APP_CodecDecodeFrame(&Rx, &Frame, Out, sizeof(Out)) != HYUN_APP_CODEC_ERR_SYNC)
+        {
+            Bad++;
+        }
+    }
+    UtAssert_True(Bad == 0, "Delta frames after a gap wait for a key frame (%lu decoded)", (unsigned long)Bad);
+
+    UT_Codec_Payload(In, sizeof(In), n++);
+    HYUN_APP_CodecEncodeFrame(&Tx, In, sizeof(In), &Frame);
+    UtAssert_True(HYUN_APP_CodecDecodeFrame(&Rx, &Frame, Out, sizeof(Out)) == HYUN_APP_CODEC_SUCCESS &&
+                      memcmp(In, Out, sizeof(In)) == 0,
+                  "Resynchronised on the key frame");
+
+    /* A length change forces a key frame */
+    UT_Codec_Payload(In, sizeof(In), n++);
+    HYUN_APP_CodecEncodeFrame(&Tx, In, 32, &Frame);
+    UtAssert_True(Frame.Flags & HYUN_APP_CODEC_FLAG_KEY, "New length coded against zeros");
+    UtAssert_True(HYUN_APP_CodecDecodeFrame(&Rx, &Frame, Out, sizeof(Out)) == HYUN_APP_CODEC_SUCCESS &&
+                      memcmp(In, Out, 32) == 0,
+                  "New length round trips");
+}
+
+void Test_HYUN_APP_CodecFrame_Raw(void)
+{
+    /*
+     * Test Case For:
+     * Frames sent raw, LZ frames and length checks
+     */
+    HYUN_APP_CodecStream_t Tx;
+    HYUN_APP_CodecStream_t Rx;
+    HYUN_APP_CodecFrame_t  Frame;
+    uint8                  In[HYUN_APP_CODEC_MAX_PAYLOAD + 1];
+    uint8                  Out[HYUN_APP_CODEC_MAX_PAYLOAD];
+    size_t                 Len;
+
+    /* Noise does not shrink and goes out raw */
+    HYUN_APP_CodecStreamInit(&Tx, 0x0882, HYUN_APP_CODEC_LZ);
+    HYUN_APP_CodecStreamInit(&Rx, 0x0882, HYUN_APP_CODEC_LZ);
+    UT_Codec_Noise(In, 100, 9);
+    UtAssert_True(HYUN_APP_CodecEncodeFrame(&Tx, In, 100, &Frame) == HYUN_APP_CODEC_SUCCESS, "Encode noise");
+    UtAssert_True(Frame.Codec == HYUN_APP_CODEC_NONE && Frame.Length == 100, "Sent raw (codec %u, %u bytes)",
+                  (unsigned int)Frame.Codec, (unsigned int)Frame.Length);
+    UtAssert_True(HYUN_APP_CodecDecodeFrame(&Rx, &Frame, Out, sizeof(Out)) == HYUN_APP_CODEC_SUCCESS &&
+                      memcmp(In, Out, 100) == 0,
+                  "Raw round trip");
+
+    /* Text goes out LZ coded */
+    Len = sizeof(UT_CODEC_TEXT) - 1;
+    memcpy(In, UT_CODEC_TEXT, Len);
+    memcpy(&In[Len], UT_CODEC_TEXT, HYUN_APP_CODEC_MAX_PAYLOAD - Len);
+    HYUN_APP_CodecEncodeFrame(&Tx, In, HYUN_APP_CODEC_MAX_PAYLOAD, &Frame);
+    UtAssert_True(Frame.Codec == HYUN_APP_CODEC_LZ, "Codec (%u) == LZ", (unsigned int)Frame.Codec);
+    UtAssert_True(HYUN_APP_CodecDecodeFrame(&Rx, &Frame, Out, sizeof(Out)) == HYUN_APP_CODEC_SUCCESS &&
+                      memcmp(In, Out, HYUN_APP_CODEC_MAX_PAYLOAD) == 0,
+                  "LZ round trip");
+
+    /* Length checks on both ends */
+    UtAssert_True(HYUN_APP_CodecEncodeFrame(&Tx, In, sizeof(In), &Frame) == HYUN_APP_CODEC_ERR_LENGTH,
+                  "Payload over HYUN_APP_CODEC_MAX_PAYLOAD rejected");
+    HYUN_APP_CodecEncodeFrame(&Tx, In, 40, &Frame);
+    UtAssert_True(HYUN_APP_CodecDecodeFrame(&Rx, &Frame, Out, 39) == HYUN_APP_CODEC_ERR_LENGTH,
+                  "Caller buffer too small");
+
+    Frame.Codec  = HYUN_APP_CODEC_NONE;
+    Frame.Length = 39;
+    UtAssert_True(HYUN_APP_CodecDecodeFrame(&Rx, &Frame, Out, sizeof(Out)) == HYUN_APP_CODEC_ERR_DATA,
+                  "Raw frame with a wrong length");
+    Frame.Codec = 7;
+    UtAssert_True(HYUN_APP_CodecDecodeFrame(&Rx, &Frame, Out, sizeof(Out)) == HYUN_APP_CODEC_ERR_DATA,
+                  "Unknown codec");
+}
+
+/*
+ * Setup function prior to every test
+ */
+void Hyun_UT_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Teardown function after every test
+ */
+void Hyun_UT_TearDown(void) {}
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    ADD_TEST(HYUN_APP_Delta);
+    ADD_TEST(HYUN_APP_Lz);
+    ADD_TEST(HYUN_APP_CodecFrame_Delta);
+    ADD_TEST(HYUN_APP_CodecFrame_Raw);
+}
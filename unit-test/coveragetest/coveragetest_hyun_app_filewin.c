@@ -0,0 +1,265 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2019 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_hyun_app_filewin.c
+**
+** Purpose:
+** Coverage Unit Test cases for the HYUN_APP file downlink window
+**
+** Notes:
+** Each case plays the receiver by hand; throughput over a lossy link is
+** measured by the host link test instead.
+*/
+
+/*
+ * Includes
+ */
+
+#include <string.h>
+
+#include "hyun_app_coveragetest_common.h"
+#include "hyun_app_filewin.h"
+
+static HYUN_APP_FileWin_t UT_Win;
+
+/*
+**********************************************************************************
+**          TEST CASE FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_HYUN_APP_FileWinInit(void)
+{
+    /*
+     * Test Case For:
+     * void HYUN_APP_FileWinInit(HYUN_APP_FileWin_t *Win, uint32 Chunks, uint32 StartSeq, uint32 Window,
+     *                           uint32 TimeoutUs)
+     * bool HYUN_APP_FileWinDone(const HYUN_APP_FileWin_t *Win)
+     */
+    memset(&UT_Win, 0xA5, sizeof(UT_Win));
+    HYUN_APP_FileWinInit(&UT_Win, 10, 0, 0, 1000);
+    UtAssert_True(UT_Win.Window == 1, "Window 0 raised to 1");
+    UtAssert_True(UT_Win.AckSeq == 0 && UT_Win.NextSeq == 0, "Starts at chunk 0");
+    UtAssert_True(UT_Win.Sack == 0 && UT_Win.Resend == 0 && !UT_Win.Stalled && UT_Win.AckDueUs == 0,
+                  "State cleared");
+    UtAssert_True(!HYUN_APP_FileWinDone(&UT_Win), "Not done");
+
+    HYUN_APP_FileWinInit(&UT_Win, 10, 0, HYUN_APP_FILEWIN_MAX + 1, 1000);
+    UtAssert_True(UT_Win.Window == HYUN_APP_FILEWIN_MAX, "Window (%lu) limited to HYUN_APP_FILEWIN_MAX",
+                  (unsigned long)UT_Win.Window);
+
+    /* Resumed transfer: chunks below StartSeq are held already */
+    HYUN_APP_FileWinInit(&UT_Win, 10, 6, 4, 1000);
+    UtAssert_True(HYUN_APP_FileWinNext(&UT_Win, 0) == 6, "Resumes at chunk 6");
+
+    /* Resumed from the end of the file, or beyond it */
+    HYUN_APP_FileWinInit(&UT_Win, 10, 10, 4, 1000);
+    UtAssert_True(HYUN_APP_FileWinDone(&UT_Win), "Resumed at the end is done");
+    UtAssert_True(HYUN_APP_FileWinNext(&UT_Win, 0) == HYUN_APP_FILEWIN_NONE, "Nothing to send");
+    UtAssert_True(UT_Win.AckDueUs == 0, "No acknowledgement expected");
+    HYUN_APP_FileWinInit(&UT_Win, 10, 12, 4, 1000);
+    UtAssert_True(UT_Win.AckSeq == 10 && HYUN_APP_FileWinDone(&UT_Win), "StartSeq past the end limited");
+}
+
+void Test_HYUN_APP_FileWinNext(void)
+{
+    /*
+     * Test Case For:
+     * int32 HYUN_APP_FileWinNext(HYUN_APP_FileWin_t *Win, uint64 NowUs)
+     * bool  HYUN_APP_FileWinAck(HYUN_APP_FileWin_t *Win, uint32 AckSeq, uint32 SackMask, uint64 NowUs)
+     */
+    int32  Seq;
+    uint32 Expect;
+    uint32 Bad = 0;
+
+    HYUN_APP_FileWinInit(&UT_Win, 6, 0, 4, 1000);
+
+    /* A full window goes out, then nothing until acknowledged */
+    for (Expect = 0; Expect < 4; Expect++)
+    {
+        Seq = HYUN_APP_FileWinNext(&UT_Win, 100 + Expect);
+        UtAssert_True(Seq == (int32)Expect, "Sent chunk %ld", (long)Seq);
+    }
+    UtAssert_True(HYUN_APP_FileWinNext(&UT_Win, 200) == HYUN_APP_FILEWIN_NONE, "Window full");
+    UtAssert_True(UT_Win.AckDueUs == 1100, "Timeout from the first send (%lu)", (unsigned long)UT_Win.AckDueUs);
+
+    /* Reports on chunks never sent are refused, overtaken ones ignored */
+    UtAssert_True(!HYUN_APP_FileWinAck(&UT_Win, 5, 0, 300), "Ack past NextSeq refused");
+    UtAssert_True(HYUN_APP_FileWinAck(&UT_Win, 2, 0, 300), "Ack 2");
+    UtAssert_True(UT_Win.AckSeq == 2 && UT_Win.AckDueUs == 1300, "Window moved, timeout restarted");
+    UtAssert_True(HYUN_APP_FileWinAck(&UT_Win, 1, 0xF, 310), "Stale report accepted");
+    UtAssert_True(UT_Win.AckSeq == 2 && UT_Win.Sack == 0, "Stale report ignored");
+
+    /* Only the last chunks of the file are left */
+    UtAssert_True(HYUN_APP_FileWinNext(&UT_Win, 400) == 4, "Sent chunk 4");
+    UtAssert_True(HYUN_APP_FileWinNext(&UT_Win, 400) == 5, "Sent chunk 5");
+    UtAssert_True(HYUN_APP_FileWinNext(&UT_Win, 400) == HYUN_APP_FILEWIN_NONE, "End of file");
+
+    UtAssert_True(HYUN_APP_FileWinAck(&UT_Win, 6, 0, 500), "Ack all");
+    UtAssert_True(HYUN_APP_FileWinDone(&UT_Win), "Done");
+    UtAssert_True(UT_Win.AckDueUs == 0, "Nothing in flight");
+    UtAssert_True(UT_Win.SentCounter == 6 && UT_Win.ResendCounter == 0 && UT_Win.TimeoutCounter == 0,
+                  "Sent %lu, resent %lu", (unsigned long)UT_Win.SentCounter, (unsigned long)UT_Win.ResendCounter);
+
+    /* Steady flow: the receiver acknowledges every chunk as it arrives */
+    HYUN_APP_FileWinInit(&UT_Win, 200, 0, HYUN_APP_FILE_WINDOW, 1000);
+    Expect = 0;
+    while ((Seq = HYUN_APP_FileWinNext(&UT_Win, Expect)) != HYUN_APP_FILEWIN_NONE)
+    {
+        if (Seq != (int32)Expect || !HYUN_APP_FileWinAck(&UT_Win, Expect + 1, 0, Expect))
+        {
+            Bad++;
+        }
+        Expect++;
+    }
+    UtAssert_True(Bad == 0 && HYUN_APP_FileWinDone(&UT_Win), "200 chunks in order (%lu bad)", (unsigned long)Bad);
+    UtAssert_True(UT_Win.SentCounter == 200 && UT_Win.ResendCounter == 0, "Each sent once");
+}
+
+void Test_HYUN_APP_FileWinAck_Resend(void)
+{
+    /*
+     * Test Case For:
+     * A chunk reported missing behind HYUN_APP_FILEWIN_REORDER later ones is sent again, and again if the
+     * retransmission is lost
+     */
+    int32 Seq;
+
+    HYUN_APP_FileWinInit(&UT_Win, 20, 0, 8, 1000);
+    for (Seq = 0; Seq < 4; Seq++)
+    {
+        HYUN_APP_FileWinNext(&UT_Win, 0);
+    }
+
+    /* Chunk 0 lost; two later ones could still be reordering */
+    UtAssert_True(HYUN_APP_FileWinAck(&UT_Win, 0, 0x3, 10), "Chunks 1, 2 held");
+    UtAssert_True(UT_Win.Sack == 0x6 && UT_Win.Resend == 0, "Not yet taken as lost");
+    UtAssert_True(HYUN_APP_FileWinAck(&UT_Win, 0, 0x7, 20), "Chunks 1..3 held");
+    UtAssert_True(UT_Win.Resend == 0x1, "Chunk 0 to be sent again");
+    UtAssert_True(UT_Win.AckDueUs == 1000, "Timeout kept without progress");
+
+    /* Missing chunks go before new ones */
+    UtAssert_True(HYUN_APP_FileWinNext(&UT_Win, 30) == 0, "Chunk 0 sent again");
+    for (Seq = 4; Seq < 7; Seq++)
+    {
+        UtAssert_True(HYUN_APP_FileWinNext(&UT_Win, 40) == Seq, "New chunk %ld", (long)Seq);
+    }
+
+    /* The retransmission is lost too: later chunks overtake it */
+    UtAssert_True(HYUN_APP_FileWinAck(&UT_Win, 0, 0x1F, 50), "Chunks 1..5 held");
+    UtAssert_True(UT_Win.Resend == 0, "Retransmission may still arrive");
+    UtAssert_True(HYUN_APP_FileWinAck(&UT_Win, 0, 0x3F, 60), "Chunks 1..6 held");
+    UtAssert_True(UT_Win.Resend == 0x1, "Lost retransmission recovered");
+    UtAssert_True(HYUN_APP_FileWinNext(&UT_Win, 70) == 0, "Chunk 0 sent a third time");
+    UtAssert_True(UT_Win.ResendCounter == 2, "ResendCounter (%lu) == 2", (unsigned long)UT_Win.ResendCounter);
+
+    /* Held chunks are never sent again */
+    UtAssert_True(HYUN_APP_FileWinNext(&UT_Win, 80) == 7, "Next new chunk");
+    UtAssert_True(HYUN_APP_FileWinAck(&UT_Win, 8, 0, 90), "Everything up to chunk 7 held");
+    UtAssert_True(UT_Win.Sack == 0 && UT_Win.Resend == 0, "Masks shifted out");
+    UtAssert_True(UT_Win.AckDueUs == 0, "Nothing in flight");
+    UtAssert_True(UT_Win.TimeoutCounter == 0, "No timeout");
+}
+
+void Test_HYUN_APP_FileWinNext_Timeout(void)
+{
+    /*
+     * Test Case For:
+     * A timeout resends the window, a second one stalls the transfer with backoff until an acknowledgement
+     */
+    HYUN_APP_FileWin_t *Win = &UT_Win;
+    int32               Seq;
+
+    HYUN_APP_FileWinInit(Win, 10, 0, 4, 1000);
+    for (Seq = 0; Seq < 4; Seq++)
+    {
+        HYUN_APP_FileWinNext(Win, 0);
+    }
+    HYUN_APP_FileWinAck(Win, 0, 0x2, 10);
+    UtAssert_True(Win->Sack == 0x4, "Chunk 2 held");
+    UtAssert_True(HYUN_APP_FileWinNext(Win, 999) == HYUN_APP_FILEWIN_NONE, "Before the timeout");
+
+    /* First timeout: everything not reported goes again from AckSeq */
+    UtAssert_True(HYUN_APP_FileWinNext(Win, 1000) == 0, "Chunk 0 again");
+    UtAssert_True(Win->TimeoutCounter == 1 && Win->Backoff == 1 && !Win->Stalled, "First timeout");
+    UtAssert_True(Win->AckDueUs == 3000, "Timeout doubled (%lu)", (unsigned long)Win->AckDueUs);
+    UtAssert_True(HYUN_APP_FileWinNext(Win, 1001) == 1, "Chunk 1 again");
+    UtAssert_True(HYUN_APP_FileWinNext(Win, 1002) == 3, "Chunk 3 again, 2 skipped");
+    UtAssert_True(HYUN_APP_FileWinNext(Win, 1003) == HYUN_APP_FILEWIN_NONE, "Window full");
+
+    /* Second timeout: link taken as lost, only chunk AckSeq is probed */
+    UtAssert_True(HYUN_APP_FileWinNext(Win, 3000) == 0, "Probe chunk 0");
+    UtAssert_True(Win->Stalled && Win->Backoff == 2, "Stalled");
+    UtAssert_True(Win->AckDueUs == 7000, "Probe interval (%lu)", (unsigned long)Win->AckDueUs);
+    UtAssert_True(HYUN_APP_FileWinNext(Win, 3001) == HYUN_APP_FILEWIN_NONE, "Nothing else while stalled");
+
+    UtAssert_True(HYUN_APP_FileWinNext(Win, 7000) == 0 && Win->AckDueUs == 15000, "Probe, interval doubled");
+    UtAssert_True(HYUN_APP_FileWinNext(Win, 15000) == 0 && Win->AckDueUs == 31000, "Probe, interval doubled");
+    UtAssert_True(HYUN_APP_FileWinNext(Win, 31000) == 0 && Win->AckDueUs == 47000, "Probe, interval at the limit");
+    UtAssert_True(Win->Backoff == HYUN_APP_FILEWIN_MAX_BACKOFF, "Backoff (%u) limited", (unsigned int)Win->Backoff);
+    UtAssert_True(Win->TimeoutCounter == 5, "TimeoutCounter (%lu) == 5", (unsigned long)Win->TimeoutCounter);
+
+    /* Link back: resume from AckSeq with the unreported chunks */
+    UtAssert_True(HYUN_APP_FileWinAck(Win, 1, 0x1, 40000), "Chunk 0 and 2 held");
+    UtAssert_True(!Win->Stalled && Win->Backoff == 0, "Resumed");
+    UtAssert_True(Win->Resend == 0x5, "Chunks 1 and 3 to be sent again (0x%lx)", (unsigned long)Win->Resend);
+    UtAssert_True(HYUN_APP_FileWinNext(Win, 40001) == 1, "Chunk 1 again");
+    UtAssert_True(HYUN_APP_FileWinNext(Win, 40002) == 3, "Chunk 3 again");
+    UtAssert_True(HYUN_APP_FileWinNext(Win, 40003) == 4, "New chunk 4");
+    UtAssert_True(HYUN_APP_FileWinNext(Win, 40004) == HYUN_APP_FILEWIN_NONE, "Window full");
+    UtAssert_True(Win->AckDueUs == 41001, "Normal timeout (%lu)", (unsigned long)Win->AckDueUs);
+}
+
+void Test_HYUN_APP_FileWinTimeout(void)
+{
+    /*
+     * Test Case For:
+     * uint32 HYUN_APP_FileWinTimeout(uint32 Window, uint32 PacketBytes, uint32 BytesPerSec)
+     */
+    UT_TEST_FUNCTION_RC(HYUN_APP_FileWinTimeout(HYUN_APP_FILE_WINDOW, 1000, 0), HYUN_APP_FILE_ACK_TIMEOUT_MS * 1000);
+    UT_TEST_FUNCTION_RC(HYUN_APP_FileWinTimeout(HYUN_APP_FILE_WINDOW, 1000, 8000),
+                        HYUN_APP_FILE_ACK_TIMEOUT_MS * 1000 + HYUN_APP_FILE_WINDOW * 125000);
+}
+
+/*
+ * Setup function prior to every test
+ */
+void Hyun_UT_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Teardown function after every test
+ */
+void Hyun_UT_TearDown(void) {}
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    ADD_TEST(HYUN_APP_FileWinInit);
+    ADD_TEST(HYUN_APP_FileWinNext);
+    ADD_TEST(HYUN_APP_FileWinAck_Resend);
+    ADD_TEST(HYUN_APP_FileWinNext_Timeout);
+    ADD_TEST(HYUN_APP_FileWinTimeout);
+}
@@ -0,0 +1,287 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2019 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_hyun_app_filter.c
+**
+** Purpose:
+** Coverage Unit Test cases for the HYUN_APP streaming filters
+**
+** Notes:
+** Each windowed filter is checked against a brute-force pass over
+** the last samples, on a pseudo-random input with repeated values.
+*/
+
+/*
+ * Includes
+ */
+
+#include <math.h>
+
+#include "hyun_app_coveragetest_common.h"
+#include "hyun_app_filter.h"
+
+#define UT_FILTER_SAMPLES 500
+
+static float UT_Filter_Input[UT_FILTER_SAMPLES];
+
+/*
+ * Repeatable input, integer steps so ties are common
+ */
+static void UT_Filter_MakeInput(void)
+{
+    uint32 Seed = 12345;
+    uint32 i;
+
+    for (i = 0; i < UT_FILTER_SAMPLES; i++)
+    {
+        Seed               = Seed * 1103515245u + 12345u;
+        UT_Filter_Input[i] = (float)((Seed >> 16) % 41) - 20.0f;
+    }
+}
+
+/*
+ * Brute-force statistics of the Count samples ending at Last
+ */
+static float UT_Filter_Mean(uint32 Last, uint32 Count)
+{
+    float  Sum = 0.0f;
+    uint32 i;
+
+    for (i = 0; i < Count; i++)
+    {
+        Sum += UT_Filter_Input[Last - i];
+    }
+
+    return Sum / (float)Count;
+}
+
+static float UT_Filter_Median(uint32 Last, uint32 Count)
+{
+    float  Sorted[HYUN_APP_FILTER_MAX_WINDOW];
+    float  Tmp;
+    uint32 i;
+    uint32 j;
+
+    for (i = 0; i < Count; i++)
+    {
+        Sorted[i] = UT_Filter_Input[Last - i];
+        for (j = i; j > 0 && Sorted[j] < Sorted[j - 1]; j--)
+        {
+            Tmp           = Sorted[j];
+            Sorted[j]     = Sorted[j - 1];
+            Sorted[j - 1] = Tmp;
+        }
+    }
+
+    if ((Count & 1) == 0)
+    {
+        return 0.5f * (Sorted[Count / 2 - 1] + Sorted[Count / 2]);
+    }
+
+    return Sorted[Count / 2];
+}
+
+static void UT_Filter_MinMax(uint32 Last, uint32 Count, float *Min, float *Max)
+{
+    uint32 i;
+
+    *Min = UT_Filter_Input[Last];
+    *Max = UT_Filter_Input[Last];
+    for (i = 1; i < Count; i++)
+    {
+        if (UT_Filter_Input[Last - i] < *Min)
+        {
+            *Min = UT_Filter_Input[Last - i];
+        }
+        if (UT_Filter_Input[Last - i] > *Max)
+        {
+            *Max = UT_Filter_Input[Last - i];
+        }
+    }
+}
+
+/*
+**********************************************************************************
+**          TEST CASE FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_HYUN_APP_MovAvg(void)
+{
+    /*
+     * Test Case For:
+     * void  HYUN_APP_MovAvgInit(HYUN_APP_MovAvg_t *Filt, uint16 Size)
+     * float HYUN_APP_MovAvgUpdate(HYUN_APP_MovAvg_t *Filt, float X)
+     */
+    static const uint16 Sizes[] = {1, 4, 7, HYUN_APP_FILTER_MAX_WINDOW};
+    HYUN_APP_MovAvg_t   Filt;
+    uint32              Bad;
+    uint32              n;
+    uint32              i;
+    float               Out;
+
+    for (n = 0; n < sizeof(Sizes) / sizeof(Sizes[0]); n++)
+    {
+        HYUN_APP_MovAvgInit(&Filt, Sizes[n]);
+        Bad = 0;
+        for (i = 0; i < UT_FILTER_SAMPLES; i++)
+        {
+            Out = HYUN_APP_MovAvgUpdate(&Filt, UT_Filter_Input[i]);
+            if (fabsf(Out - UT_Filter_Mean(i, (i < Sizes[n]) ? i + 1 : Sizes[n])) > 1.0e-3f)
+            {
+                Bad++;
+            }
+        }
+        UtAssert_True(Bad == 0, "Moving average of %u matches the reference (%lu off)", (unsigned int)Sizes[n],
+                      (unsigned long)Bad);
+    }
+
+    /* Window sizes are clamped to 1 .. HYUN_APP_FILTER_MAX_WINDOW */
+    HYUN_APP_MovAvgInit(&Filt, 0);
+    UtAssert_True(Filt.Size == 1, "Size 0 clamped to 1 (%u)", (unsigned int)Filt.Size);
+    HYUN_APP_MovAvgInit(&Filt, HYUN_APP_FILTER_MAX_WINDOW + 1);
+    UtAssert_True(Filt.Size == HYUN_APP_FILTER_MAX_WINDOW, "Size clamped to HYUN_APP_FILTER_MAX_WINDOW (%u)",
+                  (unsigned int)Filt.Size);
+}
+
+void Test_HYUN_APP_Ema(void)
+{
+    /*
+     * Test Case For:
+     * void  HYUN_APP_EmaInit(HYUN_APP_Ema_t *Filt, float Alpha)
+     * float HYUN_APP_EmaUpdate(HYUN_APP_Ema_t *Filt, float X)
+     */
+    HYUN_APP_Ema_t Filt;
+
+    /* The first sample primes the average */
+    HYUN_APP_EmaInit(&Filt, 0.25f);
+    UtAssert_True(HYUN_APP_EmaUpdate(&Filt, 8.0f) == 8.0f, "First sample passes through");
+    UtAssert_True(HYUN_APP_EmaUpdate(&Filt, 0.0f) == 6.0f, "Second sample weighted by Alpha");
+
+    /* Alpha out of (0, 1] falls back to no smoothing */
+    HYUN_APP_EmaInit(&Filt, 0.0f);
+    UtAssert_True(Filt.Alpha == 1.0f, "Alpha 0 replaced by 1 (%f)", (double)Filt.Alpha);
+    HYUN_APP_EmaInit(&Filt, 1.5f);
+    UtAssert_True(Filt.Alpha == 1.0f, "Alpha 1.5 replaced by 1 (%f)", (double)Filt.Alpha);
+    HYUN_APP_EmaUpdate(&Filt, 3.0f);
+    UtAssert_True(HYUN_APP_EmaUpdate(&Filt, -2.0f) == -2.0f, "Alpha 1 follows the input");
+}
+
+void Test_HYUN_APP_Median(void)
+{
+    /*
+     * Test Case For:
+     * void  HYUN_APP_MedianInit(HYUN_APP_Median_t *Filt, uint16 Size)
+     * float HYUN_APP_MedianUpdate(HYUN_APP_Median_t *Filt, float X)
+     */
+    static const uint16 Sizes[] = {1, 2, 5, 8, HYUN_APP_FILTER_MAX_WINDOW};
+    HYUN_APP_Median_t   Filt;
+    uint32              Bad;
+    uint32              n;
+    uint32              i;
+    float               Out;
+
+    for (n = 0; n < sizeof(Sizes) / sizeof(Sizes[0]); n++)
+    {
+        HYUN_APP_MedianInit(&Filt, Sizes[n]);
+        Bad = 0;
+        for (i = 0; i < UT_FILTER_SAMPLES; i++)
+        {
+            Out = HYUN_APP_MedianUpdate(&Filt, UT_Filter_Input[i]);
+            if (Out != UT_Filter_Median(i, (i < Sizes[n]) ? i + 1 : Sizes[n]))
+            {
+                Bad++;
+            }
+        }
+        UtAssert_True(Bad == 0, "Median of %u matches the reference (%lu off)", (unsigned int)Sizes[n],
+                      (unsigned long)Bad);
+    }
+}
+
+void Test_HYUN_APP_MinMax(void)
+{
+    /*
+     * Test Case For:
+     * void  HYUN_APP_MinMaxInit(HYUN_APP_MinMax_t *Filt, uint16 Size)
+     * void  HYUN_APP_MinMaxUpdate(HYUN_APP_MinMax_t *Filt, float X)
+     * float HYUN_APP_MinMaxGetMin(const HYUN_APP_MinMax_t *Filt)
+     * float HYUN_APP_MinMaxGetMax(const HYUN_APP_MinMax_t *Filt)
+     */
+    static const uint16 Sizes[] = {1, 3, 16, HYUN_APP_FILTER_MAX_WINDOW};
+    HYUN_APP_MinMax_t   Filt;
+    uint32              Bad;
+    uint32              n;
+    uint32              i;
+    float               Min;
+    float               Max;
+
+    for (n = 0; n < sizeof(Sizes) / sizeof(Sizes[0]); n++)
+    {
+        HYUN_APP_MinMaxInit(&Filt, Sizes[n]);
+        Bad = 0;
+        for (i = 0; i < UT_FILTER_SAMPLES; i++)
+        {
+            HYUN_APP_MinMaxUpdate(&Filt, UT_Filter_Input[i]);
+            UT_Filter_MinMax(i, (i < Sizes[n]) ? i + 1 : Sizes[n], &Min, &Max);
+            if (HYUN_APP_MinMaxGetMin(&Filt) != Min || HYUN_APP_MinMaxGetMax(&Filt) != Max)
+            {
+                Bad++;
+            }
+        }
+        UtAssert_True(Bad == 0, "Min / max of %u match the reference (%lu off)", (unsigned int)Sizes[n],
+                      (unsigned long)Bad);
+    }
+
+    /* A monotonic run keeps the oldest sample as the extreme until it expires */
+    HYUN_APP_MinMaxInit(&Filt, 3);
+    for (i = 0; i < 10; i++)
+    {
+        HYUN_APP_MinMaxUpdate(&Filt, (float)i);
+    }
+    UtAssert_True(HYUN_APP_MinMaxGetMin(&Filt) == 7.0f && HYUN_APP_MinMaxGetMax(&Filt) == 9.0f,
+                  "Rising run: min %f, max %f", (double)HYUN_APP_MinMaxGetMin(&Filt),
+                  (double)HYUN_APP_MinMaxGetMax(&Filt));
+}
+
+/*
+ * Setup function prior to every test
+ */
+void Hyun_UT_Setup(void)
+{
+    UT_ResetState(0);
+    UT_Filter_MakeInput();
+}
+
+/*
+ * Teardown function after every test
+ */
+void Hyun_UT_TearDown(void) {}
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    ADD_TEST(HYUN_APP_MovAvg);
+    ADD_TEST(HYUN_APP_Ema);
+    ADD_TEST(HYUN_APP_Median);
+    ADD_TEST(HYUN_APP_MinMax);
+}
@@ -0,0 +1,286 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2019 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_hyun_app_flight.c
+**
+** Purpose:
+** Coverage Unit Test cases for the HYUN_APP flight phase detection
+**
+** Notes:
+** hyun_app.c and hyun_app_sensor.c are not part of this test, so the
+** app data and the MET conversion are provided here.
+*/
+
+/*
+ * Includes
+ */
+
+#include <string.h>
+
+#include "hyun_app_coveragetest_common.h"
+#include "ut_hyun_app.h"
+
+HYUN_APP_Data_t HYUN_APP_Data;
+
+/*
+ * MET returned by the HYUN_APP_SysTimeToUsec stand-in
+ */
+static uint64 UT_NowUs;
+
+uint64 HYUN_APP_SysTimeToUsec(CFE_TIME_SysTime_t Time)
+{
+    (void)Time;
+
+    return UT_NowUs;
+}
+
+/*
+ * Thresholds for the test cases, hysteresis of 3 steps
+ */
+static void UT_Flight_Table(HYUN_APP_Table_t *Tbl)
+{
+    memset(Tbl, 0, sizeof(*Tbl));
+
+    Tbl->LaunchAltitude  = 10.0f;
+    Tbl->LaunchVelocity  = 5.0f;
+    Tbl->ApogeeVelocity  = 1.0f;
+    Tbl->DescentVelocity = 2.0f;
+    Tbl->ReleaseAltitude = 50.0f;
+    Tbl->LandedAltitude  = 5.0f;
+    Tbl->LandedVelocity  = 1.0f;
+    Tbl->HysteresisCount = 3;
+}
+
+/*
+ * One estimator step at TimeUs [s * 1e6]
+ */
+static void UT_Flight_Estimate(HYUN_APP_KF_t *Kf, uint64 TimeUs, float Altitude, float Velocity)
+{
+    Kf->Initialized              = true;
+    Kf->LastTimeUs               = TimeUs;
+    Kf->X[HYUN_APP_KF_STATE_ALT] = Altitude;
+    Kf->X[HYUN_APP_KF_STATE_VEL] = Velocity;
+}
+
+/*
+**********************************************************************************
+**          TEST CASE FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_HYUN_APP_FlightInit(void)
+{
+    /*
+     * Test Case For:
+     * void HYUN_APP_FlightInit(HYUN_APP_FlightData_t *Flight)
+     */
+    HYUN_APP_FlightData_t Flight;
+
+    memset(&Flight, 0xA5, sizeof(Flight));
+    HYUN_APP_FlightInit(&Flight);
+
+    UtAssert_True(Flight.State == HYUN_APP_FLIGHT_LAUNCH_WAIT, "State (%u) == LAUNCH_WAIT", (unsigned int)Flight.State);
+    UtAssert_True(Flight.PendingState == HYUN_APP_FLIGHT_LAUNCH_WAIT && Flight.PendingCounter == 0,
+                  "No transition pending");
+    UtAssert_True(!Flight.GroundValid, "Ground reference not set");
+}
+
+void Test_HYUN_APP_FlightStep(void)
+{
+    /*
+     * Test Case For:
+     * bool HYUN_APP_FlightStep(HYUN_APP_FlightData_t *Flight, const HYUN_APP_Table_t *Tbl, const HYUN_APP_KF_t *Kf)
+     */
+    HYUN_APP_FlightData_t Flight;
+    HYUN_APP_Table_t      Tbl;
+    HYUN_APP_KF_t         Kf;
+    float                 Ground;
+
+    UT_Flight_Table(&Tbl);
+    HYUN_APP_FlightInit(&Flight);
+    memset(&Kf, 0, sizeof(Kf));
+
+    /* Nothing happens before the estimator has its first fix */
+    UtAssert_True(!HYUN_APP_FlightStep(&Flight, &Tbl, &Kf), "No step without an estimate");
+    UtAssert_True(!Flight.GroundValid, "Ground reference not set");
+
+    /* The first estimate is the ground reference */
+    UT_Flight_Estimate(&Kf, 1000000, 100.0f, 0.0f);
+    UtAssert_True(!HYUN_APP_FlightStep(&Flight, &Tbl, &Kf), "No transition on the pad");
+    UtAssert_True(Flight.GroundValid && Flight.GroundAltitude == 100.0f, "GroundAltitude (%f) == 100",
+                  (double)Flight.GroundAltitude);
+
+    /* Launch has to hold for HysteresisCount new estimates */
+    UT_Flight_Estimate(&Kf, 1100000, 120.0f, 20.0f);
+    UtAssert_True(!HYUN_APP_FlightStep(&Flight, &Tbl, &Kf), "Launch step 1 of 3");
+    UtAssert_True(Flight.PendingState == HYUN_APP_FLIGHT_ASCENT && Flight.PendingCounter == 1,
+                  "PendingCounter (%u) == 1", (unsigned int)Flight.PendingCounter);
+
+    /* An estimate already seen is not counted again */
+    UtAssert_True(!HYUN_APP_FlightStep(&Flight, &Tbl, &Kf), "Same estimate again");
+    UtAssert_True(Flight.PendingCounter == 1, "PendingCounter (%u) == 1", (unsigned int)Flight.PendingCounter);
+
+    UT_Flight_Estimate(&Kf, 1200000, 122.0f, 20.0f);
+    UtAssert_True(!HYUN_APP_FlightStep(&Flight, &Tbl, &Kf), "Launch step 2 of 3");
+    UT_Flight_Estimate(&Kf, 1300000, 124.0f, 20.0f);
+    UtAssert_True(HYUN_APP_FlightStep(&Flight, &Tbl, &Kf), "Launch step 3 of 3");
+    UtAssert_True(Flight.State == HYUN_APP_FLIGHT_ASCENT, "State (%u) == ASCENT", (unsigned int)Flight.State);
+    Ground = Flight.GroundAltitude;
+
+    /* A condition that lapses restarts the count */
+    UT_Flight_Estimate(&Kf, 1400000, 300.0f, 0.0f);
+    HYUN_APP_FlightStep(&Flight, &Tbl, &Kf);
+    UT_Flight_Estimate(&Kf, 1500000, 301.0f, 3.0f);
+    HYUN_APP_FlightStep(&Flight, &Tbl, &Kf);
+    UtAssert_True(Flight.PendingCounter == 0, "PendingCounter (%u) reset", (unsigned int)Flight.PendingCounter);
+    UtAssert_True(Flight.GroundAltitude == Ground, "Ground reference frozen after launch (%f)",
+                  (double)Flight.GroundAltitude);
+    UtAssert_True(Flight.MaxAltitude == 301.0f - Ground, "MaxAltitude (%f) is AGL", (double)Flight.MaxAltitude);
+
+    /* Hysteresis of 1 for the rest of the profile */
+    Tbl.HysteresisCount = 1;
+    UT_Flight_Estimate(&Kf, 1600000, 301.0f, 0.0f);
+    UtAssert_True(HYUN_APP_FlightStep(&Flight, &Tbl, &Kf) && Flight.State == HYUN_APP_FLIGHT_APOGEE,
+                  "ASCENT -> APOGEE");
+    UT_Flight_Estimate(&Kf, 1700000, 290.0f, -5.0f);
+    UtAssert_True(HYUN_APP_FlightStep(&Flight, &Tbl, &Kf) && Flight.State == HYUN_APP_FLIGHT_DESCENT,
+                  "APOGEE -> DESCENT");
+    UT_Flight_Estimate(&Kf, 1800000, 140.0f, -5.0f);
+    UtAssert_True(HYUN_APP_FlightStep(&Flight, &Tbl, &Kf) && Flight.State == HYUN_APP_FLIGHT_PAYLOAD_RELEASE,
+                  "DESCENT -> PAYLOAD_RELEASE");
+
+    /* Landing needs both a low altitude and a small speed */
+    UT_Flight_Estimate(&Kf, 1900000, 101.0f, -5.0f);
+    UtAssert_True(!HYUN_APP_FlightStep(&Flight, &Tbl, &Kf), "Still moving");
+    UT_Flight_Estimate(&Kf, 2000000, 101.0f, -0.5f);
+    UtAssert_True(HYUN_APP_FlightStep(&Flight, &Tbl, &Kf) && Flight.State == HYUN_APP_FLIGHT_LANDED,
+                  "PAYLOAD_RELEASE -> LANDED");
+
+    UT_Flight_Estimate(&Kf, 2100000, 100.0f, 0.0f);
+    UtAssert_True(!HYUN_APP_FlightStep(&Flight, &Tbl, &Kf), "LANDED is final");
+    UtAssert_True(Flight.TransitionCounter == 5, "TransitionCounter (%lu) == 5",
+                  (unsigned long)Flight.TransitionCounter);
+}
+
+void Test_HYUN_APP_FlightStep_Ground(void)
+{
+    /*
+     * Test Case For:
+     * Ground reference tracking of HYUN_APP_FlightStep() on the pad
+     */
+    HYUN_APP_FlightData_t Flight;
+    HYUN_APP_Table_t      Tbl;
+    HYUN_APP_KF_t         Kf;
+
+    UT_Flight_Table(&Tbl);
+    HYUN_APP_FlightInit(&Flight);
+    memset(&Kf, 0, sizeof(Kf));
+
+    UT_Flight_Estimate(&Kf, 1000000, 0.0f, 0.0f);
+    HYUN_APP_FlightStep(&Flight, &Tbl, &Kf);
+
+    /* One time constant after the last step the gain is one half */
+    UT_Flight_Estimate(&Kf, 1000000 + (uint64)(HYUN_APP_FLIGHT_GROUND_TAU_S * 1.0e6f), 8.0f, 0.0f);
+    HYUN_APP_FlightStep(&Flight, &Tbl, &Kf);
+    UtAssert_DoubleCmpAbs(Flight.GroundAltitude, 4.0f, 1.0e-4, "GroundAltitude (%f) == 4",
+                          (double)Flight.GroundAltitude);
+    UtAssert_True(Flight.LastStepUs == Kf.LastTimeUs, "LastStepUs follows the estimate");
+
+    /* Repeating the estimate does not move the reference again */
+    HYUN_APP_FlightStep(&Flight, &Tbl, &Kf);
+    UtAssert_DoubleCmpAbs(Flight.GroundAltitude, 4.0f, 1.0e-4, "GroundAltitude (%f) unchanged",
+                          (double)Flight.GroundAltitude);
+}
+
+void Test_HYUN_APP_FlightProcess(void)
+{
+    /*
+     * Test Case For:
+     * int32 HYUN_APP_FlightProcess(const HYUN_APP_Table_t *TblPtr, uint64 ArrivalUs)
+     */
+    HYUN_APP_Table_t       Tbl;
+    HYUN_APP_FlightData_t *Flight = &HYUN_APP_Data.Flight;
+
+    UT_Flight_Table(&Tbl);
+    Tbl.HysteresisCount = 1;
+
+    /* No state change: no event and no latency */
+    UT_Flight_Estimate(&HYUN_APP_Data.Kf, 1000000, 0.0f, 0.0f);
+    UT_TEST_FUNCTION_RC(HYUN_APP_FlightProcess(&Tbl, 0), CFE_SUCCESS);
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_EVS_SendEvent)) == 0, "CFE_EVS_SendEvent() not called");
+
+    /* Launch: latency from the arrival of the newest sample */
+    UT_NowUs = 5000700;
+    UT_Flight_Estimate(&HYUN_APP_Data.Kf, 1100000, 50.0f, 30.0f);
+    UT_TEST_FUNCTION_RC(HYUN_APP_FlightProcess(&Tbl, 5000000), CFE_SUCCESS);
+    UtAssert_True(Flight->State == HYUN_APP_FLIGHT_ASCENT, "State (%u) == ASCENT", (unsigned int)Flight->State);
+    UtAssert_True(Flight->LastLatencyUs == 700, "LastLatencyUs (%lu) == 700", (unsigned long)Flight->LastLatencyUs);
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_EVS_SendEvent)) == 1, "CFE_EVS_SendEvent() called");
+
+    /* Without an arrival time the latency is reported as 0, the max is kept */
+    UT_Flight_Estimate(&HYUN_APP_Data.Kf, 1200000, 60.0f, 0.0f);
+    UT_TEST_FUNCTION_RC(HYUN_APP_FlightProcess(&Tbl, 0), CFE_SUCCESS);
+    UtAssert_True(Flight->State == HYUN_APP_FLIGHT_APOGEE, "State (%u) == APOGEE", (unsigned int)Flight->State);
+    UtAssert_True(Flight->LastLatencyUs == 0, "LastLatencyUs (%lu) == 0", (unsigned long)Flight->LastLatencyUs);
+    UtAssert_True(Flight->MaxLatencyUs == 700, "MaxLatencyUs (%lu) == 700", (unsigned long)Flight->MaxLatencyUs);
+}
+
+void Test_HYUN_APP_FlightStateName(void)
+{
+    /*
+     * Test Case For:
+     * const char *HYUN_APP_FlightStateName(uint8 State)
+     */
+    UtAssert_True(strcmp(HYUN_APP_FlightStateName(HYUN_APP_FLIGHT_LAUNCH_WAIT), "LAUNCH_WAIT") == 0,
+                  "LAUNCH_WAIT named");
+    UtAssert_True(strcmp(HYUN_APP_FlightStateName(HYUN_APP_FLIGHT_LANDED), "LANDED") == 0, "LANDED named");
+    UtAssert_True(strcmp(HYUN_APP_FlightStateName(HYUN_APP_FLIGHT_LANDED + 1), "UNKNOWN") == 0,
+                  "Out of range state is UNKNOWN");
+}
+
+/*
+ * Setup function prior to every test
+ */
+void Hyun_UT_Setup(void)
+{
+    UT_ResetState(0);
+
+    memset(&HYUN_APP_Data, 0, sizeof(HYUN_APP_Data));
+    HYUN_APP_FlightInit(&HYUN_APP_Data.Flight);
+    UT_NowUs = 0;
+}
+
+/*
+ * Teardown function after every test
+ */
+void Hyun_UT_TearDown(void) {}
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    ADD_TEST(HYUN_APP_FlightInit);
+    ADD_TEST(HYUN_APP_FlightStep);
+    ADD_TEST(HYUN_APP_FlightStep_Ground);
+    ADD_TEST(HYUN_APP_FlightProcess);
+    ADD_TEST(HYUN_APP_FlightStateName);
+}
@@ -0,0 +1,177 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2019 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_hyun_app_handoff.c
+**
+** Purpose:
+** Coverage Unit Test cases for the HYUN_APP task handoff queue
+**
+** Notes:
+** Producer and consumer are driven from the one test thread; the
+** cross-task latency is measured by the host tool instead.
+*/
+
+/*
+ * Includes
+ */
+
+#include <string.h>
+
+#include "hyun_app_coveragetest_common.h"
+#include "hyun_app_handoff.h"
+
+static HYUN_APP_Handoff_t UT_Handoff;
+
+/*
+**********************************************************************************
+**          TEST CASE FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_HYUN_APP_HandoffInit(void)
+{
+    /*
+     * Test Case For:
+     * void HYUN_APP_HandoffInit(HYUN_APP_Handoff_t *Handoff)
+     */
+    size_t Size;
+
+    memset(&UT_Handoff, 0xA5, sizeof(UT_Handoff));
+    HYUN_APP_HandoffInit(&UT_Handoff);
+
+    UtAssert_True(UT_Handoff.Head == 0 && UT_Handoff.Tail == 0, "Queue empty");
+    UtAssert_True(UT_Handoff.DropCounter == 0 && UT_Handoff.HighWater == 0, "Counters cleared");
+    UtAssert_True(HYUN_APP_HandoffPeek(&UT_Handoff, &Size) == NULL, "Nothing to peek");
+}
+
+void Test_HYUN_APP_HandoffPut(void)
+{
+    /*
+     * Test Case For:
+     * bool        HYUN_APP_HandoffPut(HYUN_APP_Handoff_t *Handoff, const void *Data, size_t Size)
+     * const void *HYUN_APP_HandoffPeek(HYUN_APP_Handoff_t *Handoff, size_t *Size)
+     * void        HYUN_APP_HandoffRelease(HYUN_APP_Handoff_t *Handoff)
+     */
+    uint8        Record[HYUN_APP_HANDOFF_SLOT_SIZE + 1];
+    const uint8 *Slot;
+    size_t       Size;
+    uint32       i;
+
+    /* Records come out in order with their own size */
+    for (i = 0; i < 3; i++)
+    {
+        memset(Record, (int)(0x10 + i), sizeof(Record));
+        UtAssert_True(HYUN_APP_HandoffPut(&UT_Handoff, Record, 10 + i), "Put record %lu", (unsigned long)i);
+    }
+
+    Slot = HYUN_APP_HandoffPeek(&UT_Handoff, &Size);
+    UtAssert_True(Slot != NULL && Size == 10 && Slot[0] == 0x10 && Slot[9] == 0x10, "First record, size %lu",
+                  (unsigned long)Size);
+
+    /* Peek does not consume */
+    UtAssert_True(HYUN_APP_HandoffPeek(&UT_Handoff, &Size) == Slot, "Same slot until released");
+    HYUN_APP_HandoffRelease(&UT_Handoff);
+
+    Slot = HYUN_APP_HandoffPeek(&UT_Handoff, &Size);
+    UtAssert_True(Slot != NULL && Size == 11 && Slot[0] == 0x11, "Second record, size %lu", (unsigned long)Size);
+    HYUN_APP_HandoffRelease(&UT_Handoff);
+    Slot = HYUN_APP_HandoffPeek(&UT_Handoff, &Size);
+    UtAssert_True(Slot != NULL && Size == 12 && Slot[0] == 0x12, "Third record, size %lu", (unsigned long)Size);
+    HYUN_APP_HandoffRelease(&UT_Handoff);
+
+    UtAssert_True(HYUN_APP_HandoffPeek(&UT_Handoff, &Size) == NULL, "Queue drained");
+    UtAssert_True(UT_Handoff.HighWater == 3, "HighWater (%lu) == 3", (unsigned long)UT_Handoff.HighWater);
+
+    /* A full slot and an empty record both fit, one byte more does not */
+    UtAssert_True(HYUN_APP_HandoffPut(&UT_Handoff, Record, HYUN_APP_HANDOFF_SLOT_SIZE), "Full slot record");
+    UtAssert_True(HYUN_APP_HandoffPut(&UT_Handoff, Record, 0), "Empty record");
+    UtAssert_True(!HYUN_APP_HandoffPut(&UT_Handoff, Record, sizeof(Record)), "Oversized record refused");
+    UtAssert_True(UT_Handoff.DropCounter == 1, "DropCounter (%lu) == 1", (unsigned long)UT_Handoff.DropCounter);
+}
+
+void Test_HYUN_APP_HandoffPut_Full(void)
+{
+    /*
+     * Test Case For:
+     * A full queue refuses new records until the consumer frees a slot
+     */
+    const uint32 *Slot;
+    size_t        Size;
+    uint32        Seq;
+    uint32        Next = 0;
+    uint32        Bad  = 0;
+
+    for (Seq = 0; Seq < HYUN_APP_HANDOFF_DEPTH; Seq++)
+    {
+        UtAssert_True(HYUN_APP_HandoffPut(&UT_Handoff, &Seq, sizeof(Seq)), "Put %lu", (unsigned long)Seq);
+    }
+
+    UtAssert_True(!HYUN_APP_HandoffPut(&UT_Handoff, &Seq, sizeof(Seq)), "Full queue refuses");
+    UtAssert_True(UT_Handoff.DropCounter == 1, "DropCounter (%lu) == 1", (unsigned long)UT_Handoff.DropCounter);
+    UtAssert_True(UT_Handoff.HighWater == 0, "HighWater only moves on the consumer side");
+
+    /* Steady state over several laps of the ring, one behind the producer */
+    for (; Seq < 5 * HYUN_APP_HANDOFF_DEPTH + 3; Seq++)
+    {
+        Slot = HYUN_APP_HandoffPeek(&UT_Handoff, &Size);
+        if (Slot == NULL || Size != sizeof(uint32) || *Slot != Next)
+        {
+            Bad++;
+        }
+        HYUN_APP_HandoffRelease(&UT_Handoff);
+        Next++;
+
+        if (!HYUN_APP_HandoffPut(&UT_Handoff, &Seq, sizeof(Seq)))
+        {
+            Bad++;
+        }
+    }
+
+    UtAssert_True(Bad == 0, "Records in order across the wrap (%lu bad)", (unsigned long)Bad);
+    UtAssert_True(UT_Handoff.HighWater == HYUN_APP_HANDOFF_DEPTH, "HighWater (%lu) == HYUN_APP_HANDOFF_DEPTH",
+                  (unsigned long)UT_Handoff.HighWater);
+    UtAssert_True(UT_Handoff.Head - UT_Handoff.Tail == HYUN_APP_HANDOFF_DEPTH, "Still full");
+    UtAssert_True(UT_Handoff.DropCounter == 1, "No further drops");
+}
+
+/*
+ * Setup function prior to every test
+ */
+void Hyun_UT_Setup(void)
+{
+    UT_ResetState(0);
+    HYUN_APP_HandoffInit(&UT_Handoff);
+}
+
+/*
+ * Teardown function after every test
+ */
+void Hyun_UT_TearDown(void) {}
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    ADD_TEST(HYUN_APP_HandoffInit);
+    ADD_TEST(HYUN_APP_HandoffPut);
+    ADD_TEST(HYUN_APP_HandoffPut_Full);
+}
@@ -0,0 +1,251 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2019 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_hyun_app_kf.c
+**
+** Purpose:
+** Coverage Unit Test cases for the HYUN_APP altitude / velocity estimator
+**
+** Notes:
+** The estimator is plain C with no cFE calls, so these cases only
+** drive the API and check the state and covariance it leaves.
+*/
+
+/*
+ * Includes
+ */
+
+#include "hyun_app_coveragetest_common.h"
+#include "hyun_app_kf.h"
+
+/*
+ * True when the covariance of Kf is symmetric
+ */
+static bool UT_KF_Symmetric(const HYUN_APP_KF_t *Kf)
+{
+    uint8 i;
+    uint8 j;
+
+    for (i = 0; i < Kf->NumStates; i++)
+    {
+        for (j = 0; j < i; j++)
+        {
+            if (Kf->P[i][j] != Kf->P[j][i])
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+**********************************************************************************
+**          TEST CASE FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_HYUN_APP_KF_Init(void)
+{
+    /*
+     * Test Case For:
+     * void HYUN_APP_KF_Init(HYUN_APP_KF_t *Kf, uint8 NumStates)
+     */
+    HYUN_APP_KF_t Kf;
+
+    HYUN_APP_KF_Init(&Kf, 2);
+    UtAssert_True(Kf.NumStates == 2, "NumStates (%u) == 2", (unsigned int)Kf.NumStates);
+    UtAssert_True(!Kf.Initialized, "Estimator waits for the first baro fix");
+    UtAssert_True(Kf.P[1][1] == HYUN_APP_KF_INIT_VAR && Kf.P[2][2] == 0.0f, "Only the 2 used states get a variance");
+
+    /* Anything but 2 or 3 states falls back to the default model */
+    HYUN_APP_KF_Init(&Kf, 7);
+    UtAssert_True(Kf.NumStates == HYUN_APP_KF_DEFAULT_STATES, "NumStates (%u) == HYUN_APP_KF_DEFAULT_STATES",
+                  (unsigned int)Kf.NumStates);
+    UtAssert_True(Kf.P[2][2] == HYUN_APP_KF_INIT_VAR, "P[2][2] (%f) == HYUN_APP_KF_INIT_VAR", (double)Kf.P[2][2]);
+    UtAssert_True(Kf.P[0][1] == 0.0f, "Off-diagonal covariance starts at zero");
+}
+
+void Test_HYUN_APP_KF_Predict(void)
+{
+    /*
+     * Test Case For:
+     * void HYUN_APP_KF_Predict(HYUN_APP_KF_t *Kf, float Dt)
+     */
+    HYUN_APP_KF_t Kf;
+    HYUN_APP_KF_t Clamped;
+
+    /* A zero or negative step changes nothing */
+    HYUN_APP_KF_Init(&Kf, 2);
+    HYUN_APP_KF_Predict(&Kf, 0.0f);
+    HYUN_APP_KF_Predict(&Kf, -1.0f);
+    UtAssert_True(Kf.PredictCounter == 0, "PredictCounter (%lu) == 0", (unsigned long)Kf.PredictCounter);
+
+    /* 2-state model: the held acceleration is the control input */
+    Kf.X[HYUN_APP_KF_STATE_ALT] = 10.0f;
+    Kf.X[HYUN_APP_KF_STATE_VEL] = 2.0f;
+    Kf.Accel                    = 4.0f;
+    HYUN_APP_KF_Predict(&Kf, 0.5f);
+    UtAssert_DoubleCmpAbs(Kf.X[HYUN_APP_KF_STATE_ALT], 11.5f, 1.0e-5, "2-state altitude after 0.5 s");
+    UtAssert_DoubleCmpAbs(Kf.X[HYUN_APP_KF_STATE_VEL], 4.0f, 1.0e-5, "2-state velocity after 0.5 s");
+    UtAssert_True(Kf.P[0][0] > HYUN_APP_KF_INIT_VAR, "Altitude variance grows (%f)", (double)Kf.P[0][0]);
+    UtAssert_True(UT_KF_Symmetric(&Kf), "2-state covariance stays symmetric");
+    UtAssert_True(Kf.PredictCounter == 1, "PredictCounter (%lu) == 1", (unsigned long)Kf.PredictCounter);
+
+    /* 3-state model: acceleration is a state */
+    HYUN_APP_KF_Init(&Kf, 3);
+    Kf.X[HYUN_APP_KF_STATE_VEL]   = 2.0f;
+    Kf.X[HYUN_APP_KF_STATE_ACCEL] = 4.0f;
+    HYUN_APP_KF_Predict(&Kf, 0.5f);
+    UtAssert_DoubleCmpAbs(Kf.X[HYUN_APP_KF_STATE_ALT], 1.5f, 1.0e-5, "3-state altitude after 0.5 s");
+    UtAssert_DoubleCmpAbs(Kf.X[HYUN_APP_KF_STATE_VEL], 4.0f, 1.0e-5, "3-state velocity after 0.5 s");
+    UtAssert_DoubleCmpAbs(Kf.X[HYUN_APP_KF_STATE_ACCEL], 4.0f, 1.0e-5, "3-state acceleration is held");
+    UtAssert_True(UT_KF_Symmetric(&Kf), "3-state covariance stays symmetric");
+
+    /* Gaps longer than HYUN_APP_KF_MAX_DT are clamped */
+    HYUN_APP_KF_Init(&Kf, 3);
+    Kf.X[HYUN_APP_KF_STATE_VEL] = 1.0f;
+    Clamped                     = Kf;
+    HYUN_APP_KF_Predict(&Kf, 60.0f);
+    HYUN_APP_KF_Predict(&Clamped, HYUN_APP_KF_MAX_DT);
+    UtAssert_True(Kf.X[HYUN_APP_KF_STATE_ALT] == Clamped.X[HYUN_APP_KF_STATE_ALT] && Kf.P[0][0] == Clamped.P[0][0],
+                  "A long gap predicts by HYUN_APP_KF_MAX_DT only");
+}
+
+void Test_HYUN_APP_KF_UpdateBaro(void)
+{
+    /*
+     * Test Case For:
+     * void HYUN_APP_KF_UpdateBaro(HYUN_APP_KF_t *Kf, float Altitude)
+     */
+    HYUN_APP_KF_t Kf;
+    float         P00;
+
+    /* The first fix seeds the altitude without an update */
+    HYUN_APP_KF_Init(&Kf, 3);
+    HYUN_APP_KF_UpdateBaro(&Kf, 120.0f);
+    UtAssert_True(Kf.Initialized, "First baro fix initializes the estimator");
+    UtAssert_True(Kf.X[HYUN_APP_KF_STATE_ALT] == 120.0f, "Altitude (%f) == 120", (double)Kf.X[HYUN_APP_KF_STATE_ALT]);
+    UtAssert_True(Kf.P[0][0] == Kf.BaroVar, "Altitude variance (%f) == BaroVar", (double)Kf.P[0][0]);
+    UtAssert_True(Kf.UpdateCounter == 0, "UpdateCounter (%lu) == 0", (unsigned long)Kf.UpdateCounter);
+
+    /* Later fixes pull the altitude toward the measurement */
+    P00 = Kf.P[0][0];
+    HYUN_APP_KF_UpdateBaro(&Kf, 121.0f);
+    UtAssert_True(Kf.X[HYUN_APP_KF_STATE_ALT] > 120.0f && Kf.X[HYUN_APP_KF_STATE_ALT] < 121.0f,
+                  "Altitude (%f) between estimate and measurement", (double)Kf.X[HYUN_APP_KF_STATE_ALT]);
+    UtAssert_True(Kf.P[0][0] < P00, "Altitude variance shrinks (%f < %f)", (double)Kf.P[0][0], (double)P00);
+    UtAssert_True(UT_KF_Symmetric(&Kf), "Covariance stays symmetric");
+    UtAssert_True(Kf.UpdateCounter == 1, "UpdateCounter (%lu) == 1", (unsigned long)Kf.UpdateCounter);
+}
+
+void Test_HYUN_APP_KF_UpdateAccel(void)
+{
+    /*
+     * Test Case For:
+     * void HYUN_APP_KF_UpdateAccel(HYUN_APP_KF_t *Kf, float VertAccel)
+     */
+    HYUN_APP_KF_t Kf;
+
+    /* 2-state model: held as the control input, not fused */
+    HYUN_APP_KF_Init(&Kf, 2);
+    HYUN_APP_KF_UpdateAccel(&Kf, 3.0f);
+    UtAssert_True(Kf.Accel == 3.0f, "Accel (%f) == 3", (double)Kf.Accel);
+    UtAssert_True(Kf.UpdateCounter == 0, "UpdateCounter (%lu) == 0", (unsigned long)Kf.UpdateCounter);
+
+    /* 3-state model: ignored until the first baro fix */
+    HYUN_APP_KF_Init(&Kf, 3);
+    HYUN_APP_KF_UpdateAccel(&Kf, 3.0f);
+    UtAssert_True(Kf.X[HYUN_APP_KF_STATE_ACCEL] == 0.0f && Kf.UpdateCounter == 0,
+                  "Acceleration not fused before initialization");
+
+    HYUN_APP_KF_UpdateBaro(&Kf, 0.0f);
+    HYUN_APP_KF_UpdateAccel(&Kf, 3.0f);
+    UtAssert_True(Kf.X[HYUN_APP_KF_STATE_ACCEL] > 0.0f && Kf.X[HYUN_APP_KF_STATE_ACCEL] <= 3.0f,
+                  "Acceleration (%f) fused", (double)Kf.X[HYUN_APP_KF_STATE_ACCEL]);
+    UtAssert_True(Kf.UpdateCounter == 1, "UpdateCounter (%lu) == 1", (unsigned long)Kf.UpdateCounter);
+}
+
+void Test_HYUN_APP_KF_Step(void)
+{
+    /*
+     * Test Case For:
+     * void HYUN_APP_KF_Step(HYUN_APP_KF_t *Kf, uint64 TimeUs, uint8 Mask, float Altitude, float VertAccel)
+     */
+    HYUN_APP_KF_t Kf;
+    uint64        TimeUs;
+
+    /* The first step only sets the time */
+    HYUN_APP_KF_Init(&Kf, 3);
+    HYUN_APP_KF_Step(&Kf, 1000000, HYUN_APP_KF_MEAS_BARO, 50.0f, 0.0f);
+    UtAssert_True(Kf.PredictCounter == 0, "No prediction on the first step");
+    UtAssert_True(Kf.LastTimeUs == 1000000, "LastTimeUs (%lu) == 1000000", (unsigned long)Kf.LastTimeUs);
+    UtAssert_True(Kf.Initialized, "Baro in the mask is fused");
+
+    /* A later step predicts, an empty mask fuses nothing */
+    HYUN_APP_KF_Step(&Kf, 1050000, 0, 0.0f, 0.0f);
+    UtAssert_True(Kf.PredictCounter == 1, "PredictCounter (%lu) == 1", (unsigned long)Kf.PredictCounter);
+    UtAssert_True(Kf.UpdateCounter == 0, "UpdateCounter (%lu) == 0", (unsigned long)Kf.UpdateCounter);
+
+    /* An older sample is fused without prediction and keeps the time */
+    HYUN_APP_KF_Step(&Kf, 1020000, HYUN_APP_KF_MEAS_BARO | HYUN_APP_KF_MEAS_ACCEL, 50.0f, 0.0f);
+    UtAssert_True(Kf.PredictCounter == 1, "No prediction for an older sample");
+    UtAssert_True(Kf.LastTimeUs == 1050000, "LastTimeUs (%lu) == 1050000", (unsigned long)Kf.LastTimeUs);
+    UtAssert_True(Kf.UpdateCounter == 2, "UpdateCounter (%lu) == 2", (unsigned long)Kf.UpdateCounter);
+
+    /* A 5 m/s climb seen by the baro at 20 Hz: velocity converges */
+    HYUN_APP_KF_Init(&Kf, 3);
+    for (TimeUs = 50000; TimeUs <= 20000000; TimeUs += 50000)
+    {
+        HYUN_APP_KF_Step(&Kf, TimeUs, HYUN_APP_KF_MEAS_BARO | HYUN_APP_KF_MEAS_ACCEL, 5.0f * (float)TimeUs * 1.0e-6f,
+                         0.0f);
+    }
+    UtAssert_DoubleCmpAbs(Kf.X[HYUN_APP_KF_STATE_ALT], 100.0f, 0.5, "Altitude (%f) tracks the climb",
+                          (double)Kf.X[HYUN_APP_KF_STATE_ALT]);
+    UtAssert_DoubleCmpAbs(Kf.X[HYUN_APP_KF_STATE_VEL], 5.0f, 0.5, "Velocity (%f) converges to 5 m/s",
+                          (double)Kf.X[HYUN_APP_KF_STATE_VEL]);
+}
+
+/*
+ * Setup function prior to every test
+ */
+void Hyun_UT_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Teardown function after every test
+ */
+void Hyun_UT_TearDown(void) {}
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    ADD_TEST(HYUN_APP_KF_Init);
+    ADD_TEST(HYUN_APP_KF_Predict);
+    ADD_TEST(HYUN_APP_KF_UpdateBaro);
+    ADD_TEST(HYUN_APP_KF_UpdateAccel);
+    ADD_TEST(HYUN_APP_KF_Step);
+}
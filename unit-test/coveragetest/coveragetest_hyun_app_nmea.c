@@ -0,0 +1,244 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2019 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_hyun_app_nmea.c
+**
+** Purpose:
+** Coverage Unit Test cases for the HYUN_APP NMEA parser
+*/
+
+/*
+ * Includes
+ */
+
+#include <string.h>
+
+#include "hyun_app_coveragetest_common.h"
+#include "hyun_app_nmea.h"
+
+#define UT_NMEA_GGA "GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,"
+#define UT_NMEA_RMC "GNRMC,123520,A,4807.038,S,01131.000,W,022.4,084.4,230394,003.1,W"
+
+/*
+ * "$<Body>*<checksum>\r\n" into Out, returns its length
+ */
+static size_t UT_Nmea_Sentence(char *Out, const char *Body)
+{
+    static const char Hex[] = "0123456789ABCDEF";
+    uint8             Checksum = 0;
+    size_t            Len      = strlen(Body);
+    size_t            i;
+
+    Out[0] = '$';
+    for (i = 0; i < Len; i++)
+    {
+        Out[1 + i] = Body[i];
+        Checksum ^= (uint8)Body[i];
+    }
+    Out[1 + Len] = '*';
+    Out[2 + Len] = Hex[Checksum >> 4];
+    Out[3 + Len] = Hex[Checksum & 0x0F];
+    Out[4 + Len] = '\r';
+    Out[5 + Len] = '\n';
+    Out[6 + Len] = 0;
+
+    return Len + 6;
+}
+
+/*
+**********************************************************************************
+**          TEST CASE FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_HYUN_APP_NmeaFeed_Gga(void)
+{
+    /*
+     * Test Case For:
+     * size_t HYUN_APP_NmeaFeed(HYUN_APP_NmeaParser_t *Parser, const uint8 *Data, size_t Len,
+     *                          HYUN_APP_NmeaFix_t *Fix, bool *FixReady)
+     */
+    HYUN_APP_NmeaParser_t Parser;
+    HYUN_APP_NmeaFix_t    Fix;
+    bool                  FixReady;
+    char                  Text[2 * HYUN_APP_NMEA_MAX_SENTENCE];
+    size_t                Len;
+    size_t                Used;
+
+    HYUN_APP_NmeaInit(&Parser);
+    Len  = UT_Nmea_Sentence(Text, UT_NMEA_GGA);
+    Used = HYUN_APP_NmeaFeed(&Parser, (const uint8 *)Text, Len, &Fix, &FixReady);
+
+    UtAssert_True(FixReady, "GGA gives a fix");
+    UtAssert_True(Used == Len - 2, "Consumed (%lu) up to the checksum", (unsigned long)Used);
+    UtAssert_True(Fix.Type == HYUN_APP_NMEA_TYPE_GGA, "Type (%u) == GGA", (unsigned int)Fix.Type);
+    UtAssert_True(Fix.LatitudeE7 == 481173000, "LatitudeE7 (%ld) == 481173000", (long)Fix.LatitudeE7);
+    UtAssert_True(Fix.LongitudeE7 == 115166666, "LongitudeE7 (%ld) == 115166666", (long)Fix.LongitudeE7);
+    UtAssert_DoubleCmpAbs(Fix.Altitude, 545.4f, 1.0e-3, "Altitude (%f) == 545.4", (double)Fix.Altitude);
+    UtAssert_True(Fix.Satellites == 8 && Fix.FixValid, "8 satellites, fix valid");
+    UtAssert_True(Parser.SentenceCounter == 1, "SentenceCounter (%lu) == 1", (unsigned long)Parser.SentenceCounter);
+
+    /* The line ending left over is skipped */
+    Used = HYUN_APP_NmeaFeed(&Parser, (const uint8 *)&Text[Used], Len - Used, &Fix, &FixReady);
+    UtAssert_True(!FixReady && Used == 2, "Line ending consumed without a fix");
+}
+
+void Test_HYUN_APP_NmeaFeed_Rmc(void)
+{
+    /*
+     * Test Case For:
+     * RMC sentences, southern / western hemisphere, values carried from GGA
+     */
+    HYUN_APP_NmeaParser_t Parser;
+    HYUN_APP_NmeaFix_t    Fix;
+    bool                  FixReady;
+    char                  Text[4 * HYUN_APP_NMEA_MAX_SENTENCE];
+    size_t                Len;
+    size_t                Used;
+
+    HYUN_APP_NmeaInit(&Parser);
+
+    /* Two sentences in one buffer come out one per call */
+    Len = UT_Nmea_Sentence(Text, UT_NMEA_GGA);
+    Len += UT_Nmea_Sentence(&Text[Len], UT_NMEA_RMC);
+
+    Used = HYUN_APP_NmeaFeed(&Parser, (const uint8 *)Text, Len, &Fix, &FixReady);
+    UtAssert_True(FixReady && Fix.Type == HYUN_APP_NMEA_TYPE_GGA, "GGA first");
+
+    Used += HYUN_APP_NmeaFeed(&Parser, (const uint8 *)&Text[Used], Len - Used, &Fix, &FixReady);
+    UtAssert_True(FixReady && Fix.Type == HYUN_APP_NMEA_TYPE_RMC, "RMC second");
+    UtAssert_True(Used == Len - 2, "Consumed (%lu) up to the second checksum", (unsigned long)Used);
+    UtAssert_True(Fix.LatitudeE7 == -481173000, "LatitudeE7 (%ld) == -481173000", (long)Fix.LatitudeE7);
+    UtAssert_True(Fix.LongitudeE7 == -115166666, "LongitudeE7 (%ld) == -115166666", (long)Fix.LongitudeE7);
+    UtAssert_True(Fix.FixValid, "Status A is a valid fix");
+    UtAssert_DoubleCmpAbs(Fix.Altitude, 545.4f, 1.0e-3, "Altitude (%f) carried from GGA", (double)Fix.Altitude);
+    UtAssert_True(Fix.Satellites == 8, "Satellites (%u) carried from GGA", (unsigned int)Fix.Satellites);
+}
+
+void Test_HYUN_APP_NmeaFeed_Split(void)
+{
+    /*
+     * Test Case For:
+     * A sentence delivered one byte per call
+     */
+    HYUN_APP_NmeaParser_t Parser;
+    HYUN_APP_NmeaFix_t    Fix;
+    bool                  FixReady;
+    char                  Text[2 * HYUN_APP_NMEA_MAX_SENTENCE];
+    size_t                Len;
+    size_t                i;
+    uint32                Fixes = 0;
+
+    HYUN_APP_NmeaInit(&Parser);
+    Len = UT_Nmea_Sentence(Text, UT_NMEA_GGA);
+
+    for (i = 0; i < Len; i++)
+    {
+        UtAssert_True(HYUN_APP_NmeaFeed(&Parser, (const uint8 *)&Text[i], 1, &Fix, &FixReady) == 1,
+                      "One byte consumed");
+        if (FixReady)
+        {
+            Fixes++;
+        }
+    }
+
+    UtAssert_True(Fixes == 1, "Fixes (%lu) == 1", (unsigned long)Fixes);
+    UtAssert_True(Fix.LatitudeE7 == 481173000, "LatitudeE7 (%ld) == 481173000", (long)Fix.LatitudeE7);
+}
+
+void Test_HYUN_APP_NmeaFeed_Errors(void)
+{
+    /*
+     * Test Case For:
+     * Sentences the parser refuses
+     */
+    HYUN_APP_NmeaParser_t Parser;
+    HYUN_APP_NmeaFix_t    Fix;
+    bool                  FixReady;
+    char                  Text[4 * HYUN_APP_NMEA_MAX_SENTENCE];
+    size_t                Len;
+
+    HYUN_APP_NmeaInit(&Parser);
+
+    /* Bad checksum */
+    Len           = UT_Nmea_Sentence(Text, UT_NMEA_GGA);
+    Text[Len - 3] = (Text[Len - 3] == '0') ? '1' : '0';
+    HYUN_APP_NmeaFeed(&Parser, (const uint8 *)Text, Len, &Fix, &FixReady);
+    UtAssert_True(!FixReady, "No fix on a bad checksum");
+    UtAssert_True(Parser.ChecksumErrCounter == 1, "ChecksumErrCounter (%lu) == 1",
+                  (unsigned long)Parser.ChecksumErrCounter);
+
+    /* Non-hex checksum */
+    Len           = UT_Nmea_Sentence(Text, UT_NMEA_GGA);
+    Text[Len - 4] = 'x';
+    HYUN_APP_NmeaFeed(&Parser, (const uint8 *)Text, Len, &Fix, &FixReady);
+    UtAssert_True(!FixReady && Parser.FormatErrCounter == 1, "FormatErrCounter (%lu) == 1",
+                  (unsigned long)Parser.FormatErrCounter);
+
+    /* Other sentence types are skipped without an error */
+    Len = UT_Nmea_Sentence(Text, "GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00");
+    HYUN_APP_NmeaFeed(&Parser, (const uint8 *)Text, Len, &Fix, &FixReady);
+    UtAssert_True(!FixReady && Parser.FormatErrCounter == 1, "GSV skipped");
+
+    /* Too few fields */
+    Len = UT_Nmea_Sentence(Text, "GPGGA,123519,4807.038,N");
+    HYUN_APP_NmeaFeed(&Parser, (const uint8 *)Text, Len, &Fix, &FixReady);
+    UtAssert_True(!FixReady && Parser.FormatErrCounter == 2, "FormatErrCounter (%lu) == 2",
+                  (unsigned long)Parser.FormatErrCounter);
+
+    /* Longer than HYUN_APP_NMEA_MAX_SENTENCE */
+    Len = UT_Nmea_Sentence(Text, UT_NMEA_GGA ",0000000000000000000000000000");
+    HYUN_APP_NmeaFeed(&Parser, (const uint8 *)Text, Len, &Fix, &FixReady);
+    UtAssert_True(!FixReady && Parser.FormatErrCounter == 3, "FormatErrCounter (%lu) == 3",
+                  (unsigned long)Parser.FormatErrCounter);
+
+    /* A '$' inside a sentence starts over, the second one still parses */
+    Text[0] = '$';
+    memcpy(&Text[1], "GPGGA,1235", 10);
+    Len = 11 + UT_Nmea_Sentence(&Text[11], UT_NMEA_GGA);
+    HYUN_APP_NmeaFeed(&Parser, (const uint8 *)Text, Len, &Fix, &FixReady);
+    UtAssert_True(FixReady, "Resynchronized on '$'");
+    UtAssert_True(Parser.SentenceCounter == 1, "SentenceCounter (%lu) == 1", (unsigned long)Parser.SentenceCounter);
+}
+
+/*
+ * Setup function prior to every test
+ */
+void Hyun_UT_Setup(void)
+{
+    UT_ResetState(0);
+}
+
+/*
+ * Teardown function after every test
+ */
+void Hyun_UT_TearDown(void) {}
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    ADD_TEST(HYUN_APP_NmeaFeed_Gga);
+    ADD_TEST(HYUN_APP_NmeaFeed_Rmc);
+    ADD_TEST(HYUN_APP_NmeaFeed_Split);
+    ADD_TEST(HYUN_APP_NmeaFeed_Errors);
+}
@@ -0,0 +1,272 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2019 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_hyun_app_seq.c
+**
+** Purpose:
+** Coverage Unit Test cases for the HYUN_APP command sequences
+**
+** Notes:
+** The ground command dispatch is replaced by a stand-in that keeps the
+** payload of every step it is handed.
+*/
+
+/*
+ * Includes
+ */
+
+#include <string.h>
+
+#include "hyun_app_coveragetest_common.h"
+#include "ut_hyun_app.h"
+
+HYUN_APP_Data_t HYUN_APP_Data;
+
+/*
+ * Same length table as the app, hyun_app.c is not part of this test
+ */
+#define UT_SEQ_CMD_LENGTH(Name, CC, Type, Handler) [CC] = sizeof(Type),
+
+const size_t HYUN_APP_CmdLength[HYUN_APP_CMD_COUNT] = {HYUN_APP_CMD_DEFS(UT_SEQ_CMD_LENGTH)};
+
+static HYUN_APP_SeqTable_t UT_SeqTbl;
+static HYUN_APP_Table_t    UT_AppTbl;
+static uint8               UT_StepArgs[HYUN_APP_SEQ_MAX_STEPS][HYUN_APP_SEQ_MAX_ARGS];
+static uint32              UT_StepCount;
+static uint32              UT_RefuseStep; /* 1-based step the dispatch refuses, 0 for none */
+
+uint64 HYUN_APP_SysTimeToUsec(CFE_TIME_SysTime_t Time)
+{
+    (void)Time;
+
+    return 1000000u + 250u * UT_StepCount;
+}
+
+int32 HYUN_APP_ProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr)
+{
+    memcpy(UT_StepArgs[UT_StepCount++], (const uint8 *)SBBufPtr + sizeof(CFE_MSG_CommandHeader_t),
+           HYUN_APP_SEQ_MAX_ARGS);
+
+    return (UT_StepCount == UT_RefuseStep) ? CFE_STATUS_EXTERNAL_RESOURCE_FAIL : CFE_SUCCESS;
+}
+
+/*
+ * Step helpers: NOOP, TTAG_CANCEL carrying a tag as a marker, TEXT_CMD
+ */
+static void UT_Seq_Noop(HYUN_APP_SeqStep_t *Step)
+{
+    memset(Step, 0, sizeof(*Step));
+    Step->CommandCode = HYUN_APP_NOOP_CC;
+}
+
+static void UT_Seq_Cancel(HYUN_APP_SeqStep_t *Step, uint32 TagId)
+{
+    memset(Step, 0, sizeof(*Step));
+    Step->CommandCode = HYUN_APP_TTAG_CANCEL_CC;
+    Step->ArgLength   = sizeof(HYUN_APP_TtagCancelCmd_Payload_t);
+    memcpy(Step->Args, &TagId, sizeof(TagId));
+}
+
+static void UT_Seq_Text(HYUN_APP_SeqStep_t *Step, const char *Text)
+{
+    memset(Step, 0, sizeof(*Step));
+    Step->CommandCode = HYUN_APP_TEXT_CMD_CC;
+    Step->ArgLength   = sizeof(HYUN_APP_TextCmd_Payload_t);
+    strncpy((char *)Step->Args, Text, HYUN_APP_SEQ_MAX_ARGS - 1);
+}
+
+/*
+ * "LAUNCH": NOOP, CANCEL 7, "CX,ON", CANCEL 9
+ * "SAFE"  : CANCEL 1
+ */
+static void UT_Seq_Table(void)
+{
+    memset(&UT_SeqTbl, 0, sizeof(UT_SeqTbl));
+
+    strncpy(UT_SeqTbl.Seq[0].Name, "LAUNCH", HYUN_APP_SEQ_NAME_LEN);
+    UT_SeqTbl.Seq[0].StepCount = 4;
+    UT_Seq_Noop(&UT_SeqTbl.Seq[0].Step[0]);
+    UT_Seq_Cancel(&UT_SeqTbl.Seq[0].Step[1], 7);
+    UT_Seq_Text(&UT_SeqTbl.Seq[0].Step[2], "CX,ON");
+    UT_Seq_Cancel(&UT_SeqTbl.Seq[0].Step[3], 9);
+
+    strncpy(UT_SeqTbl.Seq[2].Name, "SAFE", HYUN_APP_SEQ_NAME_LEN);
+    UT_SeqTbl.Seq[2].StepCount = 1;
+    UT_Seq_Cancel(&UT_SeqTbl.Seq[2].Step[0], 1);
+}
+
+static int32 UT_Seq_Start(const char *Name)
+{
+    HYUN_APP_SeqStartCmd_t Cmd;
+    void                  *TblPtrs[2] = {&UT_SeqTbl, &UT_AppTbl};
+
+    memset(&Cmd, 0, sizeof(Cmd));
+    strncpy(Cmd.Payload.Name, Name, HYUN_APP_SEQ_NAME_LEN);
+
+    UT_SetDataBuffer(UT_KEY(CFE_TBL_GetAddress), TblPtrs, sizeof(TblPtrs), false);
+
+    return HYUN_APP_SeqStartCmd(&Cmd);
+}
+
+/*
+**********************************************************************************
+**          TEST CASE FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_HYUN_APP_SeqTblValidationFunc(void)
+{
+    /*
+     * Test Case For:
+     * int32 HYUN_APP_SeqTblValidationFunc(void *TblData)
+     */
+    HYUN_APP_SeqStep_t *Step = &UT_SeqTbl.Seq[0].Step[1];
+
+    UT_TEST_FUNCTION_RC(HYUN_APP_SeqTblValidationFunc(&UT_SeqTbl), CFE_SUCCESS);
+
+    /* Sequence shape */
+    UT_SeqTbl.Seq[0].StepCount = HYUN_APP_SEQ_MAX_STEPS + 1;
+    UT_TEST_FUNCTION_RC(HYUN_APP_SeqTblValidationFunc(&UT_SeqTbl), HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE);
+    UT_Seq_Table();
+    UT_SeqTbl.Seq[0].StepCount = 0;
+    UT_TEST_FUNCTION_RC(HYUN_APP_SeqTblValidationFunc(&UT_SeqTbl), HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE);
+    UT_Seq_Table();
+    strncpy(UT_SeqTbl.Seq[2].Name, "LAUNCH", HYUN_APP_SEQ_NAME_LEN);
+    UT_TEST_FUNCTION_RC(HYUN_APP_SeqTblValidationFunc(&UT_SeqTbl), HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE);
+
+    /* Steps against the command schema */
+    UT_Seq_Table();
+    Step->CommandCode = HYUN_APP_CMD_COUNT;
+    UT_TEST_FUNCTION_RC(HYUN_APP_SeqTblValidationFunc(&UT_SeqTbl), HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE);
+    Step->CommandCode = HYUN_APP_SEQ_START_CC;
+    Step->ArgLength   = sizeof(HYUN_APP_SeqStartCmd_Payload_t);
+    UT_TEST_FUNCTION_RC(HYUN_APP_SeqTblValidationFunc(&UT_SeqTbl), HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE);
+    UT_Seq_Cancel(Step, 7);
+    Step->ArgLength++;
+    UT_TEST_FUNCTION_RC(HYUN_APP_SeqTblValidationFunc(&UT_SeqTbl), HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE);
+
+    /* Text steps leave the prefix out and leave room for it */
+    UT_Seq_Text(Step, "CMD,1042,CX,ON");
+    UT_TEST_FUNCTION_RC(HYUN_APP_SeqTblValidationFunc(&UT_SeqTbl), HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE);
+    UT_Seq_Text(Step, "");
+    memset(Step->Args, 'A', HYUN_APP_SEQ_MAX_TEXT + 1);
+    UT_TEST_FUNCTION_RC(HYUN_APP_SeqTblValidationFunc(&UT_SeqTbl), HYUN_APP_TABLE_OUT_OF_RANGE_ERR_CODE);
+    Step->Args[HYUN_APP_SEQ_MAX_TEXT] = 0;
+    UT_TEST_FUNCTION_RC(HYUN_APP_SeqTblValidationFunc(&UT_SeqTbl), CFE_SUCCESS);
+}
+
+void Test_HYUN_APP_SeqStartCmd(void)
+{
+    /*
+     * Test Case For:
+     * int32 HYUN_APP_SeqStartCmd(const HYUN_APP_SeqStartCmd_t *Msg)
+     */
+    uint32 TagId;
+
+    UT_TEST_FUNCTION_RC(UT_Seq_Start("LAUNCH"), CFE_SUCCESS);
+
+    UtAssert_True(UT_StepCount == 4, "UT_StepCount (%lu) == 4", (unsigned long)UT_StepCount);
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_MSG_Init)) == 4 && UT_GetStubCount(UT_KEY(CFE_MSG_SetFcnCode)) == 4,
+                  "One packet built per step");
+    memcpy(&TagId, UT_StepArgs[1], sizeof(TagId));
+    UtAssert_True(TagId == 7, "Step 2 payload (%lu) == 7", (unsigned long)TagId);
+    UtAssert_True(strcmp((const char *)UT_StepArgs[2], "CMD,1042,CX,ON") == 0, "Text step: %s",
+                  (const char *)UT_StepArgs[2]);
+    memcpy(&TagId, UT_StepArgs[3], sizeof(TagId));
+    UtAssert_True(TagId == 9, "Step 4 payload (%lu) == 9", (unsigned long)TagId);
+
+    UtAssert_True(HYUN_APP_Data.Seq.RunCounter == 1 && HYUN_APP_Data.Seq.AbortCounter == 0, "RunCounter == 1");
+    UtAssert_True(HYUN_APP_Data.Seq.LastRunUs == 1000, "LastRunUs (%lu) == 1000",
+                  (unsigned long)HYUN_APP_Data.Seq.LastRunUs);
+    UtAssert_True(HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].CmdCounter == 1, "CmdCounter == 1");
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_TBL_ReleaseAddress)) == 2, "Both tables released");
+
+    /* A name filling the whole field */
+    memcpy(UT_SeqTbl.Seq[2].Name, "0123456789ABCDEF", HYUN_APP_SEQ_NAME_LEN);
+    UT_TEST_FUNCTION_RC(UT_Seq_Start("0123456789ABCDEF"), CFE_SUCCESS);
+    UtAssert_True(UT_StepCount == 5, "UT_StepCount (%lu) == 5", (unsigned long)UT_StepCount);
+}
+
+void Test_HYUN_APP_SeqStartCmd_Refused(void)
+{
+    /*
+     * Test Case For:
+     * Sequences that stop early or do not start
+     */
+
+    /* The third step is refused, the fourth does not run */
+    UT_RefuseStep = 3;
+    UT_TEST_FUNCTION_RC(UT_Seq_Start("LAUNCH"), CFE_STATUS_EXTERNAL_RESOURCE_FAIL);
+    UtAssert_True(UT_StepCount == 3, "UT_StepCount (%lu) == 3", (unsigned long)UT_StepCount);
+    UtAssert_True(HYUN_APP_Data.Seq.AbortCounter == 1 && HYUN_APP_Data.Seq.RunCounter == 0, "AbortCounter == 1");
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_TBL_ReleaseAddress)) == 2, "Both tables released");
+
+    /* Unknown name */
+    UT_TEST_FUNCTION_RC(UT_Seq_Start("ABORT"), CFE_STATUS_EXTERNAL_RESOURCE_FAIL);
+    UtAssert_True(UT_StepCount == 3 && HYUN_APP_Data.Seq.AbortCounter == 2, "Nothing run");
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_TBL_ReleaseAddress)) == 3, "Sequence table released");
+
+    /* No sequence table */
+    UT_SetDeferredRetcode(UT_KEY(CFE_TBL_GetAddress), 1, CFE_TBL_ERR_NEVER_LOADED);
+    UT_TEST_FUNCTION_RC(UT_Seq_Start("SAFE"), CFE_TBL_ERR_NEVER_LOADED);
+    UtAssert_True(UT_StepCount == 3 && HYUN_APP_Data.Seq.AbortCounter == 3, "Nothing run");
+    UtAssert_True(HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter == 3, "ErrCounter (%lu) == 3",
+                  (unsigned long)HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter);
+
+    /* Without the app table text steps get team 0 */
+    UT_RefuseStep = 0;
+    UT_SetDeferredRetcode(UT_KEY(CFE_TBL_GetAddress), 2, CFE_TBL_ERR_NEVER_LOADED);
+    UT_TEST_FUNCTION_RC(UT_Seq_Start("LAUNCH"), CFE_SUCCESS);
+    UtAssert_True(strcmp((const char *)UT_StepArgs[5], "CMD,0,CX,ON") == 0, "Text step: %s",
+                  (const char *)UT_StepArgs[5]);
+}
+
+/*
+ * Setup function prior to every test
+ */
+void Hyun_UT_Setup(void)
+{
+    UT_ResetState(0);
+
+    memset(&HYUN_APP_Data, 0, sizeof(HYUN_APP_Data));
+    memset(&UT_AppTbl, 0, sizeof(UT_AppTbl));
+    UT_AppTbl.TeamId = 1042;
+    UT_Seq_Table();
+
+    memset(UT_StepArgs, 0, sizeof(UT_StepArgs));
+    UT_StepCount  = 0;
+    UT_RefuseStep = 0;
+}
+
+/*
+ * Teardown function after every test
+ */
+void Hyun_UT_TearDown(void) {}
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    ADD_TEST(HYUN_APP_SeqTblValidationFunc);
+    ADD_TEST(HYUN_APP_SeqStartCmd);
+    ADD_TEST(HYUN_APP_SeqStartCmd_Refused);
+}
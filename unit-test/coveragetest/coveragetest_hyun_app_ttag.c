@@ -0,0 +1,354 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2019 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_hyun_app_ttag.c
+**
+** Purpose:
+** Coverage Unit Test cases for the HYUN_APP time-tagged command queue
+**
+** Notes:
+** Every embedded command carries its tag right after the header, so
+** the dispatch stand-in below can record the order commands ran in.
+*/
+
+/*
+ * Includes
+ */
+
+#include <string.h>
+
+#include "hyun_app_coveragetest_common.h"
+#include "ut_hyun_app.h"
+
+HYUN_APP_Data_t HYUN_APP_Data;
+
+/*
+ * MET returned by the HYUN_APP_SysTimeToUsec stand-in
+ */
+static uint64 UT_NowUs;
+
+static uint32                 UT_Dispatched[2 * HYUN_APP_TTAG_CAPACITY];
+static uint32                 UT_DispatchCount;
+static HYUN_APP_TtagListTlm_t UT_ListTlm;
+static bool                   UT_PoolEmpty;
+static uint32                 UT_PostCount;
+
+uint64 HYUN_APP_SysTimeToUsec(CFE_TIME_SysTime_t Time)
+{
+    (void)Time;
+
+    return UT_NowUs;
+}
+
+int32 HYUN_APP_ProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr)
+{
+    uint32 TagId;
+
+    memcpy(&TagId, (const uint8 *)SBBufPtr + sizeof(CFE_MSG_CommandHeader_t), sizeof(TagId));
+    UT_Dispatched[UT_DispatchCount++] = TagId;
+    return CFE_SUCCESS;
+}
+
+CFE_MSG_Message_t *HYUN_APP_PoolTake(HYUN_APP_MsgPool_t *Pool)
+{
+    (void)Pool;
+
+    return UT_PoolEmpty ? NULL : &UT_ListTlm.TlmHeader.Msg;
+}
+
+int32 HYUN_APP_DataPostTlm(HYUN_APP_MsgPool_t *Pool, CFE_MSG_Message_t *MsgPtr)
+{
+    (void)Pool;
+    (void)MsgPtr;
+
+    UT_PostCount++;
+    return CFE_SUCCESS;
+}
+
+/*
+ * TTAG_INSERT for a ground command of function code CommandCode, with
+ * the header fields the queue reads from the embedded packet
+ */
+static int32 UT_Ttag_Insert(uint32 TagId, uint64 ExecUs, CFE_MSG_FcnCode_t CommandCode)
+{
+    HYUN_APP_TtagInsertCmd_t Cmd;
+    CFE_SB_MsgId_t           MsgId = CFE_SB_ValueToMsgId(HYUN_APP_MID_GROUNDCMD_REQ);
+    size_t                   Size  = sizeof(CFE_MSG_CommandHeader_t) + sizeof(TagId);
+
+    memset(&Cmd, 0, sizeof(Cmd));
+    Cmd.Payload.TagId      = TagId;
+    Cmd.Payload.MetSeconds = (uint32)(ExecUs / 1000000u);
+    Cmd.Payload.MetMicros  = (uint32)(ExecUs % 1000000u);
+    Cmd.Payload.CmdLength  = (uint16)Size;
+    memcpy(&Cmd.Payload.Cmd[sizeof(CFE_MSG_CommandHeader_t)], &TagId, sizeof(TagId));
+
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetMsgId), &MsgId, sizeof(MsgId), false);
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetFcnCode), &CommandCode, sizeof(CommandCode), false);
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetSize), &Size, sizeof(Size), false);
+
+    return HYUN_APP_TtagInsertCmd(&Cmd);
+}
+
+static int32 UT_Ttag_Cancel(uint32 TagId)
+{
+    HYUN_APP_TtagCancelCmd_t Cmd;
+
+    memset(&Cmd, 0, sizeof(Cmd));
+    Cmd.Payload.TagId = TagId;
+
+    return HYUN_APP_TtagCancelCmd(&Cmd);
+}
+
+/*
+**********************************************************************************
+**          TEST CASE FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_HYUN_APP_TtagInsertCmd(void)
+{
+    /*
+     * Test Case For:
+     * int32 HYUN_APP_TtagInsertCmd(const HYUN_APP_TtagInsertCmd_t *Msg)
+     */
+    HYUN_APP_TtagInsertCmd_t Cmd;
+    CFE_SB_MsgId_t           MsgId;
+    size_t                   Size;
+    uint32                   TagId;
+
+    UT_NowUs = 10000000;
+
+    UtAssert_True(UT_Ttag_Insert(1, 12000000, HYUN_APP_NOOP_CC) == CFE_SUCCESS, "Insert tag 1");
+    UtAssert_True(HYUN_APP_Data.Ttag.Count == 1, "Count (%lu) == 1", (unsigned long)HYUN_APP_Data.Ttag.Count);
+    UtAssert_True(HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].CmdCounter == 1, "CmdCounter == 1");
+
+    /* Refusals */
+    UtAssert_True(UT_Ttag_Insert(1, 13000000, HYUN_APP_NOOP_CC) == CFE_STATUS_EXTERNAL_RESOURCE_FAIL,
+                  "Tag already queued");
+    UtAssert_True(UT_Ttag_Insert(0, 13000000, HYUN_APP_NOOP_CC) == CFE_STATUS_EXTERNAL_RESOURCE_FAIL, "Tag zero");
+    UtAssert_True(UT_Ttag_Insert(2, 10000000, HYUN_APP_NOOP_CC) == CFE_STATUS_EXTERNAL_RESOURCE_FAIL,
+                  "Time not ahead of now");
+    UtAssert_True(UT_Ttag_Insert(2, 13000000, HYUN_APP_TTAG_INSERT_CC) == CFE_STATUS_EXTERNAL_RESOURCE_FAIL,
+                  "Nested TTAG_INSERT");
+
+    memset(&Cmd, 0, sizeof(Cmd));
+    Cmd.Payload.TagId      = 2;
+    Cmd.Payload.MetSeconds = 13;
+    Cmd.Payload.CmdLength  = HYUN_APP_TTAG_MAX_CMD + 1;
+    UtAssert_True(HYUN_APP_TtagInsertCmd(&Cmd) == CFE_STATUS_EXTERNAL_RESOURCE_FAIL, "Command too long");
+
+    Cmd.Payload.CmdLength = sizeof(CFE_MSG_CommandHeader_t) + sizeof(TagId);
+    MsgId                 = CFE_SB_ValueToMsgId(HYUN_APP_MID_GROUNDCMD_REQ);
+    Size                  = Cmd.Payload.CmdLength + 1;
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetMsgId), &MsgId, sizeof(MsgId), false);
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetSize), &Size, sizeof(Size), false);
+    UtAssert_True(HYUN_APP_TtagInsertCmd(&Cmd) == CFE_STATUS_EXTERNAL_RESOURCE_FAIL, "Header length mismatch");
+
+    MsgId = CFE_SB_ValueToMsgId(HYUN_APP_MID_HOUSEKEEPING_REQ);
+    Size  = Cmd.Payload.CmdLength;
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetMsgId), &MsgId, sizeof(MsgId), false);
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetSize), &Size, sizeof(Size), false);
+    UtAssert_True(HYUN_APP_TtagInsertCmd(&Cmd) == CFE_STATUS_EXTERNAL_RESOURCE_FAIL, "Not a ground command");
+
+    UtAssert_True(HYUN_APP_Data.Ttag.Count == 1, "Count (%lu) still 1", (unsigned long)HYUN_APP_Data.Ttag.Count);
+    UtAssert_True(HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter == 7, "ErrCounter (%lu) == 7",
+                  (unsigned long)HYUN_APP_Data.Counters.Shard[HYUN_APP_TASK_MAIN].ErrCounter);
+
+    /* Fill to capacity */
+    for (TagId = 2; TagId <= HYUN_APP_TTAG_CAPACITY; TagId++)
+    {
+        UT_Ttag_Insert(TagId, 20000000 + TagId, HYUN_APP_NOOP_CC);
+    }
+    UtAssert_True(HYUN_APP_Data.Ttag.Count == HYUN_APP_TTAG_CAPACITY, "Count (%lu) == HYUN_APP_TTAG_CAPACITY",
+                  (unsigned long)HYUN_APP_Data.Ttag.Count);
+    UtAssert_True(UT_Ttag_Insert(TagId, 30000000, HYUN_APP_NOOP_CC) == CFE_STATUS_EXTERNAL_RESOURCE_FAIL,
+                  "Queue full");
+}
+
+void Test_HYUN_APP_TtagService(void)
+{
+    /*
+     * Test Case For:
+     * void HYUN_APP_TtagService(void)
+     */
+    static const uint32 Times[] = {9, 3, 7, 3, 1, 12, 7, 7, 2, 15, 4, 3, 11, 6, 5, 8};
+    uint32              TagId;
+    uint32              Bad = 0;
+    uint32              i;
+
+    UT_NowUs = 1000000;
+
+    /* Equal times come out in insertion order */
+    for (TagId = 1; TagId <= HYUN_APP_TTAG_CAPACITY; TagId++)
+    {
+        UT_Ttag_Insert(TagId, UT_NowUs + Times[TagId - 1] * 1000u, HYUN_APP_NOOP_CC);
+    }
+
+    /* Nothing due yet */
+    HYUN_APP_TtagService();
+    UtAssert_True(UT_DispatchCount == 0, "Nothing dispatched before its time");
+
+    /* Due commands run soonest first, late ones report their jitter */
+    UT_NowUs += 7000;
+    HYUN_APP_TtagService();
+    UtAssert_True(UT_DispatchCount == 11, "UT_DispatchCount (%lu) == 11", (unsigned long)UT_DispatchCount);
+    UtAssert_True(HYUN_APP_Data.Ttag.MaxJitterUs == 6000, "MaxJitterUs (%lu) == 6000",
+                  (unsigned long)HYUN_APP_Data.Ttag.MaxJitterUs);
+    UtAssert_True(HYUN_APP_Data.Ttag.LastJitterUs == 0, "LastJitterUs (%lu) == 0",
+                  (unsigned long)HYUN_APP_Data.Ttag.LastJitterUs);
+
+    UT_NowUs += 1000000;
+    HYUN_APP_TtagService();
+    UtAssert_True(UT_DispatchCount == HYUN_APP_TTAG_CAPACITY && HYUN_APP_Data.Ttag.Count == 0, "Queue drained");
+    UtAssert_True(HYUN_APP_Data.Ttag.ExecCounter == HYUN_APP_TTAG_CAPACITY, "ExecCounter (%u)",
+                  (unsigned int)HYUN_APP_Data.Ttag.ExecCounter);
+
+    for (i = 1; i < UT_DispatchCount; i++)
+    {
+        if (Times[UT_Dispatched[i] - 1] < Times[UT_Dispatched[i - 1] - 1] ||
+            (Times[UT_Dispatched[i] - 1] == Times[UT_Dispatched[i - 1] - 1] && UT_Dispatched[i] < UT_Dispatched[i - 1]))
+        {
+            Bad++;
+        }
+    }
+    UtAssert_True(Bad == 0, "Dispatched in (time, insertion) order (%lu out of order)", (unsigned long)Bad);
+
+    /* Freed entries are reused */
+    UtAssert_True(UT_Ttag_Insert(1, UT_NowUs + 1000, HYUN_APP_NOOP_CC) == CFE_SUCCESS, "Tag 1 reused");
+}
+
+void Test_HYUN_APP_TtagCancelCmd(void)
+{
+    /*
+     * Test Case For:
+     * int32 HYUN_APP_TtagCancelCmd(const HYUN_APP_TtagCancelCmd_t *Msg)
+     */
+    uint32 TagId;
+
+    UT_NowUs = 1000000;
+    for (TagId = 1; TagId <= 8; TagId++)
+    {
+        UT_Ttag_Insert(TagId, UT_NowUs + (9 - TagId) * 1000u, HYUN_APP_NOOP_CC);
+    }
+
+    UtAssert_True(UT_Ttag_Cancel(8) == CFE_SUCCESS, "Cancel the root");
+    UtAssert_True(UT_Ttag_Cancel(4) == CFE_SUCCESS, "Cancel from the middle");
+    UtAssert_True(UT_Ttag_Cancel(4) == CFE_STATUS_EXTERNAL_RESOURCE_FAIL, "Cancel twice");
+    UtAssert_True(UT_Ttag_Cancel(0) == CFE_STATUS_EXTERNAL_RESOURCE_FAIL, "Cancel tag zero");
+    UtAssert_True(HYUN_APP_Data.Ttag.Count == 6, "Count (%lu) == 6", (unsigned long)HYUN_APP_Data.Ttag.Count);
+
+    UT_NowUs += 10000;
+    HYUN_APP_TtagService();
+    UtAssert_True(UT_DispatchCount == 6, "UT_DispatchCount (%lu) == 6", (unsigned long)UT_DispatchCount);
+    UtAssert_True(UT_Dispatched[0] == 7 && UT_Dispatched[2] == 5 && UT_Dispatched[3] == 3 && UT_Dispatched[5] == 1,
+                  "Cancelled tags skipped, order kept");
+}
+
+void Test_HYUN_APP_TtagListCmd(void)
+{
+    /*
+     * Test Case For:
+     * int32 HYUN_APP_TtagListCmd(const HYUN_APP_TtagListCmd_t *Msg)
+     */
+    HYUN_APP_TtagListCmd_t Cmd;
+    CFE_MSG_FcnCode_t      CommandCodes[3] = {HYUN_APP_NOOP_CC, HYUN_APP_RESET_COUNTERS_CC, HYUN_APP_NOOP_CC};
+    uint8                  Heap[HYUN_APP_TTAG_CAPACITY];
+
+    memset(&Cmd, 0, sizeof(Cmd));
+
+    UT_NowUs = 5000000;
+    UT_Ttag_Insert(30, 9000001, HYUN_APP_NOOP_CC);
+    UT_Ttag_Insert(10, 6500000, HYUN_APP_NOOP_CC);
+    UT_Ttag_Insert(20, 7000000, HYUN_APP_NOOP_CC);
+    memcpy(Heap, HYUN_APP_Data.Ttag.Heap, sizeof(Heap));
+
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetFcnCode), CommandCodes, sizeof(CommandCodes), false);
+    UtAssert_True(HYUN_APP_TtagListCmd(&Cmd) == CFE_SUCCESS, "TtagListCmd() == CFE_SUCCESS");
+    UtAssert_True(UT_PostCount == 1, "List posted for downlink");
+    UtAssert_True(UT_ListTlm.Payload.Pending == 3, "Pending (%u) == 3", (unsigned int)UT_ListTlm.Payload.Pending);
+    UtAssert_True(UT_ListTlm.Payload.TagId[0] == 10 && UT_ListTlm.Payload.TagId[1] == 20 &&
+                      UT_ListTlm.Payload.TagId[2] == 30,
+                  "Soonest first");
+    UtAssert_True(UT_ListTlm.Payload.MetSeconds[0] == 6 && UT_ListTlm.Payload.MetMicros[0] == 500000,
+                  "MET %lu.%06lu", (unsigned long)UT_ListTlm.Payload.MetSeconds[0],
+                  (unsigned long)UT_ListTlm.Payload.MetMicros[0]);
+    UtAssert_True(UT_ListTlm.Payload.CommandCode[1] == HYUN_APP_RESET_COUNTERS_CC, "CommandCode (%u)",
+                  (unsigned int)UT_ListTlm.Payload.CommandCode[1]);
+    UtAssert_True(HYUN_APP_Data.Ttag.Count == 3 && memcmp(Heap, HYUN_APP_Data.Ttag.Heap, sizeof(Heap)) == 0,
+                  "Queue left as it was");
+
+    /* No buffer free */
+    UT_PoolEmpty = true;
+    UtAssert_True(HYUN_APP_TtagListCmd(&Cmd) == CFE_STATUS_EXTERNAL_RESOURCE_FAIL, "Refused without a buffer");
+    UtAssert_True(UT_PostCount == 1, "Nothing posted");
+}
+
+void Test_HYUN_APP_TtagTimeout(void)
+{
+    /*
+     * Test Case For:
+     * int32 HYUN_APP_TtagTimeout(int32 MaxMs)
+     */
+    UT_NowUs = 1000000;
+    UtAssert_True(HYUN_APP_TtagTimeout(1000) == 1000, "Empty queue waits MaxMs");
+
+    UT_Ttag_Insert(1, 1250500, HYUN_APP_NOOP_CC);
+    UtAssert_True(HYUN_APP_TtagTimeout(1000) == 251, "Wait rounded up to the due time (%ld)",
+                  (long)HYUN_APP_TtagTimeout(1000));
+    UtAssert_True(HYUN_APP_TtagTimeout(100) == 100, "Never longer than MaxMs");
+
+    UT_NowUs = 1250500;
+    UtAssert_True(HYUN_APP_TtagTimeout(1000) == CFE_SB_POLL, "Due now: poll");
+}
+
+/*
+ * Setup function prior to every test
+ */
+void Hyun_UT_Setup(void)
+{
+    UT_ResetState(0);
+
+    memset(&HYUN_APP_Data, 0, sizeof(HYUN_APP_Data));
+    HYUN_APP_TtagInit();
+
+    memset(&UT_ListTlm, 0, sizeof(UT_ListTlm));
+    UT_NowUs         = 0;
+    UT_DispatchCount = 0;
+    UT_PoolEmpty     = false;
+    UT_PostCount     = 0;
+}
+
+/*
+ * Teardown function after every test
+ */
+void Hyun_UT_TearDown(void) {}
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    ADD_TEST(HYUN_APP_TtagInsertCmd);
+    ADD_TEST(HYUN_APP_TtagService);
+    ADD_TEST(HYUN_APP_TtagCancelCmd);
+    ADD_TEST(HYUN_APP_TtagListCmd);
+    ADD_TEST(HYUN_APP_TtagTimeout);
+}
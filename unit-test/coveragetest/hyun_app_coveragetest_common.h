@@ -21,11 +21,11 @@
 /**
  * @file
  *
- * Common definitions for all sample_app coverage tests
+ * Common definitions for all hyun_app coverage tests
  */
 
-#ifndef SAMPLE_APP_COVERAGETEST_COMMON_H
-#define SAMPLE_APP_COVERAGETEST_COMMON_H
+#ifndef HYUN_APP_COVERAGETEST_COMMON_H
+#define HYUN_APP_COVERAGETEST_COMMON_H
 
 /*
  * Includes
@@ -36,9 +36,9 @@
 #include "utstubs.h"
 
 #include "cfe.h"
-#include "sample_app_events.h"
-#include "sample_app.h"
-#include "sample_app_table.h"
+#include "hyun_app_events.h"
+#include "hyun_app.h"
+#include "hyun_app_table.h"
 
 /*
  * Macro to call a function and check its int32 return code
@@ -53,16 +53,16 @@
 /*
  * Macro to add a test case to the list of tests to execute
  */
-#define ADD_TEST(test) UtTest_Add((Test_##test), Sample_UT_Setup, Sample_UT_TearDown, #test)
+#define ADD_TEST(test) UtTest_Add((Test_##test), Hyun_UT_Setup, Hyun_UT_TearDown, #test)
 
 /*
  * Setup function prior to every test
  */
-void Sample_UT_Setup(void);
+void Hyun_UT_Setup(void);
 
 /*
  * Teardown function after every test
  */
-void Sample_UT_TearDown(void);
+void Hyun_UT_TearDown(void);
 
-#endif /* SAMPLE_APP_COVERAGETEST_COMMON_H */
+#endif /* HYUN_APP_COVERAGETEST_COMMON_H */